@@ -111,8 +111,7 @@ int JackGoldfishDriver::Write() {
 
 int JackGoldfishDriver::SetBufferSize(jack_nframes_t buffer_size) {
     jack_log("JackGoldfishDriver::SetBufferSize");
-    JackAudioDriver::SetBufferSize(buffer_size);
-    return 0;
+    return JackAudioDriver::SetBufferSize(buffer_size);
 }
 
 } // end of namespace
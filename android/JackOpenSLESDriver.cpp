@@ -134,8 +134,7 @@ int JackOpenSLESDriver::Write() {
 
 int JackOpenSLESDriver::SetBufferSize(jack_nframes_t buffer_size) {
     jack_log("JackOpenSLESDriver::SetBufferSize");
-    JackAudioDriver::SetBufferSize(buffer_size);
-    return 0;
+    return JackAudioDriver::SetBufferSize(buffer_size);
 }
 
 } // end of namespace
@@ -26,6 +26,7 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 #include "JackGlobals.h"
 #include "JackTime.h"
 #include "JackPortType.h"
+#include "JackCycleTimings.h"
 #include <math.h>
 
 using namespace Jack;
@@ -161,6 +162,11 @@ extern "C"
     LIB_EXPORT int jack_connect(jack_client_t *,
                              const char* source_port,
                              const char* destination_port);
+    LIB_EXPORT int jack_connect_list(jack_client_t *,
+                                const char** source_ports,
+                                const char** destination_ports,
+                                int count,
+                                int* results);
     LIB_EXPORT int jack_disconnect(jack_client_t *,
                                 const char* source_port,
                                 const char* destination_port);
@@ -197,6 +203,16 @@ extern "C"
     LIB_EXPORT float jack_get_max_delayed_usecs(jack_client_t *client);
     LIB_EXPORT float jack_get_xrun_delayed_usecs(jack_client_t *client);
     LIB_EXPORT void jack_reset_max_delayed_usecs(jack_client_t *client);
+    LIB_EXPORT int jack_get_client_load(jack_client_t *client, const char *client_name, jack_client_load_t *load);
+    LIB_EXPORT int jack_get_client_dsp_percentile(jack_client_t *client, const char *client_name, float percentile, jack_time_t *usecs);
+    LIB_EXPORT void jack_reset_client_loads(jack_client_t *client);
+    LIB_EXPORT int jack_set_cycle_timings(jack_client_t *client, int onoff);
+    LIB_EXPORT int jack_get_cycle_timings(jack_client_t *client,
+                                          uint32_t cycle,
+                                          jack_cycle_timing_t *timing,
+                                          jack_client_cycle_timing_t *clients,
+                                          int max_clients);
+    LIB_EXPORT int jack_get_cycle_timings_client_name(jack_client_t *client, int id, char *name, size_t size);
 
     LIB_EXPORT int jack_release_timebase(jack_client_t *client);
     LIB_EXPORT int jack_set_sync_callback(jack_client_t *client,
@@ -636,7 +652,7 @@ LIB_EXPORT int jack_port_set_alias(jack_port_t* port, const char* name)
         return -1;
     } else {
         JackGraphManager* manager = GetGraphManager();
-        return (manager ? manager->GetPort(myport)->SetAlias(name) : -1);
+        return (manager ? manager->SetPortAlias(myport, name) : -1);
     }
 }
 
@@ -654,7 +670,7 @@ LIB_EXPORT int jack_port_unset_alias(jack_port_t* port, const char* name)
         return -1;
     } else {
         JackGraphManager* manager = GetGraphManager();
-        return (manager ? manager->GetPort(myport)->UnsetAlias(name) : -1);
+        return (manager ? manager->UnsetPortAlias(myport, name) : -1);
     }
 }
 
@@ -1176,6 +1192,32 @@ LIB_EXPORT int jack_connect(jack_client_t* ext_client, const char* src, const ch
     }
 }
 
+LIB_EXPORT int jack_connect_list(jack_client_t* ext_client, const char** src, const char** dst, int count, int* results)
+{
+    JackGlobals::CheckContext("jack_connect_list");
+
+    JackClient* client = (JackClient*)ext_client;
+    if (client == NULL) {
+        jack_error("jack_connect_list called with a NULL client");
+        return -1;
+    } else if ((src == NULL) || (dst == NULL) || (count < 0)) {
+        jack_error("jack_connect_list called with a NULL port name list");
+        return -1;
+    }
+    for (int i = 0; i < count; i++) {
+        if ((src[i] == NULL) || (dst[i] == NULL)) {
+            jack_error("jack_connect_list called with a NULL port name");
+            return -1;
+        }
+    }
+    if (results) {
+        return client->PortConnect(src, dst, count, results);
+    } else {
+        std::vector<int> connection_results(count);
+        return client->PortConnect(src, dst, count, (count > 0) ? &connection_results[0] : NULL);
+    }
+}
+
 LIB_EXPORT int jack_disconnect(jack_client_t* ext_client, const char* src, const char* dst)
 {
     JackGlobals::CheckContext("jack_disconnect");
@@ -1460,7 +1502,7 @@ LIB_EXPORT size_t jack_port_type_get_buffer_size(jack_client_t* ext_client, cons
             jack_error("jack_port_type_get_buffer_size called with an unknown port type = %s", port_type);
             return 0;
         } else {
-            return GetPortType(port_id)->size();
+            return GetPortType(port_id)->size(GetEngineControl()->fBufferSize);
         }
     }
 }
@@ -1657,6 +1699,127 @@ LIB_EXPORT void jack_reset_max_delayed_usecs(jack_client_t* ext_client)
     }
 }
 
+LIB_EXPORT int jack_get_client_load(jack_client_t* ext_client, const char* client_name, jack_client_load_t* load)
+{
+    JackGlobals::CheckContext("jack_get_client_load");
+
+    JackClient* client = (JackClient*)ext_client;
+    if (client == NULL) {
+        jack_error("jack_get_client_load called with a NULL client");
+        return -1;
+    } else if (client_name == NULL || load == NULL) {
+        return -1;
+    } else {
+        JackEngineControl* control = GetEngineControl();
+        JackClientLoad* client_load = (control) ? control->GetClientLoad(client_name) : NULL;
+        if (client_load) {
+            load->cpu_load = client_load->fCPULoad;
+            load->dsp_usecs = client_load->fDSPUsecs;
+            load->average_dsp_usecs = client_load->fAverageDSPUsecs;
+            load->max_dsp_usecs = client_load->fMaxDSPUsecs;
+            load->wakeup_usecs = client_load->fWakeUpUsecs;
+            load->average_wakeup_usecs = client_load->fAverageWakeUpUsecs;
+            load->max_wakeup_usecs = client_load->fMaxWakeUpUsecs;
+            load->late_cycles = client_load->fLateCycles;
+            load->notify_usecs = client_load->fNotifyUsecs;
+            load->max_notify_usecs = client_load->fMaxNotifyUsecs;
+            return 0;
+        } else {
+            return -1;
+        }
+    }
+}
+
+LIB_EXPORT int jack_get_client_dsp_percentile(jack_client_t* ext_client, const char* client_name, float percentile, jack_time_t* usecs)
+{
+    JackGlobals::CheckContext("jack_get_client_dsp_percentile");
+
+    JackClient* client = (JackClient*)ext_client;
+    if (client == NULL) {
+        jack_error("jack_get_client_dsp_percentile called with a NULL client");
+        return -1;
+    } else if (client_name == NULL || usecs == NULL) {
+        return -1;
+    } else {
+        JackEngineControl* control = GetEngineControl();
+        JackClientLoad* client_load = (control) ? control->GetClientLoad(client_name) : NULL;
+        if (client_load) {
+            *usecs = client_load->GetDSPPercentile(percentile);
+            return 0;
+        } else {
+            return -1;
+        }
+    }
+}
+
+LIB_EXPORT void jack_reset_client_loads(jack_client_t* ext_client)
+{
+    JackGlobals::CheckContext("jack_reset_client_loads");
+
+    JackClient* client = (JackClient*)ext_client;
+    if (client == NULL) {
+        jack_error("jack_reset_client_loads called with a NULL client");
+    } else {
+        JackEngineControl* control = GetEngineControl();
+        control->ResetClientLoads();
+    }
+}
+
+LIB_EXPORT int jack_set_cycle_timings(jack_client_t* ext_client, int onoff)
+{
+    JackGlobals::CheckContext("jack_set_cycle_timings");
+
+    JackClient* client = (JackClient*)ext_client;
+    if (client == NULL) {
+        jack_error("jack_set_cycle_timings called with a NULL client");
+        return -1;
+    } else {
+        JackCycleTimings* timings = GetCycleTimings();
+        if (timings) {
+            timings->fEnabled = (onoff) ? 1 : 0;
+            return 0;
+        } else {
+            return -1;
+        }
+    }
+}
+
+LIB_EXPORT int jack_get_cycle_timings(jack_client_t* ext_client,
+                                      uint32_t cycle,
+                                      jack_cycle_timing_t* timing,
+                                      jack_client_cycle_timing_t* clients,
+                                      int max_clients)
+{
+    JackGlobals::CheckContext("jack_get_cycle_timings");
+
+    JackClient* client = (JackClient*)ext_client;
+    if (client == NULL) {
+        jack_error("jack_get_cycle_timings called with a NULL client");
+        return -1;
+    } else if (timing == NULL || (clients == NULL && max_clients > 0)) {
+        return -1;
+    } else {
+        JackCycleTimings* timings = GetCycleTimings();
+        return (timings ? timings->Read(cycle, timing, clients, max_clients) : -1);
+    }
+}
+
+LIB_EXPORT int jack_get_cycle_timings_client_name(jack_client_t* ext_client, int id, char* name, size_t size)
+{
+    JackGlobals::CheckContext("jack_get_cycle_timings_client_name");
+
+    JackClient* client = (JackClient*)ext_client;
+    if (client == NULL) {
+        jack_error("jack_get_cycle_timings_client_name called with a NULL client");
+        return -1;
+    } else if (name == NULL) {
+        return -1;
+    } else {
+        JackCycleTimings* timings = GetCycleTimings();
+        return (timings ? timings->GetClientName(id, name, size) : -1);
+    }
+}
+
 // thread.h
 LIB_EXPORT int jack_client_real_time_priority(jack_client_t* ext_client)
 {
@@ -48,6 +48,7 @@ class JackActivationCount
         {}
 
         bool Signal(JackSynchro* synchro, JackClientControl* control);
+        bool Signal(JackClientControl* control);
 
         inline void Reset()
         {
@@ -74,6 +75,11 @@ class JackActivationCount
             return fValue;
         }
 
+        inline int GetCount() const
+        {
+            return fCount;
+        }
+
 }  POST_PACKED_STRUCTURE;
 
 } // end of namespace
@@ -41,6 +41,16 @@ static inline long DEC_ATOMIC(volatile SInt32* val)
     return actual;
 }
 
+// Orders the memory accesses made before and after, for data shared between threads or processes without locks
+static inline void MEMORY_BARRIER()
+{
+#ifdef WIN32
+    MemoryBarrier();
+#else
+    __sync_synchronize();
+#endif
+}
+
 #endif
 
 
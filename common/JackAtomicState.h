@@ -76,6 +76,131 @@ struct AtomicCounter
 #define CurIndex(e) (e).info.scounter.fShortVal1
 #define NextIndex(e) (e).info.scounter.fShortVal2
 
+#ifndef DIRTY_REGION_NUM
+#define DIRTY_REGION_NUM 128
+#endif
+
+/*!
+\brief Regions of a state modified by the writer since the state was last copied from the other one.
+
+The table is embedded in the state : region offsets are relative to the table itself, so they are valid for both states.
+When too many regions are marked, the whole state is considered as modified.
+*/
+
+PRE_PACKED_STRUCTURE
+class JackDirtyRegions
+{
+
+    private:
+
+        SInt32 fOffset[DIRTY_REGION_NUM];
+        UInt32 fSize[DIRTY_REGION_NUM];
+        UInt32 fCount;
+        bool fAll;
+
+    public:
+
+        JackDirtyRegions()
+        {
+            SetAll();
+        }
+
+        void Clear()
+        {
+            fCount = 0;
+            fAll = false;
+        }
+
+        void SetAll()
+        {
+            fCount = 0;
+            fAll = true;
+        }
+
+        bool IsAll() const
+        {
+            return fAll;
+        }
+
+        UInt32 GetCount() const
+        {
+            return fCount;
+        }
+
+        void Mark(const void* addr, size_t size)
+        {
+            if (fAll) {
+                return;
+            }
+
+            SInt32 start = SInt32((const char*)addr - (const char*)this);
+            SInt32 end = start + SInt32(size);
+
+            // Merge with an overlapping or contiguous region
+            for (UInt32 i = 0; i < fCount; i++) {
+                SInt32 cur_start = fOffset[i];
+                SInt32 cur_end = cur_start + SInt32(fSize[i]);
+                if (start <= cur_end && end >= cur_start) {
+                    fOffset[i] = (start < cur_start) ? start : cur_start;
+                    fSize[i] = UInt32(((end > cur_end) ? end : cur_end) - fOffset[i]);
+                    return;
+                }
+            }
+
+            if (fCount == DIRTY_REGION_NUM) {
+                SetAll();
+            } else {
+                fOffset[fCount] = start;
+                fSize[fCount] = UInt32(size);
+                fCount++;
+            }
+        }
+
+        /*!
+        \brief Copy the regions marked in src (the table of the other state) into the state containing this table.
+        */
+        void CopyRegions(const JackDirtyRegions& src)
+        {
+            for (UInt32 i = 0; i < src.fCount; i++) {
+                memcpy((char*)this + src.fOffset[i], (const char*)&src + src.fOffset[i], src.fSize[i]);
+            }
+        }
+
+} POST_PACKED_STRUCTURE;
+
+/*!
+\brief Copy a state into the other one : state types can specialize it to only copy their used part.
+*/
+
+template <class T>
+inline void JackCopyState(T* dst, const T* src)
+{
+    memcpy(dst, src, sizeof(T));
+}
+
+/*!
+\brief A state padded to a multiple of ALIGN bytes : both states of a JackAtomicState then have the same alignment.
+
+Atomic operations done on a state (like activation counters) are very slow when their operand crosses a cache line.
+*/
+
+PRE_PACKED_STRUCTURE
+template <class T, int ALIGN = 8>
+class JackAlignedState : public T
+{
+
+    private:
+
+        char fPadding[ALIGN - sizeof(T) % ALIGN];
+
+} POST_PACKED_STRUCTURE;
+
+template <class T, int ALIGN>
+inline void JackCopyState(JackAlignedState<T, ALIGN>* dst, const JackAlignedState<T, ALIGN>* src)
+{
+    JackCopyState(static_cast<T*>(dst), static_cast<const T*>(src));
+}
+
 #define CurArrayIndex(e) (CurIndex(e) & 0x0001)
 #define NextArrayIndex(e) ((CurIndex(e) + 1) & 0x0001)
 
@@ -92,7 +217,7 @@ class JackAtomicState
 
     protected:
 
-        T fState[2];
+        MEM_ALIGN(T fState[2], __alignof__(T));     // Aligned states (like JackAlignedState) keep their alignment in the packed layout
         volatile AtomicCounter fCounter;
         SInt32 fCallWriteCounter;
 
@@ -112,7 +237,7 @@ class JackAtomicState
                 NextIndex(new_val) = CurIndex(new_val); // Invalidate next index
             } while (!CAS(Counter(old_val), Counter(new_val), (UInt32*)&fCounter));
             if (need_copy)
-                memcpy(&fState[next_index], &fState[cur_index], sizeof(T));
+                JackCopyState(&fState[next_index], &fState[cur_index]);
             return next_index;
         }
 
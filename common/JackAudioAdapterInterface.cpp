@@ -24,6 +24,7 @@ Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
 #include "JackAudioAdapter.h"
 #ifndef MY_TARGET_OS_IPHONE
 #include "JackLibSampleRateResampler.h"
+#include "JackPolyphaseResampler.h"
 #endif
 #include "JackTime.h"
 #include "JackError.h"
@@ -189,6 +190,15 @@ namespace Jack
     void JackAudioAdapterInterface::Create()
     {}
 #else
+    JackResampler* JackAudioAdapterInterface::CreateResampler()
+    {
+        if (fQuality == POLYPHASE_QUALITY) {
+            return new JackPolyphaseResampler();
+        } else {
+            return new JackLibSampleRateResampler(fQuality);
+        }
+    }
+
     void JackAudioAdapterInterface::Create()
     {
         //ringbuffers
@@ -206,11 +216,11 @@ namespace Jack
         }
 
         for (int i = 0; i < fCaptureChannels; i++ ) {
-            fCaptureRingBuffer[i] = new JackLibSampleRateResampler(fQuality);
+            fCaptureRingBuffer[i] = CreateResampler();
             fCaptureRingBuffer[i]->Reset(fRingbufferCurSize);
         }
         for (int i = 0; i < fPlaybackChannels; i++ ) {
-            fPlaybackRingBuffer[i] = new JackLibSampleRateResampler(fQuality);
+            fPlaybackRingBuffer[i] = CreateResampler();
             fPlaybackRingBuffer[i]->Reset(fRingbufferCurSize);
         }
 
@@ -258,22 +268,18 @@ namespace Jack
             fTable.Write(fCaptureRingBuffer[0]->GetError(), fCaptureRingBuffer[0]->GetError() - delta_frames, ratio, 1/ratio, fCaptureRingBuffer[0]->ReadSpace(), fCaptureRingBuffer[0]->ReadSpace());
     #endif
 
-        // Push/pull from ringbuffer
-        for (int i = 0; i < fCaptureChannels; i++) {
-            fCaptureRingBuffer[i]->SetRatio(ratio);
-            if (inputBuffer[i]) {
-                if (fCaptureRingBuffer[i]->WriteResample(inputBuffer[i], frames) < frames) {
-                    failure = true;
-                }
+        // Push/pull from ringbuffer, all channels at once
+        if (fCaptureChannels > 0) {
+            fCaptureRingBuffer[0]->SetRatio(ratio);
+            if (fCaptureRingBuffer[0]->WriteResampleChannels(fCaptureRingBuffer, inputBuffer, fCaptureChannels, frames) < frames) {
+                failure = true;
             }
         }
 
-        for (int i = 0; i < fPlaybackChannels; i++) {
-            fPlaybackRingBuffer[i]->SetRatio(1/ratio);
-            if (outputBuffer[i]) {
-                if (fPlaybackRingBuffer[i]->ReadResample(outputBuffer[i], frames) < frames) {
-                     failure = true;
-                }
+        if (fPlaybackChannels > 0) {
+            fPlaybackRingBuffer[0]->SetRatio(1/ratio);
+            if (fPlaybackRingBuffer[0]->ReadResampleChannels(fPlaybackRingBuffer, outputBuffer, fPlaybackChannels, frames) < frames) {
+                failure = true;
             }
         }
         // Reset all ringbuffers in case of failure
@@ -95,6 +95,8 @@ namespace Jack
         bool fRunning;
         bool fAdaptative;
 
+        JackResampler* CreateResampler();
+
         void ResetRingBuffers();
         void AdaptRingBufferSize();
         void GrowRingBufferSize();
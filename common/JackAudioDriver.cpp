@@ -43,10 +43,14 @@ JackAudioDriver::~JackAudioDriver()
 
 int JackAudioDriver::SetBufferSize(jack_nframes_t buffer_size)
 {
-    // Update engine and graph manager state
+    // Port buffers are allocated first : on failure, the graph manager and the engine keep the previous buffer size
+    if (fGraphManager->SetBufferSize(buffer_size) < 0) {
+        return -1;
+    }
+
+    // Update engine state
     fEngineControl->fBufferSize = buffer_size;
-    fGraphManager->SetBufferSize(buffer_size);
-    
+
     fEngineControl->UpdateTimeOut();
     UpdateLatencies();
 
@@ -113,7 +117,6 @@ void JackAudioDriver::UpdateLatencies()
 
 int JackAudioDriver::Attach()
 {
-    JackPort* port;
     jack_port_id_t port_index;
     char name[REAL_JACK_PORT_NAME_SIZE];
     char alias[REAL_JACK_PORT_NAME_SIZE];
@@ -128,8 +131,7 @@ int JackAudioDriver::Attach()
             jack_error("driver: cannot register port for %s", name);
             return -1;
         }
-        port = fGraphManager->GetPort(port_index);
-        port->SetAlias(alias);
+        fGraphManager->SetPortAlias(port_index, alias);
         fCapturePortList[i] = port_index;
         jack_log("JackAudioDriver::Attach fCapturePortList[i] port_index = %ld", port_index);
     }
@@ -141,8 +143,7 @@ int JackAudioDriver::Attach()
             jack_error("driver: cannot register port for %s", name);
             return -1;
         }
-        port = fGraphManager->GetPort(port_index);
-        port->SetAlias(alias);
+        fGraphManager->SetPortAlias(port_index, alias);
         fPlaybackPortList[i] = port_index;
         jack_log("JackAudioDriver::Attach fPlaybackPortList[i] port_index = %ld", port_index);
 
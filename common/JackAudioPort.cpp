@@ -23,6 +23,7 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 #include "JackPortType.h"
 
 #include <string.h>
+#include <algorithm>
 
 #if defined (__APPLE__)
 #include <Accelerate/Accelerate.h>
@@ -30,6 +31,16 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 #include <xmmintrin.h>
 #endif
 
+// Kernels using larger vectors are compiled for their instruction set and chosen at run time on CPU features
+#if (defined (__i386__) || defined (__x86_64__)) && defined (__SSE__) && !defined (__APPLE__) && !defined (__sun__) \
+    && (defined (__clang__) || __GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))
+#define JACK_MIXDOWN_DISPATCH
+#include <immintrin.h>
+#endif
+
+#define MIXDOWN_GROUP       4   // Sources summed in one pass on the buffer
+#define MIXDOWN_GROUP_AVX   8
+
 namespace Jack
 {
 
@@ -38,99 +49,177 @@ static void AudioBufferInit(void* buffer, size_t buffer_size, jack_nframes_t)
     memset(buffer, 0, buffer_size);
 }
 
-static inline void MixAudioBuffer(jack_default_audio_sample_t* mixbuffer, jack_default_audio_sample_t* buffer, jack_nframes_t frames)
-{
+/*
+A group of sources is summed in a single pass, the partial sum being kept in registers : the mix buffer is read and
+written once per group instead of once per source. Sources are added in the same order as a source by source mix,
+so all kernels give the same result.
+*/
+
 #ifdef __APPLE__
-    vDSP_vadd(buffer, 1, mixbuffer, 1, mixbuffer, 1, frames);
+
+static void AudioBufferMixdown(void* mixbuffer, void** src_buffers, int src_count, jack_nframes_t nframes)
+{
+    jack_default_audio_sample_t* target = static_cast<jack_default_audio_sample_t*>(mixbuffer);
+
+    memcpy(mixbuffer, src_buffers[0], nframes * sizeof(jack_default_audio_sample_t));
+    for (int i = 1; i < src_count; ++i) {
+        vDSP_vadd(static_cast<jack_default_audio_sample_t*>(src_buffers[i]), 1, target, 1, target, 1, nframes);
+    }
+}
+
+static JackAudioMixdown gAudioMixdownTable[1] = { { "vdsp", AudioBufferMixdown } };
+static int gAudioMixdownCount = 1;
+
 #else
-    jack_nframes_t frames_group = frames / 4;
-    frames = frames % 4;
-
-    while (frames_group > 0) {
-    #if defined (__SSE__) && !defined (__sun__)
-        __m128 vec = _mm_add_ps(_mm_load_ps(mixbuffer), _mm_load_ps(buffer));
-        _mm_store_ps(mixbuffer, vec);
-
-        mixbuffer += 4;
-        buffer += 4;
-        frames_group--;
-    #else
-        register jack_default_audio_sample_t mixFloat1 = *mixbuffer;
-        register jack_default_audio_sample_t sourceFloat1 = *buffer;
-        register jack_default_audio_sample_t mixFloat2 = *(mixbuffer + 1);
-        register jack_default_audio_sample_t sourceFloat2 = *(buffer + 1);
-        register jack_default_audio_sample_t mixFloat3 = *(mixbuffer + 2);
-        register jack_default_audio_sample_t sourceFloat3 = *(buffer + 2);
-        register jack_default_audio_sample_t mixFloat4 = *(mixbuffer + 3);
-        register jack_default_audio_sample_t sourceFloat4 = *(buffer + 3);
-
-        buffer += 4;
-        frames_group--;
-
-        mixFloat1 += sourceFloat1;
-        mixFloat2 += sourceFloat2;
-        mixFloat3 += sourceFloat3;
-        mixFloat4 += sourceFloat4;
-
-        *mixbuffer = mixFloat1;
-        *(mixbuffer + 1) = mixFloat2;
-        *(mixbuffer + 2) = mixFloat3;
-        *(mixbuffer + 3) = mixFloat4;
-
-        mixbuffer += 4;
-    #endif
+
+typedef void (*MixAudioBuffersFunction)(jack_default_audio_sample_t* mixbuffer,
+                                        const jack_default_audio_sample_t* first,
+                                        jack_default_audio_sample_t** buffers,
+                                        int count,
+                                        jack_nframes_t frames);
+
+static inline void MixAudioBuffersTail(jack_default_audio_sample_t* mixbuffer,
+                                       const jack_default_audio_sample_t* first,
+                                       jack_default_audio_sample_t** buffers,
+                                       int count,
+                                       jack_nframes_t index,
+                                       jack_nframes_t frames)
+{
+    for (jack_nframes_t i = index; i < frames; i++) {
+        jack_default_audio_sample_t sum = first[i];
+        for (int j = 0; j < count; j++) {
+            sum += buffers[j][i];
+        }
+        mixbuffer[i] = sum;
     }
+}
+
+// mixbuffer = first + buffers[0] + ... + buffers[count - 1]
+static void MixAudioBuffers(jack_default_audio_sample_t* mixbuffer,
+                            const jack_default_audio_sample_t* first,
+                            jack_default_audio_sample_t** buffers,
+                            int count,
+                            jack_nframes_t frames)
+{
+    jack_nframes_t i = 0;
 
-    while (frames > 0) {
-        register jack_default_audio_sample_t mixFloat1 = *mixbuffer;
-        register jack_default_audio_sample_t sourceFloat1 = *buffer;
-        buffer++;
-        frames--;
-        mixFloat1 += sourceFloat1;
-        *mixbuffer = mixFloat1;
-        mixbuffer++;
+#if defined (__SSE__) && !defined (__sun__)
+    for (; i + 4 <= frames; i += 4) {
+        __m128 vec = _mm_load_ps(first + i);
+        for (int j = 0; j < count; j++) {
+            vec = _mm_add_ps(vec, _mm_load_ps(buffers[j] + i));
+        }
+        _mm_store_ps(mixbuffer + i, vec);
     }
 #endif
+
+    MixAudioBuffersTail(mixbuffer, first, buffers, count, i, frames);
 }
 
-static void AudioBufferMixdown(void* mixbuffer, void** src_buffers, int src_count, jack_nframes_t nframes)
+#ifdef JACK_MIXDOWN_DISPATCH
+
+__attribute__((target("avx")))
+static void MixAudioBuffersAVX(jack_default_audio_sample_t* mixbuffer,
+                               const jack_default_audio_sample_t* first,
+                               jack_default_audio_sample_t** buffers,
+                               int count,
+                               jack_nframes_t frames)
 {
-    void* buffer;
+    jack_nframes_t i = 0;
+
+    for (; i + 8 <= frames; i += 8) {
+        __m256 vec = _mm256_loadu_ps(first + i);
+        for (int j = 0; j < count; j++) {
+            vec = _mm256_add_ps(vec, _mm256_loadu_ps(buffers[j] + i));
+        }
+        _mm256_storeu_ps(mixbuffer + i, vec);
+    }
 
-    // Copy first buffer
-#if defined (__SSE__) && !defined (__sun__)
-    jack_nframes_t frames_group = nframes / 4;
-    jack_nframes_t remaining_frames = nframes % 4;
+    MixAudioBuffersTail(mixbuffer, first, buffers, count, i, frames);
+}
+
+__attribute__((target("avx512f")))
+static void MixAudioBuffersAVX512(jack_default_audio_sample_t* mixbuffer,
+                                  const jack_default_audio_sample_t* first,
+                                  jack_default_audio_sample_t** buffers,
+                                  int count,
+                                  jack_nframes_t frames)
+{
+    jack_nframes_t i = 0;
+
+    for (; i + 16 <= frames; i += 16) {
+        __m512 vec = _mm512_loadu_ps(first + i);
+        for (int j = 0; j < count; j++) {
+            vec = _mm512_add_ps(vec, _mm512_loadu_ps(buffers[j] + i));
+        }
+        _mm512_storeu_ps(mixbuffer + i, vec);
+    }
+
+    MixAudioBuffersTail(mixbuffer, first, buffers, count, i, frames);
+}
+
+#endif
 
-    jack_default_audio_sample_t* source = static_cast<jack_default_audio_sample_t*>(src_buffers[0]);
+template <MixAudioBuffersFunction mix, int group>
+static void AudioBufferMixdownAux(void* mixbuffer, void** src_buffers, int src_count, jack_nframes_t nframes)
+{
     jack_default_audio_sample_t* target = static_cast<jack_default_audio_sample_t*>(mixbuffer);
+    jack_default_audio_sample_t** sources = reinterpret_cast<jack_default_audio_sample_t**>(src_buffers);
 
-    while (frames_group > 0) {
-        __m128 vec = _mm_load_ps(source);
-        _mm_store_ps(target, vec);
-        source += 4;
-        target += 4;
-        --frames_group;
-    }
+    // First group is copied to the mix buffer, next ones are added to it
+    int count = std::min(src_count, group);
+    mix(target, sources[0], sources + 1, count - 1, nframes);
 
-    for (jack_nframes_t i = 0; i != remaining_frames; ++i) {
-        target[i] = source[i];
+    for (int i = count; i < src_count; i += group) {
+        mix(target, target, sources + i, std::min(src_count - i, group), nframes);
     }
+}
+
+static JackAudioMixdown gAudioMixdownTable[3];
+static int gAudioMixdownCount = 0;
 
+static JackPortMixdownFunction SelectAudioMixdown()
+{
+#if defined (__SSE__) && !defined (__sun__)
+    JackAudioMixdown generic = { "sse", AudioBufferMixdownAux<MixAudioBuffers, MIXDOWN_GROUP> };
 #else
-    memcpy(mixbuffer, src_buffers[0], nframes * sizeof(jack_default_audio_sample_t));
+    JackAudioMixdown generic = { "scalar", AudioBufferMixdownAux<MixAudioBuffers, MIXDOWN_GROUP> };
 #endif
+    gAudioMixdownTable[gAudioMixdownCount++] = generic;
 
-    // Mix remaining buffers
-    for (int i = 1; i < src_count; ++i) {
-        buffer = src_buffers[i];
-        MixAudioBuffer(static_cast<jack_default_audio_sample_t*>(mixbuffer), static_cast<jack_default_audio_sample_t*>(buffer), nframes);
+#ifdef JACK_MIXDOWN_DISPATCH
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx")) {
+        JackAudioMixdown avx = { "avx", AudioBufferMixdownAux<MixAudioBuffersAVX, MIXDOWN_GROUP_AVX> };
+        gAudioMixdownTable[gAudioMixdownCount++] = avx;
+    }
+    if (__builtin_cpu_supports("avx512f")) {
+        JackAudioMixdown avx512 = { "avx512", AudioBufferMixdownAux<MixAudioBuffersAVX512, MIXDOWN_GROUP_AVX> };
+        gAudioMixdownTable[gAudioMixdownCount++] = avx512;
     }
+#endif
+
+    return gAudioMixdownTable[gAudioMixdownCount - 1].fMixdown;
+}
+
+static JackPortMixdownFunction gAudioBufferMixdown = SelectAudioMixdown();
+
+static void AudioBufferMixdown(void* mixbuffer, void** src_buffers, int src_count, jack_nframes_t nframes)
+{
+    gAudioBufferMixdown(mixbuffer, src_buffers, src_count, nframes);
+}
+
+#endif
+
+const JackAudioMixdown* GetAudioMixdowns(int* count)
+{
+    *count = gAudioMixdownCount;
+    return gAudioMixdownTable;
 }
 
-static size_t AudioBufferSize()
+static size_t AudioBufferSize(jack_nframes_t buffer_size)
 {
-    return GetEngineControl()->fBufferSize * sizeof(jack_default_audio_sample_t);
+    return buffer_size * sizeof(jack_default_audio_sample_t);
 }
 
 const JackPortType gAudioPortType =
@@ -0,0 +1,205 @@
+/*
+Copyright (C) 2026 agent
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 2.1 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*/
+
+#ifndef __JackBitSet__
+#define __JackBitSet__
+
+#include "JackCompilerDeps.h"
+#include "JackTypes.h"
+#include "JackAtomic.h"
+#include <string.h>
+
+namespace Jack
+{
+
+/*!
+\brief Fixed size set of indexes, usable in shared memory.
+
+Set/Reset are done by the server thread, Test/Next can be used concurrently by the RT thread : each word is read or written at once.
+Iterating on the set costs one test per 32 indexes plus one step per set index.
+SetAtomic/TakeFirst can be used concurrently by several threads : words are explicitly 4 bytes aligned, a set member of a packed
+structure has to be aligned the same way.
+Per cycle loops use an Iterator, which keeps the current word so that each step only clears its lowest bit.
+*/
+
+PRE_PACKED_STRUCTURE
+template <int SIZE>
+class JackFixedBitSet
+{
+
+    private:
+
+        MEM_ALIGN(UInt32 fWord[(SIZE + 31) / 32], 4);
+
+        static int FirstBit(UInt32 word)
+        {
+        #if __GNUC__
+            return __builtin_ctz(word);
+        #else
+            int bit = 0;
+            while (!(word & 1)) {
+                word >>= 1;
+                bit++;
+            }
+            return bit;
+        #endif
+        }
+
+    public:
+
+        /*!
+        	\brief Walk on the indexes of a set, from a given index : each word is read once.
+        */
+        class Iterator
+        {
+
+            private:
+
+                const volatile UInt32* fWords;
+                int fWordIndex;
+                UInt32 fWord;
+
+            public:
+
+                Iterator(const JackFixedBitSet& set, int index = 0)
+                    : fWords(set.fWord), fWordIndex(index >> 5), fWord(0)
+                {
+                    if (index < SIZE) {
+                        fWord = fWords[fWordIndex] & (~UInt32(0) << (index & 31));
+                    } else {
+                        fWordIndex = (SIZE + 31) / 32;
+                    }
+                }
+
+                /*!
+                	\brief Returns the next index of the set, or -1.
+                */
+                int Next()
+                {
+                    while (fWord == 0) {
+                        if (++fWordIndex >= (SIZE + 31) / 32) {
+                            return -1;
+                        }
+                        fWord = fWords[fWordIndex];
+                    }
+                    int bit = FirstBit(fWord);
+                    fWord &= fWord - 1;
+                    return (fWordIndex << 5) + bit;
+                }
+        };
+
+        JackFixedBitSet()
+        {
+            Init();
+        }
+
+        void Init()
+        {
+            memset(fWord, 0, sizeof(fWord));
+        }
+
+        void Set(int index)
+        {
+            fWord[index >> 5] |= (UInt32(1) << (index & 31));
+        }
+
+        void Reset(int index)
+        {
+            fWord[index >> 5] &= ~(UInt32(1) << (index & 31));
+        }
+
+        bool Test(int index) const
+        {
+            return (fWord[index >> 5] & (UInt32(1) << (index & 31))) != 0;
+        }
+
+        /*!
+        	\brief Add the indexes of another set.
+        */
+        void Union(const JackFixedBitSet& set)
+        {
+            for (int i = 0; i < (SIZE + 31) / 32; i++) {
+                fWord[i] |= set.fWord[i];
+            }
+        }
+
+        /*!
+        	\brief Returns the first index in the set greater or equal to index, or -1.
+        */
+        int Next(int index) const
+        {
+            if (index >= SIZE) {
+                return -1;
+            }
+            const volatile UInt32* words = fWord;
+            int word_index = index >> 5;
+            UInt32 word = words[word_index] & (~UInt32(0) << (index & 31));
+            while (word == 0) {
+                if (++word_index == (SIZE + 31) / 32) {
+                    return -1;
+                }
+                word = words[word_index];
+            }
+            return (word_index << 5) + FirstBit(word);
+        }
+
+        /*!
+        	\brief Set the index, the word being atomically updated.
+        */
+        void SetAtomic(int index)
+        {
+            volatile UInt32* word = &fWord[index >> 5];
+            UInt32 actual;
+            do {
+                actual = *word;
+            } while (!CAS(actual, actual | (UInt32(1) << (index & 31)), word));
+        }
+
+        /*!
+        	\brief Atomically remove the first index of the set and returns it, or -1 if the set is empty.
+        */
+        int TakeFirst()
+        {
+            for (int i = 0; i < (SIZE + 31) / 32; i++) {
+                volatile UInt32* word = &fWord[i];
+                UInt32 actual;
+                while ((actual = *word) != 0) {
+                    int bit = FirstBit(actual);
+                    if (CAS(actual, actual & ~(UInt32(1) << bit), word)) {
+                        return (i << 5) + bit;
+                    }
+                }
+            }
+            return -1;
+        }
+
+        int GetCount() const
+        {
+            int count = 0;
+            for (int i = Next(0); i >= 0; i = Next(i + 1)) {
+                count++;
+            }
+            return count;
+        }
+
+} POST_PACKED_STRUCTURE;
+
+} // end of namespace
+
+#endif
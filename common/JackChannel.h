@@ -143,6 +143,8 @@ class JackClientChannelInterface
 
         virtual void PortConnect(int refnum, const char* src, const char* dst, int* result)
         {}
+        virtual void PortConnect(int refnum, const char* const* src, const char* const* dst, int count, int* results, int* result)
+        {}
         virtual void PortDisconnect(int refnum, const char* src, const char* dst, int* result)
         {}
         virtual void PortConnect(int refnum, jack_port_id_t src, jack_port_id_t dst, int* result)
@@ -40,12 +40,13 @@ namespace Jack
 
 #define IsRealTime() ((fProcess != NULL) | (fThreadFun != NULL) | (fSync != NULL) | (fTimebase != NULL))
 
-JackClient::JackClient():fThread(this)
+JackClient::JackClient():fThread(this),fBufferPool(NULL)
 {}
 
 JackClient::JackClient(JackSynchro* table):fThread(this)
 {
     fSynchroTable = table;
+    fBufferPool = NULL;
     fProcess = NULL;
     fGraphOrder = NULL;
     fXrun = NULL;
@@ -116,6 +117,8 @@ int JackClient::Close()
     fChannel->ClientClose(GetClientControl()->fRefNum, &result);
   
     fChannel->Close();
+    JackPortBufferPool::Release(fBufferPool);
+    fBufferPool = NULL;
     assert(JackGlobals::fSynchroMutex);
     JackGlobals::fSynchroMutex->Lock();
     fSynchroTable[GetClientControl()->fRefNum].Disconnect();
@@ -210,6 +213,16 @@ int JackClient::ClientNotify(int refnum, const char* name, int notify, int sync,
 
             case kBufferSizeCallback:
                 jack_log("JackClient::kBufferSizeCallback buffer_size = %ld", value1);
+                // Port buffers have been allocated again for the new buffer size : mapped here, not in the RT thread
+                {
+                    JackPortBufferPool* pool = GetGraphManager()->MapBufferPool();
+                    if (pool) {
+                        JackPortBufferPool::Release(fBufferPool);
+                        fBufferPool = pool;
+                    } else {
+                        jack_error("JackClient::kBufferSizeCallback : cannot map port buffers");
+                    }
+                }
                 if (fBufferSize) {
                     res = fBufferSize(value1, fBufferSizeArg);
                 }
@@ -455,6 +468,8 @@ int JackClient::Activate()
 
     int result = -1;
     GetClientControl()->fCallback[kRealTimeCallback] = IsRealTime();
+    // Without latency callback, the default latency computation is done by the server
+    GetClientControl()->fCallback[kLatencyCallback] = (fLatency != NULL);
     fChannel->ClientActivate(GetClientControl()->fRefNum, IsRealTime(), &result);
     return result;
 }
@@ -619,6 +634,26 @@ void JackClient::CycleSignal(int status)
     CycleSignalAux(status);
 }
 
+/*!
+\brief Execute one cycle in the calling thread, for a client activated without its synchro (see JackGraphExecutor) : returns false if the process callback failed.
+*/
+bool JackClient::ExecuteCycle()
+{
+    JackClientTiming* timing = GetGraphManager()->GetClientTiming(GetClientControl()->fRefNum);
+    timing->fStatus = Running;
+    timing->fAwakeAt = GetMicroSeconds();
+    GetGraphManager()->MixInputs(GetClientControl()->fRefNum);
+
+    jack_tls_set(JackGlobals::fRealTimeThread, this);
+    CallSyncCallbackAux();
+    int status = CallProcessCallback();
+    if (status == 0) {
+        CallTimebaseCallbackAux();
+    }
+    SignalSync();
+    return (status == 0);
+}
+
 inline int JackClient::CallProcessCallback()
 {
     return (fProcess != NULL) ? fProcess(GetEngineControl()->fBufferSize, fProcessArg) : 0;
@@ -735,6 +770,24 @@ int JackClient::PortConnect(const char* src, const char* dst)
     return result;
 }
 
+int JackClient::PortConnect(const char* const* src, const char* const* dst, int count, int* results)
+{
+    jack_log("JackClient::Connect count = %d", count);
+    for (int i = 0; i < count; i++) {
+        if (strlen(src[i]) >= REAL_JACK_PORT_NAME_SIZE) {
+            jack_error("\"%s\" is too long to be used as a JACK port name.\n", src[i]);
+            return -1;
+        }
+        if (strlen(dst[i]) >= REAL_JACK_PORT_NAME_SIZE) {
+            jack_error("\"%s\" is too long to be used as a JACK port name.\n", dst[i]);
+            return -1;
+        }
+    }
+    int result = -1;
+    fChannel->PortConnect(GetClientControl()->fRefNum, src, dst, count, results, &result);
+    return result;
+}
+
 int JackClient::PortDisconnect(const char* src, const char* dst)
 {
     jack_log("JackClient::Disconnect src = %s dst = %s", src, dst);
@@ -793,6 +846,8 @@ int JackClient::SetFreeWheel(int onoff)
 int JackClient::ComputeTotalLatencies()
 {
     int result = -1;
+    // Latencies of the client ports have changed : the server computes the latencies it affects
+    GetGraphManager()->SetLatencyChanged(GetClientControl()->fRefNum);
     fChannel->ComputeTotalLatencies(&result);
     return result;
 }
@@ -1057,7 +1112,7 @@ int JackClient::SetBufferSizeCallback(JackBufferSizeCallback callback, void *arg
         jack_error("You cannot set callbacks on an active client");
         return -1;
     } else {
-        GetClientControl()->fCallback[kBufferSizeCallback] = (callback != NULL);
+        // fCallback[kBufferSizeCallback] is always set
         fBufferSizeArg = arg;
         fBufferSize = callback;
         return 0;
@@ -1183,7 +1238,7 @@ int JackClient::SetLatencyCallback(JackLatencyCallback callback, void *arg)
         jack_error("You cannot set callbacks on an active client");
         return -1;
     } else {
-        // fCallback[kLatencyCallback] must always be 'true'
+        // fCallback[kLatencyCallback] is set at activation
         fLatencyArg = arg;
         fLatency = callback;
         return 0;
@@ -37,6 +37,7 @@ namespace Jack
 class JackGraphManager;
 class JackServer;
 class JackEngine;
+class JackPortBufferPool;
 struct JackClientControl;
 struct JackEngineControl;
 
@@ -92,6 +93,7 @@ class SERVER_EXPORT JackClient : public JackClientInterface, public JackRunnable
         JackThread fThread;    /*! Thread to execute the Process function */
         detail::JackClientChannelInterface* fChannel;
         JackSynchro* fSynchroTable;
+        JackPortBufferPool* fBufferPool;    /*! Port buffers held by the client in this process */
         std::list<jack_port_id_t> fPortList;
 
         JackSessionReply fSessionReply;
@@ -152,6 +154,7 @@ class SERVER_EXPORT JackClient : public JackClientInterface, public JackRunnable
         virtual int PortUnRegister(jack_port_id_t port);
 
         virtual int PortConnect(const char* src, const char* dst);
+        virtual int PortConnect(const char* const* src, const char* const* dst, int count, int* results);
         virtual int PortDisconnect(const char* src, const char* dst);
         virtual int PortDisconnect(jack_port_id_t src);
 
@@ -196,6 +199,7 @@ class SERVER_EXPORT JackClient : public JackClientInterface, public JackRunnable
         // RT Thread
         jack_nframes_t CycleWait();
         void CycleSignal(int status);
+        bool ExecuteCycle();
         virtual int SetProcessThread(JackThreadCallback fun, void *arg);
 
         // Session API
@@ -76,6 +76,8 @@ struct JackClientControl : public JackShmMemAble
         fCallback[kRemoveClient] = true;
         fCallback[kActivateClient] = true;
         fCallback[kLatencyCallback] = true;
+        // So that port buffers allocated for a new buffer size are mapped by the notification thread, not the RT one
+        fCallback[kBufferSizeCallback] = true;
         // So that driver synchro are correctly setup in "flush" or "normal" mode
         fCallback[kStartFreewheelCallback] = true;
         fCallback[kStopFreewheelCallback] = true;
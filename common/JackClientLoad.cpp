@@ -0,0 +1,193 @@
+/*
+Copyright (C) 2026 agent
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 2.1 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*/
+
+#include "JackClientLoad.h"
+#include "JackConnectionManager.h"
+#include "JackEngineControl.h"
+#include <string.h>
+#include <math.h>
+
+namespace Jack
+{
+
+static inline jack_time_t Elapsed(jack_time_t from, jack_time_t to)
+{
+    return (from > 0 && to > from) ? to - from : 0;
+}
+
+void JackClientLoad::Init(const char* name)
+{
+    strncpy(fName, (name) ? name : "", JACK_CLIENT_NAME_SIZE);
+    fName[JACK_CLIENT_NAME_SIZE] = 0;
+    fRollingDSPUsecs = 0;
+    fRollingWakeUpUsecs = 0;
+    fRollingCount = 0;
+    fDSPUsecs = 0;
+    fWakeUpUsecs = 0;
+    fAverageDSPUsecs = 0;
+    fAverageWakeUpUsecs = 0;
+    fCPULoad = 0.f;
+    fNotifyUsecs = 0;
+    fResetCount = 0;
+    Reset();
+}
+
+void JackClientLoad::Reset()
+{
+    memset(fHistogram, 0, sizeof(fHistogram));
+    fMaxDSPUsecs = 0;
+    fMaxWakeUpUsecs = 0;
+    fLateCycles = 0;
+    fMaxNotifyUsecs = 0;
+}
+
+/*
+    Buckets 0 to 3 hold 0 to 3 usecs, then each power of two is split in 4 buckets:
+    4 to 7 usecs in buckets 4 to 7, 8-9, 10-11, 12-13, 14-15 usecs in buckets 8 to 11...
+*/
+
+int JackClientLoad::GetBucket(jack_time_t usecs)
+{
+    if (usecs < 4) {
+        return int(usecs);
+    }
+
+    int power = 2;
+    while ((usecs >> (power + 1)) != 0) {
+        power++;
+    }
+
+    int bucket = (power - 1) * 4 + int((usecs >> (power - 2)) & 3);
+    return (bucket < CLIENT_LOAD_BUCKETS) ? bucket : CLIENT_LOAD_BUCKETS - 1;
+}
+
+jack_time_t JackClientLoad::GetBucketMax(int bucket)
+{
+    if (bucket < 4) {
+        return jack_time_t(bucket);
+    }
+
+    int power = bucket / 4 + 1;
+    jack_time_t min = jack_time_t(4 + bucket % 4) << (power - 2);
+    return min + (jack_time_t(1) << (power - 2)) - 1;
+}
+
+/*
+    Called at the beginning of the next cycle, with the client timing of the previous one.
+    A client which is not finished at that time is late : its DSP time is counted until the next cycle begin.
+*/
+
+void JackClientLoad::Update(const JackClientTiming* timing,
+                            jack_time_t cycle_begin,
+                            jack_time_t next_cycle_begin,
+                            jack_time_t period_usecs,
+                            UInt32 reset_count)
+{
+    if (reset_count != fResetCount) {
+        fResetCount = reset_count;
+        Reset();
+    }
+
+    bool late;
+
+    switch (timing->fStatus) {
+
+        case Triggered:
+            fWakeUpUsecs = Elapsed(timing->fSignaledAt, next_cycle_begin);
+            fDSPUsecs = 0;
+            late = true;
+            break;
+
+        case Running:
+            fWakeUpUsecs = Elapsed(timing->fSignaledAt, timing->fAwakeAt);
+            fDSPUsecs = Elapsed(timing->fAwakeAt, next_cycle_begin);
+            late = true;
+            break;
+
+        case Finished:
+            fWakeUpUsecs = Elapsed(timing->fSignaledAt, timing->fAwakeAt);
+            fDSPUsecs = Elapsed(timing->fAwakeAt, timing->fFinishedAt);
+            late = (timing->fFinishedAt > cycle_begin + period_usecs);
+            break;
+
+        default:
+            // Not part of the cycle
+            return;
+    }
+
+    if (late) {
+        fLateCycles++;
+    }
+    if (fDSPUsecs > fMaxDSPUsecs) {
+        fMaxDSPUsecs = fDSPUsecs;
+    }
+    if (fWakeUpUsecs > fMaxWakeUpUsecs) {
+        fMaxWakeUpUsecs = fWakeUpUsecs;
+    }
+    fHistogram[GetBucket(fDSPUsecs)]++;
+
+    fRollingDSPUsecs += fDSPUsecs;
+    fRollingWakeUpUsecs += fWakeUpUsecs;
+
+    // Each time we have a full set of iterations, publish the averages
+    if (++fRollingCount == JACK_ENGINE_ROLLING_COUNT) {
+        fAverageDSPUsecs = fRollingDSPUsecs / JACK_ENGINE_ROLLING_COUNT;
+        fAverageWakeUpUsecs = fRollingWakeUpUsecs / JACK_ENGINE_ROLLING_COUNT;
+        fCPULoad = (period_usecs > 0) ? float(fAverageDSPUsecs) * 100.f / float(period_usecs) : 0.f;
+        fRollingDSPUsecs = 0;
+        fRollingWakeUpUsecs = 0;
+        fRollingCount = 0;
+    }
+}
+
+/*
+    Upper bound of the bucket holding the wanted percentile. Read while the server updates the histogram,
+    the result may be off by one cycle.
+*/
+
+jack_time_t JackClientLoad::GetDSPPercentile(float percentile) const
+{
+    UInt32 histogram[CLIENT_LOAD_BUCKETS];
+    UInt32 total = 0;
+
+    for (int i = 0; i < CLIENT_LOAD_BUCKETS; i++) {
+        histogram[i] = fHistogram[i];
+        total += histogram[i];
+    }
+    if (total == 0) {
+        return 0;
+    }
+
+    percentile = (percentile < 0.f) ? 0.f : ((percentile > 100.f) ? 100.f : percentile);
+    UInt32 wanted = UInt32(ceil(double(total) * percentile / 100.));
+    if (wanted == 0) {
+        wanted = 1;
+    }
+
+    UInt32 count = 0;
+    for (int i = 0; i < CLIENT_LOAD_BUCKETS; i++) {
+        count += histogram[i];
+        if (count >= wanted) {
+            return GetBucketMax(i);
+        }
+    }
+    return GetBucketMax(CLIENT_LOAD_BUCKETS - 1);
+}
+
+} // end of namespace
@@ -0,0 +1,95 @@
+/*
+Copyright (C) 2026 agent
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 2.1 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*/
+
+#ifndef __JackClientLoad__
+#define __JackClientLoad__
+
+#include "JackConstants.h"
+#include "JackTypes.h"
+#include "JackCompilerDeps.h"
+#include "types.h"
+
+namespace Jack
+{
+
+#define CLIENT_LOAD_BUCKETS 64      // DSP time histogram : 4 buckets per power of two, up to 131 ms
+
+struct JackClientTiming;
+
+/*!
+\brief DSP time and wake-up latency of a client, maintained by the server at each cycle.
+
+The time taken by the client to answer the last synchronous notification is also kept, with its max value.
+
+Averages are computed on the same rolling window as the server CPU load (JACK_ENGINE_ROLLING_COUNT cycles).
+Max values, late cycles and the DSP time histogram (used for percentiles) are kept until the next reset.
+*/
+
+PRE_PACKED_STRUCTURE
+class SERVER_EXPORT JackClientLoad
+{
+
+    private:
+
+        jack_time_t fRollingDSPUsecs;       // Sums over the current rolling window
+        jack_time_t fRollingWakeUpUsecs;
+        UInt32 fRollingCount;
+        UInt32 fResetCount;
+        UInt32 fHistogram[CLIENT_LOAD_BUCKETS];
+
+        void Reset();
+
+    public:
+
+        char fName[JACK_CLIENT_NAME_SIZE + 1];
+        jack_time_t fDSPUsecs;              // Last cycle
+        jack_time_t fWakeUpUsecs;
+        jack_time_t fAverageDSPUsecs;       // Last rolling window
+        jack_time_t fAverageWakeUpUsecs;
+        jack_time_t fMaxDSPUsecs;           // Since the last reset
+        jack_time_t fMaxWakeUpUsecs;
+        UInt32 fLateCycles;
+        float fCPULoad;
+        jack_time_t fNotifyUsecs;           // Last synchronous notification
+        jack_time_t fMaxNotifyUsecs;        // Since the last reset
+
+        JackClientLoad()
+        {
+            Init(NULL);
+        }
+
+        // Server side
+        void Init(const char* name);
+        void Update(const JackClientTiming* timing,
+                    jack_time_t cycle_begin,
+                    jack_time_t next_cycle_begin,
+                    jack_time_t period_usecs,
+                    UInt32 reset_count);
+
+        // Reader side
+        jack_time_t GetDSPPercentile(float percentile) const;
+
+        static int GetBucket(jack_time_t usecs);
+        static jack_time_t GetBucketMax(int bucket);
+
+} POST_PACKED_STRUCTURE;
+
+} // end of namespace
+
+#endif
@@ -34,11 +34,11 @@ JackConnectionManager::JackConnectionManager()
     int i;
     jack_log("JackConnectionManager::InitConnections size = %ld ", sizeof(JackConnectionManager));
 
-    for (i = 0; i < PORT_NUM_MAX; i++) {
-        fConnection[i].Init();
-    }
-
+    fConnection.Init();
+    fConnectionRef.Init();
     fLoopFeedback.Init();
+    fReachableRef.Init(0);
+    fActiveRef.Init();
 
     jack_log("JackConnectionManager::InitClients");
     for (i = 0; i < CLIENT_NUM; i++) {
@@ -53,28 +53,13 @@ JackConnectionManager::~JackConnectionManager()
 // Internal API
 //--------------
 
-bool JackConnectionManager::IsLoopPathAux(int ref1, int ref2) const
+/*!
+\brief Update the reachable refnum sets after the first connection or the last disconnection between 2 refnum.
+*/
+void JackConnectionManager::UpdateReachableRef(int ref1, int ref2, bool connect)
 {
-    jack_log("JackConnectionManager::IsLoopPathAux ref1 = %ld ref2 = %ld", ref1, ref2);
-
-    if (ref1 < GetEngineControl()->fDriverNum || ref2 < GetEngineControl()->fDriverNum) {
-        return false;
-    } else if (ref1 == ref2) {	// Same refnum
-        return true;
-    } else {
-        jack_int_t output[CLIENT_NUM];
-        fConnectionRef.GetOutputTable(ref1, output);
-
-        if (fConnectionRef.IsInsideTable(ref2, output)) { // If ref2 is contained in the outputs of ref1
-            return true;
-        } else {
-            for (int i = 0; i < CLIENT_NUM && output[i] != EMPTY; i++) { // Otherwise recurse for all ref1 outputs
-                if (IsLoopPathAux(output[i], ref2)) {
-                    return true; // Stop when a path is found
-                }
-            }
-            return false;
-        }
+    if ((connect) ? fReachableRef.Connect(ref1, ref2) : fReachableRef.Disconnect(ref1, fOutputRef)) {
+        fDirty.Mark(&fReachableRef, sizeof(fReachableRef));
     }
 }
 
@@ -89,7 +74,7 @@ int JackConnectionManager::Connect(jack_port_id_t port_src, jack_port_id_t port_
 {
     jack_log("JackConnectionManager::Connect port_src = %ld port_dst = %ld", port_src, port_dst);
 
-    if (fConnection[port_src].AddItem(port_dst)) {
+    if (fConnection.AddItem(port_src, port_dst, fDirty)) {
         return 0;
     } else {
         jack_error("Connection table is full !!");
@@ -104,7 +89,7 @@ int JackConnectionManager::Disconnect(jack_port_id_t port_src, jack_port_id_t po
 {
     jack_log("JackConnectionManager::Disconnect port_src = %ld port_dst = %ld", port_src, port_dst);
 
-    if (fConnection[port_src].RemoveItem(port_dst)) {
+    if (fConnection.RemoveItem(port_src, port_dst, fDirty)) {
         return 0;
     } else {
         jack_error("Connection not found !!");
@@ -117,15 +102,15 @@ int JackConnectionManager::Disconnect(jack_port_id_t port_src, jack_port_id_t po
 */
 bool JackConnectionManager::IsConnected(jack_port_id_t port_src, jack_port_id_t port_dst) const
 {
-    return fConnection[port_src].CheckItem(port_dst);
+    return fConnection.CheckItem(port_src, port_dst);
 }
 
 /*!
-\brief Get the connection port array.
+\brief Fill the EMPTY terminated connection port array (of CONNECTION_NUM_FOR_PORT size), returns the number of connections.
 */
-const jack_int_t* JackConnectionManager::GetConnections(jack_port_id_t port_index) const
+int JackConnectionManager::GetConnections(jack_port_id_t port_index, jack_int_t* res) const
 {
-    return fConnection[port_index].GetItems();
+    return fConnection.GetItems(port_index, res);
 }
 
 //------------------------
@@ -138,6 +123,7 @@ const jack_int_t* JackConnectionManager::GetConnections(jack_port_id_t port_inde
 int JackConnectionManager::AddInputPort(int refnum, jack_port_id_t port_index)
 {
     if (fInputPort[refnum].AddItem(port_index)) {
+        fDirty.Mark(&fInputPort[refnum], sizeof(fInputPort[refnum]));
         jack_log("JackConnectionManager::AddInputPort ref = %ld port = %ld", refnum, port_index);
         return 0;
     } else {
@@ -152,6 +138,7 @@ int JackConnectionManager::AddInputPort(int refnum, jack_port_id_t port_index)
 int JackConnectionManager::AddOutputPort(int refnum, jack_port_id_t port_index)
 {
     if (fOutputPort[refnum].AddItem(port_index)) {
+        fDirty.Mark(&fOutputPort[refnum], sizeof(fOutputPort[refnum]));
         jack_log("JackConnectionManager::AddOutputPort ref = %ld port = %ld", refnum, port_index);
         return 0;
     } else {
@@ -168,6 +155,7 @@ int JackConnectionManager::RemoveInputPort(int refnum, jack_port_id_t port_index
     jack_log("JackConnectionManager::RemoveInputPort ref = %ld port_index = %ld ", refnum, port_index);
 
     if (fInputPort[refnum].RemoveItem(port_index)) {
+        fDirty.Mark(&fInputPort[refnum], sizeof(fInputPort[refnum]));
         return 0;
     } else {
         jack_error("Input port index = %ld not found for application ref = %ld", port_index, refnum);
@@ -183,6 +171,7 @@ int JackConnectionManager::RemoveOutputPort(int refnum, jack_port_id_t port_inde
     jack_log("JackConnectionManager::RemoveOutputPort ref = %ld port_index = %ld ", refnum, port_index);
 
     if (fOutputPort[refnum].RemoveItem(port_index)) {
+        fDirty.Mark(&fOutputPort[refnum], sizeof(fOutputPort[refnum]));
         return 0;
     } else {
         jack_error("Output port index = %ld not found for application ref = %ld", port_index, refnum);
@@ -211,10 +200,31 @@ const jack_int_t* JackConnectionManager::GetOutputPorts(int refnum)
 */
 void JackConnectionManager::InitRefNum(int refnum)
 {
+    // Refnum connected to this one have an item in the connection table
+    for (int i = 0; i < CLIENT_NUM; i++) {
+        if (fOutputRef[i].Test(refnum)) {
+            fConnectionRef.ClearItem(i, refnum, fDirty);
+            fOutputRef[i].Reset(refnum);
+            fDirty.Mark(&fOutputRef[i], sizeof(fOutputRef[i]));
+        }
+    }
+    fConnectionRef.ClearItems(refnum, fDirty);
+
     fInputPort[refnum].Init();
     fOutputPort[refnum].Init();
-    fConnectionRef.Init(refnum);
     fInputCounter[refnum].SetValue(0);
+    fInputCounter[refnum].Reset();
+
+    // Remove refnum from the execution plan
+    fOutputRef[refnum].Init();
+    fActiveRef.Reset(refnum);
+    UpdateReachableRef(refnum, refnum, false);
+
+    fDirty.Mark(&fInputPort[refnum], sizeof(fInputPort[refnum]));
+    fDirty.Mark(&fOutputPort[refnum], sizeof(fOutputPort[refnum]));
+    fDirty.Mark(&fInputCounter[refnum], sizeof(fInputCounter[refnum]));
+    fDirty.Mark(&fOutputRef[refnum], sizeof(fOutputRef[refnum]));
+    fDirty.Mark(&fActiveRef, sizeof(fActiveRef));
 }
 
 /*!
@@ -223,9 +233,12 @@ void JackConnectionManager::InitRefNum(int refnum)
 void JackConnectionManager::ResetGraph(JackClientTiming* timing)
 {
     // Reset activation counter : must be done *before* starting to resume clients
-    for (int i = 0; i < CLIENT_NUM; i++) {
-        fInputCounter[i].Reset();
-        timing[i].fStatus = NotTriggered;
+    // Refnum without input client are never signaled : their counter stays at 0
+    JackFixedBitSet<CLIENT_NUM>::Iterator it(fActiveRef);
+    for (int ref = it.Next(); ref >= 0; ref = it.Next()) {
+        fInputCounter[ref].Reset();
+        timing[ref].fStatus = NotTriggered;
+        timing[ref].fMixdownTime = 0;
     }
 }
 
@@ -243,53 +256,54 @@ int JackConnectionManager::SuspendRefNum(JackClientControl* control, JackSynchro
 }
 
 /*!
-\brief Signal clients connected to the given client.
+\brief Signal clients connected to the given client, clients handled by the dispatcher are activated without their synchro.
 */
-int JackConnectionManager::ResumeRefNum(JackClientControl* control, JackSynchro* table, JackClientTiming* timing)
+int JackConnectionManager::ResumeRefNum(JackClientControl* control, JackSynchro* table, JackClientTiming* timing, JackActivationDispatcher* dispatcher)
 {
     jack_time_t current_date = GetMicroSeconds();
-    const jack_int_t* output_ref = fConnectionRef.GetItems(control->fRefNum);
+    const JackFixedBitSet<CLIENT_NUM>& output_ref = fOutputRef[control->fRefNum];
     int res = 0;
 
     // Update state and timestamp of current client
     timing[control->fRefNum].fStatus = Finished;
     timing[control->fRefNum].fFinishedAt = current_date;
 
-    for (int i = 0; i < CLIENT_NUM; i++) {
-
-        // Signal connected clients or drivers
-        if (output_ref[i] > 0) {
+    // Signal connected clients or drivers
+    JackFixedBitSet<CLIENT_NUM>::Iterator it(output_ref);
+    for (int ref = it.Next(); ref >= 0; ref = it.Next()) {
 
-            // Update state and timestamp of destination clients
-            timing[i].fStatus = Triggered;
-            timing[i].fSignaledAt = current_date;
+        // Update state and timestamp of destination clients
+        timing[ref].fStatus = Triggered;
+        timing[ref].fSignaledAt = current_date;
 
-            if (!fInputCounter[i].Signal(table + i, control)) {
-                jack_log("JackConnectionManager::ResumeRefNum error: ref = %ld output = %ld ", control->fRefNum, i);
-                res = -1;
+        if (dispatcher && dispatcher->IsDispatched(ref)) {
+            if (fInputCounter[ref].Signal(control)) {
+                dispatcher->Activate(ref);
             }
+        } else if (!fInputCounter[ref].Signal(table + ref, control)) {
+            jack_log("JackConnectionManager::ResumeRefNum error: ref = %ld output = %ld ", control->fRefNum, ref);
+            res = -1;
         }
     }
 
     return res;
 }
 
-static bool HasNoConnection(jack_int_t* table)
-{
-    for (int ref = 0; ref < CLIENT_NUM; ref++) {
-        if (table[ref] > 0) return false;
-    }
-    return true;
-}
-
 // Using http://en.wikipedia.org/wiki/Topological_sorting
 
 void JackConnectionManager::TopologicalSort(std::vector<jack_int_t>& sorted)
 {
-    JackFixedMatrix<CLIENT_NUM> tmp;
+    int inputs[CLIENT_NUM];
+    JackFixedBitSet<CLIENT_NUM> removed;
     std::set<jack_int_t> level;
 
-    fConnectionRef.Copy(tmp);
+    // Number of connected input refnum per refnum
+    memset(inputs, 0, sizeof(inputs));
+    for (int ref = 0; ref < CLIENT_NUM; ref++) {
+        for (int dst = fOutputRef[ref].Next(0); dst >= 0; dst = fOutputRef[ref].Next(dst + 1)) {
+            inputs[dst]++;
+        }
+    }
 
     // Inputs of the graph
     level.insert(AUDIO_DRIVER_REFNUM);
@@ -299,32 +313,63 @@ void JackConnectionManager::TopologicalSort(std::vector<jack_int_t>& sorted)
         jack_int_t refnum = *level.begin();
         sorted.push_back(refnum);
         level.erase(level.begin());
-        const jack_int_t* output_ref1 = tmp.GetItems(refnum);
-        for (int dst = 0; dst < CLIENT_NUM; dst++) {
-            if (output_ref1[dst] > 0) {
-                tmp.ClearItem(refnum, dst);
-                jack_int_t output_ref2[CLIENT_NUM];
-                tmp.GetOutputTable1(dst, output_ref2);
-                if (HasNoConnection(output_ref2)) {
-                    level.insert(dst);
-                }
+        // Output connections are removed once, a refnum connected to itself is sorted again
+        if (removed.Test(refnum)) {
+            continue;
+        }
+        removed.Set(refnum);
+        const JackFixedBitSet<CLIENT_NUM>& output_ref = fOutputRef[refnum];
+        for (int dst = output_ref.Next(0); dst >= 0; dst = output_ref.Next(dst + 1)) {
+            if (--inputs[dst] == 0) {
+                level.insert(dst);
             }
         }
     }
 }
 
+/*!
+\brief Copy the state : only the regions modified in src are copied, or the complete state (with the used part of the connection pool only) if they are unknown.
+*/
+void JackConnectionManager::Copy(const JackConnectionManager& src)
+{
+    if (src.fDirty.IsAll()) {
+        fConnection.Copy(src.fConnection);
+        memcpy(fInputPort, src.fInputPort, sizeof(fInputPort));
+        memcpy(fOutputPort, src.fOutputPort, sizeof(fOutputPort));
+        fConnectionRef.Copy(src.fConnectionRef);
+        memcpy(fInputCounter, src.fInputCounter, sizeof(fInputCounter));
+        memcpy(fOutputRef, src.fOutputRef, sizeof(fOutputRef));
+        memcpy(&fActiveRef, &src.fActiveRef, sizeof(fActiveRef));
+        memcpy(&fLoopFeedback, &src.fLoopFeedback, sizeof(fLoopFeedback));
+        memcpy(&fReachableRef, &src.fReachableRef, sizeof(fReachableRef));
+    } else {
+        fDirty.CopyRegions(src.fDirty);
+    }
+
+    // Both states are now identical
+    fDirty.Clear();
+}
+
+/*!
+\brief The state was changed outside of the connection manager methods : it will be completely copied at next switch.
+*/
+void JackConnectionManager::Invalidate()
+{
+    fDirty.SetAll();
+}
+
 /*!
 \brief Increment the number of ports between 2 clients, if the 2 clients become connected, then the Activation counter is updated.
 */
-void JackConnectionManager::IncDirectConnection(jack_port_id_t port_src, jack_port_id_t port_dst)
+int JackConnectionManager::IncDirectConnection(jack_port_id_t port_src, jack_port_id_t port_dst)
 {
     int ref1 = GetOutputRefNum(port_src);
     int ref2 = GetInputRefNum(port_dst);
 
     assert(ref1 >= 0 && ref2 >= 0);
 
-    DirectConnect(ref1, ref2);
     jack_log("JackConnectionManager::IncConnectionRef: ref1 = %ld ref2 = %ld", ref1, ref2);
+    return DirectConnect(ref1, ref2);
 }
 
 /*!
@@ -344,14 +389,28 @@ void JackConnectionManager::DecDirectConnection(jack_port_id_t port_src, jack_po
 /*!
 \brief Directly connect 2 reference numbers.
 */
-void JackConnectionManager::DirectConnect(int ref1, int ref2)
+int JackConnectionManager::DirectConnect(int ref1, int ref2)
 {
     assert(ref1 >= 0 && ref2 >= 0);
 
-    if (fConnectionRef.IncItem(ref1, ref2) == 1) { // First connection between client ref1 and client ref2
+    int count = fConnectionRef.IncItem(ref1, ref2, fDirty);
+    if (count < 0) {
+        jack_error("JackConnectionManager::DirectConnect no more connected refnum pairs : ref1 = %ld ref2 = %ld", ref1, ref2);
+        return -1;
+    } else if (count == 1) { // First connection between client ref1 and client ref2
         jack_log("JackConnectionManager::DirectConnect first: ref1 = %ld ref2 = %ld", ref1, ref2);
         fInputCounter[ref2].IncValue();
+        fDirty.Mark(&fInputCounter[ref2], sizeof(fInputCounter[ref2]));
+        // Update the execution plan
+        fOutputRef[ref1].Set(ref2);
+        fDirty.Mark(&fOutputRef[ref1], sizeof(fOutputRef[ref1]));
+        UpdateReachableRef(ref1, ref2, true);
+        if (fInputCounter[ref2].GetCount() == 1) {
+            fActiveRef.Set(ref2);
+            fDirty.Mark(&fActiveRef, sizeof(fActiveRef));
+        }
     }
+    return 0;
 }
 
 /*!
@@ -361,9 +420,20 @@ void JackConnectionManager::DirectDisconnect(int ref1, int ref2)
 {
     assert(ref1 >= 0 && ref2 >= 0);
 
-    if (fConnectionRef.DecItem(ref1, ref2) == 0) { // Last connection between client ref1 and client ref2
+    if (fConnectionRef.DecItem(ref1, ref2, fDirty) == 0) { // Last connection between client ref1 and client ref2
         jack_log("JackConnectionManager::DirectDisconnect last: ref1 = %ld ref2 = %ld", ref1, ref2);
         fInputCounter[ref2].DecValue();
+        fDirty.Mark(&fInputCounter[ref2], sizeof(fInputCounter[ref2]));
+        // Update the execution plan
+        fOutputRef[ref1].Reset(ref2);
+        fDirty.Mark(&fOutputRef[ref1], sizeof(fOutputRef[ref1]));
+        UpdateReachableRef(ref1, ref2, false);
+        if (fInputCounter[ref2].GetCount() == 0) {
+            // Not reset by ResetGraph anymore
+            fInputCounter[ref2].Reset();
+            fActiveRef.Reset(ref2);
+            fDirty.Mark(&fActiveRef, sizeof(fActiveRef));
+        }
     }
 }
 
@@ -407,9 +477,62 @@ int JackConnectionManager::GetOutputRefNum(jack_port_id_t port_index) const
 /*!
 \brief Test is a connection path exists between port_src and port_dst.
 */
-bool JackConnectionManager::IsLoopPath(jack_port_id_t port_src, jack_port_id_t port_dst) const
+bool JackConnectionManager::IsLoopPath(jack_port_id_t port_src, jack_port_id_t port_dst)
+{
+    return IsLoopRefPath(GetInputRefNum(port_dst), GetOutputRefNum(port_src), GetEngineControl()->fDriverNum);
+}
+
+/*!
+\brief Refnum whose latencies have to be computed again when the ports of the changed refnum have new latencies or connections :
+capture latencies go downstream (refnum reached from a changed one), playback latencies go upstream (refnum reaching a changed one).
+Drivers are always included. Returns false if the reachable sets are not computed for the current drivers.
+*/
+bool JackConnectionManager::GetLatencyRefs(const JackFixedBitSet<CLIENT_NUM>& changed, int driver_num,
+                                           JackFixedBitSet<CLIENT_NUM>& capture, JackFixedBitSet<CLIENT_NUM>& playback) const
+{
+    if (fReachableRef.GetFirst() != driver_num) {
+        return false;
+    }
+
+    capture.Init();
+    playback.Init();
+    for (int ref = 0; ref < driver_num; ref++) {
+        capture.Set(ref);
+        playback.Set(ref);
+    }
+
+    for (int ref = changed.Next(0); ref >= 0; ref = changed.Next(ref + 1)) {
+        capture.Set(ref);
+        playback.Set(ref);
+        if (ref >= driver_num) {
+            capture.Union(fReachableRef.GetReachable(ref));
+            for (int i = driver_num; i < CLIENT_NUM; i++) {
+                if (fReachableRef.Test(i, ref)) {
+                    playback.Set(i);
+                }
+            }
+        }
+    }
+    return true;
+}
+
+/*!
+\brief Test if ref2 is reached from ref1 through clients : a ref2 to ref1 connection would then create a loop.
+*/
+bool JackConnectionManager::IsLoopRefPath(int ref1, int ref2, int driver_num)
 {
-    return IsLoopPathAux(GetInputRefNum(port_dst), GetOutputRefNum(port_src));
+    // Paths through drivers are ignored, the sets are computed again when drivers are added or removed
+    if (fReachableRef.GetFirst() != driver_num) {
+        jack_log("JackConnectionManager::IsLoopRefPath driver_num = %ld", driver_num);
+        fReachableRef.Compute(driver_num, fOutputRef);
+        fDirty.Mark(&fReachableRef, sizeof(fReachableRef));
+    }
+
+    if (ref1 < driver_num || ref2 < driver_num) {
+        return false;
+    } else {
+        return (ref1 == ref2 || fReachableRef.Test(ref1, ref2));
+    }
 }
 
 bool JackConnectionManager::IsFeedbackConnection(jack_port_id_t port_src, jack_port_id_t port_dst) const
@@ -430,6 +553,7 @@ bool JackConnectionManager::IncFeedbackConnection(jack_port_id_t port_src, jack_
         DirectConnect(ref2, ref1);
     }
 
+    fDirty.Mark(&fLoopFeedback, sizeof(fLoopFeedback));
     return fLoopFeedback.IncConnection(ref1, ref2); // Add the feedback connection
 }
 
@@ -446,6 +570,7 @@ bool JackConnectionManager::DecFeedbackConnection(jack_port_id_t port_src, jack_
         DirectDisconnect(ref2, ref1);
     }
 
+    fDirty.Mark(&fLoopFeedback, sizeof(fLoopFeedback));
     return fLoopFeedback.DecConnection(ref1, ref2); // Remove the feedback connection
 }
 
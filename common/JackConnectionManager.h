@@ -24,6 +24,8 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 #include "JackActivationCount.h"
 #include "JackError.h"
 #include "JackCompilerDeps.h"
+#include "JackAtomicState.h"
+#include "JackBitSet.h"
 #include <vector>
 #include <assert.h>
 
@@ -43,7 +45,7 @@ class JackFixedArray
 
     private:
 
-        jack_int_t fTable[SIZE];
+        MEM_ALIGN(jack_int_t fTable[SIZE], 2);
         uint32_t fCounter;
 
     public:
@@ -157,98 +159,359 @@ class JackFixedArray1 : public JackFixedArray<SIZE>
 } POST_PACKED_STRUCTURE;
 
 /*!
-\brief Utility class.
+\brief Sparse connection table : one list of connected ports per port, items are taken from a shared pool.
+
+Each port keeps an ordered list of connected ports whose items are allocated from a fixed size pool with a free list.
+The pool is used from its beginning, so that only the first GetUsedItems() items need to be copied when the state is duplicated.
+Modified parts are marked in the JackDirtyRegions table of the containing state.
 */
 
 PRE_PACKED_STRUCTURE
-template <int SIZE>
-class JackFixedMatrix
+template <int PORT_SIZE, int ITEM_SIZE, int ITEM_SIZE_FOR_PORT>
+class JackConnectionPool
 {
+
     private:
 
-        jack_int_t fTable[SIZE][SIZE];
+        PRE_PACKED_STRUCTURE
+        struct List
+        {
+            jack_int_t fHead;       // First item of the port list
+            jack_int_t fTail;       // Last item of the port list
+            jack_int_t fCounter;    // Number of items of the port list
+        } POST_PACKED_STRUCTURE;
+
+        PRE_PACKED_STRUCTURE
+        struct Item
+        {
+            jack_int_t fValue;
+            jack_int_t fNext;
+        } POST_PACKED_STRUCTURE;
+
+        List fList[PORT_SIZE];
+        jack_int_t fFree;           // First item of the free list
+        uint32_t fUsed;             // Items [0, fUsed) have been used at least once
+        Item fItem[ITEM_SIZE];
+
+        void MarkItem(jack_int_t item, JackDirtyRegions& dirty)
+        {
+            dirty.Mark(&fItem[item], sizeof(Item));
+        }
+
+        jack_int_t AllocateItem(JackDirtyRegions& dirty)
+        {
+            jack_int_t item;
+            if (fFree != EMPTY) {
+                item = fFree;
+                fFree = fItem[item].fNext;
+            } else if (fUsed < ITEM_SIZE) {
+                item = jack_int_t(fUsed++);
+            } else {
+                return EMPTY;
+            }
+            dirty.Mark(&fFree, sizeof(fFree) + sizeof(fUsed));
+            return item;
+        }
+
+        void ReleaseItem(jack_int_t item, JackDirtyRegions& dirty)
+        {
+            fItem[item].fValue = EMPTY;
+            fItem[item].fNext = fFree;
+            fFree = item;
+            MarkItem(item, dirty);
+            dirty.Mark(&fFree, sizeof(fFree));
+        }
 
     public:
 
-        JackFixedMatrix()
-        {}
+        JackConnectionPool()
+        {
+            Init();
+        }
 
-        void Init(jack_int_t index)
+        void Init()
         {
-            for (int i = 0; i < SIZE; i++) {
-                fTable[index][i] = 0;
-                fTable[i][index] = 0;
+            for (int i = 0; i < PORT_SIZE; i++) {
+                fList[i].fHead = EMPTY;
+                fList[i].fTail = EMPTY;
+                fList[i].fCounter = 0;
+            }
+            fFree = EMPTY;
+            fUsed = 0;
+        }
+
+        bool AddItem(jack_int_t port, jack_int_t index, JackDirtyRegions& dirty)
+        {
+            List& list = fList[port];
+
+            if (list.fCounter >= ITEM_SIZE_FOR_PORT) {
+                return false;
+            }
+
+            jack_int_t item = AllocateItem(dirty);
+            if (item == EMPTY) {
+                return false;
+            }
+
+            fItem[item].fValue = index;
+            fItem[item].fNext = EMPTY;
+            MarkItem(item, dirty);
+            if (list.fTail == EMPTY) {
+                list.fHead = item;
+            } else {
+                fItem[list.fTail].fNext = item;
+                MarkItem(list.fTail, dirty);
+            }
+            list.fTail = item;
+            list.fCounter++;
+            dirty.Mark(&list, sizeof(List));
+            return true;
+        }
+
+        bool RemoveItem(jack_int_t port, jack_int_t index, JackDirtyRegions& dirty)
+        {
+            List& list = fList[port];
+            jack_int_t prev = EMPTY;
+
+            for (jack_int_t item = list.fHead; item != EMPTY; prev = item, item = fItem[item].fNext) {
+                if (fItem[item].fValue == index) {
+                    if (prev == EMPTY) {
+                        list.fHead = fItem[item].fNext;
+                    } else {
+                        fItem[prev].fNext = fItem[item].fNext;
+                        MarkItem(prev, dirty);
+                    }
+                    if (list.fTail == item) {
+                        list.fTail = prev;
+                    }
+                    list.fCounter--;
+                    dirty.Mark(&list, sizeof(List));
+                    ReleaseItem(item, dirty);
+                    return true;
+                }
             }
+            return false;
         }
 
-        const jack_int_t* GetItems(jack_int_t index) const
+        jack_int_t GetItem(jack_int_t port, jack_int_t index) const
         {
-            return fTable[index];
+            jack_int_t item = fList[port].fHead;
+            for (int i = 0; i < index && item != EMPTY; i++) {
+                item = fItem[item].fNext;
+            }
+            return (item != EMPTY) ? fItem[item].fValue : EMPTY;
         }
 
-        jack_int_t IncItem(jack_int_t index1, jack_int_t index2)
+        /*!
+        	\brief Fill an EMPTY terminated array (of ITEM_SIZE_FOR_PORT size) with the items of a port.
+        */
+        int GetItems(jack_int_t port, jack_int_t* res) const
         {
-            fTable[index1][index2]++;
-            return fTable[index1][index2];
+            int i = 0;
+            // Bounded walk : a non RT reader may see a state being rewritten, it will read again in this case
+            for (jack_int_t item = fList[port].fHead; item != EMPTY && i < ITEM_SIZE_FOR_PORT; item = fItem[item].fNext) {
+                res[i++] = fItem[item].fValue;
+            }
+            if (i < ITEM_SIZE_FOR_PORT) {
+                res[i] = EMPTY;
+            }
+            return i;
         }
 
-        jack_int_t DecItem(jack_int_t index1, jack_int_t index2)
+        bool CheckItem(jack_int_t port, jack_int_t index) const
         {
-            fTable[index1][index2]--;
-            return fTable[index1][index2];
+            int i = 0;
+            for (jack_int_t item = fList[port].fHead; item != EMPTY && i < ITEM_SIZE_FOR_PORT; item = fItem[item].fNext, i++) {
+                if (fItem[item].fValue == index)
+                    return true;
+            }
+            return false;
         }
 
-        jack_int_t GetItemCount(jack_int_t index1, jack_int_t index2) const
+        uint32_t GetItemCount(jack_int_t port) const
         {
-            return fTable[index1][index2];
+            return fList[port].fCounter;
         }
 
-        void ClearItem(jack_int_t index1, jack_int_t index2)
+        uint32_t GetUsedItems() const
         {
-            fTable[index1][index2] = 0;
+            return fUsed;
         }
 
         /*!
-        	\brief Get the output indexes of a given index.
+        	\brief Copy the pool, only the used part of the item table is copied.
         */
-        void GetOutputTable(jack_int_t index, jack_int_t* output) const
+        void Copy(const JackConnectionPool& src)
+        {
+            memcpy(fList, src.fList, sizeof(fList));
+            fFree = src.fFree;
+            fUsed = src.fUsed;
+            memcpy(fItem, src.fItem, sizeof(Item) * src.fUsed);
+        }
+
+} POST_PACKED_STRUCTURE;
+
+/*!
+\brief Sparse table of the number of connections between 2 refnum : one list of connected refnum per refnum, items are taken from a shared pool.
+
+Only connected refnum pairs use an item, so the size grows with the connected pairs instead of the square of the refnum number.
+The pool is used from its beginning, so that only the first used items need to be copied when the state is duplicated.
+Modified parts are marked in the JackDirtyRegions table of the containing state.
+*/
+
+PRE_PACKED_STRUCTURE
+template <int SIZE, int ITEM_SIZE>
+class JackConnectionRefTable
+{
+
+    private:
+
+        PRE_PACKED_STRUCTURE
+        struct Item
         {
-            int i, j;
+            jack_int_t fRef;        // Connected refnum
+            jack_int_t fCount;      // Number of connections to this refnum
+            jack_int_t fNext;
+        } POST_PACKED_STRUCTURE;
 
-            for (i = 0; i < SIZE; i++)
-                output[i] = EMPTY;
+        jack_int_t fHead[SIZE];     // First item of the refnum list
+        jack_int_t fFree;           // First item of the free list
+        uint32_t fUsed;             // Items [0, fUsed) have been used at least once
+        Item fItem[ITEM_SIZE];
 
-            for (i = 0, j = 0; i < SIZE; i++) {
-                if (fTable[index][i] > 0) {
-                    output[j] = i;
-                    j++;
+        jack_int_t FindItem(jack_int_t ref1, jack_int_t ref2) const
+        {
+            jack_int_t item = fHead[ref1];
+            while (item != EMPTY && fItem[item].fRef != ref2) {
+                item = fItem[item].fNext;
+            }
+            return item;
+        }
+
+        void RemoveItem(jack_int_t ref1, jack_int_t item, JackDirtyRegions& dirty)
+        {
+            if (fHead[ref1] == item) {
+                fHead[ref1] = fItem[item].fNext;
+                dirty.Mark(&fHead[ref1], sizeof(jack_int_t));
+            } else {
+                jack_int_t prev = fHead[ref1];
+                while (fItem[prev].fNext != item) {
+                    prev = fItem[prev].fNext;
                 }
+                fItem[prev].fNext = fItem[item].fNext;
+                dirty.Mark(&fItem[prev], sizeof(Item));
             }
+            fItem[item].fRef = EMPTY;
+            fItem[item].fCount = 0;
+            fItem[item].fNext = fFree;
+            fFree = item;
+            dirty.Mark(&fItem[item], sizeof(Item));
+            dirty.Mark(&fFree, sizeof(fFree));
+        }
+
+    public:
+
+        JackConnectionRefTable()
+        {
+            Init();
         }
 
-        void GetOutputTable1(jack_int_t index, jack_int_t* output) const
+        void Init()
         {
             for (int i = 0; i < SIZE; i++) {
-                output[i] = fTable[i][index];
+                fHead[i] = EMPTY;
             }
+            fFree = EMPTY;
+            fUsed = 0;
         }
 
-        bool IsInsideTable(jack_int_t index, jack_int_t* output) const
+        /*!
+        	\brief Increment the number of connections between 2 refnum, returns the new number or -1 if the pool is full.
+        */
+        int IncItem(jack_int_t ref1, jack_int_t ref2, JackDirtyRegions& dirty)
+        {
+            jack_int_t item = FindItem(ref1, ref2);
+            if (item == EMPTY) {
+                if (fFree != EMPTY) {
+                    item = fFree;
+                    fFree = fItem[item].fNext;
+                } else if (fUsed < ITEM_SIZE) {
+                    item = jack_int_t(fUsed++);
+                } else {
+                    return -1;
+                }
+                dirty.Mark(&fFree, sizeof(fFree) + sizeof(fUsed));
+                fItem[item].fRef = ref2;
+                fItem[item].fCount = 0;
+                fItem[item].fNext = fHead[ref1];
+                fHead[ref1] = item;
+                dirty.Mark(&fHead[ref1], sizeof(jack_int_t));
+            }
+            fItem[item].fCount++;
+            dirty.Mark(&fItem[item], sizeof(Item));
+            return fItem[item].fCount;
+        }
+
+        /*!
+        	\brief Decrement the number of connections between 2 refnum, returns the new number : the item is released at 0.
+        */
+        int DecItem(jack_int_t ref1, jack_int_t ref2, JackDirtyRegions& dirty)
         {
-            for (int i = 0; i < SIZE && output[i] != EMPTY; i++) {
-                if (output[i] == index)
-                    return true;
+            jack_int_t item = FindItem(ref1, ref2);
+            if (item == EMPTY) {
+                return -1;
             }
-            return false;
+            int count = --fItem[item].fCount;
+            if (count == 0) {
+                RemoveItem(ref1, item, dirty);
+            } else {
+                dirty.Mark(&fItem[item], sizeof(Item));
+            }
+            return count;
         }
 
-        void Copy(JackFixedMatrix& copy)
+        /*!
+        	\brief Remove the connections between 2 refnum.
+        */
+        void ClearItem(jack_int_t ref1, jack_int_t ref2, JackDirtyRegions& dirty)
         {
-            for (int i = 0; i < SIZE; i++) {
-                memcpy(copy.fTable[i], fTable[i], sizeof(jack_int_t) * SIZE);
+            jack_int_t item = FindItem(ref1, ref2);
+            if (item != EMPTY) {
+                RemoveItem(ref1, item, dirty);
             }
         }
 
+        /*!
+        	\brief Remove the connections of a refnum to other refnum.
+        */
+        void ClearItems(jack_int_t ref1, JackDirtyRegions& dirty)
+        {
+            while (fHead[ref1] != EMPTY) {
+                RemoveItem(ref1, fHead[ref1], dirty);
+            }
+        }
+
+        jack_int_t GetItemCount(jack_int_t ref1, jack_int_t ref2) const
+        {
+            jack_int_t item = FindItem(ref1, ref2);
+            return (item != EMPTY) ? fItem[item].fCount : 0;
+        }
+
+        uint32_t GetUsedItems() const
+        {
+            return fUsed;
+        }
+
+        /*!
+        	\brief Copy the table, only the used part of the item table is copied.
+        */
+        void Copy(const JackConnectionRefTable& src)
+        {
+            memcpy(fHead, src.fHead, sizeof(fHead));
+            fFree = src.fFree;
+            fUsed = src.fUsed;
+            memcpy(fItem, src.fItem, sizeof(Item) * src.fUsed);
+        }
 
 } POST_PACKED_STRUCTURE;
 
@@ -366,6 +629,128 @@ class JackLoopFeedback
 
 } POST_PACKED_STRUCTURE;
 
+/*!
+\brief Transitive closure of the direct connections between refnum.
+
+For each refnum, the set of refnum reachable from it through direct connections, paths going through a refnum below
+the first indexed one (the drivers) being ignored. An added connection is merged in the sets of the refnum reaching its
+source, a removed one makes the sets of the refnum reaching its source to be computed again from the outputs.
+*/
+
+PRE_PACKED_STRUCTURE
+template <int SIZE>
+class JackFixedClosure
+{
+    private:
+
+        MEM_ALIGN(JackFixedBitSet<SIZE> fReachable[SIZE], 4);
+        int fFirst;     // First indexed refnum
+
+        void ComputeAux(int ref, JackFixedBitSet<SIZE>& todo, const JackFixedBitSet<SIZE>* outputs)
+        {
+            todo.Reset(ref);
+            for (int i = outputs[ref].Next(fFirst); i >= 0; i = outputs[ref].Next(i + 1)) {
+                if (i != ref) {
+                    if (todo.Test(i)) {
+                        ComputeAux(i, todo, outputs);
+                    }
+                    fReachable[ref].Set(i);
+                    fReachable[ref].Union(fReachable[i]);
+                }
+            }
+        }
+
+    public:
+
+        JackFixedClosure()
+        {
+            Init(0);
+        }
+
+        void Init(int first)
+        {
+            for (int i = 0; i < SIZE; i++) {
+                fReachable[i].Init();
+            }
+            fFirst = first;
+        }
+
+        int GetFirst() const
+        {
+            return fFirst;
+        }
+
+        /*!
+        	\brief Test if ref2 can be reached from ref1.
+        */
+        bool Test(int ref1, int ref2) const
+        {
+            return fReachable[ref1].Test(ref2);
+        }
+
+        const JackFixedBitSet<SIZE>& GetReachable(int ref) const
+        {
+            return fReachable[ref];
+        }
+
+        /*!
+        	\brief Merge a new ref1 to ref2 connection, returns false if the closure is unchanged.
+        */
+        bool Connect(int ref1, int ref2)
+        {
+            if (ref1 < fFirst || ref2 < fFirst || ref1 == ref2 || fReachable[ref1].Test(ref2)) {
+                return false;
+            }
+
+            JackFixedBitSet<SIZE> added = fReachable[ref2];
+            added.Set(ref2);
+            for (int i = fFirst; i < SIZE; i++) {
+                if (i == ref1 || fReachable[i].Test(ref1)) {
+                    fReachable[i].Union(added);
+                }
+            }
+            return true;
+        }
+
+        /*!
+        	\brief Outputs of ref have been removed : compute the sets reaching it again, returns false if the closure is unchanged.
+        */
+        bool Disconnect(int ref, const JackFixedBitSet<SIZE>* outputs)
+        {
+            if (ref < fFirst) {
+                return false;
+            }
+
+            JackFixedBitSet<SIZE> todo;
+            for (int i = fFirst; i < SIZE; i++) {
+                if (i == ref || fReachable[i].Test(ref)) {
+                    todo.Set(i);
+                    fReachable[i].Init();
+                }
+            }
+            for (int i = todo.Next(0); i >= 0; i = todo.Next(i + 1)) {
+                ComputeAux(i, todo, outputs);
+            }
+            return true;
+        }
+
+        /*!
+        	\brief Compute all sets from the outputs, with a new first indexed refnum.
+        */
+        void Compute(int first, const JackFixedBitSet<SIZE>* outputs)
+        {
+            Init(first);
+            JackFixedBitSet<SIZE> todo;
+            for (int i = fFirst; i < SIZE; i++) {
+                todo.Set(i);
+            }
+            for (int i = todo.Next(0); i >= 0; i = todo.Next(i + 1)) {
+                ComputeAux(i, todo, outputs);
+            }
+        }
+
+} POST_PACKED_STRUCTURE;
+
 /*!
 \brief For client timing measurements.
 */
@@ -376,6 +761,7 @@ struct JackClientTiming
     jack_time_t fSignaledAt;
     jack_time_t fAwakeAt;
     jack_time_t fFinishedAt;
+    jack_time_t fMixdownTime;   // Time spent mixing the inputs at the start of the client cycle
     jack_client_state_t fStatus;
 
     JackClientTiming()
@@ -390,20 +776,53 @@ struct JackClientTiming
         fSignaledAt = 0;
         fAwakeAt = 0;
         fFinishedAt = 0;
+        fMixdownTime = 0;
         fStatus = NotTriggered;
     }
 
 } POST_PACKED_STRUCTURE;
 
+/*!
+\brief Process local activation of clients.
+
+In the server process, the refnum of the set are given to Activate by ResumeRefNum instead of having their synchro signaled.
+*/
+
+class SERVER_EXPORT JackActivationDispatcher
+{
+
+    protected:
+
+        JackFixedBitSet<CLIENT_NUM> fDispatchedRef;
+
+    public:
+
+        JackActivationDispatcher()
+        {}
+        virtual ~JackActivationDispatcher()
+        {}
+
+        bool IsDispatched(int refnum) const
+        {
+            return fDispatchedRef.Test(refnum);
+        }
+
+        virtual void Activate(int refnum) = 0;   /*! Called in RT by the thread that decremented the activation counter to zero */
+};
+
 /*!
 \brief Connection manager.
 
 <UL>
-<LI>The <B>fConnection</B> array contains the list (array line) of connected ports for a given port.
+<LI>The <B>fConnection</B> pool contains the list of connected ports for a given port.
 <LI>The <B>fInputPort</B> array contains the list (array line) of input connected  ports for a given client.
 <LI>The <B>fOutputPort</B> array contains the list (array line) of ouput connected  ports for a given client.
-<LI>The <B>fConnectionRef</B> array contains the number of ports connected between two clients.
+<LI>The <B>fConnectionRef</B> table contains the number of ports connected between two clients, for the connected pairs only.
 <LI>The <B>fInputCounter</B> array contains the number of input clients connected to a given for activation purpose.
+<LI>The <B>fOutputRef</B> array contains the set of refnum directly connected to a given refnum : the execution plan used by ResumeRefNum.
+<LI>The <B>fReachableRef</B> closure contains the set of refnum reachable from a given refnum : used to detect loops.
+<LI>The <B>fActiveRef</B> set contains the refnum having at least one input client : the activation counters reset by ResetGraph.
+<LI>The <B>fDirty</B> table contains the regions modified since the state was copied from the other state.
 </UL>
 */
 
@@ -413,14 +832,18 @@ class SERVER_EXPORT JackConnectionManager
 
     private:
 
-        JackFixedArray<CONNECTION_NUM_FOR_PORT> fConnection[PORT_NUM_MAX];  /*! Connection matrix: list of connected ports for a given port: needed to compute Mix buffer */
+        JackActivationCount fInputCounter[CLIENT_NUM];					/*! Activation counter per refnum : first to keep the atomic counters aligned */
+        JackConnectionPool<PORT_NUM_MAX, CONNECTION_NUM, CONNECTION_NUM_FOR_PORT> fConnection;  /*! Connection lists: list of connected ports for a given port: needed to compute Mix buffer */
         JackFixedArray1<PORT_NUM_FOR_CLIENT> fInputPort[CLIENT_NUM];	/*! Table of input port per refnum : to find a refnum for a given port */
         JackFixedArray<PORT_NUM_FOR_CLIENT> fOutputPort[CLIENT_NUM];	/*! Table of output port per refnum : to find a refnum for a given port */
-        JackFixedMatrix<CLIENT_NUM> fConnectionRef;						/*! Table of port connections by (refnum , refnum) */
-        JackActivationCount fInputCounter[CLIENT_NUM];					/*! Activation counter per refnum */
+        JackConnectionRefTable<CLIENT_NUM, CONNECTION_REF_NUM> fConnectionRef;  /*! Number of port connections by connected (refnum , refnum) */
+        MEM_ALIGN(JackFixedBitSet<CLIENT_NUM> fOutputRef[CLIENT_NUM], 4);  /*! Set of connected refnum per refnum */
+        MEM_ALIGN(JackFixedBitSet<CLIENT_NUM> fActiveRef, 4);              /*! Set of refnum with a non zero activation count */
         JackLoopFeedback<CONNECTION_NUM_FOR_PORT> fLoopFeedback;		/*! Loop feedback connections */
+        JackFixedClosure<CLIENT_NUM> fReachableRef;                     /*! Set of refnum reachable through clients per refnum */
+        JackDirtyRegions fDirty;                                        /*! Regions modified since the state was copied from the other state */
 
-        bool IsLoopPathAux(int ref1, int ref2) const;
+        void UpdateReachableRef(int ref1, int ref2, bool connect);
 
     public:
 
@@ -437,23 +860,25 @@ class SERVER_EXPORT JackConnectionManager
         */
         jack_int_t Connections(jack_port_id_t port_index) const
         {
-            return fConnection[port_index].GetItemCount();
+            return fConnection.GetItemCount(port_index);
         }
 
         jack_port_id_t GetPort(jack_port_id_t port_index, int connection) const
         {
             assert(connection < CONNECTION_NUM_FOR_PORT);
-            return (jack_port_id_t)fConnection[port_index].GetItem(connection);
+            return (jack_port_id_t)fConnection.GetItem(port_index, connection);
         }
 
-        const jack_int_t* GetConnections(jack_port_id_t port_index) const;
+        int GetConnections(jack_port_id_t port_index, jack_int_t* res) const;
 
         bool IncFeedbackConnection(jack_port_id_t port_src, jack_port_id_t port_dst);
         bool DecFeedbackConnection(jack_port_id_t port_src, jack_port_id_t port_dst);
         bool IsFeedbackConnection(jack_port_id_t port_src, jack_port_id_t port_dst) const;
 
-        bool IsLoopPath(jack_port_id_t port_src, jack_port_id_t port_dst) const;
-        void IncDirectConnection(jack_port_id_t port_src, jack_port_id_t port_dst);
+        bool IsLoopPath(jack_port_id_t port_src, jack_port_id_t port_dst);
+        bool IsLoopRefPath(int ref1, int ref2, int driver_num);
+        bool GetLatencyRefs(const JackFixedBitSet<CLIENT_NUM>& changed, int driver_num, JackFixedBitSet<CLIENT_NUM>& capture, JackFixedBitSet<CLIENT_NUM>& playback) const;
+        int IncDirectConnection(jack_port_id_t port_src, jack_port_id_t port_dst);
         void DecDirectConnection(jack_port_id_t port_src, jack_port_id_t port_dst);
 
         // Ports management
@@ -473,7 +898,7 @@ class SERVER_EXPORT JackConnectionManager
 
         // Connect/Disconnect 2 refnum "directly"
         bool IsDirectConnection(int ref1, int ref2) const;
-        void DirectConnect(int ref1, int ref2);
+        int DirectConnect(int ref1, int ref2);
         void DirectDisconnect(int ref1, int ref2);
 
         int GetActivation(int refnum) const
@@ -481,14 +906,32 @@ class SERVER_EXPORT JackConnectionManager
             return fInputCounter[refnum].GetValue();
         }
 
+        const JackFixedBitSet<CLIENT_NUM>& GetOutputRefs(int refnum) const
+        {
+            return fOutputRef[refnum];
+        }
+
         // Graph
         void ResetGraph(JackClientTiming* timing);
-        int ResumeRefNum(JackClientControl* control, JackSynchro* table, JackClientTiming* timing);
+        int ResumeRefNum(JackClientControl* control, JackSynchro* table, JackClientTiming* timing, JackActivationDispatcher* dispatcher = NULL);
         int SuspendRefNum(JackClientControl* control, JackSynchro* table, JackClientTiming* timing, long time_out_usec);
         void TopologicalSort(std::vector<jack_int_t>& sorted);
 
+        void Copy(const JackConnectionManager& src);
+        void Invalidate();
+
 } POST_PACKED_STRUCTURE;
 
+/*!
+\brief Only the regions modified in the source state (or the used part of the connection pool) are copied when switching states.
+*/
+
+template <>
+inline void JackCopyState<JackConnectionManager>(JackConnectionManager* dst, const JackConnectionManager* src)
+{
+    dst->Copy(*src);
+}
+
 } // end of namespace
 
 #endif
@@ -59,23 +59,34 @@
 
 #define CONNECTION_NUM_FOR_PORT PORT_NUM_FOR_CLIENT
 
+#ifndef CONNECTION_NUM
+#define CONNECTION_NUM 32768        // Size of the connection pool shared by all ports (each connection uses 2 items)
+#endif
+
 #ifndef CLIENT_NUM
-#define CLIENT_NUM 64
+#define CLIENT_NUM 256
+#endif
+
+#ifndef CONNECTION_REF_NUM
+#define CONNECTION_REF_NUM (CLIENT_NUM * 32)   // Size of the pool of connected refnum pairs : 32 connected clients per client in average
 #endif
 
 #define AUDIO_DRIVER_REFNUM   0                 // Audio driver is initialized first, it will get the refnum 0
 #define FREEWHEEL_DRIVER_REFNUM   1             // Freewheel driver is initialized second, it will get the refnum 1
+#define DRIVER_REFNUM_NUM   2                   // Refnums always taken by the audio and freewheel drivers
 
 #define JACK_DEFAULT_SERVER_NAME "default"
 
 #define ALL_CLIENTS -1 // for notification
 
-#define JACK_PROTOCOL_VERSION 8
+#define JACK_PROTOCOL_VERSION 9
 
 #define SOCKET_TIME_OUT 2               // in sec
+#define NOTIFY_TIME_OUT 2000000         // in usec, for all clients to answer a synchronous notification
 #define DRIVER_OPEN_TIMEOUT 5           // in sec
 #define FREEWHEEL_DRIVER_TIMEOUT 10     // in sec
 #define DRIVER_TIMEOUT_FACTOR    10
+#define SYNCHRO_SPIN       20           // in usec, time spent by a futex synchro waiter spinning before sleeping in the kernel
 
 #define JACK_SERVER_FAILURE "JACK server has been closed"
 
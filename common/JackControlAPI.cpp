@@ -44,6 +44,7 @@
 #include "JackConstants.h"
 #include "JackDriverLoader.h"
 #include "JackServerGlobals.h"
+#include "JackStartupTime.h"
 
 using namespace Jack;
 
@@ -94,10 +95,30 @@ struct jackctl_server
     union jackctl_parameter_value clock_source;
     union jackctl_parameter_value default_clock_source;
 
+    /* uint32_t, client activation synchro type */
+    union jackctl_parameter_value synchro;
+    union jackctl_parameter_value default_synchro;
+
     /* uint32_t, max port number */
     union jackctl_parameter_value port_max;
     union jackctl_parameter_value default_port_max;
 
+    /* uint32_t, max client number */
+    union jackctl_parameter_value client_max;
+    union jackctl_parameter_value default_client_max;
+
+    /* uint32_t, number of graph executor threads */
+    union jackctl_parameter_value graph_workers;
+    union jackctl_parameter_value default_graph_workers;
+
+    /* uint32_t, usecs an idle graph worker looks for clients before sleeping */
+    union jackctl_parameter_value graph_worker_spin;
+    union jackctl_parameter_value default_graph_worker_spin;
+
+    /* bool, mix the input ports of a client when it is activated */
+    union jackctl_parameter_value activation_mixdown;
+    union jackctl_parameter_value default_activation_mixdown;
+
     /* bool */
     union jackctl_parameter_value replace_registry;
     union jackctl_parameter_value default_replace_registry;
@@ -743,6 +764,8 @@ SERVER_EXPORT jackctl_server_t * jackctl_server_create(
     struct jackctl_server * server_ptr;
     union jackctl_parameter_value value;
 
+    JackStartupTime::Start();
+
     server_ptr = (struct jackctl_server *)malloc(sizeof(struct jackctl_server));
     if (server_ptr == NULL)
     {
@@ -854,6 +877,20 @@ SERVER_EXPORT jackctl_server_t * jackctl_server_create(
         goto fail_free_parameters;
     }
 
+    value.ui = JACK_SYNCHRO_SEMAPHORE;
+    if (jackctl_add_parameter(
+            &server_ptr->parameters,
+            "synchro",
+            "Client activation synchro type : s(emaphore) | f(utex).",
+            "",
+            JackParamUInt,
+            &server_ptr->synchro,
+            &server_ptr->default_synchro,
+            value) == NULL)
+    {
+        goto fail_free_parameters;
+    }
+
     value.ui = PORT_NUM;
     if (jackctl_add_parameter(
           &server_ptr->parameters,
@@ -868,6 +905,62 @@ SERVER_EXPORT jackctl_server_t * jackctl_server_create(
         goto fail_free_parameters;
     }
 
+    value.ui = CLIENT_NUM;
+    if (jackctl_add_parameter(
+          &server_ptr->parameters,
+          "client-max",
+          "Maximum number of clients.",
+          "",
+          JackParamUInt,
+          &server_ptr->client_max,
+          &server_ptr->default_client_max,
+          value) == NULL)
+    {
+        goto fail_free_parameters;
+    }
+
+    value.ui = 0;
+    if (jackctl_add_parameter(
+          &server_ptr->parameters,
+          "graph-workers",
+          "Number of threads running internal clients (0 : each internal client runs in its own thread).",
+          "",
+          JackParamUInt,
+          &server_ptr->graph_workers,
+          &server_ptr->default_graph_workers,
+          value) == NULL)
+    {
+        goto fail_free_parameters;
+    }
+
+    value.ui = 0;
+    if (jackctl_add_parameter(
+          &server_ptr->parameters,
+          "graph-worker-spin",
+          "Time in usecs an idle graph worker looks for clients before sleeping (0 : sleeps at once).",
+          "",
+          JackParamUInt,
+          &server_ptr->graph_worker_spin,
+          &server_ptr->default_graph_worker_spin,
+          value) == NULL)
+    {
+        goto fail_free_parameters;
+    }
+
+    value.b = false;
+    if (jackctl_add_parameter(
+          &server_ptr->parameters,
+          "activation-mixdown",
+          "Mix all the input ports of a client at the start of its cycle, instead of when it first reads each of them.",
+          "",
+          JackParamBool,
+          &server_ptr->activation_mixdown,
+          &server_ptr->default_activation_mixdown,
+          value) == NULL)
+    {
+        goto fail_free_parameters;
+    }
+
     value.b = false;
     if (jackctl_add_parameter(
             &server_ptr->parameters,
@@ -920,9 +1013,11 @@ SERVER_EXPORT jackctl_server_t * jackctl_server_create(
     {
         goto fail_free_parameters;
     }
+    JackStartupTime::Mark("drivers scan");
 
     /* Allowed to fail */
     jackctl_internals_load(server_ptr);
+    JackStartupTime::Mark("internals scan");
 
     return server_ptr;
 
@@ -1005,6 +1100,9 @@ jackctl_server_open(
             return false;
         }
 
+        // Time spent by the application before opening the server (parameters setup...)
+        JackStartupTime::Mark("server open request");
+
         int rc = jack_register_server(server_ptr->name.str, server_ptr->replace_registry.b);
         switch (rc)
         {
@@ -1025,6 +1123,7 @@ jackctl_server_open(
          * instance of this server name */
         jack_cleanup_shm();
         JackTools::CleanupFiles(server_ptr->name.str);
+        JackStartupTime::Mark("server register");
 
         if (!server_ptr->realtime.b && server_ptr->client_timeout.i == 0) {
             server_ptr->client_timeout.i = 500; /* 0.5 sec; usable when non realtime. */
@@ -1036,6 +1135,18 @@ jackctl_server_open(
             goto fail;
         }
 
+        /* check client max value before allocating server */
+        if (server_ptr->client_max.ui > CLIENT_NUM) {
+            jack_error("Jack server started with too much clients %d (when client max can be %d)", server_ptr->client_max.ui, CLIENT_NUM);
+            goto fail;
+        }
+
+        /* the audio and freewheel drivers take a refnum, at least one is left for a client (slaves are checked when they are added) */
+        if (server_ptr->client_max.ui <= DRIVER_REFNUM_NUM) {
+            jack_error("Jack server started with too few clients %d (when client max has to be more than %d)", server_ptr->client_max.ui, DRIVER_REFNUM_NUM);
+            goto fail;
+        }
+
         /* get the engine/driver started */
         server_ptr->engine = new JackServer(
             server_ptr->sync.b,
@@ -1044,8 +1155,13 @@ jackctl_server_open(
             server_ptr->realtime.b,
             server_ptr->realtime_priority.i,
             server_ptr->port_max.ui,
+            server_ptr->client_max.ui,
+            server_ptr->graph_workers.ui,
+            server_ptr->graph_worker_spin.ui,
+            server_ptr->activation_mixdown.b,
             server_ptr->verbose.b,
             (jack_timer_type_t)server_ptr->clock_source.ui,
+            (jack_synchro_type_t)server_ptr->synchro.ui,
             server_ptr->self_connect_mode.c,
             server_ptr->name.str);
         if (server_ptr->engine == NULL)
@@ -1053,6 +1169,7 @@ jackctl_server_open(
             jack_error("Failed to create new JackServer object");
             goto fail_unregister;
         }
+        JackStartupTime::Mark("server create");
 
         if (!jackctl_create_param_list(driver_ptr->parameters, &paramlist)) goto fail_delete;
         rc = server_ptr->engine->Open(driver_ptr->desc_ptr, paramlist);
@@ -1366,6 +1483,16 @@ SERVER_EXPORT bool jackctl_server_add_slave(jackctl_server * server_ptr, jackctl
             jack_error("Cannot add a slave in a running server");
             return false;
         } else {
+            /* the slave takes a refnum, at least one is left for a client */
+            unsigned int driver_num = DRIVER_REFNUM_NUM + 1;
+            for (JSList * node = server_ptr->drivers; node; node = jack_slist_next(node)) {
+                driver_num += jack_slist_length(((jackctl_driver *)node->data)->infos);
+            }
+            if (server_ptr->client_max.ui <= driver_num) {
+                jack_error("Cannot add a slave : client max %d leaves no refnum for clients", server_ptr->client_max.ui);
+                return false;
+            }
+
             JSList * paramlist;
             if (!jackctl_create_param_list(driver_ptr->parameters, &paramlist)) return false;
             JackDriverInfo* info = server_ptr->engine->AddSlave(driver_ptr->desc_ptr, paramlist);
@@ -0,0 +1,153 @@
+/*
+Copyright (C) 2026 agent
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 2.1 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*/
+
+#include "JackCycleTimings.h"
+#include "JackClientInterface.h"
+#include "JackClientControl.h"
+#include "JackEngineControl.h"
+#include "JackGraphManager.h"
+#include "JackAtomic.h"
+#include <string.h>
+
+namespace Jack
+{
+
+#define CYCLE_TIMINGS_READ_TRY 4
+
+JackCycleTimings::JackCycleTimings()
+    :fWriteCycle(0), fWriteClient(0), fEnabled(0)
+{
+    memset(fCycles, 0, sizeof(fCycles));
+    memset(fClients, 0, sizeof(fClients));
+    memset(fNames, 0, sizeof(fNames));
+}
+
+void JackCycleTimings::SetClient(int refnum, const char* name)
+{
+    if (refnum >= 0 && refnum < CLIENT_NUM) {
+        strncpy(fNames[refnum], (name) ? name : "", JACK_CLIENT_NAME_SIZE);
+    }
+}
+
+static inline UInt32 RelativeTime(jack_time_t time, jack_time_t begin)
+{
+    return (time > begin) ? UInt32(time - begin) : 0;
+}
+
+void JackCycleTimings::RecordAux(JackClientInterface** table, JackGraphManager* manager, JackEngineControl* control, jack_time_t prev_cycle_end)
+{
+    // Previous cycle begin, when the first cycle has been processed
+    jack_time_t begin = control->fPrevCycleTime;
+    if (begin == 0) {
+        return;
+    }
+
+    UInt32 first = fWriteClient;
+    UInt32 count = 0;
+
+    JackFixedBitSet<CLIENT_NUM>::Iterator it(control->fUsedRefNum, control->fDriverNum);
+    for (int i = it.Next(); i >= 0; i = it.Next()) {
+        JackClientInterface* client = table[i];
+        if (client && client->GetClientControl()->fActive) {
+            JackClientTiming* timing = manager->GetClientTiming(i);
+            JackCycleTimingClient* entry = &fClients[(first + count) & (CYCLE_TIMINGS_CLIENTS - 1)];
+            entry->fRefNum = i;
+            entry->fStatus = timing->fStatus;
+            entry->fSignaledAt = RelativeTime(timing->fSignaledAt, begin);
+            entry->fAwakeAt = RelativeTime(timing->fAwakeAt, begin);
+            entry->fFinishedAt = RelativeTime(timing->fFinishedAt, begin);
+            count++;
+        }
+    }
+
+    JackCycleTimingCycle* cycle = &fCycles[fWriteCycle & (CYCLE_TIMINGS_CYCLES - 1)];
+    cycle->fCycle = fWriteCycle;
+    cycle->fBegin = begin;
+    cycle->fEnd = prev_cycle_end;
+    cycle->fPeriodUsecs = UInt32(control->fPeriodUsecs);
+    cycle->fFirstClient = first;
+    cycle->fClientCount = count;
+
+    // Published once written
+    MEMORY_BARRIER();
+    fWriteClient = first + count;
+    fWriteCycle = fWriteCycle + 1;
+}
+
+static inline jack_time_t AbsoluteTime(UInt32 time, jack_time_t begin)
+{
+    return (time > 0) ? begin + time : 0;
+}
+
+int JackCycleTimings::Read(UInt32 cycle, jack_cycle_timing_t* timing, jack_client_cycle_timing_t* clients, int max_clients)
+{
+    for (int i = 0; i < CYCLE_TIMINGS_READ_TRY; i++) {
+
+        UInt32 write_cycle = fWriteCycle;
+        MEMORY_BARRIER();
+
+        // The slot after the last recorded cycle may be in writing
+        UInt32 oldest = (write_cycle > CYCLE_TIMINGS_CYCLES - 1) ? write_cycle - (CYCLE_TIMINGS_CYCLES - 1) : 0;
+        if (SInt32(cycle - oldest) < 0) {
+            cycle = oldest;
+        }
+        if (SInt32(cycle - write_cycle) >= 0) {
+            return -1;
+        }
+
+        JackCycleTimingCycle record = fCycles[cycle & (CYCLE_TIMINGS_CYCLES - 1)];
+        int count = (int(record.fClientCount) < max_clients) ? int(record.fClientCount) : max_clients;
+
+        for (int j = 0; j < count; j++) {
+            JackCycleTimingClient entry = fClients[(record.fFirstClient + j) & (CYCLE_TIMINGS_CLIENTS - 1)];
+            clients[j].id = entry.fRefNum;
+            clients[j].status = entry.fStatus;
+            clients[j].signaled_at = AbsoluteTime(entry.fSignaledAt, record.fBegin);
+            clients[j].awake_at = AbsoluteTime(entry.fAwakeAt, record.fBegin);
+            clients[j].finished_at = AbsoluteTime(entry.fFinishedAt, record.fBegin);
+        }
+
+        // Check the writer did not reuse the cycle or its client timings while they were copied
+        MEMORY_BARRIER();
+        UInt32 cycle_distance = fWriteCycle - cycle;
+        UInt32 client_distance = fWriteClient + CLIENT_NUM - record.fFirstClient;
+        if (record.fCycle == cycle && cycle_distance < CYCLE_TIMINGS_CYCLES && client_distance <= CYCLE_TIMINGS_CLIENTS) {
+            timing->cycle = cycle;
+            timing->begin = record.fBegin;
+            timing->end = record.fEnd;
+            timing->period_usecs = record.fPeriodUsecs;
+            timing->client_count = count;
+            return 0;
+        }
+    }
+
+    return -1;
+}
+
+int JackCycleTimings::GetClientName(int id, char* name, size_t size)
+{
+    if (id < 0 || id >= CLIENT_NUM || size == 0) {
+        return -1;
+    }
+    strncpy(name, fNames[id], size);
+    name[size - 1] = 0;
+    return 0;
+}
+
+} // end of namespace
@@ -0,0 +1,116 @@
+/*
+Copyright (C) 2026 agent
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 2.1 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*/
+
+#ifndef __JackCycleTimings__
+#define __JackCycleTimings__
+
+#include "JackShmMem.h"
+#include "JackConstants.h"
+#include "JackTypes.h"
+#include "types.h"
+#include "statistics.h"
+
+namespace Jack
+{
+
+#define CYCLE_TIMINGS_CYCLES    1024    // Cycles kept, must be a power of two
+#define CYCLE_TIMINGS_CLIENTS   16384   // Client timings kept, must be a power of two
+
+class JackClientInterface;
+class JackGraphManager;
+struct JackEngineControl;
+
+/*!
+\brief Timings of a client during a cycle, relative to the cycle begin.
+*/
+
+PRE_PACKED_STRUCTURE
+struct JackCycleTimingClient
+{
+    UInt32 fSignaledAt;
+    UInt32 fAwakeAt;
+    UInt32 fFinishedAt;
+    UInt16 fRefNum;
+    UInt16 fStatus;
+
+} POST_PACKED_STRUCTURE;
+
+/*!
+\brief A cycle : its client timings are fClientCount entries from fFirstClient in the client ring.
+*/
+
+PRE_PACKED_STRUCTURE
+struct JackCycleTimingCycle
+{
+    jack_time_t fBegin;
+    jack_time_t fEnd;
+    UInt32 fCycle;
+    UInt32 fPeriodUsecs;
+    UInt32 fFirstClient;
+    UInt32 fClientCount;
+
+} POST_PACKED_STRUCTURE;
+
+/*!
+\brief Ring of per cycle client timings in its own shared memory segment.
+
+Recording is toggled at runtime by clients (fEnabled), and costs nothing when disabled. The engine writes the timings of
+a cycle at the beginning of the next one, when all clients of the cycle are done. Readers do not lock : a cycle which
+has been overwritten while being copied is read again.
+*/
+
+PRE_PACKED_STRUCTURE
+class SERVER_EXPORT JackCycleTimings : public JackShmMem
+{
+
+    private:
+
+        JackCycleTimingCycle fCycles[CYCLE_TIMINGS_CYCLES];
+        JackCycleTimingClient fClients[CYCLE_TIMINGS_CLIENTS];
+        char fNames[CLIENT_NUM][JACK_CLIENT_NAME_SIZE + 1];
+        volatile UInt32 fWriteCycle;    // Cycles recorded
+        volatile UInt32 fWriteClient;   // Client timings recorded
+
+        void RecordAux(JackClientInterface** table, JackGraphManager* manager, JackEngineControl* control, jack_time_t prev_cycle_end);
+
+    public:
+
+        volatile SInt32 fEnabled;
+
+        JackCycleTimings();
+
+        // Server side
+        void SetClient(int refnum, const char* name);
+
+        void Record(JackClientInterface** table, JackGraphManager* manager, JackEngineControl* control, jack_time_t prev_cycle_end)
+        {
+            if (fEnabled) {
+                RecordAux(table, manager, control, prev_cycle_end);
+            }
+        }
+
+        // Reader side
+        int Read(UInt32 cycle, jack_cycle_timing_t* timing, jack_client_cycle_timing_t* clients, int max_clients);
+        int GetClientName(int id, char* name, size_t size);
+
+} POST_PACKED_STRUCTURE;
+
+} // end of namespace
+
+#endif
@@ -260,6 +260,28 @@ int JackDebugClient::PortConnect(const char* src, const char* dst)
     return res;
 }
 
+int JackDebugClient::PortConnect(const char* const* src, const char* const* dst, int count, int* results)
+{
+    CheckClient("PortConnect");
+    if (!fIsActivated)
+        *fStream << "!!! ERROR !!! Trying to connect a list of " << count << " ports while the client has not been activated !" << endl;
+    int res = fClient->PortConnect(src, dst, count, results);
+    for (int j = 0; j < count; j++) {
+        for (int i = (fTotalPortNumber - 1); i >= 0; i--) {     // We search the record into the history
+            if (strcmp(fPortList[i].name, src[j]) == 0 || strcmp(fPortList[i].name, dst[j]) == 0) {
+                if (fPortList[i].IsUnregistered != 0)
+                    *fStream << "!!! ERROR !!! Connecting port " << fPortList[i].name << " previoulsy unregistered !" << endl;
+                fPortList[i].IsConnected++;
+                *fStream << "Connecting port " << src[j] << " to " << dst[j] << ". ";
+                break;
+            }
+        }
+    }
+    if (res != 0)
+        *fStream << "Client '" << fClientName << "' try to do PortConnect on a list but server return " << res << " ." << endl;
+    return res;
+}
+
 int JackDebugClient::PortDisconnect(const char* src, const char* dst)
 {
     CheckClient("PortDisconnect");
@@ -92,6 +92,7 @@ class JackDebugClient : public JackClient
         int PortUnRegister(jack_port_id_t port);
 
         int PortConnect(const char* src, const char* dst);
+        int PortConnect(const char* const* src, const char* const* dst, int count, int* results);
         int PortDisconnect(const char* src, const char* dst);
         int PortDisconnect(jack_port_id_t src);
 
@@ -125,7 +125,10 @@ int JackDriver::Open(jack_nframes_t buffer_size,
 
     fEngineControl->UpdateTimeOut();
 
-    fGraphManager->SetBufferSize(buffer_size);
+    if (fGraphManager->SetBufferSize(buffer_size) < 0) {
+        jack_error("Cannot allocate port buffers for driver");
+        return -1;
+    }
     fGraphManager->DirectConnect(fClientControl.fRefNum, fClientControl.fRefNum); // Connect driver to itself for "sync" mode
     SetupDriverSync(fClientControl.fRefNum, false);
     return 0;
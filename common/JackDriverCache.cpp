@@ -0,0 +1,399 @@
+/*
+Copyright (C) 2026 agent
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+#include "JackDriverCache.h"
+#include "JackError.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+
+#define DRIVER_CACHE_MAGIC "JACKDRV2"
+
+namespace Jack
+{
+
+/*
+The file starts with the magic string and the sizes of the descriptor structures : a cache written by a server
+built differently is ignored. Then come the entries : path, modification time, size, inode, kind, reload flag and
+serialized descriptor. A descriptor is serialized as its structure, followed by its parameters, then the constraints of
+the parameters having one, each followed by its possible values if it is an enumeration.
+*/
+
+struct JackDriverCacheHeader
+{
+    char fMagic[8];
+    uint32_t fDescSize;
+    uint32_t fParamSize;
+    uint32_t fConstraintSize;
+    uint32_t fEnumSize;
+};
+
+static void InitHeader(JackDriverCacheHeader* header)
+{
+    memset(header, 0, sizeof(JackDriverCacheHeader));
+    memcpy(header->fMagic, DRIVER_CACHE_MAGIC, sizeof(header->fMagic));
+    header->fDescSize = sizeof(jack_driver_desc_t);
+    header->fParamSize = sizeof(jack_driver_param_desc_t);
+    header->fConstraintSize = sizeof(jack_driver_param_constraint_desc_t);
+    header->fEnumSize = sizeof(jack_driver_param_value_enum_t);
+}
+
+static void Append(std::vector<char>& data, const void* value, size_t size)
+{
+    const char* bytes = static_cast<const char*>(value);
+    data.insert(data.end(), bytes, bytes + size);
+}
+
+// Copies the next 'size' bytes of data, false if there are not enough of them
+static bool Extract(const std::vector<char>& data, size_t* offset, void* value, size_t size)
+{
+    if (*offset + size > data.size()) {
+        return false;
+    }
+    memcpy(value, &data[*offset], size);
+    *offset += size;
+    return true;
+}
+
+static bool ReadValue(FILE* file, void* value, size_t size)
+{
+    return fread(value, 1, size, file) == size;
+}
+
+static bool WriteValue(FILE* file, const void* value, size_t size)
+{
+    return fwrite(value, 1, size, file) == size;
+}
+
+JackDriverCache::JackDriverCache():fModified(false)
+{
+    const char* path = getenv("JACK_DRIVER_CACHE");
+    if (path) {
+        fPath = path;
+    } else if (getenv("XDG_CACHE_HOME")) {
+        fPath = std::string(getenv("XDG_CACHE_HOME")) + "/jack/driver_cache";
+    } else if (getenv("HOME")) {
+        fPath = std::string(getenv("HOME")) + "/.cache/jack/driver_cache";
+    }
+
+    if (!fPath.empty() && !Read()) {
+        fEntries.clear();
+    }
+}
+
+JackDriverCache::~JackDriverCache()
+{}
+
+bool JackDriverCache::Match(const Entry& entry, const struct stat* st)
+{
+    return entry.fTime == int64_t(st->st_mtime) && entry.fSize == int64_t(st->st_size) && entry.fInode == int64_t(st->st_ino);
+}
+
+bool JackDriverCache::HasEnumeration(jack_driver_desc_t* desc)
+{
+    for (uint32_t i = 0; i < desc->nparams; i++) {
+        jack_driver_param_constraint_desc_t* constraint = desc->params[i].constraint;
+        if (constraint && (constraint->flags & JACK_CONSTRAINT_FLAG_RANGE) == 0 && constraint->constraint.enumeration.count > 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool JackDriverCache::Find(const char* filename, const struct stat* st, int wanted, int* kind, jack_driver_desc_t** desc)
+{
+    std::map<std::string, Entry>::iterator it = fEntries.find(filename);
+    if (it == fEntries.end() || !Match((*it).second, st)) {
+        return false;
+    }
+
+    if ((*it).second.fKind == wanted && (*it).second.fReload) {
+        return false;
+    }
+
+    *kind = (*it).second.fKind;
+    *desc = NULL;
+    if (*kind == wanted && !(*it).second.fDescriptor.empty()) {
+        if ((*desc = Deserialize((*it).second.fDescriptor)) == NULL) {
+            jack_error("JackDriverCache::Find : cannot read descriptor of %s", filename);
+            fEntries.erase(it);
+            fModified = true;
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void JackDriverCache::Add(const char* filename, const struct stat* st, int kind, jack_driver_desc_t* desc)
+{
+    // An object loaded again to get its descriptor does not change the cache
+    std::map<std::string, Entry>::iterator it = fEntries.find(filename);
+    if (it != fEntries.end() && Match((*it).second, st) && (*it).second.fKind == kind && (*it).second.fReload) {
+        return;
+    }
+
+    Entry& entry = fEntries[filename];
+    entry.fTime = st->st_mtime;
+    entry.fSize = st->st_size;
+    entry.fInode = st->st_ino;
+    entry.fKind = kind;
+    entry.fReload = (desc && HasEnumeration(desc));
+    entry.fDescriptor.clear();
+    if (desc && !entry.fReload) {
+        Serialize(desc, entry.fDescriptor);
+    }
+    fModified = true;
+}
+
+void JackDriverCache::Save()
+{
+    if (fPath.empty() || !fModified) {
+        return;
+    }
+
+    // Objects removed or replaced since they were added are dropped
+    std::map<std::string, Entry>::iterator it = fEntries.begin();
+    while (it != fEntries.end()) {
+        struct stat st;
+        if (stat((*it).first.c_str(), &st) < 0 || !Match((*it).second, &st)) {
+            fEntries.erase(it++);
+        } else {
+            it++;
+        }
+    }
+
+    if (Write()) {
+        fModified = false;
+    }
+}
+
+void JackDriverCache::Serialize(jack_driver_desc_t* desc, std::vector<char>& data)
+{
+    Append(data, desc, sizeof(jack_driver_desc_t));
+    if (desc->nparams > 0) {
+        Append(data, desc->params, desc->nparams * sizeof(jack_driver_param_desc_t));
+    }
+
+    for (uint32_t i = 0; i < desc->nparams; i++) {
+        jack_driver_param_constraint_desc_t* constraint = desc->params[i].constraint;
+        if (constraint) {
+            Append(data, constraint, sizeof(jack_driver_param_constraint_desc_t));
+            if ((constraint->flags & JACK_CONSTRAINT_FLAG_RANGE) == 0 && constraint->constraint.enumeration.count > 0) {
+                Append(data, constraint->constraint.enumeration.possible_values_array,
+                    constraint->constraint.enumeration.count * sizeof(jack_driver_param_value_enum_t));
+            }
+        }
+    }
+}
+
+// Allocated as jack_driver_descriptor_construct and jack_constraint_add_enum do
+jack_driver_desc_t* JackDriverCache::Deserialize(const std::vector<char>& data)
+{
+    size_t offset = 0;
+    jack_driver_desc_t* desc = (jack_driver_desc_t*)calloc(1, sizeof(jack_driver_desc_t));
+    if (!desc) {
+        return NULL;
+    }
+
+    if (!Extract(data, &offset, desc, sizeof(jack_driver_desc_t))) {
+        free(desc);
+        return NULL;
+    }
+    desc->params = NULL;
+
+    if (desc->nparams > 0) {
+        if ((desc->params = (jack_driver_param_desc_t*)calloc(desc->nparams, sizeof(jack_driver_param_desc_t))) == NULL
+            || !Extract(data, &offset, desc->params, desc->nparams * sizeof(jack_driver_param_desc_t))) {
+            free(desc->params);
+            free(desc);
+            return NULL;
+        }
+    }
+
+    // Constraints are read only for parameters which had one when serialized
+    bool res = true;
+    for (uint32_t i = 0; i < desc->nparams; i++) {
+        jack_driver_param_desc_t* param = &desc->params[i];
+        if (!param->constraint) {
+            continue;
+        }
+        param->constraint = NULL;
+        if (!res) {
+            continue;
+        }
+
+        jack_driver_param_constraint_desc_t* constraint = (jack_driver_param_constraint_desc_t*)calloc(1, sizeof(jack_driver_param_constraint_desc_t));
+        if (!constraint || !Extract(data, &offset, constraint, sizeof(jack_driver_param_constraint_desc_t))) {
+            free(constraint);
+            res = false;
+            continue;
+        }
+        param->constraint = constraint;
+
+        if ((constraint->flags & JACK_CONSTRAINT_FLAG_RANGE) == 0) {
+            uint32_t count = constraint->constraint.enumeration.count;
+            constraint->constraint.enumeration.possible_values_array = NULL;
+            if (count > 0) {
+                jack_driver_param_value_enum_t* values = (jack_driver_param_value_enum_t*)calloc(count, sizeof(jack_driver_param_value_enum_t));
+                constraint->constraint.enumeration.possible_values_array = values;
+                if (!values || !Extract(data, &offset, values, count * sizeof(jack_driver_param_value_enum_t))) {
+                    constraint->constraint.enumeration.count = 0;
+                    res = false;
+                }
+            }
+        }
+    }
+
+    if (!res || offset != data.size()) {
+        FreeDescriptor(desc);
+        return NULL;
+    }
+
+    return desc;
+}
+
+void JackDriverCache::FreeDescriptor(jack_driver_desc_t* desc)
+{
+    if (!desc) {
+        return;
+    }
+
+    for (uint32_t i = 0; i < desc->nparams; i++) {
+        jack_driver_param_constraint_desc_t* constraint = desc->params[i].constraint;
+        if (constraint) {
+            if ((constraint->flags & JACK_CONSTRAINT_FLAG_RANGE) == 0) {
+                free(constraint->constraint.enumeration.possible_values_array);
+            }
+            free(constraint);
+        }
+    }
+
+    free(desc->params);
+    free(desc);
+}
+
+bool JackDriverCache::Read()
+{
+    FILE* file = fopen(fPath.c_str(), "rb");
+    if (!file) {
+        jack_log("JackDriverCache::Read : no cache %s", fPath.c_str());
+        return false;
+    }
+
+    JackDriverCacheHeader header;
+    JackDriverCacheHeader expected;
+    InitHeader(&expected);
+    uint32_t count = 0;
+    bool res = ReadValue(file, &header, sizeof(header))
+        && memcmp(&header, &expected, sizeof(header)) == 0
+        && ReadValue(file, &count, sizeof(count));
+
+    for (uint32_t i = 0; res && i < count; i++) {
+        uint32_t path_size = 0;
+        uint32_t desc_size = 0;
+        Entry entry;
+        res = ReadValue(file, &path_size, sizeof(path_size)) && path_size <= JACK_PATH_MAX;
+        if (!res) {
+            break;
+        }
+        std::vector<char> path(path_size + 1, 0);
+        res = ReadValue(file, &path[0], path_size)
+            && ReadValue(file, &entry.fTime, sizeof(entry.fTime))
+            && ReadValue(file, &entry.fSize, sizeof(entry.fSize))
+            && ReadValue(file, &entry.fInode, sizeof(entry.fInode))
+            && ReadValue(file, &entry.fKind, sizeof(entry.fKind))
+            && ReadValue(file, &entry.fReload, sizeof(entry.fReload))
+            && ReadValue(file, &desc_size, sizeof(desc_size))
+            && desc_size < (1 << 24);
+        if (res && desc_size > 0) {
+            entry.fDescriptor.resize(desc_size);
+            res = ReadValue(file, &entry.fDescriptor[0], desc_size);
+        }
+        if (res) {
+            fEntries[&path[0]] = entry;
+        }
+    }
+
+    fclose(file);
+    if (!res) {
+        jack_error("JackDriverCache::Read : invalid cache %s", fPath.c_str());
+        return false;
+    }
+
+    jack_log("JackDriverCache::Read : %d entries in %s", count, fPath.c_str());
+    return true;
+}
+
+bool JackDriverCache::Write()
+{
+    // Directories of the cache, if they are missing
+    for (size_t pos = fPath.find('/', 1); pos != std::string::npos; pos = fPath.find('/', pos + 1)) {
+        std::string dir = fPath.substr(0, pos);
+        if (mkdir(dir.c_str(), 0755) < 0 && errno != EEXIST) {
+            jack_error("JackDriverCache::Write : cannot create directory %s : %s", dir.c_str(), strerror(errno));
+            return false;
+        }
+    }
+
+    // Written aside then renamed, so that servers starting at the same time always read a complete cache
+    char tmp_path[JACK_PATH_MAX + 32];
+    snprintf(tmp_path, sizeof(tmp_path), "%s.%d", fPath.c_str(), int(getpid()));
+    FILE* file = fopen(tmp_path, "wb");
+    if (!file) {
+        jack_error("JackDriverCache::Write : cannot open %s : %s", tmp_path, strerror(errno));
+        return false;
+    }
+
+    JackDriverCacheHeader header;
+    InitHeader(&header);
+    uint32_t count = fEntries.size();
+    bool res = WriteValue(file, &header, sizeof(header)) && WriteValue(file, &count, sizeof(count));
+
+    std::map<std::string, Entry>::iterator it;
+    for (it = fEntries.begin(); res && it != fEntries.end(); it++) {
+        const Entry& entry = (*it).second;
+        uint32_t path_size = (*it).first.size();
+        uint32_t desc_size = entry.fDescriptor.size();
+        res = WriteValue(file, &path_size, sizeof(path_size))
+            && WriteValue(file, (*it).first.c_str(), path_size)
+            && WriteValue(file, &entry.fTime, sizeof(entry.fTime))
+            && WriteValue(file, &entry.fSize, sizeof(entry.fSize))
+            && WriteValue(file, &entry.fInode, sizeof(entry.fInode))
+            && WriteValue(file, &entry.fKind, sizeof(entry.fKind))
+            && WriteValue(file, &entry.fReload, sizeof(entry.fReload))
+            && WriteValue(file, &desc_size, sizeof(desc_size))
+            && (desc_size == 0 || WriteValue(file, &entry.fDescriptor[0], desc_size));
+    }
+
+    res = (fclose(file) == 0) && res;
+    if (!res || rename(tmp_path, fPath.c_str()) < 0) {
+        jack_error("JackDriverCache::Write : cannot write %s", fPath.c_str());
+        unlink(tmp_path);
+        return false;
+    }
+
+    jack_log("JackDriverCache::Write : %d entries in %s", count, fPath.c_str());
+    return true;
+}
+
+} // end of namespace
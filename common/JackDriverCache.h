@@ -0,0 +1,100 @@
+/*
+Copyright (C) 2026 agent
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+#ifndef __JackDriverCache__
+#define __JackDriverCache__
+
+#include "driver_interface.h"
+
+#include <sys/stat.h>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace Jack
+{
+
+/*!
+\brief Persistent cache of the descriptors of the drivers and internal clients.
+
+Shared objects of the driver directory do not have to be loaded to know their kind and get their descriptor : entries
+are keyed by the object path, and are valid as long as its modification time, size and inode do not change. The cache
+file is JACK_DRIVER_CACHE if set (an empty value disables the cache), $XDG_CACHE_HOME/jack/driver_cache or
+$HOME/.cache/jack/driver_cache otherwise.
+
+Descriptors having enumerated values are not cached, since the values may be built when the descriptor is (the
+ALSA cards present at that time) : only the kind of the object is, and it is loaded each time its descriptor is wanted.
+*/
+
+class JackDriverCache
+{
+
+    public:
+
+        enum Kind {
+            kNone = 0,      // Loadable object which is neither a driver nor an internal client
+            kDriver,
+            kInternal
+        };
+
+    private:
+
+        struct Entry
+        {
+            int64_t fTime;
+            int64_t fSize;
+            int64_t fInode;
+            int32_t fKind;
+            int32_t fReload;                // The descriptor is not cached, the object has to be loaded to get it
+            std::vector<char> fDescriptor;  // Serialized, empty if the object has no descriptor or it is not cached
+        };
+
+        std::map<std::string, Entry> fEntries;
+        std::string fPath;
+        bool fModified;
+
+        static bool Match(const Entry& entry, const struct stat* st);
+        static bool HasEnumeration(jack_driver_desc_t* desc);
+
+        static void Serialize(jack_driver_desc_t* desc, std::vector<char>& data);
+        static jack_driver_desc_t* Deserialize(const std::vector<char>& data);
+
+        bool Read();
+        bool Write();
+
+    public:
+
+        JackDriverCache();
+        ~JackDriverCache();
+
+        // Kind of the object, and a copy of its descriptor if it is of the 'wanted' kind (to be freed by the caller) : false if not in the cache,
+        // or if the object is of the 'wanted' kind and its descriptor is not cached
+        bool Find(const char* filename, const struct stat* st, int wanted, int* kind, jack_driver_desc_t** desc);
+        void Add(const char* filename, const struct stat* st, int kind, jack_driver_desc_t* desc);
+
+        // Writes the cache if it has been modified
+        void Save();
+
+        static void FreeDescriptor(jack_driver_desc_t* desc);
+
+};
+
+} // end of namespace
+
+#endif
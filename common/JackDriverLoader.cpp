@@ -30,6 +30,8 @@ Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
 
 #ifndef WIN32
 #include <dirent.h>
+#include <sys/stat.h>
+#include "JackDriverCache.h"
 #endif
 
 #ifdef WIN32
@@ -416,6 +418,8 @@ jack_driver_desc_t* jack_find_driver_descriptor (JSList * drivers, const char* n
     return desc;
 }
 
+#ifdef WIN32
+
 static void* check_symbol(const char* sofile, const char* symbol, const char* driver_dir, void** res_dllhandle = NULL)
 {
     void* dlhandle;
@@ -424,11 +428,7 @@ static void* check_symbol(const char* sofile, const char* symbol, const char* dr
     sprintf(filename, "%s/%s", driver_dir, sofile);
 
     if ((dlhandle = LoadDriverModule(filename)) == NULL) {
-#ifdef WIN32
         jack_error ("Could not open component .dll '%s': %ld", filename, GetLastError());
-#else
-        jack_error ("Could not open component .so '%s': %s", filename, dlerror());
-#endif
     } else {
         res = (void*)GetDriverProc(dlhandle, symbol);
         if (res_dllhandle) {
@@ -482,8 +482,6 @@ error:
     return descriptor;
 }
 
-#ifdef WIN32
-
 JSList * jack_drivers_load(JSList * drivers)
 {
     //char dll_filename[512];
@@ -543,19 +541,99 @@ error:
 
 #else
 
+static const char* jack_get_driver_dir()
+{
+    const char* driver_dir;
+    if ((driver_dir = getenv("JACK_DRIVER_DIR")) == 0) {
+        driver_dir = ADDON_DIR;
+    }
+    return driver_dir;
+}
+
+/* Descriptor of an object of the driver directory if it is of the 'wanted' kind. The cache gives it if the object did not
+change, otherwise the object is loaded once to check its kind and get its descriptor, which are then cached. */
+static jack_driver_desc_t* jack_get_cached_descriptor(Jack::JackDriverCache* cache, JSList* drivers, const char* sofile,
+                                                      const char* driver_dir, int wanted, int* kind)
+{
+    jack_driver_desc_t* descriptor = NULL;
+    jack_driver_desc_t* other_descriptor;
+    JackDriverDescFunction so_get_descriptor = NULL;
+    char filename[1024];
+    struct stat st;
+    JSList* node;
+    void* dlhandle;
+
+    *kind = Jack::JackDriverCache::kNone;
+    snprintf(filename, sizeof(filename), "%s/%s", driver_dir, sofile);
+    if (stat(filename, &st) < 0) {
+        jack_error("Could not stat component .so '%s': %s", filename, strerror(errno));
+        return NULL;
+    }
+
+    if (!cache->Find(filename, &st, wanted, kind, &descriptor)) {
+
+        if ((dlhandle = LoadDriverModule(filename)) == NULL) {
+            jack_error("Could not open component .so '%s': %s", filename, dlerror());
+            return NULL;
+        }
+
+        if (GetDriverProc(dlhandle, "jack_internal_initialize") != NULL) {
+            *kind = Jack::JackDriverCache::kInternal;
+            so_get_descriptor = (JackDriverDescFunction)GetDriverProc(dlhandle, "jack_get_descriptor");
+        } else {
+            *kind = Jack::JackDriverCache::kDriver;
+            so_get_descriptor = (JackDriverDescFunction)GetDriverProc(dlhandle, "driver_get_descriptor");
+        }
+
+        if (so_get_descriptor == NULL) {
+            if (*kind == wanted) {
+                jack_error("jack_get_descriptor : dll %s is not a driver", sofile);
+            }
+        } else if ((descriptor = so_get_descriptor()) == NULL) {
+            jack_error("Driver from '%s' returned NULL descriptor", filename);
+        } else {
+            strncpy(descriptor->file, filename, JACK_PATH_MAX);
+        }
+
+        UnloadDriverModule(dlhandle);
+        cache->Add(filename, &st, *kind, descriptor);
+
+        if (*kind != wanted) {
+            Jack::JackDriverCache::FreeDescriptor(descriptor);
+            return NULL;
+        }
+    }
+
+    if (descriptor == NULL) {
+        return NULL;
+    }
+
+    /* check it doesn't exist already */
+    for (node = drivers; node; node = jack_slist_next (node)) {
+        other_descriptor = (jack_driver_desc_t*) node->data;
+        if (strcmp(descriptor->name, other_descriptor->name) == 0) {
+            jack_error("The drivers in '%s' and '%s' both have the name '%s'; using the first",
+                       other_descriptor->file, filename, other_descriptor->name);
+            Jack::JackDriverCache::FreeDescriptor(descriptor);
+            return NULL;
+        }
+    }
+
+    return descriptor;
+}
+
 JSList* jack_drivers_load (JSList * drivers)
 {
     struct dirent * dir_entry;
     DIR * dir_stream;
     const char* ptr;
     int err;
+    int kind;
     JSList* driver_list = NULL;
     jack_driver_desc_t* desc = NULL;
+    Jack::JackDriverCache cache;
 
-    const char* driver_dir;
-    if ((driver_dir = getenv("JACK_DRIVER_DIR")) == 0) {
-        driver_dir = ADDON_DIR;
-    }
+    const char* driver_dir = jack_get_driver_dir();
 
     /* search through the driver_dir and add get descriptors
     from the .so files in it */
@@ -582,12 +660,13 @@ JSList* jack_drivers_load (JSList * drivers)
             continue;
         }
 
+        desc = jack_get_cached_descriptor (&cache, drivers, dir_entry->d_name, driver_dir, Jack::JackDriverCache::kDriver, &kind);
+
         /* check if dll is an internal client */
-        if (check_symbol(dir_entry->d_name, "jack_internal_initialize", driver_dir) != NULL) {
+        if (kind != Jack::JackDriverCache::kDriver) {
             continue;
         }
 
-        desc = jack_get_descriptor (drivers, dir_entry->d_name, "driver_get_descriptor", driver_dir);
         if (desc) {
             driver_list = jack_slist_append (driver_list, desc);
         } else {
@@ -601,6 +680,8 @@ JSList* jack_drivers_load (JSList * drivers)
                     driver_dir, strerror (errno));
     }
 
+    cache.Save();
+
     if (!driver_list) {
         jack_error ("Could not find any drivers in %s!", driver_dir);
         return NULL;
@@ -674,13 +755,12 @@ JSList* jack_internals_load(JSList * internals)
     DIR * dir_stream;
     const char* ptr;
     int err;
+    int kind;
     JSList* driver_list = NULL;
     jack_driver_desc_t* desc;
+    Jack::JackDriverCache cache;
 
-    const char* driver_dir;
-    if ((driver_dir = getenv("JACK_DRIVER_DIR")) == 0) {
-        driver_dir = ADDON_DIR;
-    }
+    const char* driver_dir = jack_get_driver_dir();
 
     /* search through the driver_dir and add get descriptors
     from the .so files in it */
@@ -703,12 +783,13 @@ JSList* jack_internals_load(JSList * internals)
             continue;
         }
 
+        desc = jack_get_cached_descriptor (&cache, internals, dir_entry->d_name, driver_dir, Jack::JackDriverCache::kInternal, &kind);
+
         /* check if dll is an internal client */
-        if (check_symbol(dir_entry->d_name, "jack_internal_initialize", driver_dir) == NULL) {
+        if (kind != Jack::JackDriverCache::kInternal) {
             continue;
         }
 
-        desc = jack_get_descriptor (internals, dir_entry->d_name, "jack_get_descriptor", driver_dir);
         if (desc) {
             driver_list = jack_slist_append (driver_list, desc);
         } else {
@@ -722,6 +803,8 @@ JSList* jack_internals_load(JSList * internals)
                     driver_dir, strerror (errno));
     }
 
+    cache.Save();
+
     if (!driver_list) {
         jack_error ("Could not find any internals in %s!", driver_dir);
         return NULL;
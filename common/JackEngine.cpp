@@ -20,6 +20,7 @@ Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
 #include <iostream>
 #include <fstream>
 #include <set>
+#include <algorithm>
 #include <assert.h>
 #include <ctype.h>
 
@@ -33,6 +34,8 @@ Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
 #include "JackGlobals.h"
 #include "JackChannel.h"
 #include "JackError.h"
+#include "JackStartupTime.h"
+#include "JackCycleTimings.h"
 
 namespace Jack
 {
@@ -40,6 +43,7 @@ namespace Jack
 JackEngine::JackEngine(JackGraphManager* manager,
                        JackSynchro* table,
                        JackEngineControl* control,
+                       JackCycleTimings* timings,
                        char self_connect_mode)
                     : JackLockAble(control->fServerName), 
                     fSignal(control->fServerName)
@@ -47,6 +51,7 @@ JackEngine::JackEngine(JackGraphManager* manager,
     fGraphManager = manager;
     fSynchroTable = table;
     fEngineControl = control;
+    fCycleTimings = timings;
     fSelfConnectMode = self_connect_mode;
     for (int i = 0; i < CLIENT_NUM; i++) {
         fClientTable[i] = NULL;
@@ -84,12 +89,12 @@ int JackEngine::Close()
         if (JackLoadableInternalClient* loadable_client = dynamic_cast<JackLoadableInternalClient*>(fClientTable[i])) {
             jack_log("JackEngine::Close loadable client = %s", loadable_client->GetClientControl()->fName);
             loadable_client->Close();
-            fClientTable[i] = NULL;
+            SetClient(i, NULL);
             delete loadable_client;
         } else if (JackExternalClient* external_client = dynamic_cast<JackExternalClient*>(fClientTable[i])) {
             jack_log("JackEngine::Close external client = %s", external_client->GetClientControl()->fName);
             external_client->Close();
-            fClientTable[i] = NULL;
+            SetClient(i, NULL);
             delete external_client;
         }
     }
@@ -108,7 +113,7 @@ void JackEngine::NotifyQuit()
 
 int JackEngine::AllocateRefnum()
 {
-    for (int i = 0; i < CLIENT_NUM; i++) {
+    for (int i = 0; i < fEngineControl->fClientMax; i++) {
         if (!fClientTable[i]) {
             jack_log("JackEngine::AllocateRefNum ref = %ld", i);
             return i;
@@ -117,18 +122,24 @@ int JackEngine::AllocateRefnum()
     return -1;
 }
 
+void JackEngine::SetClient(int refnum, JackClientInterface* client)
+{
+    fClientTable[refnum] = client;
+    fCycleTimings->SetClient(refnum, (client) ? client->GetClientControl()->fName : NULL);
+    fEngineControl->fClientLoad[refnum].Init((client) ? client->GetClientControl()->fName : NULL);
+    if (client) {
+        fEngineControl->fUsedRefNum.Set(refnum);
+    } else {
+        fEngineControl->fUsedRefNum.Reset(refnum);
+    }
+}
+
 void JackEngine::ReleaseRefnum(int refnum)
 {
-    fClientTable[refnum] = NULL;
+    SetClient(refnum, NULL);
 
     if (fEngineControl->fTemporary) {
-        int i;
-        for (i = fEngineControl->fDriverNum; i < CLIENT_NUM; i++) {
-            if (fClientTable[i]) {
-                break;
-            }
-        }
-        if (i == CLIENT_NUM) {
+        if (fEngineControl->fUsedRefNum.Next(fEngineControl->fDriverNum) < 0) {
             // Last client and temporay case: quit the server
             jack_log("JackEngine::ReleaseRefnum server quit");
             fEngineControl->fTemporary = false;
@@ -162,8 +173,11 @@ bool JackEngine::Process(jack_time_t cur_cycle_begin, jack_time_t prev_cycle_end
 {
     bool res = true;
 
+    JackStartupTime::Cycle();
+
     // Cycle  begin
     fEngineControl->CycleBegin(fClientTable, fGraphManager, cur_cycle_begin, prev_cycle_end);
+    fCycleTimings->Record(fClientTable, fGraphManager, fEngineControl, prev_cycle_end);
   
     // Graph
     if (fGraphManager->IsFinishedGraph()) {
@@ -210,7 +224,8 @@ static const char* State2String(jack_client_state_t state)
 
 void JackEngine::CheckXRun(jack_time_t callback_usecs)  // REVOIR les conditions de fin
 {
-    for (int i = fEngineControl->fDriverNum; i < CLIENT_NUM; i++) {
+    JackFixedBitSet<CLIENT_NUM>::Iterator it(fEngineControl->fUsedRefNum, fEngineControl->fDriverNum);
+    for (int i = it.Next(); i >= 0; i = it.Next()) {
         JackClientInterface* client = fClientTable[i];
         if (client && client->GetClientControl()->fActive) {
             JackClientTiming* timing = fGraphManager->GetClientTiming(i);
@@ -235,26 +250,52 @@ int JackEngine::ComputeTotalLatencies()
     std::vector<jack_int_t> sorted;
     std::vector<jack_int_t>::iterator it;
     std::vector<jack_int_t>::reverse_iterator rit;
+    JackFixedBitSet<CLIENT_NUM> capture;
+    JackFixedBitSet<CLIENT_NUM> playback;
 
     fGraphManager->TopologicalSort(sorted);
 
+    // Only the clients affected by the changes since the last computation, or all of them
+    bool all = !fGraphManager->GetLatencyChanges(fEngineControl->fDriverNum, capture, playback);
+
     /* iterate over all clients in graph order, and emit
 	 * capture latency callback.
 	 */
 
     for (it = sorted.begin(); it != sorted.end(); it++) {
-        NotifyClient(*it, kLatencyCallback, true, "", 0, 0);
+        if (all || capture.Test(*it)) {
+            ComputeClientLatency(*it, 0);
+        }
     }
 
     /* now issue playback latency callbacks in reverse graph order.
 	 */
     for (rit = sorted.rbegin(); rit != sorted.rend(); rit++) {
-        NotifyClient(*rit, kLatencyCallback, true, "", 1, 0);
+        if (all || playback.Test(*rit)) {
+            ComputeClientLatency(*rit, 1);
+        }
     }
 
     return 0;
 }
 
+/*!
+\brief Drivers and clients with a latency callback are notified, latencies of the other clients are computed by the server.
+*/
+void JackEngine::ComputeClientLatency(int refnum, int status)
+{
+    JackClientInterface* client = fClientTable[refnum];
+    if (!client) {
+        return;
+    }
+
+    if (client->GetClientControl()->fCallback[kLatencyCallback]) {
+        NotifyClient(refnum, kLatencyCallback, true, "", status, 0);
+    } else if (client->GetClientControl()->fActive) {
+        fGraphManager->ComputeLatency(refnum, (status == 0) ? JackCaptureLatency : JackPlaybackLatency);
+    }
+}
+
 //---------------
 // Notifications
 //---------------
@@ -297,9 +338,74 @@ void JackEngine::NotifyClient(int refnum, int event, int sync, const char* messa
 
 void JackEngine::NotifyClients(int event, int sync, const char* message, int value1, int value2)
 {
+    if (!sync) {
+        for (int i = 0; i < CLIENT_NUM; i++) {
+            NotifyClient(i, event, sync, message, value1, value2);
+        }
+        return;
+    }
+
+    // Drivers and internal clients first : the engine is unlocked while they are notified
     for (int i = 0; i < CLIENT_NUM; i++) {
-        NotifyClient(i, event, sync, message, value1, value2);
+        JackClientInterface* client = fClientTable[i];
+        if (client && !dynamic_cast<JackExternalClient*>(client)) {
+            ClientNotify(client, i, client->GetClientControl()->fName, event, sync, message, value1, value2);
+        }
     }
+
+    // Then all external clients are notified at once, and their results collected
+    JackExternalClient* clients[CLIENT_NUM];
+    jack_time_t post_times[CLIENT_NUM];
+    int count = 0;
+
+    for (int i = 0; i < CLIENT_NUM; i++) {
+        JackExternalClient* client = dynamic_cast<JackExternalClient*>(fClientTable[i]);
+        if (client && client->GetClientControl()->fCallback[event]) {
+            if (client->ClientNotifyPost(i, client->GetClientControl()->fName, event, message, value1, value2) < 0) {
+                jack_error("ClientNotify fails name = %s notification = %ld val1 = %ld val2 = %ld", client->GetClientControl()->fName, event, value1, value2);
+            } else {
+                clients[count] = client;
+                post_times[count++] = GetMicroSeconds();
+            }
+        }
+    }
+
+    ClientNotifyResults(clients, post_times, count, event);
+}
+
+int JackEngine::ClientNotifyResults(JackExternalClient** clients, jack_time_t* post_times, int count, int notify)
+{
+    // Drivers are opened before the clock source is set
+    if (count == 0) {
+        return 0;
+    }
+
+    JackNotifyChannel* channels[CLIENT_NUM];
+    int results[CLIENT_NUM];
+    jack_time_t reply_times[CLIENT_NUM];
+
+    for (int i = 0; i < count; i++) {
+        channels[i] = clients[i]->GetNotifyChannel();
+    }
+
+    // All results are collected together, each one timestamped on arrival
+    int res = JackNotifyChannel::ClientNotifyResults(channels, results, reply_times, count, GetMicroSeconds() + NOTIFY_TIME_OUT);
+
+    for (int i = 0; i < count; i++) {
+        JackClientControl* control = clients[i]->GetClientControl();
+        if (results[i] < 0) {
+            jack_error("ClientNotify fails name = %s notification = %ld", control->fName, notify);
+            res = -1;
+        }
+        if (reply_times[i] > 0) {
+            JackClientLoad* load = &fEngineControl->fClientLoad[control->fRefNum];
+            load->fNotifyUsecs = reply_times[i] - post_times[i];
+            load->fMaxNotifyUsecs = std::max(load->fMaxNotifyUsecs, load->fNotifyUsecs);
+            jack_log("JackEngine::ClientNotifyResults name = %s notification = %ld latency = %lld usec", control->fName, notify, load->fNotifyUsecs);
+        }
+    }
+
+    return res;
 }
 
 int JackEngine::NotifyAddClient(JackClientInterface* new_client, const char* new_name, int refnum)
@@ -307,6 +413,11 @@ int JackEngine::NotifyAddClient(JackClientInterface* new_client, const char* new
     jack_log("JackEngine::NotifyAddClient: name = %s", new_name);
     
     // Notify existing clients of the new client and new client of existing clients.
+    JackExternalClient* external_client = dynamic_cast<JackExternalClient*>(new_client);
+    JackExternalClient* clients[CLIENT_NUM];
+    jack_time_t post_times[CLIENT_NUM];
+    int count = 0;
+
     for (int i = 0; i < CLIENT_NUM; i++) {
         JackClientInterface* old_client = fClientTable[i];
         if (old_client && old_client != new_client) {
@@ -315,13 +426,26 @@ int JackEngine::NotifyAddClient(JackClientInterface* new_client, const char* new
                 jack_error("NotifyAddClient old_client fails name = %s", old_name);
                 // Not considered as a failure...
             }
-            if (ClientNotify(new_client, i, old_name, kAddClient, true, "", 0, 0) < 0) {
+            // An external new client receives all notifications before its results are read
+            if (external_client) {
+                if (external_client->ClientNotifyPost(i, old_name, kAddClient, "", 0, 0) < 0) {
+                    jack_error("NotifyAddClient new_client fails name = %s", new_name);
+                    return -1;
+                }
+                clients[count] = external_client;
+                post_times[count++] = GetMicroSeconds();
+            } else if (ClientNotify(new_client, i, old_name, kAddClient, true, "", 0, 0) < 0) {
                 jack_error("NotifyAddClient new_client fails name = %s", new_name);
                 return -1;
             }
         }
     }
 
+    if (ClientNotifyResults(clients, post_times, count, kAddClient) < 0) {
+        jack_error("NotifyAddClient new_client fails name = %s", new_name);
+        return -1;
+    }
+
     return 0;
 }
 
@@ -631,7 +755,7 @@ int JackEngine::ClientExternalOpen(const char* name, int pid, int uuid, int* ref
         goto error;
     }
 
-    fClientTable[refnum] = client;
+    SetClient(refnum, client);
 
     if (NotifyAddClient(client, real_name, refnum) < 0) {
         jack_error("Cannot notify add client");
@@ -648,7 +772,7 @@ int JackEngine::ClientExternalOpen(const char* name, int pid, int uuid, int* ref
 error:
     // Cleanup...
     fSynchroTable[refnum].Destroy();
-    fClientTable[refnum] = 0;
+    SetClient(refnum, NULL);
     client->Close();
     delete client;
     return -1;
@@ -676,7 +800,7 @@ int JackEngine::ClientInternalOpen(const char* name, int* ref, JackEngineControl
         goto error;
     }
 
-    fClientTable[refnum] = client;
+    SetClient(refnum, client);
 
     if (NotifyAddClient(client, name, refnum) < 0) {
         jack_error("Cannot notify add client");
@@ -693,7 +817,7 @@ int JackEngine::ClientInternalOpen(const char* name, int* ref, JackEngineControl
 error:
     // Cleanup...
     fSynchroTable[refnum].Destroy();
-    fClientTable[refnum] = 0;
+    SetClient(refnum, NULL);
     return -1;
 }
 
@@ -941,6 +1065,20 @@ int JackEngine::PortConnect(int refnum, const char* src, const char* dst)
            : PortConnect(refnum, port_src, port_dst);
 }
 
+int JackEngine::PortConnect(int refnum, const char* const* src, const char* const* dst, int count, int* results)
+{
+    jack_log("JackEngine::PortConnect ref = %d count = %d", refnum, count);
+    int res = 0;
+
+    for (int i = 0; i < count; i++) {
+        results[i] = PortConnect(refnum, src[i], dst[i]);
+        if (results[i] != 0) {
+            res = -1;
+        }
+    }
+    return res;
+}
+
 int JackEngine::PortConnect(int refnum, jack_port_id_t src, jack_port_id_t dst)
 {
     jack_log("JackEngine::PortConnect ref = %d src = %d dst = %d", refnum, src, dst);
@@ -1040,7 +1178,7 @@ int JackEngine::PortRename(int refnum, jack_port_id_t port, const char* name)
 {
     char old_name[REAL_JACK_PORT_NAME_SIZE];
     strcpy(old_name, fGraphManager->GetPort(port)->GetName());
-    fGraphManager->GetPort(port)->SetName(name);
+    fGraphManager->SetPortName(port, name);
     NotifyPortRename(port, old_name);
     return 0;
 }
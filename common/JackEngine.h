@@ -35,6 +35,7 @@ namespace Jack
 
 class JackClientInterface;
 struct JackEngineControl;
+class JackCycleTimings;
 class JackExternalClient;
 
 /*!
@@ -49,6 +50,7 @@ class SERVER_EXPORT JackEngine : public JackLockAble
 
         JackGraphManager* fGraphManager;
         JackEngineControl* fEngineControl;
+        JackCycleTimings* fCycleTimings;
         char fSelfConnectMode;
         JackClientInterface* fClientTable[CLIENT_NUM];
         JackSynchro* fSynchroTable;
@@ -76,8 +78,10 @@ class SERVER_EXPORT JackEngine : public JackLockAble
 
         int AllocateRefnum();
         void ReleaseRefnum(int refnum);
+        void SetClient(int refnum, JackClientInterface* client);
 
         int ClientNotify(JackClientInterface* client, int refnum, const char* name, int notify, int sync, const char* message, int value1, int value2);
+        int ClientNotifyResults(JackExternalClient** clients, jack_time_t* post_times, int count, int notify);
         
         void NotifyClient(int refnum, int event, int sync, const char*  message, int value1, int value2);
         void NotifyClients(int event, int sync, const char*  message,  int value1, int value2);
@@ -87,6 +91,8 @@ class SERVER_EXPORT JackEngine : public JackLockAble
         void NotifyPortRename(jack_port_id_t src, const char* old_name);
         void NotifyActivate(int refnum);
 
+        void ComputeClientLatency(int refnum, int status);
+
         int GetNewUUID();
         void EnsureUUID(int uuid);
 
@@ -99,7 +105,7 @@ class SERVER_EXPORT JackEngine : public JackLockAble
 
     public:
 
-        JackEngine(JackGraphManager* manager, JackSynchro* table, JackEngineControl* controler, char self_connect_mode);
+        JackEngine(JackGraphManager* manager, JackSynchro* table, JackEngineControl* controler, JackCycleTimings* timings, char self_connect_mode);
         ~JackEngine();
 
         int Open();
@@ -132,6 +138,7 @@ class SERVER_EXPORT JackEngine : public JackLockAble
         int PortUnRegister(int refnum, jack_port_id_t port);
 
         int PortConnect(int refnum, const char* src, const char* dst);
+        int PortConnect(int refnum, const char* const* src, const char* const* dst, int count, int* results);
         int PortDisconnect(int refnum, const char* src, const char* dst);
 
         int PortConnect(int refnum, jack_port_id_t src, jack_port_id_t dst);
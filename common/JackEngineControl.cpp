@@ -42,14 +42,18 @@ void JackEngineControl::CalcCPULoad(JackClientInterface** table,
     fCurCycleTime = cur_cycle_begin;
     jack_time_t last_cycle_end = prev_cycle_end;
 
-    // In Asynchronous mode, last cycle end is the max of client end dates
-    if (!fSyncMode) {
-        for (int i = fDriverNum; i < CLIENT_NUM; i++) {
-            JackClientInterface* client = table[i];
+    JackFixedBitSet<CLIENT_NUM>::Iterator it(fUsedRefNum, fDriverNum);
+    for (int i = it.Next(); i >= 0; i = it.Next()) {
+        JackClientInterface* client = table[i];
+        if (client && client->GetClientControl()->fActive) {
             JackClientTiming* timing = manager->GetClientTiming(i);
-            if (client && client->GetClientControl()->fActive && timing->fStatus == Finished) {
+            // In Asynchronous mode, last cycle end is the max of client end dates
+            if (!fSyncMode && timing->fStatus == Finished) {
                 last_cycle_end = JACK_MAX(last_cycle_end, timing->fFinishedAt);
             }
+            if (fPrevCycleTime > 0) {
+                fClientLoad[i].Update(timing, fPrevCycleTime, cur_cycle_begin, fPeriodUsecs, fClientLoadReset);
+            }
         }
     }
 
@@ -97,6 +101,16 @@ void JackEngineControl::ResetRollingUsecs()
     fRollingInterval = int(floor((JACK_ENGINE_ROLLING_INTERVAL * 1000.f) / fPeriodUsecs));
 }
 
+JackClientLoad* JackEngineControl::GetClientLoad(const char* name)
+{
+    for (int i = fUsedRefNum.Next(fDriverNum); i >= 0; i = fUsedRefNum.Next(i + 1)) {
+        if (strcmp(fClientLoad[i].fName, name) == 0) {
+            return &fClientLoad[i];
+        }
+    }
+    return NULL;
+}
+
 void JackEngineControl::NotifyXRun(jack_time_t callback_usecs, float delayed_usecs)
 {
     ResetFrameTime(callback_usecs);  
@@ -24,7 +24,9 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 #include "JackShmMem.h"
 #include "JackFrameTimer.h"
 #include "JackTransportEngine.h"
+#include "JackClientLoad.h"
 #include "JackConstants.h"
+#include "JackBitSet.h"
 #include "types.h"
 #include <stdio.h>
 
@@ -88,11 +90,22 @@ struct SERVER_EXPORT JackEngineControl : public JackShmMem
     // Timer
     JackFrameTimer fFrameTimer;
 
+    // Clients (kept after the atomic states : moving them may make a CAS operand cross a cache line)
+    int fClientMax;
+    MEM_ALIGN(JackFixedBitSet<CLIENT_NUM> fUsedRefNum, 4);  // Refnum of opened clients and drivers: per cycle loops only visit them
+
+    // Shared memory index of the cycle timings (JackCycleTimings)
+    int fCycleTimingsIndex;
+
+    // Per client load, indexed by refnum
+    JackClientLoad fClientLoad[CLIENT_NUM];
+    UInt32 fClientLoadReset;    // Incremented by clients to reset max values, taken into account by the server
+
 #ifdef JACK_MONITOR
     JackEngineProfiling fProfiler;
 #endif
 
-    JackEngineControl(bool sync, bool temporary, long timeout, bool rt, long priority, bool verbose, jack_timer_type_t clock, const char* server_name)
+    JackEngineControl(bool sync, bool temporary, long timeout, bool rt, long priority, int client_max, bool verbose, jack_timer_type_t clock, const char* server_name)
     {
         fBufferSize = 512;
         fSampleRate = 48000;
@@ -121,6 +134,9 @@ struct SERVER_EXPORT JackEngineControl : public JackShmMem
         fXrunDelayedUsecs = 0.f;
         fClockSource = clock;
         fDriverNum = 0;
+        fClientMax = client_max;
+        fCycleTimingsIndex = -1;
+        fClientLoadReset = 0;
     }
 
     ~JackEngineControl()
@@ -178,6 +194,13 @@ struct SERVER_EXPORT JackEngineControl : public JackShmMem
         fMaxDelayedUsecs = 0.f;
     }
 
+    // Client load
+    JackClientLoad* GetClientLoad(const char* name);
+    void ResetClientLoads()
+    {
+        fClientLoadReset++;
+    }
+
     // Private
     void CalcCPULoad(JackClientInterface** table, JackGraphManager* manager, jack_time_t cur_cycle_begin, jack_time_t prev_cycle_end);
     void ResetRollingUsecs();
@@ -67,11 +67,11 @@ JackEngineProfiling::~JackEngineProfiling()
                 int ref = fIntervalTable[j].fRefNum;
 
                 // Is valid client cycle
-                if (fProfileTable[i].fClientTable[ref].fStatus != NotTriggered) {
+                if (fProfileTable[i].fClientTable[j].fStatus != NotTriggered) {
 
-                    long d5 = long(fProfileTable[i].fClientTable[ref].fSignaledAt - fProfileTable[i - 1].fCurCycleBegin);
-                    long d6 = long(fProfileTable[i].fClientTable[ref].fAwakeAt - fProfileTable[i - 1].fCurCycleBegin);
-                    long d7 = long(fProfileTable[i].fClientTable[ref].fFinishedAt - fProfileTable[i - 1].fCurCycleBegin);
+                    long d5 = long(fProfileTable[i].fClientTable[j].fSignaledAt - fProfileTable[i - 1].fCurCycleBegin);
+                    long d6 = long(fProfileTable[i].fClientTable[j].fAwakeAt - fProfileTable[i - 1].fCurCycleBegin);
+                    long d7 = long(fProfileTable[i].fClientTable[j].fFinishedAt - fProfileTable[i - 1].fCurCycleBegin);
 
                      fStream << ref << "\t" ;
                      fStream << ((d5 > 0) ? d5 : 0) << "\t";
@@ -79,10 +79,11 @@ JackEngineProfiling::~JackEngineProfiling()
                      fStream << ((d7 > 0) ? d7 : 0) << "\t";
                      fStream << ((d6 > 0 && d5 > 0) ? (d6 - d5) : 0) << "\t" ;
                      fStream << ((d7 > 0 && d6 > 0) ? (d7 - d6) : 0) << "\t" ;
-                     fStream << fProfileTable[i].fClientTable[ref].fStatus << "\t" ;;
+                     fStream << fProfileTable[i].fClientTable[j].fStatus << "\t" ;;
+                     fStream << fProfileTable[i].fClientTable[j].fMixdownTime << "\t";
 
                 } else { // Print tabs
-                     fStream <<  "\t  \t  \t  \t  \t  \t \t";
+                     fStream <<  "\t  \t  \t  \t  \t  \t \t  \t";
                 }
             }
 
@@ -157,17 +158,17 @@ JackEngineProfiling::~JackEngineProfiling()
                 if (i == 0) {
                     if (i + 1 == fMeasuredClient) { // Last client
                         fStream3 << "\"JackEngineProfiling.log\" using 1 title \"Audio period\" with lines,\"JackEngineProfiling.log\" using ";
-                        fStream3 <<  ((i + 1) * 7) - 1;
+                        fStream3 <<  ((i + 1) * 8) - 2;
                         fStream3 << " title \"" << fIntervalTable[i].fName << "\"with lines";
                      } else {
                         fStream3 << "\"JackEngineProfiling.log\" using 1 title \"Audio period\" with lines,\"JackEngineProfiling.log\" using ";
-                        fStream3 <<  ((i + 1) * 7) - 1;
+                        fStream3 <<  ((i + 1) * 8) - 2;
                         fStream3 << " title \"" << fIntervalTable[i].fName << "\"with lines,";
                     }
                 } else if (i + 1 == fMeasuredClient) { // Last client
-                    fStream3 << "\"JackEngineProfiling.log\" using " << ((i + 1) * 7) - 1  << " title \"" << fIntervalTable[i].fName << "\" with lines";
+                    fStream3 << "\"JackEngineProfiling.log\" using " << ((i + 1) * 8) - 2  << " title \"" << fIntervalTable[i].fName << "\" with lines";
                 } else {
-                    fStream3 << "\"JackEngineProfiling.log\" using " << ((i + 1) * 7) - 1  << " title \"" << fIntervalTable[i].fName << "\" with lines,";
+                    fStream3 << "\"JackEngineProfiling.log\" using " << ((i + 1) * 8) - 2  << " title \"" << fIntervalTable[i].fName << "\" with lines,";
                 }
             }
 
@@ -185,17 +186,17 @@ JackEngineProfiling::~JackEngineProfiling()
                 if (i == 0) {
                     if ((i + 1) == fMeasuredClient) { // Last client
                         fStream3 << "\"JackEngineProfiling.log\" using 1 title \"Audio period\" with lines,\"JackEngineProfiling.log\" using ";
-                        fStream3 <<  ((i + 1) * 7) - 1;
+                        fStream3 <<  ((i + 1) * 8) - 2;
                         fStream3 << " title \"" << fIntervalTable[i].fName << "\"with lines";
                     } else {
                         fStream3 << "\"JackEngineProfiling.log\" using 1 title \"Audio period\" with lines,\"JackEngineProfiling.log\" using ";
-                        fStream3 <<  ((i + 1) * 7) - 1;
+                        fStream3 <<  ((i + 1) * 8) - 2;
                         fStream3 << " title \"" << fIntervalTable[i].fName << "\"with lines,";
                     }
                 } else if ((i + 1) == fMeasuredClient) { // Last client
-                    fStream3 << "\"JackEngineProfiling.log\" using " << ((i + 1) * 7) - 1  << " title \"" << fIntervalTable[i].fName << "\" with lines";
+                    fStream3 << "\"JackEngineProfiling.log\" using " << ((i + 1) * 8) - 2  << " title \"" << fIntervalTable[i].fName << "\" with lines";
                 } else {
-                    fStream3 << "\"JackEngineProfiling.log\" using " << ((i + 1) * 7) - 1  << " title \"" << fIntervalTable[i].fName << "\" with lines,";
+                    fStream3 << "\"JackEngineProfiling.log\" using " << ((i + 1) * 8) - 2  << " title \"" << fIntervalTable[i].fName << "\" with lines,";
                 }
             }
             fStream3 << "\nunset multiplot\n";
@@ -219,9 +220,9 @@ JackEngineProfiling::~JackEngineProfiling()
             fStream4 << "plot ";
             for (unsigned int i = 0; i < fMeasuredClient; i++) {
                 if ((i + 1) == fMeasuredClient) { // Last client
-                    fStream4 << "\"JackEngineProfiling.log\" using " << ((i + 1) * 7)  << " title \"" << fIntervalTable[i].fName << "\" with lines";
+                    fStream4 << "\"JackEngineProfiling.log\" using " << ((i + 1) * 8) - 1  << " title \"" << fIntervalTable[i].fName << "\" with lines";
                  } else {
-                     fStream4 << "\"JackEngineProfiling.log\" using " << ((i + 1) * 7)  << " title \"" << fIntervalTable[i].fName << "\" with lines,";
+                     fStream4 << "\"JackEngineProfiling.log\" using " << ((i + 1) * 8) - 1  << " title \"" << fIntervalTable[i].fName << "\" with lines,";
                 }
             }
 
@@ -237,9 +238,9 @@ JackEngineProfiling::~JackEngineProfiling()
             fStream4 << "plot ";
             for (unsigned int i = 0; i < fMeasuredClient; i++) {
                 if ((i + 1) == fMeasuredClient) { // Last client
-                    fStream4 << "\"JackEngineProfiling.log\" using " << ((i + 1) * 7)  << " title \"" << fIntervalTable[i].fName << "\" with lines";
+                    fStream4 << "\"JackEngineProfiling.log\" using " << ((i + 1) * 8) - 1  << " title \"" << fIntervalTable[i].fName << "\" with lines";
                 } else {
-                     fStream4 << "\"JackEngineProfiling.log\" using " << ((i + 1) * 7)  << " title \"" << fIntervalTable[i].fName << "\" with lines,";
+                     fStream4 << "\"JackEngineProfiling.log\" using " << ((i + 1) * 8) - 1  << " title \"" << fIntervalTable[i].fName << "\" with lines,";
                 }
             }
             fStream4 << "\nunset multiplot\n";
@@ -263,9 +264,9 @@ JackEngineProfiling::~JackEngineProfiling()
             fStream5 << "plot ";
             for (unsigned int i = 0; i < fMeasuredClient; i++) {
                 if ((i + 1) == fMeasuredClient) { // Last client
-                    fStream5 << "\"JackEngineProfiling.log\" using " << ((i + 1) * 7) + 1  << " title \"" << fIntervalTable[i].fName << "\" with lines";
+                    fStream5 << "\"JackEngineProfiling.log\" using " << ((i + 1) * 8)  << " title \"" << fIntervalTable[i].fName << "\" with lines";
                 } else {
-                    fStream5 << "\"JackEngineProfiling.log\" using " << ((i + 1) * 7) + 1  << " title \"" << fIntervalTable[i].fName << "\" with lines,";
+                    fStream5 << "\"JackEngineProfiling.log\" using " << ((i + 1) * 8)  << " title \"" << fIntervalTable[i].fName << "\" with lines,";
                 }
             }
 
@@ -281,9 +282,9 @@ JackEngineProfiling::~JackEngineProfiling()
             fStream5 << "plot ";
             for (unsigned int i = 0; i < fMeasuredClient; i++) {
                 if ((i + 1) == fMeasuredClient) {// Last client
-                    fStream5 << "\"JackEngineProfiling.log\" using " << ((i + 1) * 7) + 1  << " title \"" << fIntervalTable[i].fName << "\" with lines";
+                    fStream5 << "\"JackEngineProfiling.log\" using " << ((i + 1) * 8)  << " title \"" << fIntervalTable[i].fName << "\" with lines";
                 } else {
-                    fStream5 << "\"JackEngineProfiling.log\" using " << ((i + 1) * 7) + 1  << " title \"" << fIntervalTable[i].fName << "\" with lines,";
+                    fStream5 << "\"JackEngineProfiling.log\" using " << ((i + 1) * 8)  << " title \"" << fIntervalTable[i].fName << "\" with lines,";
                 }
             }
             fStream5 << "\nunset multiplot\n";
@@ -329,15 +330,15 @@ JackEngineProfiling::~JackEngineProfiling()
     }
 }
 
-bool JackEngineProfiling::CheckClient(const char* name, int cur_point)
+int JackEngineProfiling::CheckClient(const char* name, int cur_point)
 {
-    for (int i = 0; i < MEASURED_CLIENTS; i++) {
+    for (unsigned int i = 0; i < fMeasuredClient; i++) {
        if (strcmp(fIntervalTable[i].fName, name) == 0) {
             fIntervalTable[i].fEndInterval = cur_point;
-            return true;
+            return i;
         }
     }
-    return false;
+    return -1;
 }
 
 void JackEngineProfiling::Profile(JackClientInterface** table,
@@ -359,19 +360,24 @@ void JackEngineProfiling::Profile(JackClientInterface** table,
         JackClientTiming* timing = manager->GetClientTiming(i);
         if (client && client->GetClientControl()->fActive && client->GetClientControl()->fCallback[kRealTimeCallback]) {
 
-            if (!CheckClient(client->GetClientControl()->fName, fAudioCycle)) {
+            int measured = CheckClient(client->GetClientControl()->fName, fAudioCycle);
+            if (measured < 0) {
+                if (fMeasuredClient == MEASURED_CLIENTS) {
+                    continue; // Only the first MEASURED_CLIENTS clients are measured
+                }
                 // Keep new measured client
-                fIntervalTable[fMeasuredClient].fRefNum = i;
-                strcpy(fIntervalTable[fMeasuredClient].fName, client->GetClientControl()->fName);
-                fIntervalTable[fMeasuredClient].fBeginInterval = fAudioCycle;
-                fIntervalTable[fMeasuredClient].fEndInterval = fAudioCycle;
-                fMeasuredClient++;
+                measured = fMeasuredClient++;
+                fIntervalTable[measured].fRefNum = i;
+                strcpy(fIntervalTable[measured].fName, client->GetClientControl()->fName);
+                fIntervalTable[measured].fBeginInterval = fAudioCycle;
+                fIntervalTable[measured].fEndInterval = fAudioCycle;
             }
-            fProfileTable[fAudioCycle].fClientTable[i].fRefNum = i;
-            fProfileTable[fAudioCycle].fClientTable[i].fSignaledAt = timing->fSignaledAt;
-            fProfileTable[fAudioCycle].fClientTable[i].fAwakeAt = timing->fAwakeAt;
-            fProfileTable[fAudioCycle].fClientTable[i].fFinishedAt = timing->fFinishedAt;
-            fProfileTable[fAudioCycle].fClientTable[i].fStatus = timing->fStatus;
+            fProfileTable[fAudioCycle].fClientTable[measured].fRefNum = i;
+            fProfileTable[fAudioCycle].fClientTable[measured].fSignaledAt = timing->fSignaledAt;
+            fProfileTable[fAudioCycle].fClientTable[measured].fAwakeAt = timing->fAwakeAt;
+            fProfileTable[fAudioCycle].fClientTable[measured].fFinishedAt = timing->fFinishedAt;
+            fProfileTable[fAudioCycle].fClientTable[measured].fStatus = timing->fStatus;
+            fProfileTable[fAudioCycle].fClientTable[measured].fMixdownTime = timing->fMixdownTime;
         }
     }
 }
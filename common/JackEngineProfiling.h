@@ -45,13 +45,15 @@ struct JackTimingMeasureClient
     jack_time_t	fAwakeAt;
     jack_time_t	fFinishedAt;
     jack_client_state_t fStatus;
+    jack_time_t	fMixdownTime;
     
     JackTimingMeasureClient() 
         :fRefNum(-1),
         fSignaledAt(0),
         fAwakeAt(0),
         fFinishedAt(0),
-        fStatus((jack_client_state_t)0)
+        fStatus((jack_client_state_t)0),
+        fMixdownTime(0)
     {}
     
 } POST_PACKED_STRUCTURE;
@@ -87,7 +89,7 @@ struct JackTimingMeasure
     jack_time_t fPeriodUsecs;
     jack_time_t fCurCycleBegin;
     jack_time_t fPrevCycleEnd;
-    JackTimingMeasureClient fClientTable[CLIENT_NUM];
+    JackTimingMeasureClient fClientTable[MEASURED_CLIENTS];   // Indexed like the interval table, so that the size does not depend of CLIENT_NUM
     
     JackTimingMeasure()
         :fAudioCycle(0), 
@@ -117,7 +119,7 @@ class SERVER_EXPORT JackEngineProfiling
         unsigned int fAudioCycle;
         unsigned int fMeasuredClient;
         
-        bool CheckClient(const char* name, int cur_point);
+        int CheckClient(const char* name, int cur_point);
         
     public:
     
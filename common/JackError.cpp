@@ -63,6 +63,14 @@ static void jack_format_and_log(int level, const char *prefix, const char *fmt,
     size_t len;
     jack_log_function_t log_function;
 
+    log_function = (jack_log_function_t)jack_tls_get(JackGlobals::fKeyLogFunction);
+
+    /* RT threads : formatting is deferred to the message buffer thread */
+    if (log_function == JackMessageBufferAdd) {
+        JackMessageBufferAddFormat(level, prefix, fmt, ap);
+        return;
+    }
+
     if (prefix != NULL) {
         len = strlen(prefix);
         assert(len < 256);
@@ -73,8 +81,6 @@ static void jack_format_and_log(int level, const char *prefix, const char *fmt,
 
     vsnprintf(buffer + len, sizeof(buffer) - len, fmt, ap);
 
-    log_function = (jack_log_function_t)jack_tls_get(JackGlobals::fKeyLogFunction);
-
     /* if log function is not overriden for thread, use default one */
     if (log_function == NULL)
     {
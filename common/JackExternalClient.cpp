@@ -41,6 +41,12 @@ int JackExternalClient::ClientNotify(int refnum, const char* name, int notify, i
     return result;
 }
 
+int JackExternalClient::ClientNotifyPost(int refnum, const char* name, int notify, const char* message, int value1, int value2)
+{
+    jack_log("JackExternalClient::ClientNotifyPost ref = %ld client = %s name = %s notify = %ld", refnum, fClientControl->fName, name, notify);
+    return fChannel.ClientNotifyPost(refnum, name, notify, message, value1, value2);
+}
+
 int JackExternalClient::Open(const char* name, int pid, int refnum, int uuid, int* shared_client)
 {
     try {
@@ -51,6 +51,14 @@ class JackExternalClient : public JackClientInterface
 
         int ClientNotify(int refnum, const char* name, int notify, int sync, const char* message, int value1, int value2);
 
+        // Synchronous notification in two steps, so that several clients can be notified at once
+        int ClientNotifyPost(int refnum, const char* name, int notify, const char* message, int value1, int value2);
+
+        JackNotifyChannel* GetNotifyChannel()
+        {
+            return &fChannel;
+        }
+
         JackClientControl* GetClientControl() const;
 };
 
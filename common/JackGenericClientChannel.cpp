@@ -44,6 +44,14 @@ int JackGenericClientChannel::ServerCheck(const char* server_name)
     }
 }
 
+int JackGenericClientChannel::WriteRequest(JackRequest* req)
+{
+    // The request is serialized in memory, then sent with a single write
+    JackRequestBuffer buffer;
+    CheckRes(req->Write(&buffer));
+    return buffer.Flush(fRequest);
+}
+
 void JackGenericClientChannel::ServerSyncCall(JackRequest* req, JackResult* res, int* result)
 {
     // Check call context
@@ -59,7 +67,7 @@ void JackGenericClientChannel::ServerSyncCall(JackRequest* req, JackResult* res,
         return;
     }
     
-    if (req->Write(fRequest) < 0) {
+    if (WriteRequest(req) < 0) {
         jack_error("Could not write request type = %ld", req->fType);
         *result = -1;
         return;
@@ -89,7 +97,7 @@ void JackGenericClientChannel::ServerAsyncCall(JackRequest* req, JackResult* res
         return;
     }
     
-    if (req->Write(fRequest) < 0) {
+    if (WriteRequest(req) < 0) {
         jack_error("Could not write request type = %ld", req->fType);
         *result = -1;
     } else {
@@ -166,6 +174,30 @@ void JackGenericClientChannel::PortDisconnect(int refnum, const char* src, const
     ServerSyncCall(&req, &res, result);
 }
 
+void JackGenericClientChannel::PortConnect(int refnum, const char* const* src, const char* const* dst, int count, int* results, int* result)
+{
+    *result = 0;
+
+    // Connections are sent by lists of CONNECTION_LIST_SIZE
+    for (int i = 0; i < count; i += CONNECTION_LIST_SIZE) {
+        int list_count = (count - i < CONNECTION_LIST_SIZE) ? count - i : CONNECTION_LIST_SIZE;
+        int list_result = -1;
+        JackPortConnectNameListRequest req(refnum, src + i, dst + i, list_count);
+        JackPortConnectNameListResult res;
+        ServerSyncCall(&req, &res, &list_result);
+        if (res.fCount == list_count) {
+            memcpy(results + i, res.fResults, list_count * sizeof(int));
+        } else {
+            for (int j = 0; j < list_count; j++) {
+                results[i + j] = -1;
+            }
+        }
+        if (list_result != 0) {
+            *result = -1;
+        }
+    }
+}
+
 void JackGenericClientChannel::PortConnect(int refnum, jack_port_id_t src, jack_port_id_t dst, int* result)
 {
     JackPortConnectRequest req(refnum, src, dst);
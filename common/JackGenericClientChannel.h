@@ -39,8 +39,9 @@ class JackGenericClientChannel : public detail::JackClientChannelInterface
 
         detail::JackClientRequestInterface* fRequest;
 
-        void ServerSyncCall(JackRequest* req, JackResult* res, int* result);
-        void ServerAsyncCall(JackRequest* req, JackResult* res, int* result);
+        int WriteRequest(JackRequest* req);
+        virtual void ServerSyncCall(JackRequest* req, JackResult* res, int* result);
+        virtual void ServerAsyncCall(JackRequest* req, JackResult* res, int* result);
 
     public:
 
@@ -66,6 +67,7 @@ class JackGenericClientChannel : public detail::JackClientChannelInterface
         void PortUnRegister(int refnum, jack_port_id_t port_index, int* result);
 
         void PortConnect(int refnum, const char* src, const char* dst, int* result);
+        void PortConnect(int refnum, const char* const* src, const char* const* dst, int count, int* results, int* result);
         void PortDisconnect(int refnum, const char* src, const char* dst, int* result);
 
         void PortConnect(int refnum, jack_port_id_t src, jack_port_id_t dst, int* result);
@@ -23,6 +23,7 @@ namespace Jack
 {
 
 bool JackGlobals::fVerbose = 0;
+jack_synchro_type_t JackGlobals::fSynchroType = JACK_SYNCHRO_SEMAPHORE;
 
 jack_tls_key JackGlobals::fRealTimeThread;
 static bool gKeyRealtimeThreadInitialized = jack_tls_allocate_key(&JackGlobals::fRealTimeThread);
@@ -37,6 +38,7 @@ JackMutex* JackGlobals::fOpenMutex = new JackMutex();
 JackMutex* JackGlobals::fSynchroMutex = new JackMutex();
 volatile bool JackGlobals::fServerRunning = false;
 JackClient* JackGlobals::fClientTable[CLIENT_NUM] = {};
+JackActivationDispatcher* JackGlobals::fActivationDispatcher = NULL;
 
 #ifndef WIN32
 jack_thread_creator_t JackGlobals::fJackThreadCreator = pthread_create;
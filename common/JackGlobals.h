@@ -34,6 +34,9 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 namespace Jack
 {
 
+class JackActivationDispatcher;
+class JackCycleTimings;
+
 // Globals used for client management on server or library side.
 struct JackGlobals {
 
@@ -44,7 +47,9 @@ struct JackGlobals {
     static JackMutex* fSynchroMutex;
     static volatile bool fServerRunning;
     static JackClient* fClientTable[CLIENT_NUM];
+    static JackActivationDispatcher* fActivationDispatcher;   // Server side only, when internal clients are run by the graph executor
     static bool fVerbose;
+    static jack_synchro_type_t fSynchroType;   // Server side only, kind of synchro allocated for the clients
 #ifndef WIN32
     static jack_thread_creator_t fJackThreadCreator;
 #endif
@@ -59,6 +64,7 @@ struct JackGlobals {
 extern SERVER_EXPORT JackGraphManager* GetGraphManager();
 extern SERVER_EXPORT JackEngineControl* GetEngineControl();
 extern SERVER_EXPORT JackSynchro* GetSynchroTable();
+extern SERVER_EXPORT JackCycleTimings* GetCycleTimings();
 
 } // end of namespace
 
@@ -0,0 +1,320 @@
+/*
+Copyright (C) 2026 agent
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+#include "JackSystemDeps.h"
+#include "JackGraphExecutor.h"
+#include "JackClient.h"
+#include "JackClientControl.h"
+#include "JackEngineControl.h"
+#include "JackGlobals.h"
+#include "JackAtomic.h"
+#include "JackError.h"
+#include "JackTime.h"
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+namespace Jack
+{
+
+static int GetCPUCount()
+{
+#if defined(__linux__)
+    long cpu_count = sysconf(_SC_NPROCESSORS_ONLN);
+    return (cpu_count > 0) ? int(cpu_count) : 1;
+#else
+    return 0;   // Unknown
+#endif
+}
+
+// Full barrier store, so that a following read cannot be done before the store
+static inline void WriteAtomic(volatile SInt32* val, SInt32 value)
+{
+    SInt32 actual;
+    do {
+        actual = *val;
+    } while (!CAS(actual, value, val));
+}
+
+JackGraphWorker::JackGraphWorker(JackGraphExecutor* executor, int index)
+    :fSleeping(0), fRunning(EMPTY), fIdleDate(0), fIndex(index), fExecutor(executor), fThread(this)
+{}
+
+bool JackGraphWorker::Init()
+{
+    JackEngineControl* control = fExecutor->fEngineControl;
+
+    if (!jack_tls_set(fExecutor->fWorkerKey, this)) {
+        jack_error("JackGraphWorker::Init : failed to set thread key");
+    }
+
+#if defined(__linux__)
+    // Pin the worker, so that the clients it runs keep their data in the same cache
+    int cpu_count = GetCPUCount();
+    if (cpu_count > 1) {
+        cpu_set_t cpu_set;
+        CPU_ZERO(&cpu_set);
+        CPU_SET(fIndex % cpu_count, &cpu_set);
+        int res = pthread_setaffinity_np(pthread_self(), sizeof(cpu_set), &cpu_set);
+        if (res != 0) {
+            jack_error("JackGraphWorker::Init : cannot pin worker %d err = %s", fIndex, strerror(res));
+        }
+    }
+#endif
+
+    if (control->fRealTime) {
+        set_threaded_log_function();
+        fThread.SetParams(control->fPeriod, control->fComputation, control->fConstraint);
+        if (fThread.AcquireSelfRealTime(control->fClientPriority) < 0) {
+            jack_error("JackGraphWorker::AcquireSelfRealTime error");
+        }
+    }
+
+    jack_log("JackGraphWorker::Init worker = %d", fIndex);
+    return true;
+}
+
+bool JackGraphWorker::Execute()
+{
+    int refnum = fExecutor->Take(fIndex);
+
+    if (refnum >= 0) {
+        fExecutor->Run(this, refnum);
+        fIdleDate = 0;
+    } else if (fExecutor->fSpin == 0) {
+        Sleep();
+    } else if (fIdleDate == 0) {
+        fIdleDate = GetMicroSeconds();
+    } else if (GetMicroSeconds() - fIdleDate > fExecutor->fSpin) {
+        Sleep();
+        fIdleDate = 0;
+    }
+
+    return !fExecutor->fStopping;
+}
+
+void JackGraphWorker::Sleep()
+{
+    WriteAtomic(&fSleeping, 1);
+
+    // A client may have been activated before fSleeping was set
+    if (fExecutor->HasReady() && CAS(1, 0, &fSleeping)) {
+        return;
+    }
+
+    fSignal.Lock();
+    while (fSleeping && !fExecutor->fStopping) {
+        fSignal.Wait();
+    }
+    fSignal.Unlock();
+}
+
+JackGraphExecutor::JackGraphExecutor(int worker_count, int spin, JackSynchro* table, JackEngineControl* control)
+    :fWorkerCount(worker_count), fStopping(false), fRemoving(EMPTY), fSynchroTable(table), fEngineControl(control)
+{
+    int cpu_count = GetCPUCount();
+
+    // More workers than CPU would only compete for them, and spinning is useless on a single CPU
+    if (cpu_count > 0 && fWorkerCount > cpu_count) {
+        jack_info("Graph workers limited to the %d available CPU", cpu_count);
+        fWorkerCount = cpu_count;
+    }
+    fSpin = (cpu_count == 1 || spin < 0) ? 0 : spin;
+
+    jack_tls_allocate_key(&fWorkerKey);
+
+    for (int i = 0; i < CLIENT_NUM; i++) {
+        fEnabled[i] = 0;
+        fClientTable[i] = NULL;
+    }
+
+    fWorker = new JackGraphWorker*[fWorkerCount];
+    for (int i = 0; i < fWorkerCount; i++) {
+        fWorker[i] = new JackGraphWorker(this, i);
+    }
+}
+
+JackGraphExecutor::~JackGraphExecutor()
+{
+    for (int i = 0; i < fWorkerCount; i++) {
+        delete fWorker[i];
+    }
+    delete [] fWorker;
+    jack_tls_free_key(fWorkerKey);
+}
+
+int JackGraphExecutor::Start()
+{
+    jack_log("JackGraphExecutor::Start workers = %d", fWorkerCount);
+    fStopping = false;
+
+    for (int i = 0; i < fWorkerCount; i++) {
+        if (fWorker[i]->fThread.StartSync() < 0) {
+            jack_error("Cannot start graph worker %d", i);
+            Stop();
+            return -1;
+        }
+    }
+
+    JackGlobals::fActivationDispatcher = this;
+    return 0;
+}
+
+int JackGraphExecutor::Stop()
+{
+    jack_log("JackGraphExecutor::Stop");
+    JackGlobals::fActivationDispatcher = NULL;
+    fStopping = true;
+
+    for (int i = 0; i < fWorkerCount; i++) {
+        fWorker[i]->fSignal.LockedSignal();
+        fWorker[i]->fThread.Stop();
+    }
+    return 0;
+}
+
+void JackGraphExecutor::AddClient(JackClient* client)
+{
+    int refnum = client->GetClientControl()->fRefNum;
+    jack_log("JackGraphExecutor::AddClient ref = %ld", refnum);
+
+    fClientTable[refnum] = client;
+    WriteAtomic(&fEnabled[refnum], 1);
+    fDispatchedRef.Set(refnum);
+}
+
+void JackGraphExecutor::RemoveClient(JackClient* client)
+{
+    int refnum = client->GetClientControl()->fRefNum;
+    if (fClientTable[refnum] != client) {
+        return;
+    }
+    jack_log("JackGraphExecutor::RemoveClient ref = %ld", refnum);
+
+    fDispatchedRef.Reset(refnum);
+    WriteAtomic(&fEnabled[refnum], 0);
+
+    // Wait for a worker that may still run the client, it signals fDrained when done
+    fDrained.Lock();
+    WriteAtomic(&fRemoving, refnum);
+    for (int i = 0; i < fWorkerCount; i++) {
+        while (fWorker[i]->fRunning == refnum) {
+            fDrained.Wait();
+        }
+    }
+    WriteAtomic(&fRemoving, EMPTY);
+    fDrained.Unlock();
+
+    fClientTable[refnum] = NULL;
+}
+
+/*!
+\brief Take a refnum in the ready set of the worker, or steal one in the ready set of the other workers.
+*/
+int JackGraphExecutor::Take(int index)
+{
+    for (int i = 0; i < fWorkerCount; i++) {
+        int refnum = fWorker[(index + i) % fWorkerCount]->fReady.TakeFirst();
+        if (refnum >= 0) {
+            return refnum;
+        }
+    }
+    return -1;
+}
+
+bool JackGraphExecutor::HasReady()
+{
+    for (int i = 0; i < fWorkerCount; i++) {
+        if (fWorker[i]->fReady.Next(0) >= 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void JackGraphExecutor::Run(JackGraphWorker* worker, int refnum)
+{
+    WriteAtomic(&worker->fRunning, refnum);
+
+    if (fEnabled[refnum]) {
+        if (!fClientTable[refnum]->ExecuteCycle()) {
+            // Next cycles are given to the client thread, that will deactivate the client
+            jack_error("JackGraphExecutor::Run : process callback of ref = %ld failed", refnum);
+            WriteAtomic(&fEnabled[refnum], 0);
+        }
+    } else {
+        // Client removed after being activated : its own thread runs the cycle
+        fSynchroTable[refnum].Signal();
+    }
+
+    WriteAtomic(&worker->fRunning, EMPTY);
+
+    // Only taken when the client is being removed
+    if (fRemoving == refnum) {
+        fDrained.LockedSignal();
+    }
+}
+
+bool JackGraphExecutor::Wake(int index)
+{
+    JackGraphWorker* worker = fWorker[index];
+
+    if (worker->fSleeping && CAS(1, 0, &worker->fSleeping)) {
+        worker->fSignal.LockedSignal();
+        return true;
+    } else {
+        return false;
+    }
+}
+
+void JackGraphExecutor::WakeOther(int index)
+{
+    for (int i = 1; i < fWorkerCount; i++) {
+        if (Wake((index + i) % fWorkerCount)) {
+            return;
+        }
+    }
+}
+
+/*!
+\brief Called in RT by the thread that activated the client : the driver, an internal client run by a worker, or any other client thread of the server process.
+*/
+void JackGraphExecutor::Activate(int refnum)
+{
+    JackGraphWorker* worker = static_cast<JackGraphWorker*>(jack_tls_get(fWorkerKey));
+
+    if (worker) {
+        // The worker runs it after the current client, another one is woken up if there is more than one to run
+        worker->fReady.SetAtomic(refnum);
+        if (worker->fReady.GetCount() > 1) {
+            WakeOther(worker->fIndex);
+        }
+    } else {
+        int index = refnum % fWorkerCount;
+        fWorker[index]->fReady.SetAtomic(refnum);
+        if (!Wake(index)) {
+            WakeOther(index);
+        }
+    }
+}
+
+} // end of namespace
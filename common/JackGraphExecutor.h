@@ -0,0 +1,122 @@
+/*
+Copyright (C) 2026 agent
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+#ifndef __JackGraphExecutor__
+#define __JackGraphExecutor__
+
+#include "JackConnectionManager.h"
+#include "JackBitSet.h"
+#include "JackPlatformPlug.h"
+#include "JackThread.h"
+
+namespace Jack
+{
+
+class JackClient;
+class JackGraphExecutor;
+struct JackEngineControl;
+
+/*!
+\brief A RT thread of the graph executor, pinned on a CPU.
+*/
+
+class JackGraphWorker : public JackRunnableInterface
+{
+
+    friend class JackGraphExecutor;
+
+    private:
+
+        JackFixedBitSet<CLIENT_NUM> fReady;     /*! Activated refnum : first member to keep the words aligned for the atomic operations */
+        volatile SInt32 fSleeping;              /*! 1 when the worker waits on fSignal */
+        volatile SInt32 fRunning;               /*! Refnum being executed by the worker, or EMPTY */
+        jack_time_t fIdleDate;
+        int fIndex;
+        JackGraphExecutor* fExecutor;
+        JackProcessSync fSignal;
+        JackThread fThread;
+
+        void Sleep();
+
+    public:
+
+        JackGraphWorker(JackGraphExecutor* executor, int index);
+        virtual ~JackGraphWorker()
+        {}
+
+        // JackRunnableInterface interface
+        bool Init();
+        bool Execute();
+
+};
+
+/*!
+\brief Executes internal clients on a pool of worker threads inside the server process.
+
+A client activated by the driver or by another internal client is added to the ready set of a worker instead of having
+its synchro signaled : the worker runs it and directly activates the next clients, a branch of the graph is then
+executed without any system call. Idle workers steal activated clients from the other workers, so independent
+branches run in parallel. Clients activated by an external client still have their synchro signaled and are
+run by their own thread.
+*/
+
+class SERVER_EXPORT JackGraphExecutor : public JackActivationDispatcher
+{
+
+    friend class JackGraphWorker;
+
+    private:
+
+        JackGraphWorker** fWorker;
+        int fWorkerCount;
+        jack_time_t fSpin;                      /*! Time spent by an idle worker looking for clients before sleeping, 0 to sleep at once */
+        volatile bool fStopping;
+        volatile SInt32 fRemoving;              /*! Refnum being removed, or EMPTY */
+        JackProcessSync fDrained;               /*! Signaled when a worker stops running the removed client */
+        volatile SInt32 fEnabled[CLIENT_NUM];   /*! 1 if the client can be run by a worker */
+        JackClient* fClientTable[CLIENT_NUM];
+        JackSynchro* fSynchroTable;
+        JackEngineControl* fEngineControl;
+        jack_tls_key fWorkerKey;                /*! The JackGraphWorker of the current thread */
+
+        int Take(int index);
+        bool HasReady();
+        void Run(JackGraphWorker* worker, int refnum);
+        bool Wake(int index);
+        void WakeOther(int index);
+
+    public:
+
+        JackGraphExecutor(int worker_count, int spin, JackSynchro* table, JackEngineControl* control);
+        virtual ~JackGraphExecutor();
+
+        int Start();
+        int Stop();
+
+        void AddClient(JackClient* client);
+        void RemoveClient(JackClient* client);
+
+        // JackActivationDispatcher interface
+        void Activate(int refnum);
+
+};
+
+} // end of namespace
+
+#endif
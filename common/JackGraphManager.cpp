@@ -20,6 +20,10 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 
 #include "JackGraphManager.h"
 #include "JackConstants.h"
+#include "JackGlobals.h"
+#include "JackEngineControl.h"
+#include "JackClientControl.h"
+#include "JackTime.h"
 #include "JackError.h"
 #include <assert.h>
 #include <stdlib.h>
@@ -54,6 +58,11 @@ JackGraphManager* JackGraphManager::Allocate(int port_max)
 
 void JackGraphManager::Destroy(JackGraphManager* manager)
 {
+    JackPortBufferPool* pool = manager->GetBufferPool();
+    if (pool) {
+        JackPortBufferPool::Destroy(pool);
+    }
+
     // "Placement" new was used
     manager->~JackGraphManager();
     JackShmMem::operator delete(manager);
@@ -68,6 +77,10 @@ JackGraphManager::JackGraphManager(int port_max)
     }
 
     fPortMax = port_max;
+    fBufferPoolIndex = -1;
+    fBufferPoolId = 0;
+    fCycle = 0;
+    fActivationMixdown = false;
 }
 
 JackPort* JackGraphManager::GetPort(jack_port_id_t port_index)
@@ -76,11 +89,6 @@ JackPort* JackGraphManager::GetPort(jack_port_id_t port_index)
     return &fPortArray[port_index];
 }
 
-jack_default_audio_sample_t* JackGraphManager::GetBuffer(jack_port_id_t port_index)
-{
-    return fPortArray[port_index].GetBuffer();
-}
-
 // Server
 void JackGraphManager::InitRefNum(int refnum)
 {
@@ -93,6 +101,7 @@ void JackGraphManager::InitRefNum(int refnum)
 void JackGraphManager::RunCurrentGraph()
 {
     JackConnectionManager* manager = ReadCurrentState();
+    fCycle++;
     manager->ResetGraph(fClientTiming);
 }
 
@@ -101,6 +110,7 @@ bool JackGraphManager::RunNextGraph()
 {
     bool res;
     JackConnectionManager* manager = TrySwitchState(&res);
+    fCycle++;
     manager->ResetGraph(fClientTiming);
     return res;
 }
@@ -116,14 +126,39 @@ bool JackGraphManager::IsFinishedGraph()
 int JackGraphManager::ResumeRefNum(JackClientControl* control, JackSynchro* table)
 {
     JackConnectionManager* manager = ReadCurrentState();
-    return manager->ResumeRefNum(control, table, fClientTiming);
+    return manager->ResumeRefNum(control, table, fClientTiming, JackGlobals::fActivationDispatcher);
+}
+
+/*!
+\brief Mix all the input ports of the client at the start of its own cycle, the time spent is charged to the client.
+*/
+// RT
+void JackGraphManager::MixInputs(int refnum)
+{
+    if (!fActivationMixdown) {
+        return;
+    }
+
+    const jack_int_t* ports = ReadCurrentState()->GetInputPorts(refnum);
+    jack_nframes_t buffer_size = GetEngineControl()->fBufferSize;
+    jack_time_t start = GetMicroSeconds();
+
+    for (int i = 0; (i < PORT_NUM_FOR_CLIENT) && (ports[i] != EMPTY); i++) {
+        GetBuffer(ports[i], buffer_size);
+    }
+
+    fClientTiming[refnum].fMixdownTime = GetMicroSeconds() - start;
 }
 
 // RT
 int JackGraphManager::SuspendRefNum(JackClientControl* control, JackSynchro* table, long usec)
 {
     JackConnectionManager* manager = ReadCurrentState();
-    return manager->SuspendRefNum(control, table, fClientTiming, usec);
+    int res = manager->SuspendRefNum(control, table, fClientTiming, usec);
+    if (res == 0) {
+        MixInputs(control->fRefNum);
+    }
+    return res;
 }
 
 void JackGraphManager::TopologicalSort(std::vector<jack_int_t>& sorted)
@@ -167,29 +202,48 @@ bool JackGraphManager::IsDirectConnection(int ref1, int ref2)
 // RT
 void* JackGraphManager::GetBuffer(jack_port_id_t port_index, jack_nframes_t buffer_size)
 {
-    AssertPort(port_index);
     AssertBufferSize(buffer_size);
 
-    JackConnectionManager* manager = ReadCurrentState();
+    JackPortBufferPool* pool = GetBufferPool();
+    if (!pool) {
+        jack_error("JackGraphManager::GetBuffer : port buffers are not mapped");
+        return NULL;
+    }
+
+    return GetBufferAux(ReadCurrentState(), pool, port_index, buffer_size);
+}
+
+// RT
+void* JackGraphManager::GetBufferAux(JackConnectionManager* manager, JackPortBufferPool* pool, jack_port_id_t port_index, jack_nframes_t buffer_size)
+{
+    AssertPort(port_index);
     JackPort* port = GetPort(port_index);
+    char* address = pool->GetAddress();
 
     // This happens when a port has just been unregistered and is still used by the RT code
     if (!port->IsUsed()) {
         jack_log("JackGraphManager::GetBuffer : port = %ld is released state", port_index);
-        return GetBuffer(0); // port_index 0 is not used
+        return address + pool->GetUnusedBuffer();
     }
 
     jack_int_t len = manager->Connections(port_index);
 
     // Output port
     if (port->fFlags & JackPortIsOutput) {
-        return (port->fTied != NO_PORT) ? GetBuffer(port->fTied, buffer_size) : GetBuffer(port_index);
+        return (port->fTied != NO_PORT) ? GetBufferAux(manager, pool, port->fTied, buffer_size) : port->GetBuffer(address);
+    }
+
+    // Input buffer already cleared or mixed in this cycle
+    UInt32 cycle = fCycle;
+    if (port->fMixCycle == cycle) {
+        return port->GetBuffer(address);
     }
 
     // No connections : return a zero-filled buffer
     if (len == 0) {
-        port->ClearBuffer(buffer_size);
-        return port->GetBuffer();
+        port->ClearBuffer(port->GetBuffer(address), buffer_size);
+        port->fMixCycle = cycle;
+        return port->GetBuffer(address);
 
     // One connection
     } else if (len == 1) {
@@ -198,29 +252,32 @@ void* JackGraphManager::GetBuffer(jack_port_id_t port_index, jack_nframes_t buff
         // Ports in same client : copy the buffer
         if (GetPort(src_index)->GetRefNum() == port->GetRefNum()) {
             void* buffers[1];
-            buffers[0] = GetBuffer(src_index, buffer_size);
-            port->MixBuffers(buffers, 1, buffer_size);
-            return port->GetBuffer();
+            buffers[0] = GetBufferAux(manager, pool, src_index, buffer_size);
+            port->MixBuffers(port->GetBuffer(address), buffers, 1, buffer_size);
+            port->fMixCycle = cycle;
+            return port->GetBuffer(address);
         // Otherwise, use zero-copy mode, just pass the buffer of the connected (output) port.
         } else {
-            return GetBuffer(src_index, buffer_size);
+            return GetBufferAux(manager, pool, src_index, buffer_size);
         }
 
     // Multiple connections : mix all buffers
     } else {
 
-        const jack_int_t* connections = manager->GetConnections(port_index);
+        jack_int_t connections[CONNECTION_NUM_FOR_PORT];
         void* buffers[CONNECTION_NUM_FOR_PORT];
         jack_port_id_t src_index;
         int i;
 
+        manager->GetConnections(port_index, connections);
+
         for (i = 0; (i < CONNECTION_NUM_FOR_PORT) && ((src_index = connections[i]) != EMPTY); i++) {
-            AssertPort(src_index);
-            buffers[i] = GetBuffer(src_index, buffer_size);
+            buffers[i] = GetBufferAux(manager, pool, src_index, buffer_size);
         }
 
-        port->MixBuffers(buffers, i, buffer_size);
-        return port->GetBuffer();
+        port->MixBuffers(port->GetBuffer(address), buffers, i, buffer_size);
+        port->fMixCycle = cycle;
+        return port->GetBuffer(address);
     }
 }
 
@@ -241,7 +298,8 @@ int JackGraphManager::RequestMonitor(jack_port_id_t port_index, bool onoff) // C
 
     port->RequestMonitor(onoff);
 
-    const jack_int_t* connections = ReadCurrentState()->GetConnections(port_index);
+    jack_int_t connections[CONNECTION_NUM_FOR_PORT];
+    ReadCurrentState()->GetConnections(port_index, connections);
     if ((port->fFlags & JackPortIsOutput) == 0) { // ?? Taken from jack, why not (port->fFlags  & JackPortIsInput) ?
         jack_port_id_t src_index;
         for (int i = 0; (i < CONNECTION_NUM_FOR_PORT) && ((src_index = connections[i]) != EMPTY); i++) {
@@ -256,13 +314,15 @@ int JackGraphManager::RequestMonitor(jack_port_id_t port_index, bool onoff) // C
 // Client
 jack_nframes_t JackGraphManager::ComputeTotalLatencyAux(jack_port_id_t port_index, jack_port_id_t src_port_index, JackConnectionManager* manager, int hop_count)
 {
-    const jack_int_t* connections = ReadCurrentState()->GetConnections(port_index);
+    jack_int_t connections[CONNECTION_NUM_FOR_PORT];
     jack_nframes_t max_latency = 0;
     jack_port_id_t dst_index;
 
     if (hop_count > 8)
         return GetPort(port_index)->GetLatency();
 
+    ReadCurrentState()->GetConnections(port_index, connections);
+
     for (int i = 0; (i < CONNECTION_NUM_FOR_PORT) && ((dst_index = connections[i]) != EMPTY); i++) {
         if (src_port_index != dst_index) {
             AssertPort(dst_index);
@@ -309,11 +369,13 @@ int JackGraphManager::ComputeTotalLatencies()
 
 void JackGraphManager::RecalculateLatencyAux(jack_port_id_t port_index, jack_latency_callback_mode_t mode)
 {
-    const jack_int_t* connections = ReadCurrentState()->GetConnections(port_index);
+    jack_int_t connections[CONNECTION_NUM_FOR_PORT];
     JackPort* port = GetPort(port_index);
     jack_latency_range_t latency = { UINT32_MAX, 0 };
     jack_port_id_t dst_index;
 
+    ReadCurrentState()->GetConnections(port_index, connections);
+
     for (int i = 0; (i < CONNECTION_NUM_FOR_PORT) && ((dst_index = connections[i]) != EMPTY); i++) {
         AssertPort(dst_index);
         JackPort* dst_port = GetPort(dst_index);
@@ -347,17 +409,124 @@ void JackGraphManager::RecalculateLatency(jack_port_id_t port_index, jack_latenc
     //jack_log("JackGraphManager::RecalculateLatency port_index = %ld", port_index);
 }
 
+// Server and client
+void JackGraphManager::SetLatencyChanged(int refnum)
+{
+    fLatencyChangedRef.SetAtomic(refnum);
+}
+
+/*!
+\brief Take the refnum changed since the last call, returns the refnum whose latencies have to be computed again, or false if all have to.
+*/
+bool JackGraphManager::GetLatencyChanges(int driver_num, JackFixedBitSet<CLIENT_NUM>& capture, JackFixedBitSet<CLIENT_NUM>& playback)
+{
+    JackFixedBitSet<CLIENT_NUM> changed;
+    bool found = false;
+
+    for (int refnum = fLatencyChangedRef.TakeFirst(); refnum >= 0; refnum = fLatencyChangedRef.TakeFirst()) {
+        changed.Set(refnum);
+        found = true;
+    }
+
+    return found && ReadCurrentState()->GetLatencyRefs(changed, driver_num, capture, playback);
+}
+
+/*!
+\brief Server side latency computation of a client without latency callback, as done by JackClient::HandleLatencyCallback :
+ports receive the latency of their connections, then the other ports get the maximum latency of the client.
+*/
+void JackGraphManager::ComputeLatency(int refnum, jack_latency_callback_mode_t mode)
+{
+    JackConnectionManager* manager = ReadCurrentState();
+    const jack_int_t* connected = (mode == JackCaptureLatency) ? manager->GetInputPorts(refnum) : manager->GetOutputPorts(refnum);
+    const jack_int_t* others = (mode == JackCaptureLatency) ? manager->GetOutputPorts(refnum) : manager->GetInputPorts(refnum);
+    jack_latency_range_t latency = { UINT32_MAX, 0 };
+    jack_port_id_t port_index;
+
+    for (int i = 0; (i < PORT_NUM_FOR_CLIENT) && ((port_index = connected[i]) != EMPTY); i++) {
+        jack_latency_range_t other_latency;
+        RecalculateLatencyAux(port_index, mode);
+        GetPort(port_index)->GetLatencyRange(mode, &other_latency);
+        if (other_latency.max > latency.max)
+            latency.max = other_latency.max;
+        if (other_latency.min < latency.min)
+            latency.min = other_latency.min;
+    }
+
+    if (latency.min == UINT32_MAX)
+        latency.min = 0;
+
+    for (int i = 0; (i < PORT_NUM_FOR_CLIENT) && ((port_index = others[i]) != EMPTY); i++) {
+        GetPort(port_index)->SetLatencyRange(mode, &latency);
+    }
+}
+
 // Server
-void JackGraphManager::SetBufferSize(jack_nframes_t buffer_size)
+int JackGraphManager::SetBufferSize(jack_nframes_t buffer_size)
 {
     jack_log("JackGraphManager::SetBufferSize size = %ld", buffer_size);
 
-    jack_port_id_t port_index;
-    for (port_index = FIRST_AVAILABLE_PORT; port_index < fPortMax; port_index++) {
-        JackPort* port = GetPort(port_index);
-        if (port->IsUsed())
-            port->ClearBuffer(buffer_size);
+    // Port buffers are allocated again for a new buffer size
+    JackPortBufferPool* pool = GetBufferPool();
+    if (buffer_size > 0 && (!pool || pool->GetBufferSize() != buffer_size)) {
+        if (AllocateBufferPool(buffer_size) < 0) {
+            return -1;
+        }
+        pool = GetBufferPool();
+    }
+
+    if (pool) {
+        jack_port_id_t port_index;
+        for (port_index = FIRST_AVAILABLE_PORT; port_index < fPortMax; port_index++) {
+            JackPort* port = GetPort(port_index);
+            if (port->IsUsed())
+                port->ClearBuffer(port->GetBuffer(pool->GetAddress()), buffer_size);
+        }
+    }
+    return 0;
+}
+
+/*!
+\brief Allocate the port buffers for a new buffer size, the ports being laid out client by client, then release the
+previous ones : the audio driver is stopped, client processes map the new buffers when they are notified.
+*/
+int JackGraphManager::AllocateBufferPool(jack_nframes_t buffer_size)
+{
+    JackPortBufferPool* prev_pool = GetBufferPool();
+    JackPortBufferPool* pool;
+
+    try {
+        pool = JackPortBufferPool::Allocate((prev_pool) ? prev_pool->GetId() + 1 : 1, buffer_size, fPortMax);
+    } catch (...) {
+        jack_error("Cannot allocate port buffers for buffer size = %ld", buffer_size);
+        return -1;
+    }
+
+    // Ports keep their previous buffer until all new ones are allocated
+    std::vector<UInt32> offsets(fPortMax, pool->GetUnusedBuffer());
+    for (int refnum = 0; refnum < CLIENT_NUM; refnum++) {
+        for (jack_port_id_t port_index = FIRST_AVAILABLE_PORT; port_index < fPortMax; port_index++) {
+            JackPort* port = GetPort(port_index);
+            if (port->IsUsed() && port->fRefNum == refnum && (offsets[port_index] = pool->AllocateBuffer(refnum, port->fTypeId)) == 0) {
+                jack_error("Cannot allocate port buffers for buffer size = %ld", buffer_size);
+                JackPortBufferPool::Destroy(pool);
+                return -1;
+            }
+        }
+    }
+
+    for (jack_port_id_t port_index = 0; port_index < fPortMax; port_index++) {
+        GetPort(port_index)->fBufferOffset = offsets[port_index];
     }
+
+    JackPortBufferPool::SetMapped(pool);
+    fBufferPoolIndex = pool->GetShmIndex();
+    fBufferPoolId = pool->GetId();
+
+    if (prev_pool) {
+        JackPortBufferPool::Destroy(prev_pool);
+    }
+    return 0;
 }
 
 // Server
@@ -372,6 +541,8 @@ jack_port_id_t JackGraphManager::AllocatePortAux(int refnum, const char* port_na
             jack_log("JackGraphManager::AllocatePortAux port_index = %ld name = %s type = %s", port_index, port_name, port_type);
             if (!port->Allocate(refnum, port_name, port_type, flags))
                 return NO_PORT;
+            fNameIndex.Add(port->fName, port_index);
+            SetLatencyChanged(refnum);
             break;
         }
     }
@@ -382,22 +553,35 @@ jack_port_id_t JackGraphManager::AllocatePortAux(int refnum, const char* port_na
 // Server
 jack_port_id_t JackGraphManager::AllocatePort(int refnum, const char* port_name, const char* port_type, JackPortFlags flags, jack_nframes_t buffer_size)
 {
+    JackPortBufferPool* pool = GetBufferPool();
+    if (!pool) {
+        jack_error("JackGraphManager::AllocatePort : port buffers are not allocated");
+        return NO_PORT;
+    }
+
     JackConnectionManager* manager = WriteNextStateStart();
     jack_port_id_t port_index = AllocatePortAux(refnum, port_name, port_type, flags);
 
     if (port_index != NO_PORT) {
         JackPort* port = GetPort(port_index);
         assert(port);
-        port->ClearBuffer(buffer_size);
-
-        int res;
-        if (flags & JackPortIsOutput) {
-            res = manager->AddOutputPort(refnum, port_index);
-        } else {
-            res = manager->AddInputPort(refnum, port_index);
+        int res = -1;
+
+        port->fBufferOffset = pool->AllocateBuffer(refnum, port->fTypeId);
+        if (port->fBufferOffset > 0) {
+            port->ClearBuffer(port->GetBuffer(pool->GetAddress()), buffer_size);
+            port->fMixCycle = fCycle - 1;
+            if (flags & JackPortIsOutput) {
+                res = manager->AddOutputPort(refnum, port_index);
+            } else {
+                res = manager->AddInputPort(refnum, port_index);
+            }
         }
-        // Insertion failure
+        // Buffer allocation or insertion failure
         if (res < 0) {
+            pool->ReleaseBuffer(port->fBufferOffset, port->fTypeId);
+            port->fBufferOffset = pool->GetUnusedBuffer();
+            fNameIndex.Remove(port->fName, port_index);
             port->Release();
             port_index = NO_PORT;
         }
@@ -412,6 +596,7 @@ int JackGraphManager::ReleasePort(int refnum, jack_port_id_t port_index)
 {
     JackConnectionManager* manager = WriteNextStateStart();
     JackPort* port = GetPort(port_index);
+    JackPortBufferPool* pool = GetBufferPool();
     int res;
 
     if (port->fFlags & JackPortIsOutput) {
@@ -422,7 +607,18 @@ int JackGraphManager::ReleasePort(int refnum, jack_port_id_t port_index)
         res = manager->RemoveInputPort(refnum, port_index);
     }
 
+    fNameIndex.Remove(port->fName, port_index);
+    fNameIndex.Remove(port->fAlias1, port_index);
+    fNameIndex.Remove(port->fAlias2, port_index);
+    if (pool) {
+        pool->ReleaseBuffer(port->fBufferOffset, port->fTypeId);
+        port->fBufferOffset = pool->GetUnusedBuffer();
+    }
     port->Release();
+    SetLatencyChanged(refnum);
+    if (fNameIndex.NeedRebuild()) {
+        fNameIndex.Rebuild(fPortArray, fPortMax);
+    }
     WriteNextStateStop();
     return res;
 }
@@ -516,9 +712,8 @@ void JackGraphManager::DisconnectAllOutput(jack_port_id_t port_index)
     jack_log("JackGraphManager::DisconnectAllOutput port_index = %ld ", port_index);
     JackConnectionManager* manager = WriteNextStateStart();
 
-    const jack_int_t* connections = manager->GetConnections(port_index);
-    while (connections[0] != EMPTY) {
-        Disconnect(port_index, connections[0]); // Warning : Disconnect shift port to left
+    while (manager->Connections(port_index) > 0) {
+        Disconnect(port_index, manager->GetPort(port_index, 0)); // Warning : Disconnect removes the first connection
     }
     WriteNextStateStop();
 }
@@ -541,8 +736,7 @@ int JackGraphManager::DisconnectAll(jack_port_id_t port_index)
 void JackGraphManager::GetConnections(jack_port_id_t port_index, jack_int_t* res)
 {
     JackConnectionManager* manager = WriteNextStateStart();
-    const jack_int_t* connections = manager->GetConnections(port_index);
-    memcpy(res, connections, sizeof(jack_int_t) * CONNECTION_NUM_FOR_PORT);
+    manager->GetConnections(port_index, res);
     WriteNextStateStop();
 }
 
@@ -551,6 +745,7 @@ void JackGraphManager::Activate(int refnum)
 {
     DirectConnect(FREEWHEEL_DRIVER_REFNUM, refnum);
     DirectConnect(refnum, FREEWHEEL_DRIVER_REFNUM);
+    SetLatencyChanged(refnum);
 }
 
 /*
@@ -637,9 +832,15 @@ int JackGraphManager::Connect(jack_port_id_t port_src, jack_port_id_t port_dst)
     if (manager->IsLoopPath(port_src, port_dst)) {
         jack_log("JackGraphManager::Connect: LOOP detected");
         manager->IncFeedbackConnection(port_src, port_dst);
-    } else {
-        manager->IncDirectConnection(port_src, port_dst);
+    } else if (manager->IncDirectConnection(port_src, port_dst) < 0) {
+        jack_error("JackGraphManager::Connect failed port_src = %ld port_dst = %ld", port_src, port_dst);
+        manager->Disconnect(port_src, port_dst);
+        manager->Disconnect(port_dst, port_src);
+        res = -1;
+        goto end;
     }
+    SetLatencyChanged(src->GetRefNum());
+    SetLatencyChanged(dst->GetRefNum());
 
 end:
     WriteNextStateStop();
@@ -686,6 +887,8 @@ int JackGraphManager::Disconnect(jack_port_id_t port_src, jack_port_id_t port_ds
     } else {
         manager->DecDirectConnection(port_src, port_dst);
     }
+    SetLatencyChanged(GetPort(port_src)->GetRefNum());
+    SetLatencyChanged(GetPort(port_dst)->GetRefNum());
 
 end:
     WriteNextStateStop();
@@ -738,13 +941,42 @@ int JackGraphManager::GetTwoPorts(const char* src_name, const char* dst_name, ja
 // Client : port array
 jack_port_id_t JackGraphManager::GetPort(const char* name)
 {
-    for (unsigned int i = 0; i < fPortMax; i++) {
-        JackPort* port = GetPort(i);
-        if (port->IsUsed() && port->NameEquals(name)) {
-            return i;
-        }
+    return fNameIndex.Find(name, fPortArray, fPortMax);
+}
+
+// Server
+void JackGraphManager::SetPortName(jack_port_id_t port_index, const char* name)
+{
+    JackPort* port = GetPort(port_index);
+    char old_name[REAL_JACK_PORT_NAME_SIZE];
+    strcpy(old_name, port->fName);
+    port->SetName(name);
+    fNameIndex.Add(port->fName, port_index);
+    fNameIndex.Remove(old_name, port_index);
+}
+
+// Server and client
+int JackGraphManager::SetPortAlias(jack_port_id_t port_index, const char* alias)
+{
+    JackPort* port = GetPort(port_index);
+    bool first = (port->fAlias1[0] == '\0');
+    if (port->SetAlias(alias) < 0) {
+        return -1;
     }
-    return NO_PORT;
+    // Index the alias as stored by the port
+    fNameIndex.Add((first) ? port->fAlias1 : port->fAlias2, port_index);
+    return 0;
+}
+
+// Server and client
+int JackGraphManager::UnsetPortAlias(jack_port_id_t port_index, const char* alias)
+{
+    JackPort* port = GetPort(port_index);
+    if (port->UnsetAlias(alias) < 0) {
+        return -1;
+    }
+    fNameIndex.Remove(alias, port_index);
+    return 0;
 }
 
 /*!
@@ -754,10 +986,12 @@ jack_port_id_t JackGraphManager::GetPort(const char* name)
 // Client
 void JackGraphManager::GetConnectionsAux(JackConnectionManager* manager, const char** res, jack_port_id_t port_index)
 {
-    const jack_int_t* connections = manager->GetConnections(port_index);
+    jack_int_t connections[CONNECTION_NUM_FOR_PORT];
     jack_int_t index;
     int i;
 
+    manager->GetConnections(port_index, connections);
+
     // Cleanup connection array
     memset(res, 0, sizeof(char*) * CONNECTION_NUM_FOR_PORT);
 
@@ -894,6 +1128,7 @@ void JackGraphManager::Restore(JackConnectionManager* src)
 {
     JackConnectionManager* manager = WriteNextStateStart();
     memcpy(manager, src, sizeof(JackConnectionManager));
+    manager->Invalidate();
     WriteNextStateStop();
 }
 
@@ -23,6 +23,8 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 
 #include "JackShmMem.h"
 #include "JackPort.h"
+#include "JackPortNameIndex.h"
+#include "JackPortBufferPool.h"
 #include "JackConstants.h"
 #include "JackConnectionManager.h"
 #include "JackAtomicState.h"
@@ -37,12 +39,18 @@ namespace Jack
 */
 
 PRE_PACKED_STRUCTURE
-class SERVER_EXPORT JackGraphManager : public JackShmMem, public JackAtomicState<JackConnectionManager>
+class SERVER_EXPORT JackGraphManager : public JackShmMem, public JackAtomicState<JackAlignedState<JackConnectionManager> >
 {
 
     private:
 
         unsigned int fPortMax;
+        int fBufferPoolIndex;       // Port buffers segment, allocated for the current buffer size
+        volatile UInt32 fBufferPoolId;
+        volatile UInt32 fCycle;     // Incremented each time a graph cycle starts, stamps the input mixdowns
+        MEM_ALIGN(JackPortNameIndex fNameIndex, 4);    // Port names and aliases, its slots are changed with CAS
+        MEM_ALIGN(JackFixedBitSet<CLIENT_NUM> fLatencyChangedRef, 4);    // Refnum whose ports changed since the last latency computation, also set by clients
+        bool fActivationMixdown;    // Mix the inputs of a client when its cycle starts
         JackClientTiming fClientTiming[CLIENT_NUM];
         JackPort fPortArray[0];    // The actual size depends of port_max, it will be dynamically computed and allocated using "placement" new
 
@@ -50,8 +58,8 @@ class SERVER_EXPORT JackGraphManager : public JackShmMem, public JackAtomicState
         jack_port_id_t AllocatePortAux(int refnum, const char* port_name, const char* port_type, JackPortFlags flags);
         void GetConnectionsAux(JackConnectionManager* manager, const char** res, jack_port_id_t port_index);
         void GetPortsAux(const char** matching_ports, const char* port_name_pattern, const char* type_name_pattern, unsigned long flags);
-        jack_default_audio_sample_t* GetBuffer(jack_port_id_t port_index);
-        void* GetBufferAux(JackConnectionManager* manager, jack_port_id_t port_index, jack_nframes_t frames);
+        void* GetBufferAux(JackConnectionManager* manager, JackPortBufferPool* pool, jack_port_id_t port_index, jack_nframes_t frames);
+        int AllocateBufferPool(jack_nframes_t buffer_size);
         jack_nframes_t ComputeTotalLatencyAux(jack_port_id_t port_index, jack_port_id_t src_port_index, JackConnectionManager* manager, int hop_count);
         void RecalculateLatencyAux(jack_port_id_t port_index, jack_latency_callback_mode_t mode);
 
@@ -61,7 +69,7 @@ class SERVER_EXPORT JackGraphManager : public JackShmMem, public JackAtomicState
         ~JackGraphManager()
         {}
 
-        void SetBufferSize(jack_nframes_t buffer_size);
+        int SetBufferSize(jack_nframes_t buffer_size);
 
         // Ports management
         jack_port_id_t AllocatePort(int refnum, const char* port_name, const char* port_type, JackPortFlags flags, jack_nframes_t buffer_size);
@@ -74,10 +82,20 @@ class SERVER_EXPORT JackGraphManager : public JackShmMem, public JackAtomicState
         JackPort* GetPort(jack_port_id_t index);
         jack_port_id_t GetPort(const char* name);
 
+        // Port names are changed here to keep the name index up to date
+        void SetPortName(jack_port_id_t port_index, const char* name);
+        int SetPortAlias(jack_port_id_t port_index, const char* alias);
+        int UnsetPortAlias(jack_port_id_t port_index, const char* alias);
+
         int ComputeTotalLatency(jack_port_id_t port_index);
         int ComputeTotalLatencies();
         void RecalculateLatency(jack_port_id_t port_index, jack_latency_callback_mode_t mode);
 
+        // Latency ranges computed again after a change
+        void SetLatencyChanged(int refnum);
+        bool GetLatencyChanges(int driver_num, JackFixedBitSet<CLIENT_NUM>& capture, JackFixedBitSet<CLIENT_NUM>& playback);
+        void ComputeLatency(int refnum, jack_latency_callback_mode_t mode);
+
         int RequestMonitor(jack_port_id_t port_index, bool onoff);
 
         // Connections management
@@ -116,6 +134,23 @@ class SERVER_EXPORT JackGraphManager : public JackShmMem, public JackAtomicState
         // Buffer management
         void* GetBuffer(jack_port_id_t port_index, jack_nframes_t frames);
 
+        // Port buffers mapped in this process, RT
+        JackPortBufferPool* GetBufferPool()
+        {
+            return JackPortBufferPool::GetMapped();
+        }
+
+        // Client open and notification thread : the returned pool is to be released with JackPortBufferPool::Release
+        JackPortBufferPool* MapBufferPool()
+        {
+            return JackPortBufferPool::Acquire(fBufferPoolIndex, fBufferPoolId);
+        }
+
+        void SetActivationMixdown(bool onoff)
+        {
+            fActivationMixdown = onoff;
+        }
+
         // Activation management
         void RunCurrentGraph();
         bool RunNextGraph();
@@ -124,6 +159,7 @@ class SERVER_EXPORT JackGraphManager : public JackShmMem, public JackAtomicState
         void InitRefNum(int refnum);
         int ResumeRefNum(JackClientControl* control, JackSynchro* table);
         int SuspendRefNum(JackClientControl* control, JackSynchro* table, long usecs);
+        void MixInputs(int refnum);
         void TopologicalSort(std::vector<jack_int_t>& sorted);
 
         JackClientTiming* GetClientTiming(int refnum)
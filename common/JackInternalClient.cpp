@@ -29,6 +29,7 @@ Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
 #include "JackClientControl.h"
 #include "JackInternalClientChannel.h"
 #include "JackTools.h"
+#include "JackGraphExecutor.h"
 #include <assert.h>
 
 namespace Jack
@@ -48,6 +49,11 @@ SERVER_EXPORT JackEngineControl* GetEngineControl()
     return JackServerGlobals::fInstance->GetEngineControl();
 }
 
+SERVER_EXPORT JackCycleTimings* GetCycleTimings()
+{
+    return JackServerGlobals::fInstance->GetCycleTimings();
+}
+
 SERVER_EXPORT JackSynchro* GetSynchroTable()
 {
     return JackServerGlobals::fInstance->GetSynchroTable();
@@ -117,6 +123,31 @@ void JackInternalClient::ShutDown(jack_status_t code, const char* message)
     JackClient::ShutDown(code, message);
 }
 
+/*!
+\brief When the server has a graph executor, clients with a process callback are run by its workers.
+*/
+int JackInternalClient::Activate()
+{
+    JackGraphExecutor* executor = JackServerGlobals::fInstance->GetGraphExecutor();
+    int res = JackClient::Activate();
+
+    if (res == 0 && executor && fProcess && !fThreadFun) {
+        executor->AddClient(this);
+    }
+    return res;
+}
+
+int JackInternalClient::Deactivate()
+{
+    JackGraphExecutor* executor = JackServerGlobals::fInstance->GetGraphExecutor();
+
+    // Client must not be run by a worker anymore when its thread is stopped
+    if (executor) {
+        executor->RemoveClient(this);
+    }
+    return JackClient::Deactivate();
+}
+
 JackGraphManager* JackInternalClient::GetGraphManager() const
 {
     assert(fGraphManager);
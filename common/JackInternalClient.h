@@ -49,6 +49,9 @@ class JackInternalClient : public JackClient
         int Open(const char* server_name, const char* name, int uuid, jack_options_t options, jack_status_t* status);
         void ShutDown(jack_status_t code, const char* message);
 
+        int Activate();
+        int Deactivate();
+
         JackGraphManager* GetGraphManager() const;
         JackEngineControl* GetEngineControl() const;
         JackClientControl* GetClientControl() const;
@@ -78,6 +78,10 @@ class JackInternalClientChannel : public detail::JackClientChannelInterface
         {
             *result = fEngine->PortConnect(refnum, src, dst);
         }
+        void PortConnect(int refnum, const char* const* src, const char* const* dst, int count, int* results, int* result)
+        {
+            *result = fEngine->PortConnect(refnum, src, dst, count, results);
+        }
         void PortDisconnect(int refnum, const char* src, const char* dst, int* result)
         {
             *result = fEngine->PortDisconnect(refnum, src, dst);
@@ -46,6 +46,26 @@ JackEngineControl* GetEngineControl()
     }
 }
 
+JackCycleTimings* GetCycleTimings()
+{
+    JackLibGlobals* globals = JackLibGlobals::fGlobals;
+    if (!globals) {
+        return NULL;
+    }
+
+    // Mapped on first use, most clients never read them
+    JackEngineControl* control = globals->fEngineControl;
+    if (!globals->fCycleTimings && control && control->fCycleTimingsIndex >= 0) {
+        try {
+            globals->fCycleTimings.SetShmIndex(control->fCycleTimingsIndex, control->fServerName);
+        } catch (...) {
+            jack_error("Map cycle timings segment exception");
+            return NULL;
+        }
+    }
+    return globals->fCycleTimings;
+}
+
 JackSynchro* GetSynchroTable()
 {
     return (JackLibGlobals::fGlobals ? JackLibGlobals::fGlobals->fSynchroTable : 0);
@@ -128,6 +148,11 @@ int JackLibClient::Open(const char* server_name, const char* name, int uuid, jac
         goto error;
     }
 
+    if (!(fBufferPool = GetGraphManager()->MapBufferPool())) {
+        jack_error("Cannot map port buffers");
+        goto error;
+    }
+
     SetupDriverSync(false);
 
     // Connect shared synchro : the synchro must be usable in I/O mode when several clients live in the same process
@@ -148,6 +173,8 @@ int JackLibClient::Open(const char* server_name, const char* name, int uuid, jac
 error:
     fChannel->Stop();
     fChannel->Close();
+    JackPortBufferPool::Release(fBufferPool);
+    fBufferPool = NULL;
     return -1;
 }
 
@@ -26,6 +26,7 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 #include "JackPlatformPlug.h"
 #include "JackGraphManager.h"
 #include "JackMessageBuffer.h"
+#include "JackCycleTimings.h"
 #include "JackTime.h"
 #include "JackClient.h"
 #include "JackError.h"
@@ -54,6 +55,7 @@ struct JackLibGlobals
 {
     JackShmReadWritePtr<JackGraphManager> fGraphManager;	/*! Shared memory Port manager */
     JackShmReadWritePtr<JackEngineControl> fEngineControl;	/*! Shared engine control */  // transport engine has to be writable
+    JackShmReadWritePtr<JackCycleTimings> fCycleTimings;    /*! Shared cycle timings, mapped on first use */
     JackSynchro fSynchroTable[CLIENT_NUM];                  /*! Shared synchro table */
     sigset_t fProcessSignals;
 
@@ -68,6 +70,7 @@ struct JackLibGlobals
         }
         fGraphManager = -1;
         fEngineControl = -1;
+        fCycleTimings = -1;
 
         // Filter SIGPIPE to avoid having client get a SIGPIPE when trying to access a died server.
     #ifdef WIN32
@@ -86,6 +89,7 @@ struct JackLibGlobals
         for (int i = 0; i < CLIENT_NUM; i++) {
             fSynchroTable[i].Disconnect();
         }
+        JackPortBufferPool::Unmap();
         JackMessageBuffer::Destroy();
 
        // Restore old signal mask
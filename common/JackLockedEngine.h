@@ -83,8 +83,8 @@ class SERVER_EXPORT JackLockedEngine
 
     public:
 
-        JackLockedEngine(JackGraphManager* manager, JackSynchro* table, JackEngineControl* controler, char self_connect_mode):
-            fEngine(manager, table, controler, self_connect_mode)
+        JackLockedEngine(JackGraphManager* manager, JackSynchro* table, JackEngineControl* controler, JackCycleTimings* timings, char self_connect_mode):
+            fEngine(manager, table, controler, timings, self_connect_mode)
         {}
         ~JackLockedEngine()
         {}
@@ -215,6 +215,13 @@ class SERVER_EXPORT JackLockedEngine
             return (fEngine.CheckClient(refnum)) ? fEngine.PortConnect(refnum, src, dst) : -1;
             CATCH_EXCEPTION_RETURN
         }
+        int PortConnect(int refnum, const char* const* src, const char* const* dst, int count, int* results)
+        {
+            TRY_CALL
+            JackLock lock(&fEngine);
+            return (fEngine.CheckClient(refnum)) ? fEngine.PortConnect(refnum, src, dst, count, results) : -1;
+            CATCH_EXCEPTION_RETURN
+        }
         int PortDisconnect(int refnum, const char* src, const char* dst)
         {
             TRY_CALL
@@ -23,34 +23,222 @@
 #include "JackGlobals.h"
 #include "JackError.h"
 #include "JackTime.h"
+#include "JackTools.h"
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
 
 namespace Jack
 {
 
 JackMessageBuffer* JackMessageBuffer::fInstance = NULL;
 
+jack_tls_key JackMessageBuffer::fKeyOverruns;
+static bool gKeyOverrunsInitialized = jack_tls_allocate_key(&JackMessageBuffer::fKeyOverruns);
+
+/*
+Conversions of a format : as the argument has to be read from the va_list by the writer, and given back to
+snprintf by the message thread, both parse the format the same way.
+*/
+
+enum {
+    kArgNone,       // %%
+    kArgInt,
+    kArgLong,
+    kArgLongLong,
+    kArgIntMax,
+    kArgSize,
+    kArgPtrDiff,
+    kArgDouble,
+    kArgLongDouble,
+    kArgString,
+    kArgPointer,
+    kArgInvalid     // Not deferred (%n, %m, wide characters...)
+};
+
+struct JackConversion
+{
+    int fLength;    // Characters of the conversion specification
+    int fStars;     // Width and/or precision given as int arguments
+    int fKind;
+};
+
+static void ParseConversion(const char* fmt, JackConversion* conv)
+{
+    const char* ptr = fmt + 1;
+    char modifier = 0;
+
+    conv->fStars = 0;
+    conv->fKind = kArgInvalid;
+
+    if (*ptr == '%') {
+        conv->fLength = 2;
+        conv->fKind = kArgNone;
+        return;
+    }
+
+    // Flags, width and precision
+    while (*ptr && strchr("-+ #0'", *ptr)) {
+        ptr++;
+    }
+    if (*ptr == '*') {
+        conv->fStars++;
+        ptr++;
+    } else {
+        while (*ptr >= '0' && *ptr <= '9') {
+            ptr++;
+        }
+    }
+    if (*ptr == '.') {
+        ptr++;
+        if (*ptr == '*') {
+            conv->fStars++;
+            ptr++;
+        } else {
+            while (*ptr >= '0' && *ptr <= '9') {
+                ptr++;
+            }
+        }
+    }
+
+    // Length modifier, 'q' stands for 'll'
+    switch (*ptr) {
+        case 'h':
+            modifier = *ptr++;
+            if (*ptr == 'h') {
+                ptr++;
+            }
+            break;
+        case 'l':
+            modifier = *ptr++;
+            if (*ptr == 'l') {
+                modifier = 'q';
+                ptr++;
+            }
+            break;
+        case 'q':
+        case 'L':
+        case 'j':
+        case 'z':
+        case 't':
+            modifier = *ptr++;
+            break;
+    }
+
+    switch (*ptr) {
+        case 'd':
+        case 'i':
+        case 'o':
+        case 'u':
+        case 'x':
+        case 'X':
+            switch (modifier) {
+                case 0:
+                case 'h':
+                    conv->fKind = kArgInt;
+                    break;
+                case 'l':
+                    conv->fKind = kArgLong;
+                    break;
+                case 'q':
+                    conv->fKind = kArgLongLong;
+                    break;
+                case 'j':
+                    conv->fKind = kArgIntMax;
+                    break;
+                case 'z':
+                    conv->fKind = kArgSize;
+                    break;
+                case 't':
+                    conv->fKind = kArgPtrDiff;
+                    break;
+            }
+            break;
+        case 'c':
+            if (modifier == 0) {
+                conv->fKind = kArgInt;
+            }
+            break;
+        case 'e':
+        case 'E':
+        case 'f':
+        case 'F':
+        case 'g':
+        case 'G':
+        case 'a':
+        case 'A':
+            if (modifier == 0 || modifier == 'l') {
+                conv->fKind = kArgDouble;
+            } else if (modifier == 'L') {
+                conv->fKind = kArgLongDouble;
+            }
+            break;
+        case 's':
+            if (modifier == 0) {
+                conv->fKind = kArgString;
+            }
+            break;
+        case 'p':
+            if (modifier == 0) {
+                conv->fKind = kArgPointer;
+            }
+            break;
+    }
+
+    conv->fLength = (*ptr) ? int(ptr + 1 - fmt) : int(ptr - fmt);
+}
+
+// Advances in the message after a snprintf, a truncated message stays terminated
+static void Advance(char** message, size_t* room, int res)
+{
+    if (res < 0) {
+        res = 0;
+    }
+    if (size_t(res) >= *room) {
+        res = int(*room) - 1;
+    }
+    *message += res;
+    *room -= res;
+}
+
 JackMessageBuffer::JackMessageBuffer()
     :fInit(NULL),
     fInitArg(NULL),
     fThread(this),
+    fWakeUp(),
     fGuard(),
-    fInBuffer(0),
-    fOutBuffer(0),
+    fWrite(0),
+    fRead(0),
+    fSleeping(false),
     fOverruns(0),
     fRunning(false)
-{}
+{
+    for (UInt32 i = 0; i < MB_RECORDS; i++) {
+        fRecords[i].fSequence = i;
+    }
+}
 
 JackMessageBuffer::~JackMessageBuffer()
 {}
 
 bool JackMessageBuffer::Start()
 {
+    // A semaphore private to the process
+    char name[SYNC_MAX_NAME_SIZE];
+    snprintf(name, sizeof(name), "message_buffer_%d", JackTools::GetPID());
+    if (!fWakeUp.Allocate(name, "jack", 0)) {
+        return false;
+    }
+
     // Before StartSync()...
     fRunning = true;
     if (fThread.StartSync() == 0) {
         return true;
     } else {
         fRunning = false;
+        fWakeUp.Destroy();
         return false;
     }
 }
@@ -63,63 +251,322 @@ bool JackMessageBuffer::Stop()
         jack_log("no message buffer overruns");
     }
 
-    if (fGuard.Lock()) {
-        fRunning = false;
-        fGuard.Signal();
-        fGuard.Unlock();
-        fThread.Stop();
-    } else {
-        fThread.Kill();
-    }
+    fRunning = false;
+    fWakeUp.Signal();
+    fThread.Stop();
 
     Flush();
+    fWakeUp.Destroy();
     return true;
 }
 
-void JackMessageBuffer::Flush()
+UInt32 JackMessageBuffer::GetThreadOverruns()
 {
-    while (fOutBuffer != fInBuffer) {
-        jack_log_function(fBuffers[fOutBuffer].level, fBuffers[fOutBuffer].message);
-        fOutBuffer = MB_NEXT(fOutBuffer);
+    return UInt32((uintptr_t)jack_tls_get(fKeyOverruns));
+}
+
+JackMessageRecord* JackMessageBuffer::Reserve()
+{
+    JackMessageRecord* record;
+    UInt32 pos = fWrite;
+
+    // A record is free when its sequence is its position : writers compete for it on the write index
+    while (true) {
+        record = &fRecords[pos & (MB_RECORDS - 1)];
+        SInt32 diff = SInt32(record->fSequence - pos);
+        if (diff == 0) {
+            if (CAS(pos, pos + 1, &fWrite)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // Ring is full
+            INC_ATOMIC(&fOverruns);
+            jack_tls_set(fKeyOverruns, (void*)(uintptr_t)(GetThreadOverruns() + 1));
+            return NULL;
+        }
+        pos = fWrite;
+    }
+
+    record->fLost = GetThreadOverruns();
+    if (record->fLost > 0) {
+        jack_tls_set(fKeyOverruns, NULL);
+    }
+    return record;
+}
+
+void JackMessageBuffer::Commit(JackMessageRecord* record)
+{
+    MEMORY_BARRIER();
+    record->fSequence = record->fSequence + 1;
+    MEMORY_BARRIER();
+
+    /* the message thread sets fSleeping before checking the ring : either it sees the record,
+    or the record is signaled, the semaphore keeping a signal posted before the wait
+    */
+    if (fSleeping) {
+        fWakeUp.Signal();
     }
 }
 
 void JackMessageBuffer::AddMessage(int level, const char *message)
 {
-    if (fGuard.Trylock()) {
-        fBuffers[fInBuffer].level = level;
-        strncpy(fBuffers[fInBuffer].message, message, MB_BUFFERSIZE);
-        fInBuffer = MB_NEXT(fInBuffer);
-        fGuard.Signal();
-        fGuard.Unlock();
-    } else {            /* lock collision */
-        INC_ATOMIC(&fOverruns);
+    JackMessageRecord* record = Reserve();
+    if (record) {
+        record->fLevel = level;
+        record->fPrefix = -1;
+        record->fFormat = 0;
+        record->fDeferred = false;
+        strncpy(record->fStrings, message, MB_STRINGS - 1);
+        record->fStrings[MB_STRINGS - 1] = 0;
+        Commit(record);
+    }
+}
+
+void JackMessageBuffer::AddFormat(int level, const char* prefix, const char* fmt, va_list ap)
+{
+    JackMessageRecord* record = Reserve();
+    if (!record) {
+        return;
+    }
+
+    record->fLevel = level;
+    record->fPrefix = -1;
+    record->fDeferred = true;
+
+    va_list ap_copy;
+    va_copy(ap_copy, ap);
+    int arg = 0;
+    size_t used = 0;
+
+    // Prefix then format, a prefix that fills the record leaves room for an empty message
+    if (prefix) {
+        size_t prefix_len = strnlen(prefix, MB_STRINGS - 2);
+        memcpy(record->fStrings, prefix, prefix_len);
+        record->fStrings[prefix_len] = 0;
+        record->fPrefix = 0;
+        used = prefix_len + 1;
+    }
+    record->fFormat = int(used);
+    size_t fmt_len = strnlen(fmt, MB_STRINGS - used);
+    if (fmt_len == MB_STRINGS - used) {
+        record->fDeferred = false;
+    } else {
+        memcpy(record->fStrings + used, fmt, fmt_len + 1);
+        used += fmt_len + 1;
+    }
+
+    for (const char* ptr = fmt; *ptr && record->fDeferred; ) {
+
+        if (*ptr != '%') {
+            ptr++;
+            continue;
+        }
+
+        JackConversion conv;
+        ParseConversion(ptr, &conv);
+        if (conv.fKind == kArgInvalid || arg + conv.fStars + 1 > MB_RECORD_ARGS) {
+            record->fDeferred = false;
+            break;
+        }
+        ptr += conv.fLength;
+
+        for (int i = 0; i < conv.fStars; i++) {
+            record->fArgs[arg++].i = va_arg(ap, int);
+        }
+
+        switch (conv.fKind) {
+            case kArgInt:
+                record->fArgs[arg++].i = va_arg(ap, int);
+                break;
+            case kArgLong:
+                record->fArgs[arg++].i = va_arg(ap, long);
+                break;
+            case kArgLongLong:
+                record->fArgs[arg++].i = va_arg(ap, long long);
+                break;
+            case kArgIntMax:
+                record->fArgs[arg++].i = va_arg(ap, intmax_t);
+                break;
+            case kArgSize:
+                record->fArgs[arg++].i = va_arg(ap, size_t);
+                break;
+            case kArgPtrDiff:
+                record->fArgs[arg++].i = va_arg(ap, ptrdiff_t);
+                break;
+            case kArgDouble:
+                record->fArgs[arg++].d = va_arg(ap, double);
+                break;
+            case kArgLongDouble:
+                record->fArgs[arg++].d = double(va_arg(ap, long double));
+                break;
+            case kArgPointer:
+                record->fArgs[arg++].p = va_arg(ap, void*);
+                break;
+            case kArgString: {
+                const char* str = va_arg(ap, const char*);
+                if (str == NULL) {
+                    str = "(null)";
+                }
+                size_t len = strnlen(str, MB_STRINGS - used);
+                if (len == MB_STRINGS - used) {
+                    // No room left
+                    record->fDeferred = false;
+                    break;
+                }
+                memcpy(record->fStrings + used, str, len + 1);
+                record->fArgs[arg++].i = used;
+                used += len + 1;
+                break;
+            }
+        }
+
+    }
+
+    // Not deferred : formatted at once, after the prefix
+    if (!record->fDeferred) {
+        vsnprintf(record->fStrings + record->fFormat, MB_STRINGS - record->fFormat, fmt, ap_copy);
+    }
+
+    va_end(ap_copy);
+    Commit(record);
+}
+
+#define MB_FORMAT(value) \
+    ((conv.fStars == 0) ? snprintf(message, room, spec, value) \
+    : (conv.fStars == 1) ? snprintf(message, room, spec, star[0], value) \
+    : snprintf(message, room, spec, star[0], star[1], value))
+
+void JackMessageBuffer::Format(JackMessageRecord* record, char* message)
+{
+    size_t room = MB_BUFFERSIZE;
+    message[0] = 0;
+
+    if (record->fPrefix >= 0) {
+        Advance(&message, &room, snprintf(message, room, "%s", record->fStrings + record->fPrefix));
+    }
+
+    if (!record->fDeferred) {
+        snprintf(message, room, "%s", record->fStrings + record->fFormat);
+        return;
+    }
+
+    int arg = 0;
+    for (const char* ptr = record->fStrings + record->fFormat; *ptr && room > 1; ) {
+
+        if (*ptr != '%') {
+            *message++ = *ptr++;
+            *message = 0;
+            room--;
+            continue;
+        }
+
+        JackConversion conv;
+        char spec[32];
+        int star[2];
+        int len = 0;
+
+        ParseConversion(ptr, &conv);
+        for (int i = 0; i < conv.fLength && len < int(sizeof(spec)) - 1; i++) {
+            // Long double arguments were stored as double
+            if (!(conv.fKind == kArgLongDouble && ptr[i] == 'L')) {
+                spec[len++] = ptr[i];
+            }
+        }
+        spec[len] = 0;
+        ptr += conv.fLength;
+
+        for (int i = 0; i < conv.fStars; i++) {
+            star[i] = int(record->fArgs[arg++].i);
+        }
+
+        switch (conv.fKind) {
+            case kArgNone:
+                Advance(&message, &room, snprintf(message, room, "%%"));
+                break;
+            case kArgInt:
+                Advance(&message, &room, MB_FORMAT(int(record->fArgs[arg++].i)));
+                break;
+            case kArgLong:
+                Advance(&message, &room, MB_FORMAT(long(record->fArgs[arg++].i)));
+                break;
+            case kArgLongLong:
+                Advance(&message, &room, MB_FORMAT(record->fArgs[arg++].i));
+                break;
+            case kArgIntMax:
+                Advance(&message, &room, MB_FORMAT(intmax_t(record->fArgs[arg++].i)));
+                break;
+            case kArgSize:
+                Advance(&message, &room, MB_FORMAT(size_t(record->fArgs[arg++].i)));
+                break;
+            case kArgPtrDiff:
+                Advance(&message, &room, MB_FORMAT(ptrdiff_t(record->fArgs[arg++].i)));
+                break;
+            case kArgDouble:
+            case kArgLongDouble:
+                Advance(&message, &room, MB_FORMAT(record->fArgs[arg++].d));
+                break;
+            case kArgPointer:
+                Advance(&message, &room, MB_FORMAT(record->fArgs[arg++].p));
+                break;
+            case kArgString:
+                Advance(&message, &room, MB_FORMAT(record->fStrings + record->fArgs[arg++].i));
+                break;
+        }
+    }
+}
+
+void JackMessageBuffer::Flush()
+{
+    char message[MB_BUFFERSIZE];
+
+    while (true) {
+        JackMessageRecord* record = &fRecords[fRead & (MB_RECORDS - 1)];
+        if (record->fSequence != fRead + 1) {
+            break;
+        }
+        MEMORY_BARRIER();
+
+        if (record->fLost > 0) {
+            snprintf(message, sizeof(message), "WARNING: %u messages lost by a thread (message buffer full)", (unsigned int)record->fLost);
+            jack_log_function(LOG_LEVEL_ERROR, message);
+        }
+        Format(record, message);
+        jack_log_function(record->fLevel, message);
+
+        // Record can be reused
+        MEMORY_BARRIER();
+        record->fSequence = fRead + MB_RECORDS;
+        fRead++;
     }
 }
 
 bool JackMessageBuffer::Execute()
 {
-    if (fGuard.Lock()) {
-        while (fRunning) {
-            fGuard.Wait();
-            /* the client asked for all threads to run a thread
-            initialization callback, which includes us.
-            */
-            if (fInit) {
-                fInit(fInitArg);
+    while (fRunning) {
+        /* writers only signal when fSleeping is set : do not wait if
+        a record has been written since the last flush
+        */
+        fSleeping = true;
+        MEMORY_BARRIER();
+        if (!fInit && fRecords[fRead & (MB_RECORDS - 1)].fSequence != fRead + 1) {
+            fWakeUp.Wait();
+        }
+        fSleeping = false;
+
+        /* the client asked for all threads to run a thread
+        initialization callback, which includes us.
+        */
+        if (fInit) {
+            fInit(fInitArg);
+            /* and we're done */
+            if (fGuard.Lock()) {
                 fInit = NULL;
-                /* and we're done */
                 fGuard.Signal();
+                fGuard.Unlock();
             }
-            
-            /* releasing the mutex reduces contention */
-            fGuard.Unlock();
-            Flush();
-            fGuard.Lock();
         }
-        fGuard.Unlock();
-    } else {
-        jack_error("JackMessageBuffer::Execute lock cannot be taken");
+
+        Flush();
     }
 
     return false;
@@ -162,6 +609,15 @@ void JackMessageBufferAdd(int level, const char *message)
     }
 }
 
+void JackMessageBufferAddFormat(int level, const char* prefix, const char* fmt, va_list ap)
+{
+    if (Jack::JackMessageBuffer::fInstance == NULL) {
+        jack_log_function(LOG_LEVEL_ERROR, "messagebuffer not initialized, skip message");
+    } else {
+        Jack::JackMessageBuffer::fInstance->AddFormat(level, prefix, fmt, ap);
+    }
+}
+
 int JackMessageBuffer::SetInitCallback(JackThreadInitCallback callback, void *arg)
 {
     if (fInstance && callback && fRunning && fGuard.Lock()) {
@@ -171,11 +627,14 @@ int JackMessageBuffer::SetInitCallback(JackThreadInitCallback callback, void *ar
         
     #ifndef WIN32
         // wake msg buffer thread 
-        fGuard.Signal();
+        fWakeUp.Signal();
         // wait for it to be done  
-        fGuard.Wait();
+        while (fInit) {
+            fGuard.Wait();
+        }
         // and we're done 
         fGuard.Unlock();
+        return 0;
     #else
         /*
         The condition variable emulation code does not work reliably on Windows (lost signal).
@@ -183,19 +642,17 @@ int JackMessageBuffer::SetInitCallback(JackThreadInitCallback callback, void *ar
         Probaly better in the long term : use pthread-win32 (http://sourceware.org/pthreads-win32/`
         */
         fGuard.Unlock();
+        fWakeUp.Signal();
         int count = 0;
         while (fInit && ++count < 1000) {
-            /* wake msg buffer thread */
-            fGuard.Signal();
             JackSleep(1000);
         }
-        if (count == 1000) goto error;
+        if (count < 1000) {
+            return 0;
+        }
     #endif
-    
-        return 0;
     }
-    
-error:
+
     jack_error("JackMessageBuffer::SetInitCallback : callback cannot be executed");
     return -1;
 }
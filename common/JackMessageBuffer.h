@@ -34,39 +34,69 @@
 #include "JackMutex.h"
 #include "JackAtomic.h"
 
+#include <stdarg.h>
+
 namespace Jack
 {
 
-/* MB_NEXT() relies on the fact that MB_BUFFERS is a power of two */
-#define MB_BUFFERS  128
-#define MB_NEXT(index) ((index+1) & (MB_BUFFERS-1))
+#define MB_RECORDS      256     /* must be a power of two */
+#define MB_RECORD_ARGS  8       /* arguments of a deferred format */
+#define MB_STRINGS      288     /* room for the string arguments of a record */
 #define MB_BUFFERSIZE   256     /* message length limit */
 
-struct JackMessage
+/*!
+\brief A message as written by the RT threads : the format and its raw arguments, formatted later by the message thread.
+
+The prefix, the format and the string arguments are copied in the record, since the caller (a client library that can
+be unloaded) may not keep them. When the format cannot be deferred (unsupported conversion, too many arguments, strings
+too long), the message is formatted at once in fStrings and fDeferred is false.
+*/
+
+struct JackMessageRecord
 {
-    int level;
-    char message[MB_BUFFERSIZE];
+    volatile UInt32 fSequence;  // Position of the record in the ring, once written or read
+    int fLevel;
+    UInt32 fLost;               // Messages lost by the writing thread before this one
+    int fPrefix;                // Offset of the prefix in fStrings, -1 if none
+    int fFormat;                // Offset of the format, or of the formatted message if not deferred
+    bool fDeferred;
+    union {
+        long long i;
+        double d;
+        const void* p;
+    } fArgs[MB_RECORD_ARGS];
+    char fStrings[MB_STRINGS];
 };
 
 /*!
 \brief Message buffer to be used from RT threads.
+
+Records are written in a lock-free ring by any number of threads : a writer never blocks, the message is lost (and
+counted for the writing thread) if the ring is full. Formatting is done by the message thread, woken up by a semaphore
+posted by the writers, so that committing a record never takes a lock.
 */
 
-class JackMessageBuffer : public JackRunnableInterface
+class SERVER_EXPORT JackMessageBuffer : public JackRunnableInterface
 {
 
     private:
 
         volatile JackThreadInitCallback fInit;
         void* fInitArg;
-        JackMessage fBuffers[MB_BUFFERS];
+        JackMessageRecord fRecords[MB_RECORDS];
         JackThread fThread;
-        JackProcessSync fGuard;
-        volatile unsigned int fInBuffer;
-        volatile unsigned int fOutBuffer;
+        JackSynchro fWakeUp;            // Posted by the writers while the message thread sleeps
+        JackProcessSync fGuard;         // Thread initialization callback
+        volatile UInt32 fWrite;
+        UInt32 fRead;
+        volatile bool fSleeping;        // Message thread waiting on fWakeUp, writers have to signal it
         SInt32 fOverruns;
         bool fRunning;
 
+        JackMessageRecord* Reserve();
+        void Commit(JackMessageRecord* record);
+        void Format(JackMessageRecord* record, char* message);
+
         void Flush();
 
         bool Start();
@@ -84,9 +114,14 @@ class JackMessageBuffer : public JackRunnableInterface
 	    bool static Destroy();
 
         void AddMessage(int level, const char *message);
+        void AddFormat(int level, const char* prefix, const char* fmt, va_list ap);
         int SetInitCallback(JackThreadInitCallback callback, void *arg);
 
+        // Messages lost by the calling thread since its last written one
+        static UInt32 GetThreadOverruns();
+
 	    static JackMessageBuffer* fInstance;
+        static jack_tls_key fKeyOverruns;   // Messages lost by each thread
 };
 
 #ifdef __cplusplus
@@ -95,6 +130,7 @@ extern "C"
 #endif
 
 void JackMessageBufferAdd(int level, const char *message);
+void JackMessageBufferAddFormat(int level, const char* prefix, const char* fmt, va_list ap);
 
 #ifdef __cplusplus
 }
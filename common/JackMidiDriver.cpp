@@ -56,7 +56,6 @@ int JackMidiDriver::Open(bool capturing,
 
 int JackMidiDriver::Attach()
 {
-    JackPort* port;
     jack_port_id_t port_index;
     char name[REAL_JACK_PORT_NAME_SIZE];
     char alias[REAL_JACK_PORT_NAME_SIZE];
@@ -71,8 +70,7 @@ int JackMidiDriver::Attach()
             jack_error("driver: cannot register port for %s", name);
             return -1;
         }
-        port = fGraphManager->GetPort(port_index);
-        port->SetAlias(alias);
+        fGraphManager->SetPortAlias(port_index, alias);
         fCapturePortList[i] = port_index;
         jack_log("JackMidiDriver::Attach fCapturePortList[i] port_index = %ld", port_index);
     }
@@ -84,8 +82,7 @@ int JackMidiDriver::Attach()
             jack_error("driver: cannot register port for %s", name);
             return -1;
         }
-        port = fGraphManager->GetPort(port_index);
-        port->SetAlias(alias);
+        fGraphManager->SetPortAlias(port_index, alias);
         fPlaybackPortList[i] = port_index;
         jack_log("JackMidiDriver::Attach fPlaybackPortList[i] port_index = %ld", port_index);
     }
@@ -72,7 +72,24 @@ SERVER_EXPORT jack_midi_data_t* JackMidiBuffer::ReserveEvent(jack_nframes_t time
     return (jack_midi_data_t*)this + event->offset;
 }
 
-void MidiBufferInit(void* buffer, size_t buffer_size, jack_nframes_t nframes)
+SERVER_EXPORT bool JackMidiBuffer::CopyEvent(const JackMidiEvent* event, void* src_buffer)
+{
+    if (event->size <= JackMidiEvent::INLINE_SIZE_MAX) {
+        // Room for one more event header, see MaxEventSize
+        if (sizeof(JackMidiBuffer) + sizeof(JackMidiEvent) * (event_count + 1) + write_pos <= (size_t)buffer_size) {
+            events[event_count++] = *event;
+            return true;
+        }
+    }
+    jack_midi_data_t* dest = ReserveEvent(event->time, event->size);
+    if (!dest) {
+        return false;
+    }
+    memcpy(dest, const_cast<JackMidiEvent*>(event)->GetData(src_buffer), event->size);
+    return true;
+}
+
+SERVER_EXPORT void MidiBufferInit(void* buffer, size_t buffer_size, jack_nframes_t nframes)
 {
     JackMidiBuffer* midi = (JackMidiBuffer*)buffer;
     midi->magic = JackMidiBuffer::MAGIC;
@@ -82,16 +99,47 @@ void MidiBufferInit(void* buffer, size_t buffer_size, jack_nframes_t nframes)
 }
 
 /*
- * The mixdown function below, is a simplest (read slowest) implementation possible.
- * But, since it is unlikely that it will mix many buffers with many events,
- * it should perform quite good.
- * More efficient (and possibly, fastest possible) implementation (it exists),
- * using calendar queue algorithm is about 3 times bigger, and uses alloca().
- * So, let's listen to D.Knuth about premature optimisation, a leave the current
- * implementation as is, until it is proved to be a bottleneck.
- * Dmitry Baikov.
+ * Events of a source buffer are sorted by time : the sources are merged with a binary min-heap
+ * ordered by the time of their next event, then by source index so that simultaneous events
+ * are written in the sources order. A single source with events is copied as a whole.
  */
-static void MidiBufferMixdown(void* mixbuffer, void** src_buffers, int src_count, jack_nframes_t nframes)
+static inline bool MidiSourceBefore(JackMidiBuffer** sources, int a, int b)
+{
+    uint32_t time_a = sources[a]->events[sources[a]->mix_index].time;
+    uint32_t time_b = sources[b]->events[sources[b]->mix_index].time;
+    return (time_a < time_b) || (time_a == time_b && a < b);
+}
+
+static inline void MidiHeapDown(int* heap, int heap_size, int pos, JackMidiBuffer** sources)
+{
+    int source = heap[pos];
+    while (true) {
+        int child = 2 * pos + 1;
+        if (child >= heap_size) {
+            break;
+        }
+        if (child + 1 < heap_size && MidiSourceBefore(sources, heap[child + 1], heap[child])) {
+            child++;
+        }
+        if (!MidiSourceBefore(sources, heap[child], source)) {
+            break;
+        }
+        heap[pos] = heap[child];
+        pos = child;
+    }
+    heap[pos] = source;
+}
+
+static void MidiBufferCopy(JackMidiBuffer* mix, JackMidiBuffer* src)
+{
+    // Both buffers have the same size : events and their data keep the same place
+    memcpy(mix->events, src->events, sizeof(JackMidiEvent) * src->event_count);
+    memcpy((jack_midi_data_t*)mix + mix->buffer_size - src->write_pos, (jack_midi_data_t*)src + src->buffer_size - src->write_pos, src->write_pos);
+    mix->event_count = src->event_count;
+    mix->write_pos = src->write_pos;
+}
+
+SERVER_EXPORT void MidiBufferMixdown(void* mixbuffer, void** src_buffers, int src_count, jack_nframes_t nframes)
 {
     JackMidiBuffer* mix = static_cast<JackMidiBuffer*>(mixbuffer);
     if (!mix->IsValid()) {
@@ -100,9 +148,13 @@ static void MidiBufferMixdown(void* mixbuffer, void** src_buffers, int src_count
     }
     mix->Reset(nframes);
 
+    JackMidiBuffer** sources = reinterpret_cast<JackMidiBuffer**>(src_buffers);
+    int heap[CONNECTION_NUM_FOR_PORT];
+    int heap_size = 0;
     int event_count = 0;
+
     for (int i = 0; i < src_count; ++i) {
-        JackMidiBuffer* buf = static_cast<JackMidiBuffer*>(src_buffers[i]);
+        JackMidiBuffer* buf = sources[i];
         if (!buf->IsValid()) {
             jack_error("Jack::MidiBufferMixdown - invalid source buffer");
             return;
@@ -110,38 +162,40 @@ static void MidiBufferMixdown(void* mixbuffer, void** src_buffers, int src_count
         buf->mix_index = 0;
         event_count += buf->event_count;
         mix->lost_events += buf->lost_events;
+        if (buf->event_count > 0 && heap_size < CONNECTION_NUM_FOR_PORT) {
+            heap[heap_size++] = i;
+        }
     }
 
-    int events_done;
-    for (events_done = 0; events_done < event_count; ++events_done) {
-        JackMidiBuffer* next_buf = 0;
-        JackMidiEvent* next_event = 0;
-
-        // find the earliest event
-        for (int i = 0; i < src_count; ++i) {
-            JackMidiBuffer* buf = static_cast<JackMidiBuffer*>(src_buffers[i]);
-            if (buf->mix_index >= buf->event_count)
-                continue;
-            JackMidiEvent* e = &buf->events[buf->mix_index];
-            if (!next_event || e->time < next_event->time) {
-                next_event = e;
-                next_buf = buf;
-            }
-        }
-        assert(next_event != 0);
+    if (heap_size == 0) {
+        return;
+    }
+
+    if (heap_size == 1 && sources[heap[0]]->buffer_size == mix->buffer_size) {
+        MidiBufferCopy(mix, sources[heap[0]]);
+        return;
+    }
 
-        // write the event
-        jack_midi_data_t* dest = mix->ReserveEvent(next_event->time, next_event->size);
-        if (!dest) {
+    for (int i = heap_size / 2 - 1; i >= 0; --i) {
+        MidiHeapDown(heap, heap_size, i, sources);
+    }
+
+    int events_done;
+    for (events_done = 0; events_done < event_count && heap_size > 0; ++events_done) {
+        JackMidiBuffer* next_buf = sources[heap[0]];
+        if (!mix->CopyEvent(&next_buf->events[next_buf->mix_index], next_buf)) {
             break;
         }
-        memcpy(dest, next_event->GetData(next_buf), next_event->size);
-        next_buf->mix_index++;
+        // the source is removed from the heap when all its events are written
+        if (++next_buf->mix_index >= next_buf->event_count) {
+            heap[0] = heap[--heap_size];
+        }
+        MidiHeapDown(heap, heap_size, 0, sources);
     }
     mix->lost_events += event_count - events_done;
 }
 
-static size_t MidiBufferSize()
+static size_t MidiBufferSize(jack_nframes_t buffer_size)
 {
     return BUFFER_SIZE_MAX * sizeof(jack_default_audio_sample_t);
 }
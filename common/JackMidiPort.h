@@ -95,9 +95,13 @@ struct SERVER_EXPORT JackMidiBuffer
 
     // checks only size constraints.
     jack_midi_data_t* ReserveEvent(jack_nframes_t time, jack_shmsize_t size);
+
+    // copies an event of another buffer, inline events are copied as a whole.
+    bool CopyEvent(const JackMidiEvent* event, void* src_buffer);
 };
 
-void MidiBufferInit(void* buffer, size_t buffer_size, jack_nframes_t nframes);
+SERVER_EXPORT void MidiBufferInit(void* buffer, size_t buffer_size, jack_nframes_t nframes);
+SERVER_EXPORT void MidiBufferMixdown(void* mixbuffer, void** src_buffers, int src_count, jack_nframes_t nframes);
 
 } // namespace Jack
 
@@ -124,6 +124,11 @@ namespace Jack
                     fRingbufferCurSize = param->value.ui;
                     fAdaptative = false;
                     break;
+            #ifdef NET_BATCH_IO
+                case 'b':
+                    SetBatchIO(true);
+                    break;
+            #endif
              }
         }
 
@@ -454,7 +459,7 @@ extern "C"
         jack_driver_descriptor_add_parameter(desc, &filler, "latency", 'l', JackDriverParamUInt, &value, NULL, "Network latency", NULL);
 
         value.i = 0;
-        jack_driver_descriptor_add_parameter(desc, &filler, "quality", 'q', JackDriverParamInt, &value, NULL, "Resample algorithm quality (0 - 4)", NULL);
+        jack_driver_descriptor_add_parameter(desc, &filler, "quality", 'q', JackDriverParamInt, &value, NULL, "Resample algorithm quality (0 - 4, 5 for built-in polyphase)", NULL);
 
         value.i = 32768;
         jack_driver_descriptor_add_parameter(desc, &filler, "ring-buffer", 'g', JackDriverParamInt, &value, NULL, "Fixed ringbuffer size", "Fixed ringbuffer size (if not set => automatic adaptative)");
@@ -462,6 +467,11 @@ extern "C"
         value.i = false;
         jack_driver_descriptor_add_parameter(desc, &filler, "auto-connect", 'c', JackDriverParamBool, &value, NULL, "Auto connect netadapter to system ports", NULL);
 
+    #ifdef NET_BATCH_IO
+        value.i = false;
+        jack_driver_descriptor_add_parameter(desc, &filler, "batch", 'b', JackDriverParamBool, &value, NULL, "Send and receive the network packets by batch", "Send and receive the audio packets of a cycle with one system call (sendmmsg/recvmmsg)");
+    #endif
+
         return desc;
     }
 
@@ -235,7 +235,10 @@ namespace Jack
         fNetTimeMon->SetPlotFile(net_time_mon_options, 2, net_time_mon_fields, 5);
 #endif
         // Driver parametering
-        JackTimedDriver::SetBufferSize(fParams.fPeriodSize);
+        if (JackTimedDriver::SetBufferSize(fParams.fPeriodSize) < 0) {
+            jack_error("Can't set buffer size = %ld", fParams.fPeriodSize);
+            return false;
+        }
         JackTimedDriver::SetSampleRate(fParams.fSampleRate);
 
         JackDriver::NotifyBufferSize(fParams.fPeriodSize);
@@ -334,7 +337,7 @@ namespace Jack
             }
 
             port = fGraphManager->GetPort(port_index);
-            port->SetAlias(alias);
+            fGraphManager->SetPortAlias(port_index, alias);
             fCapturePortList[audio_port_index] = port_index;
             jack_log("JackNetDriver::AllocPorts() fCapturePortList[%d] audio_port_index = %ld fPortLatency = %ld", audio_port_index, port_index, port->GetLatency());
         }
@@ -349,7 +352,7 @@ namespace Jack
             }
 
             port = fGraphManager->GetPort(port_index);
-            port->SetAlias(alias);
+            fGraphManager->SetPortAlias(port_index, alias);
             fPlaybackPortList[audio_port_index] = port_index;
             jack_log("JackNetDriver::AllocPorts() fPlaybackPortList[%d] audio_port_index = %ld fPortLatency = %ld", audio_port_index, port_index, port->GetLatency());
         }
@@ -714,6 +717,11 @@ Deactivated for now..
             value.ui = 5U;
             jack_driver_descriptor_add_parameter(desc, &filler, "latency", 'l', JackDriverParamUInt, &value, NULL, "Network latency", NULL);
 
+#ifdef NET_BATCH_IO
+            value.i = false;
+            jack_driver_descriptor_add_parameter(desc, &filler, "batch", 'b', JackDriverParamBool, &value, NULL, "Send and receive the network packets by batch", "Send and receive the audio packets of a cycle with one system call (sendmmsg/recvmmsg)");
+#endif
+
             return desc;
         }
 
@@ -738,6 +746,7 @@ Deactivated for now..
             const JSList* node;
             const jack_driver_param_t* param;
             bool auto_save = false;
+            bool batch_io = false;
 
             // Possibly use env variable for UDP port
             const char* default_udp_port = getenv("JACK_NETJACK_PORT");
@@ -789,6 +798,11 @@ Deactivated for now..
                     case 's':
                         auto_save = true;
                         break;
+                    #ifdef NET_BATCH_IO
+                    case 'b':
+                        batch_io = true;
+                        break;
+                    #endif
                     /*
                     Deactivated for now..
                     case 't' :
@@ -807,11 +821,14 @@ Deactivated for now..
 
             try {
 
-                Jack::JackDriverClientInterface* driver = new Jack::JackWaitThreadedDriver(
-                        new Jack::JackNetDriver("system", "net_pcm", engine, table, multicast_ip, udp_port, mtu,
+                Jack::JackNetDriver* net_driver = new Jack::JackNetDriver("system", "net_pcm", engine, table, multicast_ip, udp_port, mtu,
                                                 midi_input_ports, midi_output_ports,
                                                 net_name, transport_sync,
-                                                network_latency, celt_encoding, opus_encoding, auto_save));
+                                                network_latency, celt_encoding, opus_encoding, auto_save);
+            #ifdef NET_BATCH_IO
+                net_driver->SetBatchIO(batch_io);
+            #endif
+                Jack::JackDriverClientInterface* driver = new Jack::JackWaitThreadedDriver(net_driver);
                 if (driver->Open(period_size, sample_rate, 1, 1, audio_capture_ports, audio_playback_ports, monitor, "from_master_", "to_master_", 0, 0) == 0) {
                     return driver;
                 } else {
@@ -64,6 +64,10 @@ namespace Jack
         memset(&fSendTransportData, 0, sizeof(net_transport_data_t));
         memset(&fReturnTransportData, 0, sizeof(net_transport_data_t));
         fPacketTimeOut = PACKET_TIMEOUT;
+    #ifdef NET_BATCH_IO
+        fBatchIO = false;
+        fTxBatchBuffer = NULL;
+    #endif
     }
 
     void JackNetInterface::FreeNetworkBuffers()
@@ -85,6 +89,9 @@ namespace Jack
         fSocket.Close();
         delete[] fTxBuffer;
         delete[] fRxBuffer;
+    #ifdef NET_BATCH_IO
+        delete[] fTxBatchBuffer;
+    #endif
         delete fNetAudioCaptureBuffer;
         delete fNetAudioPlaybackBuffer;
         delete fNetMidiCaptureBuffer;
@@ -148,6 +155,21 @@ namespace Jack
         fTxData = fTxBuffer + HEADER_SIZE;
         fRxData = fRxBuffer + HEADER_SIZE;
 
+    #ifdef NET_BATCH_IO
+        if (fBatchIO) {
+            jack_info("Network packets are sent and received by batch");
+            delete[] fTxBatchBuffer;
+            fTxBatchBuffer = new char[NET_BATCH_MAX * fParams.fMtu];
+            memset(fTxBatch, 0, sizeof(fTxBatch));
+            for (int i = 0; i < NET_BATCH_MAX; i++) {
+                fTxBatchIov[i].iov_base = fTxBatchBuffer + i * fParams.fMtu;
+                fTxBatch[i].msg_hdr.msg_iov = &fTxBatchIov[i];
+                fTxBatch[i].msg_hdr.msg_iovlen = 1;
+            }
+            fSocket.SetRecvBatch(NET_BATCH_MAX, fParams.fMtu);
+        }
+    #endif
+
         return true;
     }
 
@@ -180,6 +202,12 @@ namespace Jack
             fTxHeader.fActivePorts = buffer->RenderFromJackPorts(fTxHeader.fFrames);
             fTxHeader.fNumPacket = buffer->GetNumPackets(fTxHeader.fActivePorts);
 
+        #ifdef NET_BATCH_IO
+            if (fBatchIO) {
+                return AudioSendBatch(buffer);
+            }
+        #endif
+
             for (uint subproc = 0; subproc < fTxHeader.fNumPacket; subproc++) {
                 fTxHeader.fSubCycle = subproc;
                 fTxHeader.fIsLastPckt = (subproc == (fTxHeader.fNumPacket - 1)) ? 1 : 0;
@@ -194,6 +222,31 @@ namespace Jack
         return 0;
     }
 
+#ifdef NET_BATCH_IO
+    int JackNetInterface::AudioSendBatch(NetAudioBuffer* buffer)
+    {
+        unsigned int packets = 0;
+
+        for (uint subproc = 0; subproc < fTxHeader.fNumPacket; subproc++) {
+            // Each packet of the batch is rendered in its own buffer
+            char* packet = fTxBatchBuffer + packets * fParams.fMtu;
+            fTxHeader.fSubCycle = subproc;
+            fTxHeader.fIsLastPckt = (subproc == (fTxHeader.fNumPacket - 1)) ? 1 : 0;
+            fTxHeader.fPacketSize = HEADER_SIZE + buffer->RenderToNetwork(subproc, fTxHeader.fActivePorts, packet + HEADER_SIZE);
+            PacketHeaderHToN(&fTxHeader, reinterpret_cast<packet_header_t*>(packet));
+            fTxBatchIov[packets].iov_len = fTxHeader.fPacketSize;
+
+            if (++packets == NET_BATCH_MAX || fTxHeader.fIsLastPckt) {
+                if (SendBatch(packets) == SOCKET_ERROR) {
+                    return SOCKET_ERROR;
+                }
+                packets = 0;
+            }
+        }
+        return 0;
+    }
+#endif
+
     int JackNetInterface::MidiRecv(packet_header_t* rx_head, NetMidiBuffer* buffer, uint& recvd_midi_pckt)
     {
         int rx_bytes = Recv(rx_head->fPacketSize, 0);
@@ -451,6 +504,18 @@ namespace Jack
         return tx_bytes;
     }
 
+#ifdef NET_BATCH_IO
+    int JackNetMasterInterface::SendBatch(unsigned int count)
+    {
+        int tx_bytes;
+
+        if (((tx_bytes = fSocket.SendBatch(fTxBatch, count, 0)) == SOCKET_ERROR) && fRunning) {
+            FatalSendError();
+        }
+        return tx_bytes;
+    }
+#endif
+
     int JackNetMasterInterface::SyncSend()
     {
         SetRcvTimeOut();
@@ -858,6 +923,20 @@ namespace Jack
         return tx_bytes;
     }
 
+#ifdef NET_BATCH_IO
+    int JackNetSlaveInterface::SendBatch(unsigned int count)
+    {
+        int tx_bytes = fSocket.SendBatch(fTxBatch, count, 0);
+
+        // handle errors
+        if (tx_bytes == SOCKET_ERROR) {
+            FatalSendError();
+        }
+
+        return tx_bytes;
+    }
+#endif
+
     int JackNetSlaveInterface::SyncRecv()
     {
         SetRcvTimeOut();
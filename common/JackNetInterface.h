@@ -80,6 +80,14 @@ namespace Jack
             NetAudioBuffer* fNetAudioCaptureBuffer;
             NetAudioBuffer* fNetAudioPlaybackBuffer;
 
+        #ifdef NET_BATCH_IO
+            // batched I/O ('batch' parameter set) : audio packets are rendered in their own buffer and sent together
+            bool fBatchIO;
+            char* fTxBatchBuffer;
+            struct mmsghdr fTxBatch[NET_BATCH_MAX];
+            struct iovec fTxBatchIov[NET_BATCH_MAX];
+        #endif
+
             // utility methods
             int SetNetBufferSize();
             void FreeNetworkBuffers();
@@ -109,6 +117,10 @@ namespace Jack
 
             int MidiSend(NetMidiBuffer* buffer, int midi_channnels, int audio_channels);
             int AudioSend(NetAudioBuffer* buffer, int audio_channels);
+        #ifdef NET_BATCH_IO
+            int AudioSendBatch(NetAudioBuffer* buffer);
+            virtual int SendBatch(unsigned int count) = 0;
+        #endif
 
             int MidiRecv(packet_header_t* rx_head, NetMidiBuffer* buffer, uint& recvd_midi_pckt);
             int AudioRecv(packet_header_t* rx_head, NetAudioBuffer* buffer);
@@ -133,6 +145,14 @@ namespace Jack
 
             virtual ~JackNetInterface();
 
+        #ifdef NET_BATCH_IO
+            // to be set before the network buffers are allocated
+            void SetBatchIO(bool onoff)
+            {
+                fBatchIO = onoff;
+            }
+        #endif
+
     };
 
     /**
@@ -166,6 +186,9 @@ namespace Jack
 
             int Send(size_t size, int flags);
             int Recv(size_t size, int flags);
+        #ifdef NET_BATCH_IO
+            int SendBatch(unsigned int count);
+        #endif
 
             void FatalRecvError();
             void FatalSendError();
@@ -223,6 +246,9 @@ namespace Jack
 
             int Recv(size_t size, int flags);
             int Send(size_t size, int flags);
+        #ifdef NET_BATCH_IO
+            int SendBatch(unsigned int count);
+        #endif
 
             void FatalRecvError();
             void FatalSendError();
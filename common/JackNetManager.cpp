@@ -36,6 +36,14 @@ namespace Jack
         //settings
         fName = const_cast<char*>(fParams.fName);
         fClient = NULL;
+        fManager = NULL;
+        fReceived = true;
+        fRxPackets = NULL;
+        fRxPacketSize = NULL;
+        fRxPacketMax = 0;
+        fRxPacketCount = 0;
+        fRxPacketRead = 0;
+        fRxError = false;
         fSendTransportData.fState = -1;
         fReturnTransportData.fState = -1;
         fLastTransportState = -1;
@@ -101,13 +109,15 @@ namespace Jack
         delete[] fAudioPlaybackPorts;
         delete[] fMidiCapturePorts;
         delete[] fMidiPlaybackPorts;
+        delete[] fRxPackets;
+        delete[] fRxPacketSize;
 #ifdef JACK_MONITOR
         fNetTimeMon->Save();
         delete fNetTimeMon;
 #endif
     }
 //init--------------------------------------------------------------------------------
-    bool JackNetMaster::Init(bool auto_connect)
+    bool JackNetMaster::Init(bool auto_connect, JackNetMasterManager* manager)
     {
         //network init
         if (!JackNetMasterInterface::Init()) {
@@ -128,6 +138,16 @@ namespace Jack
             return false;
         }
         
+        //the packets of a cycle are received by the manager while the master sends its own
+        if (manager) {
+            float audio_size = (fNetAudioPlaybackBuffer) ? fNetAudioPlaybackBuffer->GetCycleSize() : 0;
+            float midi_size = (fNetMidiPlaybackBuffer) ? fNetMidiPlaybackBuffer->GetCycleSize() : 0;
+            fRxPacketMax = 2 + int(audio_size + midi_size) / fParams.fMtu;
+            fRxPackets = new char[fRxPacketMax * fParams.fMtu];
+            fRxPacketSize = new int[fRxPacketMax];
+            fManager = manager;
+        }
+
         if (jack_set_process_callback(fClient, SetProcess, this) < 0) {
             goto fail;
         }
@@ -520,8 +540,17 @@ namespace Jack
         fNetTimeMon->Add((((float)(GetMicroSeconds() - begin_time)) / (float) fPeriodUsecs) * 100.f);
 #endif
 
+        // the slave answer is received by the manager while the data is sent
+        if (fManager) {
+            fManager->Receive(this);
+        }
+
         // send data
-        if (DataSend() == SOCKET_ERROR) {
+        int res = DataSend();
+        if (fManager) {
+            WaitReceive();
+        }
+        if (res == SOCKET_ERROR) {
             return SOCKET_ERROR;
         }
 
@@ -530,7 +559,7 @@ namespace Jack
 #endif
 
         // receive sync
-        int res = SyncRecv();
+        res = SyncRecv();
         switch (res) {
         
             case NET_SYNCHING:
@@ -571,6 +600,89 @@ namespace Jack
 #endif
         return 0;
     }
+
+    void JackNetMaster::Receive()
+    {
+        // Takes the packets SyncRecv then DataRecv would take, anything else is left in the socket for them
+        packet_header_t rx_head;
+        bool sync = true;
+        fRxPacketCount = 0;
+        fRxPacketRead = 0;
+        fRxError = false;
+
+        while (fRxPacketCount < fRxPacketMax) {
+            char* packet = fRxPackets + fRxPacketCount * fParams.fMtu;
+            if (fSocket.Recv(packet, fParams.fMtu, MSG_PEEK) == SOCKET_ERROR) {
+                fRxError = true;
+                return;
+            }
+            PacketHeaderNToH(reinterpret_cast<packet_header_t*>(packet), &rx_head);
+            if (strcmp(rx_head.fPacketType, "header") != 0) {
+                return;
+            }
+            if (sync) {
+                // sync packet of the cycle, when the master is synched
+                int cycle_offset = fTxHeader.fCycle - rx_head.fCycle;
+                if (rx_head.fDataType != 's' || (cycle_offset < fMaxCycleOffset && !fSynched)) {
+                    return;
+                }
+                sync = false;
+            } else if (rx_head.fDataStream != 'r' || rx_head.fID != fParams.fID
+                       || (rx_head.fDataType != 'm' && rx_head.fDataType != 'a')) {
+                return;
+            }
+            int rx_bytes = fSocket.Recv(packet, fParams.fMtu, 0);
+            if (rx_bytes == SOCKET_ERROR) {
+                fRxError = true;
+                return;
+            }
+            fRxPacketSize[fRxPacketCount++] = rx_bytes;
+            if (rx_head.fIsLastPckt) {
+                return;
+            }
+        }
+    }
+
+    void JackNetMaster::WaitReceive()
+    {
+        fReceiveSync.Lock();
+        while (!fReceived) {
+            fReceiveSync.Wait();
+        }
+        fReceiveSync.Unlock();
+    }
+
+    int JackNetMaster::Recv(size_t size, int flags)
+    {
+        // packets received by the manager first, then the socket
+        if (fRxPacketRead < fRxPacketCount) {
+            int rx_bytes = min(fRxPacketSize[fRxPacketRead], int(size));
+            memcpy(fRxBuffer, fRxPackets + fRxPacketRead * fParams.fMtu, rx_bytes);
+            if (!(flags & MSG_PEEK)) {
+                fRxPacketRead++;
+            }
+            packet_header_t* header = reinterpret_cast<packet_header_t*>(fRxBuffer);
+            PacketHeaderNToH(header, header);
+            return rx_bytes;
+        } else if (fRxError) {
+            fRxError = false;
+            if (fRunning) {
+                FatalRecvError();
+            }
+            return SOCKET_ERROR;
+        } else {
+            return JackNetMasterInterface::Recv(size, flags);
+        }
+    }
+
+    void JackNetMaster::FatalSendError()
+    {
+        // the manager may still be receiving for the master
+        if (fManager) {
+            WaitReceive();
+        }
+        JackNetMasterInterface::FatalSendError();
+    }
     
     void JackNetMaster::SaveConnections(connections_list_t& connections)
     {
@@ -623,10 +735,16 @@ namespace Jack
     
     void JackNetMaster::LoadConnections(const connections_list_t& connections)
     {
+        // All connections are restored with a single request
+        vector<const char*> sources;
+        vector<const char*> destinations;
         list<pair<string, string> >::const_iterator it;
         for (it = connections.begin(); it != connections.end(); it++) {
-            pair<string, string> connection = *it;
-            jack_connect(fClient, connection.first.c_str(), connection.second.c_str());
+            sources.push_back(it->first.c_str());
+            destinations.push_back(it->second.c_str());
+        }
+        if (sources.size() > 0) {
+            jack_connect_list(fClient, &sources[0], &destinations[0], sources.size(), NULL);
         }
     }
 
@@ -643,6 +761,12 @@ namespace Jack
         fRunning = true;
         fAutoConnect = false;
         fAutoSave = false;
+        fBatchIO = false;
+        fThreadCount = 0;
+        fReceiveThread = NULL;
+        fReceiveRead = 0;
+        fReceiveWrite = 0;
+        fReceiveStopping = false;
 
         const JSList* node;
         const jack_driver_param_t* param;
@@ -683,6 +807,16 @@ namespace Jack
                 case 's':
                     fAutoSave = true;
                     break;
+
+                case 't':
+                    fThreadCount = param->value.ui;
+                    break;
+
+            #ifdef NET_BATCH_IO
+                case 'b':
+                    fBatchIO = true;
+                    break;
+            #endif
             }
         }
 
@@ -694,6 +828,10 @@ namespace Jack
             jack_error("Can't activate the NetManager client, transport disabled");
         }
 
+        if (fThreadCount > 0) {
+            StartReceiveThreads();
+        }
+
         //launch the manager thread
         if (jack_client_create_thread(fClient, &fThread, 0, 0, NetManagerThread, this)) {
             jack_error("Can't create the NetManager control thread");
@@ -734,6 +872,7 @@ namespace Jack
             delete (*it);
         }
         fMasterList.clear();
+        StopReceiveThreads();
         fSocket.Close();
         SocketAPIEnd();
     }
@@ -757,6 +896,82 @@ namespace Jack
         return res;
     }
 
+    void JackNetMasterManager::Receive(JackNetMaster* master)
+    {
+        // a master waits for its packets before being queued again : the queue can't overflow
+        master->fReceived = false;
+        fReceiveSignal.Lock();
+        fReceiveQueue[fReceiveWrite] = master;
+        fReceiveWrite = (fReceiveWrite + 1) % CLIENT_NUM;
+        fReceiveSignal.Signal();
+        fReceiveSignal.Unlock();
+    }
+
+    void* JackNetMasterManager::ReceiveThread(void* arg)
+    {
+        static_cast<JackNetMasterManager*>(arg)->RunReceiveThread();
+        return NULL;
+    }
+
+    void JackNetMasterManager::RunReceiveThread()
+    {
+        fReceiveSignal.Lock();
+        while (true) {
+            while (fReceiveRead == fReceiveWrite && !fReceiveStopping) {
+                fReceiveSignal.Wait();
+            }
+            if (fReceiveStopping) {
+                break;
+            }
+            JackNetMaster* master = fReceiveQueue[fReceiveRead];
+            fReceiveRead = (fReceiveRead + 1) % CLIENT_NUM;
+            fReceiveSignal.Unlock();
+
+            master->Receive();
+            master->fReceiveSync.Lock();
+            master->fReceived = true;
+            master->fReceiveSync.Signal();
+            master->fReceiveSync.Unlock();
+
+            fReceiveSignal.Lock();
+        }
+        fReceiveSignal.Unlock();
+    }
+
+    void JackNetMasterManager::StartReceiveThreads()
+    {
+        jack_info("NetManager receives the slaves packets with %d thread(s)", fThreadCount);
+        fReceiveThread = new jack_native_thread_t[fThreadCount];
+        for (int i = 0; i < fThreadCount; i++) {
+            if (jack_client_create_thread(fClient, &fReceiveThread[i], jack_client_real_time_priority(fClient),
+                                          jack_is_realtime(fClient), ReceiveThread, this)) {
+                jack_error("Can't create the NetManager receive thread %d", i);
+                fThreadCount = i;
+                break;
+            }
+        }
+        //each master receives its packets itself
+        if (fThreadCount == 0) {
+            delete [] fReceiveThread;
+            fReceiveThread = NULL;
+        }
+    }
+
+    void JackNetMasterManager::StopReceiveThreads()
+    {
+        if (fReceiveThread) {
+            fReceiveSignal.Lock();
+            fReceiveStopping = true;
+            fReceiveSignal.SignalAll();
+            fReceiveSignal.Unlock();
+            for (int i = 0; i < fThreadCount; i++) {
+                jack_client_stop_thread(fClient, fReceiveThread[i]);
+            }
+            delete [] fReceiveThread;
+            fReceiveThread = NULL;
+        }
+    }
+
     void* JackNetMasterManager::NetManagerThread(void* arg)
     {
         JackNetMasterManager* master_manager = static_cast<JackNetMasterManager*>(arg);
@@ -888,7 +1103,10 @@ namespace Jack
 
         //create a new master and add it to the list
         JackNetMaster* master = new JackNetMaster(fSocket, params, fMulticastIP);
-        if (master->Init(fAutoConnect)) {
+    #ifdef NET_BATCH_IO
+        master->SetBatchIO(fBatchIO);
+    #endif
+        if (master->Init(fAutoConnect, (fThreadCount > 0) ? this : NULL)) {
             fMasterList.push_back(master);
             if (fAutoSave && fMasterConnectionList.find(params.fName) != fMasterConnectionList.end()) {
                 master->LoadConnections(fMasterConnectionList[params.fName]);
@@ -923,8 +1141,9 @@ namespace Jack
                 fMasterConnectionList[params->fName].clear();
                 (*master_it)->SaveConnections(fMasterConnectionList[params->fName]);
             }
+            JackNetMaster* master = *master_it;
             fMasterList.erase(master_it);
-            delete (*master_it);
+            delete master;
             return 1;
         }
         return 0;
@@ -958,6 +1177,14 @@ extern "C"
         value.i = false;
         jack_driver_descriptor_add_parameter(desc, &filler, "auto-save", 's', JackDriverParamBool, &value, NULL, "Save/restore netmaster connection state when restarted", NULL);
 
+        value.ui = 0;
+        jack_driver_descriptor_add_parameter(desc, &filler, "threads", 't', JackDriverParamUInt, &value, NULL, "Threads receiving the slaves packets", "Number of threads receiving the slaves packets while the masters send theirs (0 : each master receives its packets itself)");
+
+    #ifdef NET_BATCH_IO
+        value.i = false;
+        jack_driver_descriptor_add_parameter(desc, &filler, "batch", 'b', JackDriverParamBool, &value, NULL, "Send and receive the network packets by batch", "Send and receive the audio packets of a cycle with one system call (sendmmsg/recvmmsg)");
+    #endif
+
         return desc;
     }
 
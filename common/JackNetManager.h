@@ -21,6 +21,7 @@ Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
 #define __JACKNETMANAGER_H__
 
 #include "JackNetInterface.h"
+#include "JackPlatformPlug.h"
 #include "jack.h"
 #include <list>
 #include <map>
@@ -52,6 +53,19 @@ namespace Jack
             jack_client_t* fClient;
             const char* fName;
 
+            //manager receiving the slave packets while the master encodes and sends (threads mode), or NULL
+            JackNetMasterManager* fManager;
+            JackProcessSync fReceiveSync;       // Signaled when the packets of the cycle are received
+            bool fReceived;
+
+            //packets of the cycle received by the manager, decoded by Recv in the master cycle
+            char* fRxPackets;
+            int* fRxPacketSize;
+            int fRxPacketMax;
+            int fRxPacketCount;
+            int fRxPacketRead;
+            bool fRxError;
+
             //jack ports
             jack_port_t** fAudioCapturePorts;
             jack_port_t** fAudioPlaybackPorts;
@@ -67,7 +81,7 @@ namespace Jack
             JackGnuPlotMonitor<float>* fNetTimeMon;
 #endif
 
-            bool Init(bool auto_connect);
+            bool Init(bool auto_connect, JackNetMasterManager* manager);
             int AllocPorts();
             void FreePorts();
 
@@ -76,6 +90,8 @@ namespace Jack
             void DecodeTransportData();
 
             int Process();
+            void Receive();
+            void WaitReceive();
             void TimebaseCallback(jack_position_t* pos);
             void ConnectPorts();
             void ConnectCallback(jack_port_id_t a, jack_port_id_t b, int connect);
@@ -83,6 +99,9 @@ namespace Jack
             void SaveConnections(connections_list_t& connections);
             void LoadConnections(const connections_list_t& connections);
 
+            int Recv(size_t size, int flags);
+            void FatalSendError();
+
         public:
 
             JackNetMaster(JackNetSocket& socket, session_params_t& params, const char* multicast_ip);
@@ -108,6 +127,7 @@ namespace Jack
             static void SetShutDown(void* arg);
             static int SetSyncCallback(jack_transport_state_t state, jack_position_t* pos, void* arg);
             static void* NetManagerThread(void* arg);
+            static void* ReceiveThread(void* arg);
 
             jack_client_t* fClient;
             const char* fName;
@@ -120,8 +140,22 @@ namespace Jack
             bool fRunning;
             bool fAutoConnect;
             bool fAutoSave;
+            bool fBatchIO;
+
+            //threads receiving the slave packets while the masters encode and send theirs
+            int fThreadCount;                           // Receiving threads, 0 if each master receives its packets itself
+            jack_native_thread_t* fReceiveThread;
+            JackProcessSync fReceiveSignal;             // Protects the queue, wakes the receiving threads
+            JackNetMaster* fReceiveQueue[CLIENT_NUM];   // Masters waiting for their packets, one entry at most per master
+            int fReceiveRead;
+            int fReceiveWrite;
+            bool fReceiveStopping;
 
             void Run();
+            void Receive(JackNetMaster* master);
+            void RunReceiveThread();
+            void StartReceiveThreads();
+            void StopReceiveThreads();
             JackNetMaster* InitMaster(session_params_t& params);
             master_list_it_t FindMaster(uint32_t client_id);
             int KillMaster(session_params_t* params);
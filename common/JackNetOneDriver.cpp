@@ -262,7 +262,10 @@ bool JackNetOneDriver::Initialize()
 
     //monitor
     //driver parametering
-    JackTimedDriver::SetBufferSize(netj.period_size);
+    if (JackTimedDriver::SetBufferSize(netj.period_size) < 0) {
+        jack_error("Can't set buffer size = %ld", netj.period_size);
+        return false;
+    }
     JackTimedDriver::SetSampleRate(netj.sample_rate);
 
     JackDriver::NotifyBufferSize(netj.period_size);
@@ -327,6 +327,16 @@ namespace Jack
             virtual int RenderFromNetwork(int cycle, int sub_cycle, uint32_t port_num) = 0;
             virtual int RenderToNetwork(int sub_cycle, uint32_t port_num) = 0;
 
+            // renders the packet data in the given buffer instead of the network buffer
+            int RenderToNetwork(int sub_cycle, uint32_t port_num, char* net_buffer)
+            {
+                char* buffer = fNetBuffer;
+                fNetBuffer = net_buffer;
+                int res = RenderToNetwork(sub_cycle, port_num);
+                fNetBuffer = buffer;
+                return res;
+            }
+
             virtual int ActivePortsToNetwork(char* net_buffer);
             virtual void ActivePortsFromNetwork(char* net_buffer, uint32_t port_num);
 
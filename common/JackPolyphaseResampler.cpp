@@ -0,0 +1,424 @@
+/*
+Copyright (C) 2026 agent
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+#include "JackPolyphaseResampler.h"
+#include "JackError.h"
+
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+
+#if defined (__SSE__) && !defined (__sun__)
+#include <xmmintrin.h>
+#endif
+
+// Kernels using larger vectors are compiled for their instruction set and chosen at run time on CPU features
+#if (defined (__i386__) || defined (__x86_64__)) && defined (__SSE__) && !defined (__APPLE__) && !defined (__sun__) \
+    && (defined (__clang__) || __GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))
+#define JACK_POLYPHASE_DISPATCH
+#include <immintrin.h>
+#endif
+
+#define POLYPHASE_CUTOFF    0.44    // Relatively to the input sample rate
+#define POLYPHASE_BETA      8.0     // Kaiser window parameter, about 80 dB of stopband attenuation
+
+namespace Jack
+{
+
+/*
+Filter p of the bank is the kernel of an output frame located at p / POLYPHASE_PHASES after an input frame :
+tap k applies to the input frame at POLYPHASE_TAPS / 2 - 1 - k before this one. The kernel of an output frame
+in between two filters is linearly interpolated from them.
+*/
+
+static float gPolyphaseFilters[POLYPHASE_PHASES + 1][POLYPHASE_TAPS];
+
+static double BesselI0(double x)
+{
+    double sum = 1;
+    double term = 1;
+    for (int k = 1; k < 64 && term > sum * 1e-17; k++) {
+        double half = x / (2 * k);
+        term *= half * half;
+        sum += term;
+    }
+    return sum;
+}
+
+static bool BuildPolyphaseFilters()
+{
+    const double half = POLYPHASE_TAPS / 2;
+    const double norm = BesselI0(POLYPHASE_BETA);
+
+    for (int p = 0; p <= POLYPHASE_PHASES; p++) {
+        double coefs[POLYPHASE_TAPS];
+        double sum = 0;
+        for (int k = 0; k < POLYPHASE_TAPS; k++) {
+            double x = double(p) / POLYPHASE_PHASES + half - 1 - k;
+            double r = x / half;
+            double window = (fabs(r) < 1) ? BesselI0(POLYPHASE_BETA * sqrt(1 - r * r)) / norm : 0;
+            double arg = M_PI * 2 * POLYPHASE_CUTOFF * x;
+            double sinc = (x == 0) ? 1 : sin(arg) / arg;
+            coefs[k] = 2 * POLYPHASE_CUTOFF * sinc * window;
+            sum += coefs[k];
+        }
+        // Unity gain at DC for all phases
+        for (int k = 0; k < POLYPHASE_TAPS; k++) {
+            gPolyphaseFilters[p][k] = float(coefs[k] / sum);
+        }
+    }
+
+    return true;
+}
+
+static bool gPolyphaseFiltersBuilt = BuildPolyphaseFilters();
+
+/*
+A frame is resampled on a group of channels at once : the kernel is interpolated once, then applied to each channel.
+Channels whose output is NULL are skipped.
+*/
+
+typedef void (*PolyphaseFrameFunction)(const float* filter,
+                                       float alpha,
+                                       jack_default_audio_sample_t* const* inputs,
+                                       unsigned int offset,
+                                       jack_default_audio_sample_t** outputs,
+                                       unsigned int frame,
+                                       int channels);
+
+static void ResampleFrame(const float* filter,
+                          float alpha,
+                          jack_default_audio_sample_t* const* inputs,
+                          unsigned int offset,
+                          jack_default_audio_sample_t** outputs,
+                          unsigned int frame,
+                          int channels)
+{
+    const float* next = filter + POLYPHASE_TAPS;
+    float kernel[POLYPHASE_TAPS];
+
+#if defined (__SSE__) && !defined (__sun__)
+    __m128 vec_alpha = _mm_set1_ps(alpha);
+    for (int k = 0; k < POLYPHASE_TAPS; k += 4) {
+        __m128 vec_filter = _mm_loadu_ps(filter + k);
+        _mm_storeu_ps(kernel + k, _mm_add_ps(vec_filter, _mm_mul_ps(vec_alpha, _mm_sub_ps(_mm_loadu_ps(next + k), vec_filter))));
+    }
+
+    for (int i = 0; i < channels; i++) {
+        if (outputs[i]) {
+            const jack_default_audio_sample_t* input = inputs[i] + offset;
+            __m128 sum0 = _mm_setzero_ps();
+            __m128 sum1 = _mm_setzero_ps();
+            for (int k = 0; k < POLYPHASE_TAPS; k += 8) {
+                sum0 = _mm_add_ps(sum0, _mm_mul_ps(_mm_loadu_ps(input + k), _mm_loadu_ps(kernel + k)));
+                sum1 = _mm_add_ps(sum1, _mm_mul_ps(_mm_loadu_ps(input + k + 4), _mm_loadu_ps(kernel + k + 4)));
+            }
+            sum0 = _mm_add_ps(sum0, sum1);
+            sum0 = _mm_add_ps(sum0, _mm_movehl_ps(sum0, sum0));
+            sum0 = _mm_add_ss(sum0, _mm_shuffle_ps(sum0, sum0, 1));
+            _mm_store_ss(outputs[i] + frame, sum0);
+        }
+    }
+#else
+    for (int k = 0; k < POLYPHASE_TAPS; k++) {
+        kernel[k] = filter[k] + alpha * (next[k] - filter[k]);
+    }
+
+    for (int i = 0; i < channels; i++) {
+        if (outputs[i]) {
+            const jack_default_audio_sample_t* input = inputs[i] + offset;
+            float sum = 0;
+            for (int k = 0; k < POLYPHASE_TAPS; k++) {
+                sum += input[k] * kernel[k];
+            }
+            outputs[i][frame] = sum;
+        }
+    }
+#endif
+}
+
+#ifdef JACK_POLYPHASE_DISPATCH
+
+__attribute__((target("avx")))
+static void ResampleFrameAVX(const float* filter,
+                             float alpha,
+                             jack_default_audio_sample_t* const* inputs,
+                             unsigned int offset,
+                             jack_default_audio_sample_t** outputs,
+                             unsigned int frame,
+                             int channels)
+{
+    const float* next = filter + POLYPHASE_TAPS;
+    __m256 kernel[POLYPHASE_TAPS / 8];
+
+    __m256 vec_alpha = _mm256_set1_ps(alpha);
+    for (int k = 0; k < POLYPHASE_TAPS / 8; k++) {
+        __m256 vec_filter = _mm256_loadu_ps(filter + 8 * k);
+        kernel[k] = _mm256_add_ps(vec_filter, _mm256_mul_ps(vec_alpha, _mm256_sub_ps(_mm256_loadu_ps(next + 8 * k), vec_filter)));
+    }
+
+    for (int i = 0; i < channels; i++) {
+        if (outputs[i]) {
+            const jack_default_audio_sample_t* input = inputs[i] + offset;
+            __m256 sum0 = _mm256_setzero_ps();
+            __m256 sum1 = _mm256_setzero_ps();
+            for (int k = 0; k < POLYPHASE_TAPS / 8; k += 2) {
+                sum0 = _mm256_add_ps(sum0, _mm256_mul_ps(_mm256_loadu_ps(input + 8 * k), kernel[k]));
+                sum1 = _mm256_add_ps(sum1, _mm256_mul_ps(_mm256_loadu_ps(input + 8 * k + 8), kernel[k + 1]));
+            }
+            sum0 = _mm256_add_ps(sum0, sum1);
+            __m128 sum = _mm_add_ps(_mm256_castps256_ps128(sum0), _mm256_extractf128_ps(sum0, 1));
+            sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+            sum = _mm_add_ss(sum, _mm_shuffle_ps(sum, sum, 1));
+            _mm_store_ss(outputs[i] + frame, sum);
+        }
+    }
+}
+
+#endif
+
+typedef unsigned int (*PolyphaseResampleFunction)(jack_default_audio_sample_t* const* inputs,
+                                                  jack_default_audio_sample_t** outputs,
+                                                  int channels,
+                                                  unsigned int count,
+                                                  double* position,
+                                                  double step,
+                                                  unsigned int frames);
+
+// Resamples up to 'frames' frames from the 'count' input frames, starting at 'position' which is updated
+template <PolyphaseFrameFunction resample_frame>
+static unsigned int ResampleAux(jack_default_audio_sample_t* const* inputs,
+                                jack_default_audio_sample_t** outputs,
+                                int channels,
+                                unsigned int count,
+                                double* position,
+                                double step,
+                                unsigned int frames)
+{
+    double pos = *position;
+    unsigned int frame = 0;
+
+    for (; frame < frames; frame++) {
+        unsigned int index = (unsigned int)pos;
+        // Last input frame used by the kernel not yet available
+        if (index + POLYPHASE_TAPS / 2 >= count) {
+            break;
+        }
+        double phase = (pos - index) * POLYPHASE_PHASES;
+        unsigned int filter = (unsigned int)phase;
+        resample_frame(gPolyphaseFilters[filter], float(phase - filter), inputs, index + 1 - POLYPHASE_TAPS / 2, outputs, frame, channels);
+        pos += step;
+    }
+
+    *position = pos;
+    return frame;
+}
+
+static const char* gPolyphaseKernelName = NULL;
+
+static PolyphaseResampleFunction SelectPolyphaseResample()
+{
+#ifdef JACK_POLYPHASE_DISPATCH
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx")) {
+        gPolyphaseKernelName = "avx";
+        return ResampleAux<ResampleFrameAVX>;
+    }
+#endif
+
+#if defined (__SSE__) && !defined (__sun__)
+    gPolyphaseKernelName = "sse";
+#else
+    gPolyphaseKernelName = "scalar";
+#endif
+    return ResampleAux<ResampleFrame>;
+}
+
+static PolyphaseResampleFunction gPolyphaseResample = SelectPolyphaseResample();
+
+JackPolyphaseResampler::JackPolyphaseResampler()
+    :JackResampler()
+{
+    Clear();
+}
+
+JackPolyphaseResampler::~JackPolyphaseResampler()
+{}
+
+const char* JackPolyphaseResampler::GetKernelName()
+{
+    return gPolyphaseKernelName;
+}
+
+void JackPolyphaseResampler::Clear()
+{
+    // The first output frame is the first input one : the filter only needs the frames after it
+    memset(fHistory, 0, sizeof(fHistory));
+    fCount = POLYPHASE_TAPS / 2 - 1;
+    fPosition = POLYPHASE_TAPS / 2 - 1;
+}
+
+void JackPolyphaseResampler::Discard(unsigned int frames)
+{
+    memmove(fHistory, fHistory + frames, (fCount - frames) * sizeof(jack_default_audio_sample_t));
+    fCount -= frames;
+    fPosition -= frames;
+}
+
+void JackPolyphaseResampler::Reset(unsigned int new_size)
+{
+    JackResampler::Reset(new_size);
+    Clear();
+}
+
+/*
+Resamples the frames available in the history of all channels, this resampler being the first one. They are written
+at 'offset' in buffers, or in the fOutput buffer of each resampler if buffers is NULL. Input frames no more needed are
+then discarded. All channels share the position of this resampler.
+*/
+
+unsigned int JackPolyphaseResampler::Resample(JackResampler** resamplers,
+                                              jack_default_audio_sample_t** buffers,
+                                              int channels,
+                                              unsigned int offset,
+                                              unsigned int frames)
+{
+    double step = 1 / fRatio;
+    double position = fPosition;
+    unsigned int count = fCount;
+    unsigned int res = 0;
+
+    for (int i = 0; i < channels; i += POLYPHASE_GROUP) {
+        int group = std::min(channels - i, POLYPHASE_GROUP);
+        jack_default_audio_sample_t* inputs[POLYPHASE_GROUP];
+        jack_default_audio_sample_t* outputs[POLYPHASE_GROUP];
+        for (int j = 0; j < group; j++) {
+            JackPolyphaseResampler* resampler = static_cast<JackPolyphaseResampler*>(resamplers[i + j]);
+            inputs[j] = resampler->fHistory;
+            if (buffers) {
+                outputs[j] = (buffers[i + j]) ? buffers[i + j] + offset : NULL;
+            } else {
+                outputs[j] = resampler->fOutput;
+            }
+        }
+        position = fPosition;
+        res = gPolyphaseResample(inputs, outputs, group, count, &position, step, frames);
+    }
+
+    unsigned int discarded = (unsigned int)position + 1 - POLYPHASE_TAPS / 2;
+    for (int i = 0; i < channels; i++) {
+        JackPolyphaseResampler* resampler = static_cast<JackPolyphaseResampler*>(resamplers[i]);
+        resampler->fPosition = position;
+        resampler->fCount = count;
+        resampler->Discard(discarded);
+    }
+
+    return res;
+}
+
+unsigned int JackPolyphaseResampler::ReadResample(jack_default_audio_sample_t* buffer, unsigned int frames)
+{
+    JackResampler* resampler = this;
+    return ReadResampleChannels(&resampler, &buffer, 1, frames);
+}
+
+unsigned int JackPolyphaseResampler::WriteResample(jack_default_audio_sample_t* buffer, unsigned int frames)
+{
+    JackResampler* resampler = this;
+    return WriteResampleChannels(&resampler, &buffer, 1, frames);
+}
+
+/*
+All resamplers have to be JackPolyphaseResampler, this one being the first. A NULL buffer is read as silence, and
+the frames resampled for a NULL output buffer are dropped : all channels stay in sync.
+*/
+
+unsigned int JackPolyphaseResampler::ReadResampleChannels(JackResampler** resamplers, jack_default_audio_sample_t** buffers, int channels, unsigned int frames)
+{
+    unsigned int written_frames = 0;
+
+    while (true) {
+
+        written_frames += Resample(resamplers, buffers, channels, written_frames, frames - written_frames);
+        if (written_frames == frames) {
+            break;
+        }
+
+        // Input frames needed for the remaining output frames, as much as the history can keep
+        double last_position = fPosition + double(frames - written_frames - 1) / fRatio;
+        unsigned int needed = (unsigned int)last_position + POLYPHASE_TAPS / 2 + 1 - fCount;
+        needed = std::min(needed, (unsigned int)(POLYPHASE_TAPS + POLYPHASE_CHUNK) - fCount);
+        for (int i = 0; i < channels; i++) {
+            needed = std::min(needed, resamplers[i]->ReadSpace());
+        }
+
+        if (needed == 0) {
+            jack_error("JackPolyphaseResampler::ReadResampleChannels : producer too slow, missing frames = %d", frames - written_frames);
+            break;
+        }
+
+        for (int i = 0; i < channels; i++) {
+            JackPolyphaseResampler* resampler = static_cast<JackPolyphaseResampler*>(resamplers[i]);
+            jack_ringbuffer_read(resampler->fRingBuffer, (char*)(resampler->fHistory + resampler->fCount), needed * sizeof(jack_default_audio_sample_t));
+            resampler->fCount += needed;
+        }
+    }
+
+    return written_frames;
+}
+
+unsigned int JackPolyphaseResampler::WriteResampleChannels(JackResampler** resamplers, jack_default_audio_sample_t** buffers, int channels, unsigned int frames)
+{
+    unsigned int read_frames = 0;
+
+    while (read_frames < frames) {
+
+        unsigned int chunk = std::min(frames - read_frames, (unsigned int)POLYPHASE_CHUNK);
+        for (int i = 0; i < channels; i++) {
+            JackPolyphaseResampler* resampler = static_cast<JackPolyphaseResampler*>(resamplers[i]);
+            jack_default_audio_sample_t* history = resampler->fHistory + resampler->fCount;
+            if (buffers[i]) {
+                memcpy(history, buffers[i] + read_frames, chunk * sizeof(jack_default_audio_sample_t));
+            } else {
+                memset(history, 0, chunk * sizeof(jack_default_audio_sample_t));
+            }
+            resampler->fCount += chunk;
+        }
+
+        unsigned int written_frames = Resample(resamplers, NULL, channels, 0, sizeof(fOutput) / sizeof(jack_default_audio_sample_t));
+
+        for (int i = 0; i < channels; i++) {
+            if (resamplers[i]->WriteSpace() < written_frames) {
+                jack_error("JackPolyphaseResampler::WriteResampleChannels : consumer too slow, skip frames = %d", frames - read_frames);
+                return read_frames;
+            }
+        }
+
+        for (int i = 0; i < channels; i++) {
+            JackPolyphaseResampler* resampler = static_cast<JackPolyphaseResampler*>(resamplers[i]);
+            jack_ringbuffer_write(resampler->fRingBuffer, (char*)resampler->fOutput, written_frames * sizeof(jack_default_audio_sample_t));
+        }
+
+        read_frames += chunk;
+    }
+
+    return read_frames;
+}
+
+}
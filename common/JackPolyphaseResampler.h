@@ -0,0 +1,82 @@
+/*
+Copyright (C) 2026 agent
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation; either version 2 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+
+You should have received a copy of the GNU General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+#ifndef __JackPolyphaseResampler__
+#define __JackPolyphaseResampler__
+
+#include "JackResampler.h"
+
+namespace Jack
+{
+
+#define POLYPHASE_TAPS      64      // Filter length, in input frames
+#define POLYPHASE_PHASES    256     // Filters in the bank, the ones in between are interpolated
+#define POLYPHASE_CHUNK     1024    // Input frames resampled at once
+#define POLYPHASE_GROUP     32      // Channels resampled at once
+
+#define POLYPHASE_QUALITY   5       // Adapter 'quality' parameter selecting this resampler, libsamplerate ones are 0 - 4
+
+/*!
+\brief Resampler using a bank of windowed sinc filters, with SSE/AVX inner loops.
+
+The filter cutoff is fixed relatively to the input sample rate : it is designed for the small ratio changes
+the adapters use to compensate clock drift, not for large sample rate conversions. All memory is allocated
+with the object, nothing is allocated while resampling. All channels of an adapter can be resampled in one call
+(ReadResampleChannels/WriteResampleChannels) : the filter for a frame is then computed once for all channels.
+*/
+
+class JackPolyphaseResampler : public JackResampler
+{
+
+    private:
+
+        jack_default_audio_sample_t fHistory[POLYPHASE_TAPS + POLYPHASE_CHUNK];     // Input frames still needed by the filter
+        jack_default_audio_sample_t fOutput[4 * POLYPHASE_CHUNK + 4];               // Resampled frames before being written in the ringbuffer
+        unsigned int fCount;        // Frames in fHistory
+        double fPosition;           // Position of the next output frame in fHistory
+
+        void Clear();
+        void Discard(unsigned int frames);
+
+        unsigned int Resample(JackResampler** resamplers,
+                              jack_default_audio_sample_t** buffers,
+                              int channels,
+                              unsigned int offset,
+                              unsigned int frames);
+
+    public:
+
+        JackPolyphaseResampler();
+        virtual ~JackPolyphaseResampler();
+
+        unsigned int ReadResample(jack_default_audio_sample_t* buffer, unsigned int frames);
+        unsigned int WriteResample(jack_default_audio_sample_t* buffer, unsigned int frames);
+
+        unsigned int ReadResampleChannels(JackResampler** resamplers, jack_default_audio_sample_t** buffers, int channels, unsigned int frames);
+        unsigned int WriteResampleChannels(JackResampler** resamplers, jack_default_audio_sample_t** buffers, int channels, unsigned int frames);
+
+        void Reset(unsigned int new_size);
+
+        // Name of the inner loops used on this machine
+        static const char* GetKernelName();
+
+    };
+}
+
+#endif
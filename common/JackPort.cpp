@@ -29,6 +29,7 @@ namespace Jack
 
 JackPort::JackPort()
 {
+    fBufferOffset = 0;
     Release();
 }
 
@@ -52,12 +53,7 @@ bool JackPort::Allocate(int refnum, const char* port_name, const char* port_type
     fTied = NO_PORT;
     fAlias1[0] = '\0';
     fAlias2[0] = '\0';
-    // DB: At this point we do not know current buffer size in frames,
-    // but every time buffer will be returned to any user,
-    // it will be called with either ClearBuffer or MixBuffers
-    // with correct current buffer size.
-    // So it is safe to init with 0 here.
-    ClearBuffer(0);
+    // The buffer is allocated and cleared by the graph manager
     return true;
 }
 
@@ -228,10 +224,8 @@ void JackPort::SetName(const char* new_name)
     snprintf(colon + 1, len, "%s", new_name);
 }
 
-bool JackPort::NameEquals(const char* target)
+const char* JackPort::TranslateName(const char* target, char* buf, size_t size)
 {
-    char buf[REAL_JACK_PORT_NAME_SIZE];
-
     /* this nasty, nasty kludge is here because between 0.109.0 and 0.109.1,
        the ALSA audio backend had the name "ALSA", whereas as before and
        after it, it was called "alsa_pcm". this stops breakage for
@@ -240,9 +234,17 @@ bool JackPort::NameEquals(const char* target)
     */
 
     if (strncmp(target, "ALSA:capture", 12) == 0 || strncmp(target, "ALSA:playback", 13) == 0) {
-        snprintf(buf, sizeof(buf), "alsa_pcm%s", target + 4);
-        target = buf;
+        snprintf(buf, size, "alsa_pcm%s", target + 4);
+        return buf;
+    } else {
+        return target;
     }
+}
+
+bool JackPort::NameEquals(const char* target)
+{
+    char buf[REAL_JACK_PORT_NAME_SIZE];
+    target = TranslateName(target, buf, sizeof(buf));
 
     return (strcmp(fName, target) == 0
             || strcmp(fAlias1, target) == 0
@@ -292,16 +294,16 @@ int JackPort::UnsetAlias(const char* alias)
     return 0;
 }
 
-void JackPort::ClearBuffer(jack_nframes_t frames)
+void JackPort::ClearBuffer(void* buffer, jack_nframes_t frames)
 {
     const JackPortType* type = GetPortType(fTypeId);
-    (type->init)(GetBuffer(), frames * sizeof(jack_default_audio_sample_t), frames);
+    (type->init)(buffer, frames * sizeof(jack_default_audio_sample_t), frames);
 }
 
-void JackPort::MixBuffers(void** src_buffers, int src_count, jack_nframes_t buffer_size)
+void JackPort::MixBuffers(void* buffer, void** src_buffers, int src_count, jack_nframes_t buffer_size)
 {
     const JackPortType* type = GetPortType(fTypeId);
-    (type->mixdown)(GetBuffer(), src_buffers, src_count, buffer_size);
+    (type->mixdown)(buffer, src_buffers, src_count, buffer_size);
 }
 
 } // end of namespace
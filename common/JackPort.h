@@ -24,6 +24,7 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 #include "types.h"
 #include "JackConstants.h"
 #include "JackCompilerDeps.h"
+#include "JackTypes.h"
 
 namespace Jack
 {
@@ -40,6 +41,7 @@ class SERVER_EXPORT JackPort
 {
 
         friend class JackGraphManager;
+        friend class JackPortNameIndex;
 
     private:
 
@@ -58,16 +60,22 @@ class SERVER_EXPORT JackPort
 
         bool fInUse;
         jack_port_id_t fTied;   // Locally tied source port
-        jack_default_audio_sample_t fBuffer[BUFFER_SIZE_MAX + 8];
+        UInt32 fMixCycle;       // Graph cycle of the last mixdown (or clear) of the input buffer
+        UInt32 fBufferOffset;   // Offset of the buffer in the port buffer pool, set by the graph manager
 
         bool IsUsed() const
         {
             return fInUse;
         }
 
+        // Names are indexed by the graph manager, only changed by it
+        void SetName(const char* name);
+        int SetAlias(const char* alias);
+        int UnsetAlias(const char* alias);
+
         // RT
-        void ClearBuffer(jack_nframes_t frames);
-        void MixBuffers(void** src_buffers, int src_count, jack_nframes_t frames);
+        void ClearBuffer(void* buffer, jack_nframes_t frames);
+        void MixBuffers(void* buffer, void** src_buffers, int src_count, jack_nframes_t frames);
 
     public:
 
@@ -77,12 +85,10 @@ class SERVER_EXPORT JackPort
         void Release();
         const char* GetName() const;
         const char* GetShortName() const;
-        void SetName(const char* name);
 
         int GetAliases(char* const aliases[2]);
-        int SetAlias(const char* alias);
-        int UnsetAlias(const char* alias);
         bool NameEquals(const char* target);
+        static const char* TranslateName(const char* target, char* buf, size_t size);
 
         int	GetFlags() const;
         const char* GetType() const;
@@ -105,10 +111,10 @@ class SERVER_EXPORT JackPort
             return (fMonitorRequests > 0);
         }
 
-        // Since we are in shared memory, the resulting pointer cannot be cached, so align it here...
-        jack_default_audio_sample_t* GetBuffer()
+        // The pool is mapped at a different address in each process
+        jack_default_audio_sample_t* GetBuffer(char* pool) const
         {
-            return (jack_default_audio_sample_t*)((uintptr_t)fBuffer & ~31L) + 8;
+            return (jack_default_audio_sample_t*)(pool + fBufferOffset);
         }
 
         int GetRefNum() const;
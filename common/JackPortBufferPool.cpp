@@ -0,0 +1,332 @@
+/*
+Copyright (C) 2026 agent
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 2.1 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*/
+
+#include "JackPortBufferPool.h"
+#include "JackPortType.h"
+#include "JackPlatformPlug.h"
+#include "JackError.h"
+#include <string.h>
+#include <assert.h>
+
+namespace Jack
+{
+
+#define UNIT_NONE 0xFFFFFFFF
+
+JackPortBufferPool* volatile JackPortBufferPool::fMapped = NULL;
+
+/*!
+\brief A pool mapped by a client process, and the number of clients of the process holding it.
+*/
+
+struct JackPortBufferPoolMapping
+{
+    jack_shm_info_t fInfo;
+    int fClients;
+};
+
+// Each client holds one pool at most
+static JackPortBufferPoolMapping gMappings[CLIENT_NUM];
+
+// Several clients of a process may map the new pool at the same time
+static JackMutex gMapMutex;
+
+static UInt32 AlignBuffer(size_t size)
+{
+    return UInt32((size + PORT_BUFFER_ALIGN - 1) & ~size_t(PORT_BUFFER_ALIGN - 1));
+}
+
+UInt32 JackPortBufferPool::GetUnitSize(jack_nframes_t buffer_size)
+{
+    return AlignBuffer(gAudioPortType.size(buffer_size));
+}
+
+static UInt32 GetUnits(jack_port_type_id_t port_type, jack_nframes_t buffer_size, UInt32 unit_size)
+{
+    return (AlignBuffer(GetPortType(port_type)->size(buffer_size)) + unit_size - 1) / unit_size;
+}
+
+static UInt32 GetMaxUnits(jack_nframes_t buffer_size, UInt32 unit_size)
+{
+    UInt32 max_units = 1;
+    for (jack_port_type_id_t i = 0; i < PORT_TYPES_MAX; i++) {
+        UInt32 units = GetUnits(i, buffer_size, unit_size);
+        if (units > max_units) {
+            max_units = units;
+        }
+    }
+    return max_units;
+}
+
+JackPortBufferPool::JackPortBufferPool(UInt32 id, jack_nframes_t buffer_size, UInt32 unit_size, UInt32 unit_count, UInt32 first_unit)
+{
+    fId = id;
+    fBufferSize = buffer_size;
+    fUnitSize = unit_size;
+    fUnitCount = unit_count;
+    fFirstUnit = first_unit;
+    memset(fUsed, 0, sizeof(UInt32) * ((unit_count + 31) / 32));
+
+    // The unused buffer
+    UInt32 max_units = GetMaxUnits(buffer_size, unit_size);
+    SetUsed(0, max_units, true);
+    fTopUnit = max_units;
+
+    for (int i = 0; i < CLIENT_NUM; i++) {
+        fNextUnit[i] = UNIT_NONE;
+    }
+}
+
+JackPortBufferPool* JackPortBufferPool::Allocate(UInt32 id, jack_nframes_t buffer_size, int port_max)
+{
+    UInt32 unit_size = GetUnitSize(buffer_size);
+    UInt32 max_units = GetMaxUnits(buffer_size, unit_size);
+    UInt32 unit_count = max_units * (port_max + 1);
+    UInt32 first_unit = AlignBuffer(sizeof(JackPortBufferPool) + sizeof(UInt32) * ((unit_count + 31) / 32));
+    size_t size = first_unit + size_t(unit_count) * unit_size;
+
+    jack_log("JackPortBufferPool::Allocate buffer_size = %ld units = %ld unit_size = %ld size = %ld", buffer_size, unit_count, unit_size, size);
+
+    // Using "Placement" new
+    void* shared_ptr = JackShmMem::operator new(size);
+    return new(shared_ptr) JackPortBufferPool(id, buffer_size, unit_size, unit_count, first_unit);
+}
+
+void JackPortBufferPool::Destroy(JackPortBufferPool* pool)
+{
+    if (fMapped == pool) {
+        SetMapped(NULL);
+    }
+    // "Placement" new was used
+    pool->~JackPortBufferPool();
+    JackShmMem::operator delete(pool);
+}
+
+void JackPortBufferPool::SetMapped(JackPortBufferPool* pool)
+{
+    MEMORY_BARRIER();
+    fMapped = pool;
+}
+
+void JackPortBufferPool::SetUsed(UInt32 unit, UInt32 count, bool used)
+{
+    for (UInt32 i = unit; i < unit + count; i++) {
+        if (used) {
+            fUsed[i >> 5] |= (UInt32(1) << (i & 31));
+        } else {
+            fUsed[i >> 5] &= ~(UInt32(1) << (i & 31));
+        }
+    }
+}
+
+bool JackPortBufferPool::IsFree(UInt32 unit, UInt32 count) const
+{
+    if (unit + count > fUnitCount) {
+        return false;
+    }
+    for (UInt32 i = unit; i < unit + count; i++) {
+        if (IsUsed(i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+/*!
+\brief Allocate the buffer of a port : after the previous buffer of the client, or after all buffers for its first one,
+otherwise the first free units. Returns its offset in the segment, or 0 if the pool is full.
+*/
+UInt32 JackPortBufferPool::AllocateBuffer(int refnum, jack_port_type_id_t port_type)
+{
+    UInt32 units = GetUnits(port_type, fBufferSize, fUnitSize);
+    UInt32 unit = (fNextUnit[refnum] != UNIT_NONE) ? fNextUnit[refnum] : fTopUnit;
+
+    while (unit < fUnitCount && !IsFree(unit, units)) {
+        unit++;
+    }
+
+    if (unit >= fUnitCount) {
+        for (unit = 0; unit < fUnitCount && !IsFree(unit, units); unit++) {}
+        if (unit >= fUnitCount) {
+            jack_error("JackPortBufferPool::AllocateBuffer : no more buffer for buffer size = %ld", fBufferSize);
+            return 0;
+        }
+    }
+
+    SetUsed(unit, units, true);
+    fNextUnit[refnum] = unit + units;
+    if (unit + units > fTopUnit) {
+        fTopUnit = unit + units;
+    }
+    return fFirstUnit + unit * fUnitSize;
+}
+
+void JackPortBufferPool::ReleaseBuffer(UInt32 offset, jack_port_type_id_t port_type)
+{
+    if (offset <= fFirstUnit) {
+        return; // The unused buffer
+    }
+
+    UInt32 unit = (offset - fFirstUnit) / fUnitSize;
+    UInt32 units = GetUnits(port_type, fBufferSize, fUnitSize);
+    assert(unit + units <= fUnitCount);
+    SetUsed(unit, units, false);
+
+    while (fTopUnit > 0 && !IsUsed(fTopUnit - 1)) {
+        fTopUnit--;
+    }
+}
+
+int JackPortBufferPool::GetUsedUnits() const
+{
+    int count = 0;
+    for (UInt32 i = 0; i < fUnitCount; i++) {
+        count += IsUsed(i);
+    }
+    return count;
+}
+
+static JackPortBufferPoolMapping* FindMapping(UInt32 id)
+{
+    for (int i = 0; i < CLIENT_NUM; i++) {
+        JackPortBufferPool* pool = (JackPortBufferPool*)gMappings[i].fInfo.ptr.attached_at;
+        if (pool && pool->GetId() == id) {
+            return &gMappings[i];
+        }
+    }
+    return NULL;
+}
+
+static JackPortBufferPoolMapping* FindFreeMapping()
+{
+    for (int i = 0; i < CLIENT_NUM; i++) {
+        if (!gMappings[i].fInfo.ptr.attached_at) {
+            return &gMappings[i];
+        }
+    }
+    return NULL;
+}
+
+static void ReleaseMapping(JackPortBufferPoolMapping* mapping)
+{
+    JackPortBufferPool* pool = (JackPortBufferPool*)mapping->fInfo.ptr.attached_at;
+    jack_log("JackPortBufferPool::Release index = %ld buffer_size = %ld", mapping->fInfo.index, pool->GetBufferSize());
+    if (JackPortBufferPool::GetMapped() == pool) {
+        JackPortBufferPool::SetMapped(NULL);
+    }
+    pool->UnlockMemory();
+    jack_release_lib_shm(&mapping->fInfo);
+    mapping->fInfo.ptr.attached_at = NULL;
+    mapping->fClients = 0;
+}
+
+/*!
+\brief Returns the pool of the given index and id, mapping it if this process does not already, and makes it the
+pool used by the RT code if it is the latest one. In the server process, the pool it has allocated is returned.
+*/
+JackPortBufferPool* JackPortBufferPool::Acquire(int index, UInt32 id)
+{
+    if (index < 0) {
+        return NULL;
+    }
+
+    gMapMutex.Lock();
+
+    JackPortBufferPool* pool = NULL;
+    JackPortBufferPoolMapping* mapping = FindMapping(id);
+
+    if (mapping) {
+        mapping->fClients++;
+        pool = (JackPortBufferPool*)mapping->fInfo.ptr.attached_at;
+    } else if (fMapped && fMapped->fId == id) {
+        // Allocated by the server in this process
+        pool = fMapped;
+    } else if ((mapping = FindFreeMapping()) == NULL) {
+        jack_error("JackPortBufferPool::Acquire : too many pools mapped");
+    } else {
+        jack_shm_info_t info;
+        info.index = index;
+        if (jack_attach_lib_shm(&info)) {
+            jack_error("Cannot map port buffers segment index = %ld", index);
+        } else if (((JackPortBufferPool*)jack_shm_addr(&info))->fId != id) {
+            // Allocated again since the index was read
+            jack_release_lib_shm(&info);
+        } else {
+            pool = (JackPortBufferPool*)jack_shm_addr(&info);
+            jack_log("JackPortBufferPool::Acquire index = %ld buffer_size = %ld", index, pool->fBufferSize);
+            pool->LockMemory();
+            mapping->fInfo = info;
+            mapping->fClients = 1;
+        }
+    }
+
+    // Pools are allocated with increasing ids
+    if (pool && (!fMapped || pool->fId > fMapped->fId)) {
+        SetMapped(pool);
+    }
+
+    gMapMutex.Unlock();
+    return pool;
+}
+
+/*!
+\brief A client of the process does not hold the pool anymore. It is unmapped if no other client holds it, unless
+the RT code of the process still uses it for clients holding a previous pool (their buffer size notification failed).
+*/
+void JackPortBufferPool::Release(JackPortBufferPool* pool)
+{
+    if (!pool) {
+        return;
+    }
+
+    gMapMutex.Lock();
+
+    // Pools allocated by the server are not in the table
+    JackPortBufferPoolMapping* mapping = FindMapping(pool->fId);
+    if (mapping && --mapping->fClients == 0) {
+        int clients = 0;
+        for (int i = 0; i < CLIENT_NUM; i++) {
+            clients += gMappings[i].fClients;
+        }
+        for (int i = 0; i < CLIENT_NUM; i++) {
+            JackPortBufferPool* mapped = (JackPortBufferPool*)gMappings[i].fInfo.ptr.attached_at;
+            if (mapped && gMappings[i].fClients == 0 && (mapped != fMapped || clients == 0)) {
+                ReleaseMapping(&gMappings[i]);
+            }
+        }
+    }
+
+    gMapMutex.Unlock();
+}
+
+void JackPortBufferPool::Unmap()
+{
+    gMapMutex.Lock();
+
+    // Only pools mapped by Acquire are released here, the server destroys the ones it allocates
+    for (int i = 0; i < CLIENT_NUM; i++) {
+        if (gMappings[i].fInfo.ptr.attached_at) {
+            ReleaseMapping(&gMappings[i]);
+        }
+    }
+
+    gMapMutex.Unlock();
+}
+
+} // end of namespace
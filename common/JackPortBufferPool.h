@@ -0,0 +1,131 @@
+/*
+Copyright (C) 2026 agent
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 2.1 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*/
+
+#ifndef __JackPortBufferPool__
+#define __JackPortBufferPool__
+
+#include "JackShmMem.h"
+#include "JackConstants.h"
+#include "JackTypes.h"
+#include "JackAtomic.h"
+#include "types.h"
+
+namespace Jack
+{
+
+#define PORT_BUFFER_ALIGN 64        // Alignment of the port buffers in the pool
+
+/*!
+\brief Port buffers, in a shared memory segment allocated for the current buffer size.
+
+The pool is made of units of one audio buffer, aligned on PORT_BUFFER_ALIGN bytes : bigger buffers (MIDI ones always
+have BUFFER_SIZE_MAX frames) use several contiguous units, the pool has room for a buffer of the biggest size for each
+port. Buffers of a client are allocated after its previous one when possible, and the ports are laid out again client by
+client when the pool is allocated for a new buffer size. The first buffer, of the biggest size, is not used by any port :
+it is returned for released ports still used by the RT code.
+
+Buffers are only allocated and released by the server. A client process maps the pool when a client is opened, and the
+new one in the notification thread when the buffer size changes : the RT code only reads the pool mapped in the process.
+Each client holds the pool it has switched to, a pool is unmapped once no client of the process holds it.
+*/
+
+PRE_PACKED_STRUCTURE
+class SERVER_EXPORT JackPortBufferPool : public JackShmMem
+{
+
+    private:
+
+        UInt32 fId;                     // Changed at each allocation, so that processes find out the pool they use is no more the current one
+        jack_nframes_t fBufferSize;
+        UInt32 fUnitSize;
+        UInt32 fUnitCount;
+        UInt32 fFirstUnit;              // Offset of the first unit in the segment
+        UInt32 fTopUnit;                // First unit after the allocated ones
+        UInt32 fNextUnit[CLIENT_NUM];   // Where the next buffer of a client is looked for
+        UInt32 fUsed[0];                // Bit set of the used units, followed by the units
+
+        static JackPortBufferPool* volatile fMapped;    // Process local : the pool used by the RT code of this process
+
+        JackPortBufferPool(UInt32 id, jack_nframes_t buffer_size, UInt32 unit_size, UInt32 unit_count, UInt32 first_unit);
+
+        bool IsUsed(UInt32 unit) const
+        {
+            return (fUsed[unit >> 5] & (UInt32(1) << (unit & 31))) != 0;
+        }
+
+        void SetUsed(UInt32 unit, UInt32 count, bool used);
+        bool IsFree(UInt32 unit, UInt32 count) const;
+
+    public:
+
+        static UInt32 GetUnitSize(jack_nframes_t buffer_size);
+
+        UInt32 GetId() const
+        {
+            return fId;
+        }
+
+        jack_nframes_t GetBufferSize() const
+        {
+            return fBufferSize;
+        }
+
+        size_t GetSize() const
+        {
+            return fFirstUnit + size_t(fUnitCount) * fUnitSize;
+        }
+
+        char* GetAddress()
+        {
+            return (char*)this;
+        }
+
+        // Offsets in the segment
+        UInt32 GetUnusedBuffer() const
+        {
+            return fFirstUnit;
+        }
+
+        // Server
+        UInt32 AllocateBuffer(int refnum, jack_port_type_id_t port_type);
+        void ReleaseBuffer(UInt32 offset, jack_port_type_id_t port_type);
+        int GetUsedUnits() const;
+
+        static JackPortBufferPool* Allocate(UInt32 id, jack_nframes_t buffer_size, int port_max);
+        static void Destroy(JackPortBufferPool* pool);
+        static void SetMapped(JackPortBufferPool* pool);
+
+        // RT : never maps
+        static JackPortBufferPool* GetMapped()
+        {
+            return fMapped;
+        }
+
+        // Client open and notification thread : maps the pool if needed, and holds it until released
+        static JackPortBufferPool* Acquire(int index, UInt32 id);
+        static void Release(JackPortBufferPool* pool);
+
+        // Process exit
+        static void Unmap();
+
+} POST_PACKED_STRUCTURE;
+
+} // end of namespace
+
+#endif
@@ -0,0 +1,205 @@
+/*
+Copyright (C) 2026 agent
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 2.1 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*/
+
+#include "JackPortNameIndex.h"
+#include "JackPort.h"
+#include "JackAtomic.h"
+#include "JackError.h"
+
+namespace Jack
+{
+
+#define INDEX_EMPTY     0
+#define INDEX_REMOVED   0xFFFFFFFF
+
+// Upper bits of the hash, lower bits of the port index + 1 (never 0 or 0xFFFF since port_index < PORT_NUM_MAX)
+#define INDEX_ENTRY(hash, port_index)   (((hash) & 0xFFFF0000) | ((port_index) + 1))
+#define INDEX_TAG(entry)                ((entry) & 0xFFFF0000)
+#define INDEX_PORT(entry)               (jack_port_id_t(((entry) & 0xFFFF) - 1))
+
+// FNV-1a
+UInt32 JackPortNameIndex::Hash(const char* name)
+{
+    UInt32 hash = 2166136261U;
+    for (const unsigned char* c = (const unsigned char*)name; *c; c++) {
+        hash = (hash ^ *c) * 16777619U;
+    }
+    return hash;
+}
+
+void JackPortNameIndex::Clear()
+{
+    for (int i = 0; i < PORT_NAME_INDEX_SIZE; i++) {
+        fSlots[i] = INDEX_EMPTY;
+    }
+    fRemoved = 0;
+    fOverflow = 0;
+}
+
+void JackPortNameIndex::AddAux(UInt32 hash, jack_port_id_t port_index)
+{
+    UInt32 entry = INDEX_ENTRY(hash, port_index);
+    UInt32 slot = hash % PORT_NAME_INDEX_SIZE;
+    int count = 0;
+
+    while (count < PORT_NAME_INDEX_SIZE) {
+        UInt32 value = fSlots[slot];
+        if (value == INDEX_EMPTY || value == INDEX_REMOVED) {
+            if (CAS(value, entry, &fSlots[slot])) {
+                if (value == INDEX_REMOVED) {
+                    DEC_ATOMIC(&fRemoved);
+                }
+                return;
+            }
+            // Taken meanwhile by another writer, check the slot again
+        } else {
+            slot = (slot + 1) % PORT_NAME_INDEX_SIZE;
+            count++;
+        }
+    }
+
+    jack_error("JackPortNameIndex::AddAux : index is full");
+    fOverflow = 1;
+}
+
+void JackPortNameIndex::Add(const char* name, jack_port_id_t port_index)
+{
+    if (name[0] == '\0') {
+        return;
+    }
+
+    UInt32 hash = Hash(name);
+    for (;;) {
+        UInt32 generation = fGeneration;
+        MEMORY_BARRIER();
+        AddAux(hash, port_index);
+        MEMORY_BARRIER();
+        // A rebuild starting meanwhile may have cleared the entry before reading the port : add it again
+        if ((generation & 1) || generation == fGeneration) {
+            break;
+        }
+    }
+}
+
+void JackPortNameIndex::Remove(const char* name, jack_port_id_t port_index)
+{
+    if (name[0] == '\0') {
+        return;
+    }
+
+    UInt32 hash = Hash(name);
+    UInt32 entry = INDEX_ENTRY(hash, port_index);
+    UInt32 slot = hash % PORT_NAME_INDEX_SIZE;
+
+    for (int count = 0; count < PORT_NAME_INDEX_SIZE; count++) {
+        UInt32 value = fSlots[slot];
+        if (value == INDEX_EMPTY) {
+            return;
+        } else if (value == entry && CAS(entry, INDEX_REMOVED, &fSlots[slot])) {
+            INC_ATOMIC(&fRemoved);
+            return;
+        }
+        slot = (slot + 1) % PORT_NAME_INDEX_SIZE;
+    }
+}
+
+jack_port_id_t JackPortNameIndex::FindAux(UInt32 hash, const char* name, JackPort* ports, unsigned int port_max)
+{
+    UInt32 slot = hash % PORT_NAME_INDEX_SIZE;
+
+    for (int count = 0; count < PORT_NAME_INDEX_SIZE; count++) {
+        UInt32 value = fSlots[slot];
+        if (value == INDEX_EMPTY) {
+            break;
+        } else if (value != INDEX_REMOVED && INDEX_TAG(value) == INDEX_TAG(hash)) {
+            jack_port_id_t port_index = INDEX_PORT(value);
+            if (port_index < port_max && ports[port_index].IsUsed() && ports[port_index].NameEquals(name)) {
+                return port_index;
+            }
+        }
+        slot = (slot + 1) % PORT_NAME_INDEX_SIZE;
+    }
+
+    return NO_PORT;
+}
+
+jack_port_id_t JackPortNameIndex::FindLinear(const char* name, JackPort* ports, unsigned int port_max)
+{
+    for (unsigned int i = 0; i < port_max; i++) {
+        if (ports[i].IsUsed() && ports[i].NameEquals(name)) {
+            return i;
+        }
+    }
+    return NO_PORT;
+}
+
+jack_port_id_t JackPortNameIndex::Find(const char* name, JackPort* ports, unsigned int port_max)
+{
+    char buf[REAL_JACK_PORT_NAME_SIZE];
+    const char* indexed_name = JackPort::TranslateName(name, buf, sizeof(buf));
+
+    UInt32 generation = fGeneration;
+    MEMORY_BARRIER();
+    if ((generation & 1) || fOverflow) {
+        return FindLinear(name, ports, port_max);
+    }
+
+    jack_port_id_t port_index = FindAux(Hash(indexed_name), name, ports, port_max);
+
+    // Not found while the index was rebuilt
+    MEMORY_BARRIER();
+    if (port_index == NO_PORT && generation != fGeneration) {
+        return FindLinear(name, ports, port_max);
+    }
+    return port_index;
+}
+
+bool JackPortNameIndex::NeedRebuild() const
+{
+    return (fRemoved > PORT_NAME_INDEX_SIZE / 8);
+}
+
+void JackPortNameIndex::Rebuild(JackPort* ports, unsigned int port_max)
+{
+    UInt32 generation = fGeneration;
+    if ((generation & 1) || !CAS(generation, generation + 1, &fGeneration)) {
+        return;
+    }
+    MEMORY_BARRIER();
+
+    jack_log("JackPortNameIndex::Rebuild removed = %ld", fRemoved);
+    Clear();
+    for (unsigned int i = 0; i < port_max; i++) {
+        JackPort* port = &ports[i];
+        if (port->IsUsed()) {
+            AddAux(Hash(port->fName), i);
+            if (port->fAlias1[0] != '\0') {
+                AddAux(Hash(port->fAlias1), i);
+            }
+            if (port->fAlias2[0] != '\0') {
+                AddAux(Hash(port->fAlias2), i);
+            }
+        }
+    }
+
+    MEMORY_BARRIER();
+    fGeneration = generation + 2;
+}
+
+} // end of namespace
@@ -0,0 +1,84 @@
+/*
+Copyright (C) 2026 agent
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 2.1 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*/
+
+#ifndef __JackPortNameIndex__
+#define __JackPortNameIndex__
+
+#include "JackConstants.h"
+#include "JackTypes.h"
+#include "JackCompilerDeps.h"
+#include "types.h"
+
+namespace Jack
+{
+
+#define PORT_NAME_INDEX_SIZE (PORT_NUM_MAX * 4)    // Slots for port names and aliases
+
+class JackPort;
+
+/*!
+\brief Hash index of the port names and aliases, in the graph manager shared memory.
+
+Open addressing with linear probing : a slot holds the upper bits of the name hash and the port index. Entries are
+added and removed with CAS (aliases can be set by clients), removed ones are marked and reused by the next additions.
+Lookups do not lock : the port name of a matching entry is checked, so stale entries only cost a comparison. When too
+many slots are marked, the server rebuilds the index from the port array, with an odd generation during the rebuild :
+lookups made meanwhile use a linear scan of the port array.
+*/
+
+PRE_PACKED_STRUCTURE
+class SERVER_EXPORT JackPortNameIndex
+{
+
+    private:
+
+        // Aligned in the packed layout, since they are changed with CAS and atomic increments
+        MEM_ALIGN(volatile UInt32 fSlots[PORT_NAME_INDEX_SIZE], 4);
+        MEM_ALIGN(volatile UInt32 fGeneration, 4);  // Incremented at the beginning and end of a rebuild
+        MEM_ALIGN(volatile SInt32 fRemoved, 4);     // Slots marked as removed
+        volatile UInt32 fOverflow;      // An entry could not be added, lookups use a linear scan until the next rebuild
+
+        static UInt32 Hash(const char* name);
+
+        void AddAux(UInt32 hash, jack_port_id_t port_index);
+        jack_port_id_t FindAux(UInt32 hash, const char* name, JackPort* ports, unsigned int port_max);
+        jack_port_id_t FindLinear(const char* name, JackPort* ports, unsigned int port_max);
+        void Clear();
+
+    public:
+
+        JackPortNameIndex()
+        {
+            fGeneration = 0;
+            Clear();
+        }
+
+        void Add(const char* name, jack_port_id_t port_index);
+        void Remove(const char* name, jack_port_id_t port_index);
+        jack_port_id_t Find(const char* name, JackPort* ports, unsigned int port_max);
+
+        // Server
+        bool NeedRebuild() const;
+        void Rebuild(JackPort* ports, unsigned int port_max);
+
+} POST_PACKED_STRUCTURE;
+
+} // end of namespace
+
+#endif
@@ -22,6 +22,7 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 
 #include "types.h"
 #include "JackConstants.h"
+#include "JackCompilerDeps.h"
 #include <stddef.h>
 
 namespace Jack
@@ -32,7 +33,7 @@ extern jack_port_type_id_t PORT_TYPES_MAX;
 struct JackPortType
 {
     const char* fName;
-    size_t (*size)();
+    size_t (*size)(jack_nframes_t buffer_size);
     void (*init)(void* buffer, size_t buffer_size, jack_nframes_t nframes);
     void (*mixdown)(void *mixbuffer, void** src_buffers, int src_count, jack_nframes_t nframes);
 };
@@ -43,6 +44,24 @@ extern const struct JackPortType* GetPortType(jack_port_type_id_t port_type_id);
 extern const struct JackPortType gAudioPortType;
 extern const struct JackPortType gMidiPortType;
 
+typedef void (*JackPortMixdownFunction)(void *mixbuffer, void** src_buffers, int src_count, jack_nframes_t nframes);
+
+/*!
+\brief An audio mixdown implementation.
+*/
+
+struct JackAudioMixdown
+{
+    const char* fName;
+    JackPortMixdownFunction fMixdown;
+};
+
+/*!
+\brief Audio mixdown implementations supported by the CPU : the last one is used by the audio port type.
+*/
+
+SERVER_EXPORT const JackAudioMixdown* GetAudioMixdowns(int* count);
+
 } // namespace Jack
 
 #endif
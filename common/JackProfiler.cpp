@@ -38,12 +38,16 @@ namespace Jack
         
         snprintf(port_name, sizeof(port_name) - 1, "%s:duration", name);
         fDurationPort = jack_port_register(client, port_name, JACK_DEFAULT_AUDIO_TYPE, JackPortIsOutput, 0);
+
+        snprintf(port_name, sizeof(port_name) - 1, "%s:cpu_load", name);
+        fCPULoadPort = jack_port_register(client, port_name, JACK_DEFAULT_AUDIO_TYPE, JackPortIsOutput, 0);
     }
     
     JackProfilerClient::~JackProfilerClient()
     {
         jack_port_unregister(fClient, fSchedulingPort);
         jack_port_unregister(fClient, fDurationPort);
+        jack_port_unregister(fClient, fCPULoadPort);
     }
     
 #ifdef JACK_MONITOR
@@ -100,7 +104,6 @@ namespace Jack
     
     void JackProfiler::ClientRegistration(const char* name, int val, void *arg)
     {
-    #ifdef JACK_MONITOR
         JackProfiler* profiler = static_cast<JackProfiler*>(arg);
         
         // Filter client or "system" name
@@ -118,12 +121,11 @@ namespace Jack
             std::map<std::string, JackProfilerClient*>::iterator it = profiler->fClientTable.find(name);
             if (it != profiler->fClientTable.end()) {
                 jack_log("Client %s removed", name);
-                profiler->fClientTable.erase(it);
                 delete((*it).second);
+                profiler->fClientTable.erase(it);
             }
         }
         profiler->fMutex.Unlock();
-    #endif
     }
 
     int JackProfiler::Process(jack_nframes_t nframes, void* arg)
@@ -138,13 +140,46 @@ namespace Jack
             }
         }
  
+        JackEngineControl* control = JackServerGlobals::fInstance->GetEngineControl();
+        float period_usecs = float(control->fPeriodUsecs);
+
+        // Client loads are maintained by the server at each cycle
+        if (profiler->fMutex.Trylock()) {
+            std::map<std::string, JackProfilerClient*>::iterator it;
+            for (it = profiler->fClientTable.begin(); it != profiler->fClientTable.end(); it++) {
+                int ref = (*it).second->fRefNum;
+                if (ref < 0) {
+                    continue;
+                }
+                JackClientLoad* load = &control->fClientLoad[ref];
+
+                float* buffer_scheduling = (float*)jack_port_get_buffer((*it).second->fSchedulingPort, nframes);
+                float value1 = float(load->fWakeUpUsecs) / period_usecs;
+                for (unsigned int i = 0; i < nframes; i++) {
+                    buffer_scheduling[i] = value1;
+                }
+
+                float* buffer_duration = (float*)jack_port_get_buffer((*it).second->fDurationPort, nframes);
+                float value2 = float(load->fDSPUsecs) / period_usecs;
+                for (unsigned int i = 0; i < nframes; i++) {
+                    buffer_duration[i] = value2;
+                }
+
+                float* buffer_cpu_load = (float*)jack_port_get_buffer((*it).second->fCPULoadPort, nframes);
+                float value3 = load->fCPULoad / 100.f;
+                for (unsigned int i = 0; i < nframes; i++) {
+                    buffer_cpu_load[i] = value3;
+                }
+            }
+            profiler->fMutex.Unlock();
+        }
+
     #ifdef JACK_MONITOR      
         
-        JackEngineControl* control = JackServerGlobals::fInstance->GetEngineControl();
         JackEngineProfiling* engine_profiler = &control->fProfiler;
         JackTimingMeasure* measure = engine_profiler->GetCurMeasure();
         
-       if (profiler->fLastMeasure && profiler->fMutex.Trylock()) {
+        if (profiler->fLastMeasure) {
         
             if (profiler->fDriverPeriodPort) {
                 float* buffer_driver_period = (float*)jack_port_get_buffer(profiler->fDriverPeriodPort, nframes);
@@ -161,30 +196,6 @@ namespace Jack
                     buffer_driver_end_time[i] = value2;
                 }
             }
-            
-            std::map<std::string, JackProfilerClient*>::iterator it;
-            for (it = profiler->fClientTable.begin(); it != profiler->fClientTable.end(); it++) {
-                int ref = (*it).second->fRefNum;
-                long d5 = long(measure->fClientTable[ref].fSignaledAt - profiler->fLastMeasure->fCurCycleBegin);
-                long d6 = long(measure->fClientTable[ref].fAwakeAt - profiler->fLastMeasure->fCurCycleBegin);
-                long d7 = long(measure->fClientTable[ref].fFinishedAt - profiler->fLastMeasure->fCurCycleBegin);
-                  
-                float* buffer_scheduling = (float*)jack_port_get_buffer((*it).second->fSchedulingPort, nframes);
-                float value3 = float(d6 - d5) / float(measure->fPeriodUsecs);
-                jack_log("Scheduling %f", value3);
-                for (unsigned int i = 0; i < nframes; i++) {
-                    buffer_scheduling[i] = value3;
-                }
-                  
-                float* buffer_duration = (float*)jack_port_get_buffer((*it).second->fDurationPort, nframes);
-                float value4 = float(d7 - d6) / float(measure->fPeriodUsecs);
-                jack_log("Duration %f", value4);
-                for (unsigned int i = 0; i < nframes; i++) {
-                    buffer_duration[i] = value4;
-                }
-            }
-            
-            profiler->fMutex.Unlock();
         }
         profiler->fLastMeasure = measure;
     #endif
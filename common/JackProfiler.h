@@ -40,6 +40,7 @@ struct JackProfilerClient {
     jack_client_t* fClient;
     jack_port_t* fSchedulingPort;
     jack_port_t* fDurationPort;
+    jack_port_t* fCPULoadPort;
     
     JackProfilerClient(jack_client_t* client, const char* name);
     ~JackProfilerClient();
@@ -59,10 +60,10 @@ class JackProfiler
         jack_port_t* fCPULoadPort;
         jack_port_t* fDriverPeriodPort;
         jack_port_t* fDriverEndPort;
-    #ifdef JACK_MONITOR
-        JackTimingMeasure* fLastMeasure;
         std::map<std::string, JackProfilerClient*> fClientTable;
         JackMutex fMutex;
+    #ifdef JACK_MONITOR
+        JackTimingMeasure* fLastMeasure;
     #endif
  
     public:
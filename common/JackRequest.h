@@ -31,6 +31,7 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 #include <stdio.h>
 #include <stdlib.h>
 #include <list>
+#include <vector>
 
 namespace Jack
 {
@@ -38,6 +39,103 @@ namespace Jack
 #define CheckRes(exp) { if ((exp) < 0) { jack_error("CheckRes error"); return -1; } }
 #define CheckSize() { CheckRes(trans->Read(&fSize, sizeof(int))); if (fSize != Size()) { jack_error("CheckSize error size = %d Size() = %d", fSize, Size()); return -1; } }
 
+#define REQUEST_BUFFER_SIZE 2048                // Covers all fixed size requests and results
+#define REQUEST_SIZE_MAX (1024 * 1024)          // Biggest request content accepted by the server
+
+/*!
+\brief Marshalling buffer : a request or a result is serialized field by field in it, then goes through the channel in a single transfer.
+*/
+
+class JackRequestBuffer : public detail::JackChannelTransactionInterface
+{
+
+    private:
+
+        char fInline[REQUEST_BUFFER_SIZE];
+        char* fData;
+        int fCapacity;
+        int fSize;
+        int fPos;
+
+        int Reserve(int size)
+        {
+            if (size > fCapacity) {
+                int capacity = fCapacity;
+                while (capacity < size) {
+                    capacity *= 2;
+                }
+                char* data = (char*)malloc(capacity);
+                if (!data) {
+                    jack_error("JackRequestBuffer::Reserve cannot allocate %d bytes", capacity);
+                    return -1;
+                }
+                memcpy(data, fData, fSize);
+                if (fData != fInline) {
+                    free(fData);
+                }
+                fData = data;
+                fCapacity = capacity;
+            }
+            return 0;
+        }
+
+    public:
+
+        JackRequestBuffer(): fData(fInline), fCapacity(REQUEST_BUFFER_SIZE), fSize(0), fPos(0)
+        {}
+        virtual ~JackRequestBuffer()
+        {
+            if (fData != fInline) {
+                free(fData);
+            }
+        }
+
+        int Read(void* data, int len)
+        {
+            if (fPos + len > fSize) {
+                jack_error("JackRequestBuffer::Read beyond the received content");
+                return -1;
+            }
+            memcpy(data, fData + fPos, len);
+            fPos += len;
+            return 0;
+        }
+
+        int Write(void* data, int len)
+        {
+            CheckRes(Reserve(fSize + len));
+            memcpy(fData + fSize, data, len);
+            fSize += len;
+            return 0;
+        }
+
+        // Sends the serialized content with a single write
+        int Flush(detail::JackChannelTransactionInterface* trans)
+        {
+            return trans->Write(fData, fSize);
+        }
+
+        // Receives a request content after its type : the size is read first then the fields with a single read, the size is kept for CheckSize
+        int Fill(detail::JackChannelTransactionInterface* trans)
+        {
+            int size;
+            fSize = fPos = 0;
+            CheckRes(trans->Read(&size, sizeof(int)));
+            if (size < 0 || size > REQUEST_SIZE_MAX) {
+                jack_error("JackRequestBuffer::Fill wrong request size = %d", size);
+                return -1;
+            }
+            CheckRes(Write(&size, sizeof(int)));
+            CheckRes(Reserve(fSize + size));
+            if (size > 0) {
+                CheckRes(trans->Read(fData + fSize, size));
+                fSize += size;
+            }
+            return 0;
+        }
+
+};
+
 /*!
 \brief Session API constants.
 */
@@ -89,7 +187,9 @@ struct JackRequest
         kReserveClientName = 36,
         kGetUUIDByClient = 37,
         kClientHasSessionCallback = 38,
-        kComputeTotalLatencies = 39
+        kComputeTotalLatencies = 39,
+        kConnectNamePortsList = 40,
+        kClientRequestRing = 41
     };
 
     RequestType fType;
@@ -338,6 +438,38 @@ struct JackClientCloseRequest : public JackRequest
     int Size() { return sizeof(int); }
 };
 
+/*!
+\brief Request to move the following requests of an opened client on a shared memory channel.
+*/
+
+struct JackClientRequestRingRequest : public JackRequest
+{
+
+    char fName[JACK_CLIENT_NAME_SIZE + 1];
+
+    JackClientRequestRingRequest()
+    {}
+    JackClientRequestRingRequest(const char* name): JackRequest(JackRequest::kClientRequestRing)
+    {
+        strncpy(fName, name, sizeof(fName));
+        fName[sizeof(fName) - 1] = 0;
+    }
+
+    int Read(detail::JackChannelTransactionInterface* trans)
+    {
+        CheckSize();
+        return trans->Read(&fName, sizeof(fName));
+    }
+
+    int Write(detail::JackChannelTransactionInterface* trans)
+    {
+        CheckRes(JackRequest::Write(trans, Size()));
+        return trans->Write(&fName, sizeof(fName));
+    }
+
+    int Size() { return sizeof(fName); }
+};
+
 /*!
 \brief Activate request.
 */
@@ -590,7 +722,102 @@ struct JackPortDisconnectNameRequest : public JackRequest
     }
 
     int Size() { return sizeof(int) + sizeof(fSrc) + sizeof(fDst); }
-    
+
+};
+
+#define CONNECTION_LIST_SIZE 256    // Connections handled by a single PortConnectNameList request
+
+/*!
+\brief PortConnectNameList request : a list of connections made under a single engine lock.
+*/
+
+struct JackPortConnectNameListRequest : public JackRequest
+{
+
+    struct Connection {
+        char fSrc[REAL_JACK_PORT_NAME_SIZE + 1];    // port full name
+        char fDst[REAL_JACK_PORT_NAME_SIZE + 1];    // port full name
+    };
+
+    int fRefNum;
+    int fCount;
+    std::vector<Connection> fConnections;
+
+    JackPortConnectNameListRequest(): fCount(0)
+    {}
+    JackPortConnectNameListRequest(int refnum, const char* const* src_names, const char* const* dst_names, int count)
+        : JackRequest(JackRequest::kConnectNamePortsList), fRefNum(refnum), fCount(count), fConnections(count)
+    {
+        for (int i = 0; i < count; i++) {
+            strcpy(fConnections[i].fSrc, src_names[i]);
+            strcpy(fConnections[i].fDst, dst_names[i]);
+        }
+    }
+
+    int Read(detail::JackChannelTransactionInterface* trans)
+    {
+        CheckRes(trans->Read(&fSize, sizeof(int)));
+        CheckRes(trans->Read(&fRefNum, sizeof(int)));
+        CheckRes(trans->Read(&fCount, sizeof(int)));
+        if (fCount < 0 || fCount > CONNECTION_LIST_SIZE || fSize != Size()) {
+            jack_error("CheckSize error size = %d count = %d", fSize, fCount);
+            return -1;
+        }
+        fConnections.resize(fCount);
+        for (int i = 0; i < fCount; i++) {
+            CheckRes(trans->Read(&fConnections[i].fSrc, sizeof(fConnections[i].fSrc)));
+            CheckRes(trans->Read(&fConnections[i].fDst, sizeof(fConnections[i].fDst)));
+        }
+        return 0;
+    }
+
+    int Write(detail::JackChannelTransactionInterface* trans)
+    {
+        CheckRes(JackRequest::Write(trans, Size()));
+        CheckRes(trans->Write(&fRefNum, sizeof(int)));
+        CheckRes(trans->Write(&fCount, sizeof(int)));
+        for (int i = 0; i < fCount; i++) {
+            CheckRes(trans->Write(&fConnections[i].fSrc, sizeof(fConnections[i].fSrc)));
+            CheckRes(trans->Write(&fConnections[i].fDst, sizeof(fConnections[i].fDst)));
+        }
+        return 0;
+    }
+
+    int Size() { return 2 * sizeof(int) + fCount * sizeof(Connection); }
+
+};
+
+/*!
+\brief PortConnectNameList result.
+*/
+
+struct JackPortConnectNameListResult : public JackResult
+{
+
+    int fCount;
+    int fResults[CONNECTION_LIST_SIZE];
+
+    JackPortConnectNameListResult(): JackResult(), fCount(0)
+    {}
+
+    int Read(detail::JackChannelTransactionInterface* trans)
+    {
+        CheckRes(JackResult::Read(trans));
+        CheckRes(trans->Read(&fCount, sizeof(int)));
+        if (fCount < 0 || fCount > CONNECTION_LIST_SIZE) {
+            jack_error("JackPortConnectNameListResult::Read wrong count = %d", fCount);
+            return -1;
+        }
+        return (fCount > 0) ? trans->Read(&fResults, fCount * sizeof(int)) : 0;
+    }
+
+    int Write(detail::JackChannelTransactionInterface* trans)
+    {
+        CheckRes(JackResult::Write(trans));
+        CheckRes(trans->Write(&fCount, sizeof(int)));
+        return (fCount > 0) ? trans->Write(&fResults, fCount * sizeof(int)) : 0;
+    }
+
 };
 
 /*!
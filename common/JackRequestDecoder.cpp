@@ -30,10 +30,26 @@ using namespace std;
 namespace Jack
 {
 
-#define CheckRead(req, socket)          { if (req.Read(socket) <  0) { jack_error("CheckRead error"); return -1; } }
-#define CheckWriteName(error, socket)   { if (res.Write(socket) < 0) { jack_error("%s write error name = %s", error, req.fName); } }
-#define CheckWriteRefNum(error, socket) { if (res.Write(socket) < 0) { jack_error("%s write error ref = %d", error, req.fRefNum); } }
-#define CheckWrite(error, socket)       { if (res.Write(socket) < 0) { jack_error("%s write error", error); } }
+#define CheckRead(req, socket)          { if (ReadRequest(&req, socket) <  0) { jack_error("CheckRead error"); return -1; } }
+#define CheckWriteName(error, socket)   { if (WriteResult(&res, socket) < 0) { jack_error("%s write error name = %s", error, req.fName); } }
+#define CheckWriteRefNum(error, socket) { if (WriteResult(&res, socket) < 0) { jack_error("%s write error ref = %d", error, req.fRefNum); } }
+#define CheckWrite(error, socket)       { if (WriteResult(&res, socket) < 0) { jack_error("%s write error", error); } }
+
+// The request content is received with a single read, then decoded from memory
+static int ReadRequest(JackRequest* req, detail::JackChannelTransactionInterface* socket)
+{
+    JackRequestBuffer buffer;
+    CheckRes(buffer.Fill(socket));
+    return req->Read(&buffer);
+}
+
+// The result is serialized in memory, then sent with a single write
+static int WriteResult(JackResult* res, detail::JackChannelTransactionInterface* socket)
+{
+    JackRequestBuffer buffer;
+    CheckRes(res->Write(&buffer));
+    return buffer.Flush(socket);
+}
 
 JackRequestDecoder::JackRequestDecoder(JackServer* server, JackClientHandlerInterface* handler)
     :fServer(server), fHandler(handler)
@@ -87,6 +103,16 @@ int JackRequestDecoder::HandleRequest(detail::JackChannelTransactionInterface* s
             return -1;
         }
 
+        case JackRequest::kClientRequestRing: {
+            jack_log("JackRequest::ClientRequestRing");
+            JackClientRequestRingRequest req;
+            JackResult res;
+            CheckRead(req, socket);
+            res.fResult = fHandler->RequestChannelOpen(socket, req.fName);
+            CheckWriteName("JackRequest::ClientRequestRing", socket);
+            break;
+        }
+
         case JackRequest::kActivateClient: {
             JackActivateRequest req;
             JackResult res;
@@ -137,6 +163,23 @@ int JackRequestDecoder::HandleRequest(detail::JackChannelTransactionInterface* s
             break;
         }
 
+        case JackRequest::kConnectNamePortsList: {
+            jack_log("JackRequest::ConnectNamePortsList");
+            JackPortConnectNameListRequest req;
+            JackPortConnectNameListResult res;
+            CheckRead(req, socket);
+            const char* src[CONNECTION_LIST_SIZE];
+            const char* dst[CONNECTION_LIST_SIZE];
+            for (int i = 0; i < req.fCount; i++) {
+                src[i] = req.fConnections[i].fSrc;
+                dst[i] = req.fConnections[i].fDst;
+            }
+            res.fCount = req.fCount;
+            res.fResult = fServer->GetEngine()->PortConnect(req.fRefNum, src, dst, req.fCount, res.fResults);
+            CheckWriteRefNum("JackRequest::ConnectNamePortsList", socket);
+            break;
+        }
+
         case JackRequest::kDisconnectNamePorts: {
             jack_log("JackRequest::DisconnectNamePorts");
             JackPortDisconnectNameRequest req;
@@ -33,6 +33,9 @@ struct JackClientHandlerInterface {
 
     virtual void ClientAdd(detail::JackChannelTransactionInterface* socket, JackClientOpenRequest* req, JackClientOpenResult* res) = 0;
     virtual void ClientRemove(detail::JackChannelTransactionInterface* socket, int refnum) = 0;
+
+    // Channels that can only receive the requests on the client socket refuse to open another one
+    virtual int RequestChannelOpen(detail::JackChannelTransactionInterface* socket, const char* name) { return -1; }
     
     virtual ~JackClientHandlerInterface()
     {}
@@ -20,6 +20,7 @@ Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
 #include "JackResampler.h"
 #include "JackError.h"
 #include <stdio.h>
+#include <algorithm>
 
 namespace Jack
 {
@@ -121,4 +122,28 @@ unsigned int JackResampler::WriteResample(jack_default_audio_sample_t* buffer, u
     return Write(buffer, frames);
 }
 
+unsigned int JackResampler::ReadResampleChannels(JackResampler** resamplers, jack_default_audio_sample_t** buffers, int channels, unsigned int frames)
+{
+    unsigned int res = frames;
+    for (int i = 0; i < channels; i++) {
+        resamplers[i]->SetRatio(fRatio);
+        if (buffers[i]) {
+            res = std::min(res, resamplers[i]->ReadResample(buffers[i], frames));
+        }
+    }
+    return res;
+}
+
+unsigned int JackResampler::WriteResampleChannels(JackResampler** resamplers, jack_default_audio_sample_t** buffers, int channels, unsigned int frames)
+{
+    unsigned int res = frames;
+    for (int i = 0; i < channels; i++) {
+        resamplers[i]->SetRatio(fRatio);
+        if (buffers[i]) {
+            res = std::min(res, resamplers[i]->WriteResample(buffers[i], frames));
+        }
+    }
+    return res;
+}
+
 }
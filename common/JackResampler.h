@@ -93,6 +93,10 @@ class JackResampler : public JackRingBuffer
         virtual unsigned int ReadResample(jack_default_audio_sample_t* buffer, unsigned int frames);
         virtual unsigned int WriteResample(jack_default_audio_sample_t* buffer, unsigned int frames);
 
+        // All channels of an adapter with the ratio of this resampler, which is the first one : returns the frames done on all channels
+        virtual unsigned int ReadResampleChannels(JackResampler** resamplers, jack_default_audio_sample_t** buffers, int channels, unsigned int frames);
+        virtual unsigned int WriteResampleChannels(JackResampler** resamplers, jack_default_audio_sample_t** buffers, int channels, unsigned int frames);
+
         void SetRatio(double ratio)
         {
             fRatio = Range(0.25, 4.0, ratio);
@@ -33,6 +33,9 @@ Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
 #include "JackInternalClient.h"
 #include "JackError.h"
 #include "JackMessageBuffer.h"
+#include "JackGraphExecutor.h"
+#include "JackStartupTime.h"
+#include "JackCycleTimings.h"
 
 const char * jack_get_self_connect_mode_description(char mode);
 
@@ -42,7 +45,7 @@ namespace Jack
 //----------------
 // Server control 
 //----------------
-JackServer::JackServer(bool sync, bool temporary, int timeout, bool rt, int priority, int port_max, bool verbose, jack_timer_type_t clock, char self_connect_mode, const char* server_name)
+JackServer::JackServer(bool sync, bool temporary, int timeout, bool rt, int priority, int port_max, int client_max, int graph_workers, int graph_worker_spin, bool activation_mixdown, bool verbose, jack_timer_type_t clock, jack_synchro_type_t synchro, char self_connect_mode, const char* server_name)
 {
     if (rt) {
         jack_info("JACK server starting in realtime mode with priority %ld", priority);
@@ -53,8 +56,12 @@ JackServer::JackServer(bool sync, bool temporary, int timeout, bool rt, int prio
     jack_info("self-connect-mode is \"%s\"", jack_get_self_connect_mode_description(self_connect_mode));
 
     fGraphManager = JackGraphManager::Allocate(port_max);
-    fEngineControl = new JackEngineControl(sync, temporary, timeout, rt, priority, verbose, clock, server_name);
-    fEngine = new JackLockedEngine(fGraphManager, GetSynchroTable(), fEngineControl, self_connect_mode);
+    fGraphManager->SetActivationMixdown(activation_mixdown);
+    fEngineControl = new JackEngineControl(sync, temporary, timeout, rt, priority, client_max, verbose, clock, server_name);
+    fCycleTimings = new JackCycleTimings();
+    fEngineControl->fCycleTimingsIndex = fCycleTimings->GetShmIndex();
+    fEngine = new JackLockedEngine(fGraphManager, GetSynchroTable(), fEngineControl, fCycleTimings, self_connect_mode);
+    fGraphExecutor = (graph_workers > 0) ? new JackGraphExecutor(graph_workers, graph_worker_spin, GetSynchroTable(), fEngineControl) : NULL;
 
     // A distinction is made between the threaded freewheel driver and the
     // regular freewheel driver because the freewheel driver needs to run in
@@ -70,6 +77,7 @@ JackServer::JackServer(bool sync, bool temporary, int timeout, bool rt, int prio
     JackServerGlobals::fInstance = this;   // Unique instance
     JackServerGlobals::fUserCount = 1;     // One user
     JackGlobals::fVerbose = verbose;
+    JackGlobals::fSynchroType = synchro;
 }
 
 JackServer::~JackServer()
@@ -79,6 +87,8 @@ JackServer::~JackServer()
     delete fThreadedFreewheelDriver;
     delete fEngine;
     delete fEngineControl;
+    delete fCycleTimings;
+    delete fGraphExecutor;
 }
 
 int JackServer::Open(jack_driver_desc_t* driver_desc, JSList* driver_params)
@@ -92,16 +102,19 @@ int JackServer::Open(jack_driver_desc_t* driver_desc, JSList* driver_params)
         jack_error("Cannot initialize driver");
         goto fail_close1;
     }
+    JackStartupTime::Mark("driver open");
 
     if (fRequestChannel.Open(fEngineControl->fServerName, this) < 0) {
         jack_error("Server channel open error");
         goto fail_close2;
     }
+    JackStartupTime::Mark("request channel open");
 
     if (fEngine->Open() < 0) {
         jack_error("Cannot open engine");
         goto fail_close3;
     }
+    JackStartupTime::Mark("engine open");
 
     if (fFreewheelDriver->Open() < 0) {
         jack_error("Cannot open freewheel driver");
@@ -112,14 +125,23 @@ int JackServer::Open(jack_driver_desc_t* driver_desc, JSList* driver_params)
         jack_error("Cannot attach audio driver");
         goto fail_close5;
     }
+    JackStartupTime::Mark("driver attach");
 
     fFreewheelDriver->SetMaster(false);
     fAudioDriver->SetMaster(true);
     fAudioDriver->AddSlave(fFreewheelDriver);
     InitTime();
     SetClockSource(fEngineControl->fClockSource);
+
+    if (fGraphExecutor && fGraphExecutor->Start() < 0) {
+        jack_error("Cannot start graph executor");
+        goto fail_close6;
+    }
     return 0;
 
+fail_close6:
+    fAudioDriver->Detach();
+
 fail_close5:
     fFreewheelDriver->Close();
 
@@ -145,6 +167,9 @@ int JackServer::Close()
     fAudioDriver->Close();
     fFreewheelDriver->Close();
     fEngine->Close();
+    if (fGraphExecutor) {
+        fGraphExecutor->Stop();
+    }
     // TODO: move that in reworked JackServerGlobals::Destroy()
     JackMessageBuffer::Destroy();
     EndTime();
@@ -154,6 +179,8 @@ int JackServer::Close()
 int JackServer::Start()
 {
     jack_log("JackServer::Start");
+    // Last step before the audio thread runs : the next one is the driver start up to the first cycle
+    JackStartupTime::Mark("server start request");
     if (fAudioDriver->Start() < 0) {
         return -1;
     }
@@ -453,5 +480,15 @@ JackGraphManager* JackServer::GetGraphManager()
     return fGraphManager;
 }
 
+JackCycleTimings* JackServer::GetCycleTimings()
+{
+    return fCycleTimings;
+}
+
+JackGraphExecutor* JackServer::GetGraphExecutor()
+{
+    return fGraphExecutor;
+}
+
 } // end of namespace
 
@@ -36,8 +36,10 @@ namespace Jack
 class JackGraphManager;
 class JackDriverClientInterface;
 struct JackEngineControl;
+class JackCycleTimings;
 class JackLockedEngine;
 class JackLoadableInternalClient;
+class JackGraphExecutor;
 
 /*!
 \brief The Jack server.
@@ -55,16 +57,18 @@ class SERVER_EXPORT JackServer
         JackLockedEngine* fEngine;
         JackEngineControl* fEngineControl;
         JackGraphManager* fGraphManager;
+        JackCycleTimings* fCycleTimings;
         JackServerChannel fRequestChannel;
         JackConnectionManager fConnectionState;
         JackSynchro fSynchroTable[CLIENT_NUM];
+        JackGraphExecutor* fGraphExecutor;
         bool fFreewheel;
 
         int InternalClientLoadAux(JackLoadableInternalClient* client, const char* so_name, const char* client_name, int options, int* int_ref, int uuid, int* status);
 
     public:
 
-        JackServer(bool sync, bool temporary, int timeout, bool rt, int priority, int port_max, bool verbose, jack_timer_type_t clock, char self_connect_mode, const char* server_name);
+        JackServer(bool sync, bool temporary, int timeout, bool rt, int priority, int port_max, int client_max, int graph_workers, int graph_worker_spin, bool activation_mixdown, bool verbose, jack_timer_type_t clock, jack_synchro_type_t synchro, char self_connect_mode, const char* server_name);
         ~JackServer();
 
         // Server control
@@ -101,6 +105,8 @@ class SERVER_EXPORT JackServer
         JackEngineControl* GetEngineControl();
         JackSynchro* GetSynchroTable();
         JackGraphManager* GetGraphManager();
+        JackCycleTimings* GetCycleTimings();
+        JackGraphExecutor* GetGraphExecutor();
 
 };
 
@@ -46,12 +46,17 @@ int JackServerGlobals::Start(const char* server_name,
                              int rt,
                              int priority,
                              int port_max,
+                             int client_max,
+                             int graph_workers,
+                             int graph_worker_spin,
+                             int activation_mixdown,
                              int verbose,
                              jack_timer_type_t clock,
+                             jack_synchro_type_t synchro,
                              char self_connect_mode)
 {
     jack_log("Jackdmp: sync = %ld timeout = %ld rt = %ld priority = %ld verbose = %ld ", sync, time_out_ms, rt, priority, verbose);
-    new JackServer(sync, temporary, time_out_ms, rt, priority, port_max, verbose, clock, self_connect_mode, server_name);  // Will setup fInstance and fUserCount globals
+    new JackServer(sync, temporary, time_out_ms, rt, priority, port_max, client_max, graph_workers, graph_worker_spin, activation_mixdown, verbose, clock, synchro, self_connect_mode, server_name);  // Will setup fInstance and fUserCount globals
     int res = fInstance->Open(driver_desc, driver_params);
     return (res < 0) ? res : fInstance->Start();
 }
@@ -101,6 +106,10 @@ bool JackServerGlobals::Init()
     int realtime_priority = 10;
     int verbose_aux = 0;
     unsigned int port_max = 128;
+    unsigned int client_max = CLIENT_NUM;
+    unsigned int graph_workers = 0;
+    unsigned int graph_worker_spin = 0;
+    int activation_mixdown = 0;
     int temporary = 0;
 
     int opt = 0;
@@ -110,9 +119,11 @@ bool JackServerGlobals::Init()
     JSList* master_driver_params = NULL;
     jack_driver_desc_t* driver_desc;
     jack_timer_type_t clock_source = JACK_TIMER_SYSTEM_CLOCK;
+    jack_synchro_type_t synchro = JACK_SYNCHRO_SEMAPHORE;
     int driver_nargs = 1;
     JSList* drivers = NULL;
     int loopback = 0;
+    unsigned int driver_num;
     int sync = 0;
     int rc, i;
     int res;
@@ -129,15 +140,16 @@ bool JackServerGlobals::Init()
 
         jack_log("JackServerGlobals Init");
 
-        const char *options = "-d:X:I:P:uvshVrRL:STFl:t:mn:p:"
+        const char *options = "-d:X:I:P:uvshVrRL:STFl:t:mn:p:C:W:w:M"
     #ifdef __linux__
-            "c:"
+            "c:y:"
     #endif
         ;
 
     struct option long_options[] = {
     #ifdef __linux__
                                        { "clock-source", 1, 0, 'c' },
+                                       { "synchro", 1, 0, 'y' },
     #endif
                                        { "loopback-driver", 1, 0, 'L' },
                                        { "audio-driver", 1, 0, 'd' },
@@ -146,6 +158,10 @@ bool JackServerGlobals::Init()
                                        { "verbose", 0, 0, 'v' },
                                        { "help", 0, 0, 'h' },
                                        { "port-max", 1, 0, 'p' },
+                                       { "client-max", 1, 0, 'C' },
+                                       { "graph-workers", 1, 0, 'W' },
+                                       { "graph-worker-spin", 1, 0, 'w' },
+                                       { "activation-mixdown", 0, 0, 'M' },
                                        { "no-mlock", 0, 0, 'm' },
                                        { "name", 1, 0, 'n' },
                                        { "unlock", 0, 0, 'u' },
@@ -215,6 +231,16 @@ bool JackServerGlobals::Init()
                     }
                     break;
 
+                case 'y':
+                    if (tolower (optarg[0]) == 'f') {
+                        synchro = JACK_SYNCHRO_FUTEX;
+                    } else if (tolower (optarg[0]) == 's') {
+                        synchro = JACK_SYNCHRO_SEMAPHORE;
+                    } else {
+                        jack_error("unknown option character %c", optopt);
+                    }
+                    break;
+
                 case 'd':
                     master_driver_name = optarg;
                     break;
@@ -235,6 +261,22 @@ bool JackServerGlobals::Init()
                     port_max = (unsigned int)atol(optarg);
                     break;
 
+                case 'C':
+                    client_max = (unsigned int)atol(optarg);
+                    break;
+
+                case 'W':
+                    graph_workers = (unsigned int)atol(optarg);
+                    break;
+
+                case 'w':
+                    graph_worker_spin = (unsigned int)atol(optarg);
+                    break;
+
+                case 'M':
+                    activation_mixdown = 1;
+                    break;
+
                 case 'm':
                     break;
 
@@ -343,11 +385,23 @@ bool JackServerGlobals::Init()
             client_timeout = 500; /* 0.5 sec; usable when non realtime. */
         }
 
+        if (client_max > CLIENT_NUM) {
+            jack_error("Jack server started with too much clients %d (when client max can be %d)", client_max, CLIENT_NUM);
+            goto error;
+        }
+
+        // Drivers (audio, freewheel, slaves and loopback) take a refnum, at least one is left for a client
+        driver_num = DRIVER_REFNUM_NUM + fSlavesList.size() + ((loopback > 0) ? 1 : 0);
+        if (client_max <= driver_num) {
+            jack_error("Jack server started with too few clients %d (when %d drivers are used)", client_max, driver_num);
+            goto error;
+        }
+
         for (i = 0; i < argc; i++) {
             free(argv[i]);
         }
 
-        int res = Start(server_name, driver_desc, master_driver_params, sync, temporary, client_timeout, realtime, realtime_priority, port_max, verbose_aux, clock_source, JACK_DEFAULT_SELF_CONNECT_MODE);
+        int res = Start(server_name, driver_desc, master_driver_params, sync, temporary, client_timeout, realtime, realtime_priority, port_max, client_max, graph_workers, graph_worker_spin, activation_mixdown, verbose_aux, clock_source, synchro, JACK_DEFAULT_SELF_CONNECT_MODE);
         if (res < 0) {
             jack_error("Cannot start server... exit");
             Delete();
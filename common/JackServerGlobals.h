@@ -59,8 +59,13 @@ struct SERVER_EXPORT JackServerGlobals
                      int rt,
                      int priority,
                      int port_max,
+                     int client_max,
+                     int graph_workers,
+                     int graph_worker_spin,
+                     int activation_mixdown,
                      int verbose,
                      jack_timer_type_t clock,
+                     jack_synchro_type_t synchro,
                      char self_connect_mode);
     static void Stop();
     static void Delete();
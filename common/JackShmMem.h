@@ -89,6 +89,7 @@ class JackShmMemAble
     protected:
 
         jack_shm_info_t fInfo;
+        char fPadding[8 - sizeof(jack_shm_info_t) % 8];    // Derived (packed) objects start on a 8 bytes boundary in the segment
 
     public:
 
@@ -0,0 +1,89 @@
+/*
+Copyright (C) 2026 agent
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 2.1 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*/
+
+#include "JackStartupTime.h"
+#include "JackError.h"
+
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <sys/time.h>
+#include <time.h>
+#endif
+
+namespace Jack
+{
+
+JackStartupTime::Step JackStartupTime::fSteps[STARTUP_STEPS_MAX];
+int JackStartupTime::fCount = 0;
+jack_time_t JackStartupTime::fOrigin = 0;
+bool JackStartupTime::fPending = false;
+
+jack_time_t JackStartupTime::GetTime()
+{
+#if defined (WIN32)
+    LARGE_INTEGER count, frequency;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&count);
+    return jack_time_t(double(count.QuadPart) * 1e6 / double(frequency.QuadPart));
+#elif defined (CLOCK_MONOTONIC)
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return jack_time_t(ts.tv_sec) * 1000000 + ts.tv_nsec / 1000;
+#else
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return jack_time_t(tv.tv_sec) * 1000000 + tv.tv_usec;
+#endif
+}
+
+void JackStartupTime::Start()
+{
+    fCount = 0;
+    fOrigin = GetTime();
+    fPending = true;
+}
+
+void JackStartupTime::Mark(const char* name)
+{
+    if (!fPending) {
+        Start();
+    }
+    if (fCount < STARTUP_STEPS_MAX) {
+        fSteps[fCount].fName = name;
+        fSteps[fCount].fTime = GetTime();
+        fCount++;
+    }
+}
+
+void JackStartupTime::End()
+{
+    Mark("first cycle");
+    fPending = false;
+
+    // May be called in the RT thread : logged with the message buffer
+    jack_time_t previous = fOrigin;
+    for (int i = 0; i < fCount; i++) {
+        jack_log("Startup : %-24s %8.3f ms (at %8.3f ms)", fSteps[i].fName,
+            float(fSteps[i].fTime - previous) / 1000.f, float(fSteps[i].fTime - fOrigin) / 1000.f);
+        previous = fSteps[i].fTime;
+    }
+}
+
+} // end of namespace
@@ -0,0 +1,76 @@
+/*
+Copyright (C) 2026 agent
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 2.1 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*/
+
+#ifndef __JackStartupTime__
+#define __JackStartupTime__
+
+#include "JackTypes.h"
+
+namespace Jack
+{
+
+#define STARTUP_STEPS_MAX 16
+
+/*!
+\brief Duration of the server startup steps, logged (in verbose mode) when the first cycle is processed.
+
+The server clock is not set before the server is opened : a clock of its own is used.
+*/
+
+class JackStartupTime
+{
+
+    private:
+
+        struct Step
+        {
+            const char* fName;
+            jack_time_t fTime;
+        };
+
+        static Step fSteps[STARTUP_STEPS_MAX];
+        static int fCount;
+        static jack_time_t fOrigin;
+        static bool fPending;
+
+        static jack_time_t GetTime();
+
+    public:
+
+        // Startup begins
+        static void Start();
+
+        // A step of the startup is done : the first one also starts the startup if needed
+        static void Mark(const char* name);
+
+        // Called by the engine on each cycle : the first one ends the startup
+        static void Cycle()
+        {
+            if (fPending) {
+                End();
+            }
+        }
+
+        static void End();
+
+};
+
+} // end of namespace
+
+#endif
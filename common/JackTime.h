@@ -34,7 +34,7 @@ extern "C"
     SERVER_EXPORT jack_time_t GetMicroSeconds(void);
     SERVER_EXPORT void JackSleep(long usec);
 
-    void SetClockSource(jack_timer_type_t source);
+    SERVER_EXPORT void SetClockSource(jack_timer_type_t source);
     const char* ClockSourceName(jack_timer_type_t source);
 
 #ifdef __cplusplus
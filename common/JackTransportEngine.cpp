@@ -92,7 +92,9 @@ int JackTransportEngine::SetTimebaseMaster(int refnum, bool conditionnal)
 // RT
 bool JackTransportEngine::CheckAllRolling(JackClientInterface** table)
 {
-    for (int i = GetEngineControl()->fDriverNum; i < CLIENT_NUM; i++) {
+    JackEngineControl* engine_control = GetEngineControl();
+    JackFixedBitSet<CLIENT_NUM>::Iterator it(engine_control->fUsedRefNum, engine_control->fDriverNum);
+    for (int i = it.Next(); i >= 0; i = it.Next()) {
         JackClientInterface* client = table[i];
         if (client && client->GetClientControl()->fTransportState != JackTransportRolling) {
             jack_log("CheckAllRolling ref = %ld is not rolling", i);
@@ -106,7 +108,9 @@ bool JackTransportEngine::CheckAllRolling(JackClientInterface** table)
 // RT
 void JackTransportEngine::MakeAllStartingLocating(JackClientInterface** table)
 {
-    for (int i = GetEngineControl()->fDriverNum; i < CLIENT_NUM; i++) {
+    JackEngineControl* engine_control = GetEngineControl();
+    JackFixedBitSet<CLIENT_NUM>::Iterator it(engine_control->fUsedRefNum, engine_control->fDriverNum);
+    for (int i = it.Next(); i >= 0; i = it.Next()) {
         JackClientInterface* client = table[i];
         if (client) {
             JackClientControl* control = client->GetClientControl();
@@ -122,7 +126,9 @@ void JackTransportEngine::MakeAllStartingLocating(JackClientInterface** table)
 // RT
 void JackTransportEngine::MakeAllStopping(JackClientInterface** table)
 {
-    for (int i = GetEngineControl()->fDriverNum; i < CLIENT_NUM; i++) {
+    JackEngineControl* engine_control = GetEngineControl();
+    JackFixedBitSet<CLIENT_NUM>::Iterator it(engine_control->fUsedRefNum, engine_control->fDriverNum);
+    for (int i = it.Next(); i >= 0; i = it.Next()) {
         JackClientInterface* client = table[i];
         if (client) {
             JackClientControl* control = client->GetClientControl();
@@ -137,7 +143,9 @@ void JackTransportEngine::MakeAllStopping(JackClientInterface** table)
 // RT
 void JackTransportEngine::MakeAllLocating(JackClientInterface** table)
 {
-    for (int i = GetEngineControl()->fDriverNum; i < CLIENT_NUM; i++) {
+    JackEngineControl* engine_control = GetEngineControl();
+    JackFixedBitSet<CLIENT_NUM>::Iterator it(engine_control->fUsedRefNum, engine_control->fDriverNum);
+    for (int i = it.Next(); i >= 0; i = it.Next()) {
         JackClientInterface* client = table[i];
         if (client) {
             JackClientControl* control = client->GetClientControl();
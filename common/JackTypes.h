@@ -42,6 +42,11 @@ typedef enum {
 	JACK_TIMER_HPET,
 } jack_timer_type_t;
 
+typedef enum {
+	JACK_SYNCHRO_SEMAPHORE,
+	JACK_SYNCHRO_FUTEX,
+} jack_synchro_type_t;
+
 typedef enum {
     NotTriggered,
     Triggered,
@@ -23,6 +23,7 @@
 #include <jack/session.h>
 #include <jack/thread.h>
 #include <jack/midiport.h>
+#include <jack/statistics.h>
 #include <math.h>
 #ifndef WIN32
 #include <dlfcn.h>
@@ -215,6 +216,7 @@ DECL_FUNCTION(int, jack_port_request_monitor_by_name, (jack_client_t *client, co
 DECL_FUNCTION(int, jack_port_ensure_monitor, (jack_port_t *port, int onoff), (port, onoff));
 DECL_FUNCTION(int, jack_port_monitoring_input, (jack_port_t *port) ,(port));
 DECL_FUNCTION(int, jack_connect, (jack_client_t * client, const char *source_port, const char *destination_port), (client, source_port, destination_port));
+DECL_FUNCTION(int, jack_connect_list, (jack_client_t * client, const char **source_ports, const char **destination_ports, int count, int *results), (client, source_ports, destination_ports, count, results));
 DECL_FUNCTION(int, jack_disconnect, (jack_client_t * client, const char *source_port, const char *destination_port), (client, source_port, destination_port));
 DECL_FUNCTION(int, jack_port_disconnect, (jack_client_t * client, jack_port_t * port), (client, port));
 DECL_FUNCTION(int, jack_port_name_size,(),());
@@ -243,6 +245,12 @@ DECL_VOID_FUNCTION(jack_set_info_function, (print_function fun), (fun));
 DECL_FUNCTION(float, jack_get_max_delayed_usecs, (jack_client_t *client), (client));
 DECL_FUNCTION(float, jack_get_xrun_delayed_usecs, (jack_client_t *client), (client));
 DECL_VOID_FUNCTION(jack_reset_max_delayed_usecs, (jack_client_t *client), (client));
+DECL_FUNCTION(int, jack_get_client_load, (jack_client_t *client, const char *client_name, jack_client_load_t *load), (client, client_name, load));
+DECL_FUNCTION(int, jack_get_client_dsp_percentile, (jack_client_t *client, const char *client_name, float percentile, jack_time_t *usecs), (client, client_name, percentile, usecs));
+DECL_VOID_FUNCTION(jack_reset_client_loads, (jack_client_t *client), (client));
+DECL_FUNCTION(int, jack_set_cycle_timings, (jack_client_t *client, int onoff), (client, onoff));
+DECL_FUNCTION(int, jack_get_cycle_timings, (jack_client_t *client, uint32_t cycle, jack_cycle_timing_t *timing, jack_client_cycle_timing_t *clients, int max_clients), (client, cycle, timing, clients, max_clients));
+DECL_FUNCTION(int, jack_get_cycle_timings_client_name, (jack_client_t *client, int id, char *name, size_t size), (client, id, name, size));
 
 DECL_FUNCTION(int, jack_release_timebase, (jack_client_t *client), (client));
 DECL_FUNCTION(int, jack_set_sync_callback, (jack_client_t *client, JackSyncCallback sync_callback, void *arg), (client, sync_callback, arg));
@@ -198,11 +198,16 @@ static void usage(FILE* file, jackctl_server_t *server, bool full = true)
             "               [ --timeout OR -t client-timeout-in-msecs ]\n"
             "               [ --loopback OR -L loopback-port-number ]\n"
             "               [ --port-max OR -p maximum-number-of-ports]\n"
+            "               [ --client-max OR -C maximum-number-of-clients]\n"
+            "               [ --graph-workers OR -W number-of-internal-client-threads]\n"
+            "               [ --graph-worker-spin OR -w idle-worker-spin-usecs]\n"
+            "               [ --activation-mixdown OR -M ]\n"
             "               [ --slave-backend OR -X slave-backend-name ]\n"
             "               [ --internal-client OR -I internal-client-name ]\n"
             "               [ --verbose OR -v ]\n"
 #ifdef __linux__
             "               [ --clocksource OR -c [ h(pet) | s(ystem) ]\n"
+            "               [ --synchro OR -y [ s(emaphore) | f(utex) ]\n"
 #endif
             "               [ --autoconnect OR -a <modechar>]\n");
 
@@ -248,16 +253,17 @@ int main(int argc, char** argv)
     jackctl_driver_t * master_driver_ctl;
     jackctl_driver_t * loopback_driver_ctl = NULL;
     int replace_registry = 0;
-    const char *options = "-d:X:I:P:uvshVrRL:STFl:t:mn:p:"
+    const char *options = "-d:X:I:P:uvshVrRL:STFl:t:mn:p:C:W:w:M"
         "a:"
 #ifdef __linux__
-        "c:"
+        "c:y:"
 #endif
         ;
 
     struct option long_options[] = {
 #ifdef __linux__
                                        { "clock-source", 1, 0, 'c' },
+                                       { "synchro", 1, 0, 'y' },
 #endif
                                        { "loopback-driver", 1, 0, 'L' },
                                        { "audio-driver", 1, 0, 'd' },
@@ -266,6 +272,10 @@ int main(int argc, char** argv)
                                        { "verbose", 0, 0, 'v' },
                                        { "help", 0, 0, 'h' },
                                        { "port-max", 1, 0, 'p' },
+                                       { "client-max", 1, 0, 'C' },
+                                       { "graph-workers", 1, 0, 'W' },
+                                       { "graph-worker-spin", 1, 0, 'w' },
+                                       { "activation-mixdown", 0, 0, 'M' },
                                        { "no-mlock", 0, 0, 'm' },
                                        { "name", 1, 0, 'n' },
                                        { "unlock", 0, 0, 'u' },
@@ -344,6 +354,22 @@ int main(int argc, char** argv)
                     }
                 }
                 break;
+
+            case 'y':
+                param = jackctl_get_parameter(server_parameters, "synchro");
+                if (param != NULL) {
+                    if (tolower (optarg[0]) == 'f') {
+                        value.ui = JACK_SYNCHRO_FUTEX;
+                        jackctl_parameter_set_value(param, &value);
+                    } else if (tolower (optarg[0]) == 's') {
+                        value.ui = JACK_SYNCHRO_SEMAPHORE;
+                        jackctl_parameter_set_value(param, &value);
+                    } else {
+                        usage(stdout, server_ctl);
+                        goto destroy_server;
+                    }
+                }
+                break;
         #endif
 
             case 'a':
@@ -390,6 +416,38 @@ int main(int argc, char** argv)
                 }
                 break;
 
+            case 'C':
+                param = jackctl_get_parameter(server_parameters, "client-max");
+                if (param != NULL) {
+                    value.ui = atoi(optarg);
+                    jackctl_parameter_set_value(param, &value);
+                }
+                break;
+
+            case 'W':
+                param = jackctl_get_parameter(server_parameters, "graph-workers");
+                if (param != NULL) {
+                    value.ui = atoi(optarg);
+                    jackctl_parameter_set_value(param, &value);
+                }
+                break;
+
+            case 'w':
+                param = jackctl_get_parameter(server_parameters, "graph-worker-spin");
+                if (param != NULL) {
+                    value.ui = atoi(optarg);
+                    jackctl_parameter_set_value(param, &value);
+                }
+                break;
+
+            case 'M':
+                param = jackctl_get_parameter(server_parameters, "activation-mixdown");
+                if (param != NULL) {
+                    value.b = true;
+                    jackctl_parameter_set_value(param, &value);
+                }
+                break;
+
             case 'm':
                 break;
 
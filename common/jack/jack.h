@@ -949,6 +949,26 @@ int jack_connect (jack_client_t *client,
                   const char *source_port,
                   const char *destination_port) JACK_OPTIONAL_WEAK_EXPORT;
 
+/**
+ * Establish a list of connections between ports, the same way as
+ * jack_connect() does for each pair of ports, but with a single
+ * request to the server. This is much faster when a lot of
+ * connections have to be made, for instance when a session is restored.
+ *
+ * @param source_ports the @a count output port names
+ * @param destination_ports the @a count input port names
+ * @param count number of connections
+ * @param results if not NULL, receives the result of each connection
+ * as jack_connect() would return it
+ *
+ * @return 0 if all connections have been made, otherwise a non-zero error code
+ */
+int jack_connect_list (jack_client_t *client,
+                       const char **source_ports,
+                       const char **destination_ports,
+                       int count,
+                       int *results) JACK_OPTIONAL_WEAK_EXPORT;
+
 /**
  * Remove a connection between two ports.
  *
@@ -50,6 +50,123 @@ float jack_get_xrun_delayed_usecs (jack_client_t *client);
  */
 void jack_reset_max_delayed_usecs (jack_client_t *client);
 
+/**
+ * Load of a client, maintained by the server at each cycle.
+ * Times are given in microseconds. Averages are computed over the
+ * same rolling window as jack_cpu_load(), max values and late cycles
+ * are kept since the client was opened or jack_reset_client_loads()
+ * was called.
+ */
+typedef struct {
+    float cpu_load;                     /**< share of the period used by the client process callback, in percent */
+    jack_time_t dsp_usecs;              /**< process callback duration during the last cycle */
+    jack_time_t average_dsp_usecs;
+    jack_time_t max_dsp_usecs;
+    jack_time_t wakeup_usecs;           /**< delay between the client being signaled and woken up, during the last cycle */
+    jack_time_t average_wakeup_usecs;
+    jack_time_t max_wakeup_usecs;
+    uint32_t late_cycles;               /**< cycles the client did not finish in time */
+    jack_time_t notify_usecs;           /**< time taken by the client to answer the last synchronous notification */
+    jack_time_t max_notify_usecs;
+} jack_client_load_t;
+
+/**
+ * Get the load of a client.
+ *
+ * @param client_name name of the client
+ * @param load receives the client load
+ *
+ * @return 0 on success, otherwise a non-zero error code (no such client)
+ */
+int jack_get_client_load (jack_client_t *client, const char *client_name, jack_client_load_t *load);
+
+/**
+ * Get a percentile of the process callback duration of a client,
+ * since the client was opened or jack_reset_client_loads() was called.
+ * The result is rounded up, with a precision of 25 percent.
+ *
+ * @param client_name name of the client
+ * @param percentile wanted percentile, between 0 and 100
+ * @param usecs receives the duration in microseconds
+ *
+ * @return 0 on success, otherwise a non-zero error code (no such client)
+ */
+int jack_get_client_dsp_percentile (jack_client_t *client, const char *client_name, float percentile, jack_time_t *usecs);
+
+/**
+ * Reset the max values, late cycles and percentiles of all clients
+ * loads. Like jack_reset_max_delayed_usecs(), this allows to estimate
+ * the effect of a change without restarting the JACK engine.
+ */
+void jack_reset_client_loads (jack_client_t *client);
+
+/**
+ * Timings of a cycle recorded by the server, see jack_get_cycle_timings().
+ * Times are given in microseconds, with the jack_get_time() clock.
+ */
+typedef struct {
+    uint32_t cycle;             /**< number of the recorded cycle */
+    jack_time_t begin;          /**< driver cycle begin */
+    jack_time_t end;            /**< driver cycle end */
+    jack_time_t period_usecs;   /**< period duration */
+    int client_count;           /**< client timings of the cycle */
+} jack_cycle_timing_t;
+
+/**
+ * Timings of a client during a cycle. Times not reached during the
+ * cycle are 0.
+ */
+typedef struct {
+    int id;                     /**< client id, see jack_get_cycle_timings_client_name() */
+    int status;                 /**< 0 : not triggered, 1 : triggered, 2 : running, 3 : finished */
+    jack_time_t signaled_at;    /**< client has been signaled */
+    jack_time_t awake_at;       /**< client process callback has been called */
+    jack_time_t finished_at;    /**< client process callback has returned */
+} jack_client_cycle_timing_t;
+
+/**
+ * Start or stop recording the timings of each cycle in the server.
+ * Recording is shared by all clients of the server, and costs nothing
+ * when stopped.
+ *
+ * @param onoff if non-zero, recording is started, otherwise it is stopped.
+ *
+ * @return 0 on success, otherwise a non-zero error code
+ */
+int jack_set_cycle_timings (jack_client_t *client, int onoff);
+
+/**
+ * Get the timings of a recorded cycle : the first recorded cycle
+ * whose number is at least @a cycle. The server keeps the
+ * last 1024 cycles, so @a timing->cycle can be greater than @a cycle.
+ * To read all cycles, call it again with @a timing->cycle + 1.
+ *
+ * @param cycle number of the wanted cycle, 0 for the oldest kept one
+ * @param timing receives the cycle timings
+ * @param clients receives the client timings of the cycle, at most
+ * @a max_clients of them
+ * @param max_clients size of the @a clients array
+ *
+ * @return 0 on success, otherwise a non-zero error code (no such
+ * cycle recorded yet)
+ */
+int jack_get_cycle_timings (jack_client_t *client,
+                            uint32_t cycle,
+                            jack_cycle_timing_t *timing,
+                            jack_client_cycle_timing_t *clients,
+                            int max_clients);
+
+/**
+ * Get the name of a client of the cycle timings.
+ *
+ * @param id client id, as given in jack_client_cycle_timing_t
+ * @param name receives the client name
+ * @param size size of @a name
+ *
+ * @return 0 on success, otherwise a non-zero error code
+ */
+int jack_get_cycle_timings_client_name (jack_client_t *client, int id, char *name, size_t size);
+
 #ifdef __cplusplus
 }
 #endif
@@ -172,7 +172,7 @@
 /* generates same as _mm_set_ps(1.f, 1.f, 1f., 1f) but faster  */
 static inline __m128 gen_one(void)
 {
-    volatile __m128i x;
+    volatile __m128i x = _mm_setzero_si128();
     __m128i ones = _mm_cmpeq_epi32(x, x);
     return (__m128)_mm_slli_epi32 (_mm_srli_epi32(ones, 25), 23);
 }
@@ -198,7 +198,7 @@ static inline __m128i float_24_sse(__m128 s)
  */
 static unsigned int seed = 22222;
 
-inline unsigned int fast_rand() {
+static inline unsigned int fast_rand() {
 	seed = (seed * 96314165) + 907633515;
 	return seed;
 }
@@ -445,12 +445,12 @@ void sample_move_d24_sS (char *dst, jack_default_audio_sample_t *src, unsigned l
 		_mm_store_ss((float*)z+1, (__m128)shuffled1);
 		_mm_store_ss((float*)z+2, (__m128)shuffled2);
 		_mm_store_ss((float*)z+3, (__m128)shuffled3);
+#endif
 
 		for (i = 0; i != 4; ++i) {
 			memcpy (dst, z+i, 3);
 			dst += dst_skip;
 		}
-#endif
 
 		nsamples -= 4;
 		src += 4;
@@ -574,6 +574,26 @@ void sample_move_d16_sSs (char *dst,  jack_default_audio_sample_t *src, unsigned
 
 void sample_move_d16_sS (char *dst,  jack_default_audio_sample_t *src, unsigned long nsamples, unsigned long dst_skip, dither_state_t *state)	
 {
+#if defined (__SSE2__) && !defined (__sun__)
+	const __m128 upper_bound = gen_one(); /* NORMALIZED_FLOAT_MAX */
+	const __m128 lower_bound = _mm_sub_ps(_mm_setzero_ps(), upper_bound);
+	const __m128 factor = _mm_set1_ps(SAMPLE_16BIT_SCALING);
+
+	/* clipping to the normalized range then rounding gives the same values as float_16 */
+	while (nsamples >= 4) {
+		__m128i y = _mm_cvtps_epi32(_mm_mul_ps(clip(_mm_loadu_ps(src), lower_bound, upper_bound), factor));
+
+		*((int16_t*)dst)              = _mm_extract_epi16(y, 0);
+		*((int16_t*)(dst+dst_skip))   = _mm_extract_epi16(y, 2);
+		*((int16_t*)(dst+2*dst_skip)) = _mm_extract_epi16(y, 4);
+		*((int16_t*)(dst+3*dst_skip)) = _mm_extract_epi16(y, 6);
+
+		dst += 4*dst_skip;
+		src += 4;
+		nsamples -= 4;
+	}
+#endif
+
 	while (nsamples--) {
 		float_16 (*src, *((int16_t*) dst));
 		dst += dst_skip;
@@ -752,6 +772,21 @@ void sample_move_dS_s16 (jack_default_audio_sample_t *dst, char *src, unsigned l
 {
 	/* ALERT: signed sign-extension portability !!! */
 	const jack_default_audio_sample_t scaling = 1.0/SAMPLE_16BIT_SCALING;
+
+#if defined (__SSE2__) && !defined (__sun__)
+	const __m128 factor = _mm_set1_ps(scaling);
+	while (nsamples >= 4) {
+		__m128i block = _mm_set_epi32(*((short *) (src+3*src_skip)),
+					      *((short *) (src+2*src_skip)),
+					      *((short *) (src+src_skip)),
+					      *((short *) src));
+		_mm_storeu_ps(dst, _mm_mul_ps(_mm_cvtepi32_ps(block), factor));
+		dst += 4;
+		src += 4*src_skip;
+		nsamples -= 4;
+	}
+#endif
+
 	while (nsamples--) {
 		*dst = (*((short *) src)) * scaling;
 		dst++;
@@ -31,6 +31,10 @@
 
  */
 
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE		/* sched_getaffinity */
+#endif
+
 #include "JackConstants.h"
 
 #ifdef WIN32
@@ -53,6 +57,13 @@
 #include <sys/sem.h>
 #include <stdlib.h>
 
+#ifdef __linux__
+#include <sched.h>
+#include <mntent.h>
+#include <sys/vfs.h>
+#include <sys/syscall.h>
+#endif
+
 #endif
 
 #include "shm.h"
@@ -700,6 +711,352 @@ jack_attach_lib_shm_read (jack_shm_info_t* si)
  * POSIX interface-dependent functions
  * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 
+#ifdef __linux__
+
+/* Placement of the segments allocated by the server, set in its
+ * environment:
+ *
+ * JACK_SHM_HUGEPAGES: segments of at least one huge page are files
+ * of a hugetlbfs mount, the given directory or else the first one in
+ * /proc/mounts.  Normal pages are used when no huge page is left.
+ *
+ * JACK_SHM_NUMA_NODE: memory of the segments is preferably taken
+ * from the given node, or with "auto" from the node of the CPUs the
+ * server may run on (the audio driver thread inherits them when jackd
+ * is started with taskset or numactl).
+ */
+
+#ifndef HUGETLBFS_MAGIC
+#define HUGETLBFS_MAGIC 0x958458f6
+#endif
+
+#ifndef MPOL_PREFERRED
+#define MPOL_PREFERRED 1
+#endif
+
+#define JACK_NUMA_NODE_MAX 1024
+#define JACK_NUMA_MASK_BITS (8 * sizeof (unsigned long))
+
+static int jack_shm_options_read = FALSE;
+static char jack_hugepage_dir[PATH_MAX] = "";
+static long jack_hugepage_size = 0;
+static int jack_numa_node = -1;
+
+static int
+jack_hugepage_mount (const char *dir)
+{
+	struct statfs fs;
+
+	if (statfs (dir, &fs) < 0 || fs.f_type != HUGETLBFS_MAGIC
+	    || realpath (dir, jack_hugepage_dir) == NULL)
+		return -1;
+
+	jack_hugepage_size = fs.f_bsize;
+	return 0;
+}
+
+static int
+jack_find_hugepage_mount (void)
+{
+	FILE *mounts;
+	struct mntent *entry;
+	int rc = -1;
+
+	if ((mounts = setmntent ("/proc/mounts", "r")) == NULL)
+		return -1;
+
+	while (rc < 0 && (entry = getmntent (mounts)) != NULL) {
+		if (strcmp (entry->mnt_type, "hugetlbfs") == 0)
+			rc = jack_hugepage_mount (entry->mnt_dir);
+	}
+
+	endmntent (mounts);
+	return rc;
+}
+
+/* node of a CPU, from the nodeN link of its sysfs directory */
+static int
+jack_cpu_node (int cpu)
+{
+	char path[64];
+	DIR *dir;
+	struct dirent *entry;
+	int node = -1;
+
+	snprintf (path, sizeof (path), "/sys/devices/system/cpu/cpu%d", cpu);
+	if ((dir = opendir (path)) == NULL)
+		return -1;
+
+	while (node < 0 && (entry = readdir (dir)) != NULL) {
+		if (strncmp (entry->d_name, "node", 4) == 0
+		    && sscanf (entry->d_name + 4, "%d", &node) != 1)
+			node = -1;
+	}
+
+	closedir (dir);
+	return node;
+}
+
+/* node of the CPUs the process may run on, -1 if on several nodes */
+static int
+jack_affinity_node (void)
+{
+	cpu_set_t cpus;
+	int cpu;
+	int node = -1;
+
+	if (sched_getaffinity (0, sizeof (cpus), &cpus) < 0)
+		return -1;
+
+	for (cpu = 0; cpu < CPU_SETSIZE; cpu++) {
+		if (CPU_ISSET (cpu, &cpus)) {
+			int cpu_node = jack_cpu_node (cpu);
+			if (cpu_node < 0 || (node >= 0 && cpu_node != node))
+				return -1;
+			node = cpu_node;
+		}
+	}
+
+	return node;
+}
+
+static void
+jack_read_shm_options (void)
+{
+	const char *value;
+	char *end;
+
+	if (jack_shm_options_read)
+		return;
+	jack_shm_options_read = TRUE;
+
+	if ((value = getenv ("JACK_SHM_HUGEPAGES")) != NULL) {
+		if (((value[0] == '/') ? jack_hugepage_mount (value)
+		     : jack_find_hugepage_mount ()) == 0) {
+			jack_info ("shm segments use huge pages of %ld KB in %s",
+				   jack_hugepage_size / 1024, jack_hugepage_dir);
+		} else {
+			jack_info ("No hugetlbfs mount for shm segments, "
+				   "normal pages are used");
+		}
+	}
+
+	if ((value = getenv ("JACK_SHM_NUMA_NODE")) != NULL) {
+		if (strcmp (value, "auto") == 0) {
+			jack_numa_node = jack_affinity_node ();
+		} else {
+			jack_numa_node = strtol (value, &end, 10);
+			if (end == value || *end != '\0')
+				jack_numa_node = -1;
+		}
+		if (jack_numa_node < 0 || jack_numa_node >= JACK_NUMA_NODE_MAX - 1) {
+			jack_info ("No NUMA node for shm segments (%s)", value);
+			jack_numa_node = -1;
+		} else {
+			jack_info ("shm segments use memory of NUMA node %d",
+				   jack_numa_node);
+		}
+	}
+}
+
+/* Map a new segment to set its NUMA policy, and for a hugetlbfs
+ * segment reserve its huge pages.  The policy of a tmpfs segment is
+ * kept by the segment, hugetlbfs pages are allocated here so that
+ * they come from the node.
+ */
+static int
+jack_place_shm (int shm_fd, jack_shmsize_t size, int hugepages)
+{
+	char *addr;
+	jack_shmsize_t offset;
+
+	if (!hugepages && jack_numa_node < 0)
+		return 0;
+
+	if ((addr = mmap (0, size, PROT_READ|PROT_WRITE,
+			  MAP_SHARED, shm_fd, 0)) == MAP_FAILED)
+		return -1;
+
+	if (jack_numa_node >= 0) {
+		unsigned long nodes[JACK_NUMA_NODE_MAX / JACK_NUMA_MASK_BITS];
+		memset (nodes, 0, sizeof (nodes));
+		nodes[jack_numa_node / JACK_NUMA_MASK_BITS] =
+			1UL << (jack_numa_node % JACK_NUMA_MASK_BITS);
+		if (syscall (SYS_mbind, addr, size, MPOL_PREFERRED, nodes,
+			     JACK_NUMA_NODE_MAX, 0) < 0) {
+			jack_info ("Cannot bind shm segment to NUMA node %d (%s)",
+				   jack_numa_node, strerror (errno));
+		} else if (hugepages) {
+			for (offset = 0; offset < size; offset += jack_hugepage_size)
+				((volatile char *) addr)[offset] = 0;
+		}
+	}
+
+	munmap (addr, size);
+	return 0;
+}
+
+/* allocate the segment in the hugetlbfs mount, its size is rounded to
+ * a multiple of the huge page size */
+static int
+jack_shmalloc_hugepages (const char *name, jack_shmsize_t *size,
+			 jack_shm_registry_t *registry)
+{
+	char path[PATH_MAX];
+	jack_shmsize_t huge_size;
+	int shm_fd;
+
+	/* most of a bigger page would be wasted */
+	if (jack_hugepage_size == 0 || *size < jack_hugepage_size)
+		return -1;
+
+	huge_size = (*size + jack_hugepage_size - 1)
+		/ jack_hugepage_size * jack_hugepage_size;
+	snprintf (path, sizeof (path), "%s%s", jack_hugepage_dir, name);
+	if (strlen (path) >= sizeof (registry->id))
+		return -1;
+
+	if ((shm_fd = open (path, O_RDWR|O_CREAT, 0666)) < 0) {
+		jack_info ("Cannot create shm segment %s (%s), "
+			   "normal pages are used", path, strerror (errno));
+		return -1;
+	}
+
+	if (ftruncate (shm_fd, huge_size) < 0
+	    || jack_place_shm (shm_fd, huge_size, TRUE) < 0) {
+		jack_info ("Cannot get %d huge pages for shm segment %s (%s), "
+			   "normal pages are used",
+			   (int) (huge_size / jack_hugepage_size), path,
+			   strerror (errno));
+		close (shm_fd);
+		unlink (path);
+		return -1;
+	}
+
+	close (shm_fd);
+	strncpy (registry->id, path, sizeof (registry->id));
+	*size = huge_size;
+	return 0;
+}
+
+/* The registry is writable by all users: a path id is only accepted
+ * for a segment named as jack_shmalloc_hugepages does, directly in the
+ * configured hugetlbfs mount (any hugetlbfs mount when the process was
+ * started without JACK_SHM_HUGEPAGES).
+ */
+static int
+jack_hugepage_path (const char *id, char *path)
+{
+	char dir[PATH_MAX];
+	const char *name;
+	struct statfs fs;
+
+	if (memchr (id, '\0', sizeof (jack_shm_id_t)) == NULL
+	    || strstr (id, "..") != NULL
+	    || (name = strrchr (id, '/')) == id
+	    || strncmp (name, "/jack-", 6) != 0)
+		return -1;
+
+	memcpy (dir, id, name - id);
+	dir[name - id] = '\0';
+	if (realpath (dir, path) == NULL)
+		return -1;
+
+	jack_read_shm_options ();
+	if (jack_hugepage_dir[0] != '\0') {
+		if (strcmp (path, jack_hugepage_dir) != 0)
+			return -1;
+	} else if (statfs (path, &fs) < 0 || fs.f_type != HUGETLBFS_MAGIC) {
+		return -1;
+	}
+
+	if (strlen (path) + strlen (name) >= PATH_MAX)
+		return -1;
+	strcat (path, name);
+	return 0;
+}
+
+static int
+jack_open_hugepages (const char *id, int oflag)
+{
+	char path[PATH_MAX];
+	struct statfs fs;
+	int shm_fd;
+
+	if (jack_hugepage_path (id, path) < 0) {
+		errno = EACCES;
+		return -1;
+	}
+
+	if ((shm_fd = open (path, oflag | O_NOFOLLOW)) < 0)
+		return -1;
+
+	if (fstatfs (shm_fd, &fs) < 0 || fs.f_type != HUGETLBFS_MAGIC) {
+		close (shm_fd);
+		errno = EACCES;
+		return -1;
+	}
+
+	return shm_fd;
+}
+
+static void
+jack_unlink_hugepages (const char *id)
+{
+	char path[PATH_MAX];
+
+	if (jack_hugepage_path (id, path) < 0) {
+		jack_error ("Cannot remove shm segment %s, "
+			    "not in the huge page mount", id);
+		return;
+	}
+
+	unlink (path);
+}
+
+#else
+
+static void
+jack_read_shm_options (void) {}
+
+static int
+jack_place_shm (int shm_fd, jack_shmsize_t size, int hugepages)
+{
+	return 0;
+}
+
+static int
+jack_shmalloc_hugepages (const char *name, jack_shmsize_t *size,
+			 jack_shm_registry_t *registry)
+{
+	return -1;
+}
+
+static int
+jack_open_hugepages (const char *id, int oflag)
+{
+	errno = EACCES;
+	return -1;
+}
+
+static void
+jack_unlink_hugepages (const char *id)
+{
+	jack_error ("Cannot remove shm segment %s, "
+		    "not in the huge page mount", id);
+}
+
+#endif /* __linux__ */
+
+/* segments in a hugetlbfs mount are named by their path */
+static int
+jack_open_shm (const char *id, int oflag)
+{
+	if (strchr (id + 1, '/') != NULL)
+		return jack_open_hugepages (id, oflag);
+	return shm_open (id, oflag, 0666);
+}
+
 /* gain addressability to existing SHM registry segment
  *
  * sets up global registry pointers, if successful
@@ -808,7 +1165,10 @@ static void
 jack_remove_shm (jack_shm_id_t *id)
 {
 	/* registry may or may not be locked */
-	shm_unlink ((char *) id);
+	if (strchr ((char *) id + 1, '/') != NULL)
+		jack_unlink_hugepages ((char *) id);
+	else
+		shm_unlink ((char *) id);
 }
 
 void
@@ -863,23 +1223,30 @@ jack_shmalloc (const char *shm_name, jack_shmsize_t size, jack_shm_info_t* si)
 		goto unlock;
 	}
 
-	if ((shm_fd = shm_open (name, O_RDWR|O_CREAT, 0666)) < 0) {
-		jack_error ("Cannot create shm segment %s (%s)",
-			    name, strerror (errno));
-		goto unlock;
-	}
+	jack_read_shm_options ();
 
-	if (ftruncate (shm_fd, size) < 0) {
-		jack_error ("Cannot set size of engine shm "
-			    "registry 0 (%s)",
-			    strerror (errno));
+	if (jack_shmalloc_hugepages (name, &size, registry) < 0) {
+
+		if ((shm_fd = shm_open (name, O_RDWR|O_CREAT, 0666)) < 0) {
+			jack_error ("Cannot create shm segment %s (%s)",
+				    name, strerror (errno));
+			goto unlock;
+		}
+
+		if (ftruncate (shm_fd, size) < 0) {
+			jack_error ("Cannot set size of engine shm "
+				    "registry 0 (%s)",
+				    strerror (errno));
+			close (shm_fd);
+			goto unlock;
+		}
+
+		jack_place_shm (shm_fd, size, FALSE);
 		close (shm_fd);
-		goto unlock;
+		strncpy (registry->id, name, sizeof (registry->id));
 	}
 
-	close (shm_fd);
 	registry->size = size;
-	strncpy (registry->id, name, sizeof (registry->id));
 	registry->allocator = GetPID();
 	si->index = registry->index;
 	si->ptr.attached_at = MAP_FAILED;	/* not attached */
@@ -896,8 +1263,7 @@ jack_attach_shm (jack_shm_info_t* si)
 	int shm_fd;
 	jack_shm_registry_t *registry = &jack_shm_registry[si->index];
 
-	if ((shm_fd = shm_open (registry->id,
-				O_RDWR, 0666)) < 0) {
+	if ((shm_fd = jack_open_shm (registry->id, O_RDWR)) < 0) {
 		jack_error ("Cannot open shm segment %s (%s)", registry->id,
 			    strerror (errno));
 		return -1;
@@ -922,8 +1288,7 @@ jack_attach_shm_read (jack_shm_info_t* si)
 	int shm_fd;
 	jack_shm_registry_t *registry = &jack_shm_registry[si->index];
 
-	if ((shm_fd = shm_open (registry->id,
-				O_RDONLY, 0666)) < 0) {
+	if ((shm_fd = jack_open_shm (registry->id, O_RDONLY)) < 0) {
 		jack_error ("Cannot open shm segment %s (%s)", registry->id,
 			    strerror (errno));
 		return -1;
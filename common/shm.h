@@ -191,8 +191,8 @@ extern "C"
     char* jack_shm_addr (jack_shm_info_t* si);
 
     // here begin the API
-    int jack_register_server (const char *server_name, int new_registry);
-    int jack_unregister_server (const char *server_name);
+    SERVER_EXPORT int jack_register_server (const char *server_name, int new_registry);
+    SERVER_EXPORT int jack_unregister_server (const char *server_name);
 
     int jack_initialize_shm (const char *server_name);
     int jack_initialize_shm_server (void);
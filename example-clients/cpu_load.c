@@ -12,6 +12,7 @@
 #include <unistd.h>
 #endif
 #include <jack/jack.h>
+#include <jack/statistics.h>
 
 
 jack_client_t *client;
@@ -75,7 +76,24 @@ main(int argc, char *argv[])
 #endif
 
     while (1) {
+        int i;
         printf("jack DSP load %f\n", jack_cpu_load(client));
+
+        /* load of the clients given as arguments */
+        for (i = 1; i < argc; i++) {
+            jack_client_load_t load;
+            jack_time_t p99;
+            if (jack_get_client_load(client, argv[i], &load) == 0
+                && jack_get_client_dsp_percentile(client, argv[i], 99.f, &p99) == 0) {
+                printf("    %s : DSP load %f, DSP usecs avg %lu max %lu 99%% %lu, wake-up usecs avg %lu max %lu, late cycles %u, notification usecs %lu max %lu\n",
+                       argv[i], load.cpu_load,
+                       (unsigned long)load.average_dsp_usecs, (unsigned long)load.max_dsp_usecs, (unsigned long)p99,
+                       (unsigned long)load.average_wakeup_usecs, (unsigned long)load.max_wakeup_usecs, load.late_cycles,
+                       (unsigned long)load.notify_usecs, (unsigned long)load.max_notify_usecs);
+            } else {
+                printf("    %s : no such client\n", argv[i]);
+            }
+        }
 #ifdef WIN32
         Sleep(1000);
 #else
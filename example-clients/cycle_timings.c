@@ -0,0 +1,210 @@
+/*
+    Copyright (C) 2026 agent
+
+    This program is free software; you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation; either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program; if not, write to the Free Software
+    Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <signal.h>
+#ifndef WIN32
+#include <unistd.h>
+#endif
+#include <getopt.h>
+#include <inttypes.h>
+
+#include <jack/jack.h>
+#include <jack/statistics.h>
+
+#define MAX_CLIENTS 256
+
+/* Client status, as recorded by the server */
+#define STATUS_FINISHED 3
+
+static jack_client_t *client;
+static int keep_recording = 0;
+static volatile int done = 0;
+
+static void
+signal_handler (int sig)
+{
+	done = 1;
+}
+
+static void
+jack_shutdown (void *arg)
+{
+	fprintf (stderr, "JACK shut down, exiting ...\n");
+	exit (1);
+}
+
+static void
+show_usage (const char *name)
+{
+	fprintf (stderr, "\nUsage: %s [options]\n", name);
+	fprintf (stderr, "Record and print the timings of each client during the server cycles.\n\n");
+	fprintf (stderr, "        -s, --server <name>   Connect to the jack server named <name>\n");
+	fprintf (stderr, "        -l, --late            Only print late cycles, and the clients responsible for them\n");
+	fprintf (stderr, "        -c, --count <n>       Exit after <n> printed cycles\n");
+	fprintf (stderr, "        -k, --keep            Keep the recording on when exiting\n");
+	fprintf (stderr, "        -h, --help            Display this help message\n\n");
+}
+
+static long
+relative (jack_time_t time, jack_time_t begin)
+{
+	return (time > 0) ? (long)(time - begin) : -1;
+}
+
+/* A client is late when it did not finish, or finished after the cycle deadline */
+static int
+is_late (const jack_cycle_timing_t *timing, const jack_client_cycle_timing_t *timings)
+{
+	return (timings->status != STATUS_FINISHED || timings->finished_at > timing->begin + timing->period_usecs);
+}
+
+static void
+print_cycle (const jack_cycle_timing_t *timing, const jack_client_cycle_timing_t *clients, int late_only)
+{
+	char name[jack_client_name_size ()];
+	int i;
+
+	printf ("cycle %" PRIu32 " begin %" PRIu64 " duration %ld period %" PRIu64 " clients %d\n",
+		timing->cycle, (uint64_t)timing->begin, relative (timing->end, timing->begin),
+		(uint64_t)timing->period_usecs, timing->client_count);
+
+	for (i = 0; i < timing->client_count; i++) {
+		const jack_client_cycle_timing_t *timings = &clients[i];
+		int late = is_late (timing, timings);
+		if (late_only && !late) {
+			continue;
+		}
+		if (jack_get_cycle_timings_client_name (client, timings->id, name, sizeof (name)) < 0) {
+			snprintf (name, sizeof (name), "%d", timings->id);
+		}
+		printf ("    %-32s signaled %6ld awake %6ld finished %6ld dsp %6ld%s\n", name,
+			relative (timings->signaled_at, timing->begin),
+			relative (timings->awake_at, timing->begin),
+			relative (timings->finished_at, timing->begin),
+			(timings->awake_at > 0 && timings->finished_at > timings->awake_at) ? (long)(timings->finished_at - timings->awake_at) : -1,
+			late ? "  LATE" : "");
+	}
+}
+
+int
+main (int argc, char *argv[])
+{
+	const char *server_name = NULL;
+	jack_options_t options = JackNoStartServer;
+	jack_status_t status;
+	jack_cycle_timing_t timing;
+	jack_client_cycle_timing_t clients[MAX_CLIENTS];
+	uint32_t next = 0;
+	int late_only = 0;
+	long count = -1;
+	int first = 1;
+	int i, opt, option_index;
+
+	struct option long_options[] = {
+		{ "server", 1, 0, 's' },
+		{ "late", 0, 0, 'l' },
+		{ "count", 1, 0, 'c' },
+		{ "keep", 0, 0, 'k' },
+		{ "help", 0, 0, 'h' },
+		{ 0, 0, 0, 0 }
+	};
+
+	while ((opt = getopt_long (argc, argv, "s:lc:kh", long_options, &option_index)) != EOF) {
+		switch (opt) {
+			case 's':
+				server_name = optarg;
+				options |= JackServerName;
+				break;
+			case 'l':
+				late_only = 1;
+				break;
+			case 'c':
+				count = atol (optarg);
+				break;
+			case 'k':
+				keep_recording = 1;
+				break;
+			case 'h':
+				show_usage (argv[0]);
+				return 0;
+			default:
+				show_usage (argv[0]);
+				return 1;
+		}
+	}
+
+	if ((client = jack_client_open ("cycle_timings", options, &status, server_name)) == 0) {
+		fprintf (stderr, "JACK server not running?\n");
+		return 1;
+	}
+
+	jack_on_shutdown (client, jack_shutdown, 0);
+
+#ifndef WIN32
+	signal (SIGQUIT, signal_handler);
+	signal (SIGHUP, signal_handler);
+#endif
+	signal (SIGTERM, signal_handler);
+	signal (SIGINT, signal_handler);
+
+	if (jack_set_cycle_timings (client, 1) != 0) {
+		fprintf (stderr, "Cannot start recording cycle timings\n");
+		jack_client_close (client);
+		return 1;
+	}
+
+	while (!done && count != 0) {
+
+		/* Read all cycles recorded since the last poll */
+		while (jack_get_cycle_timings (client, next, &timing, clients, MAX_CLIENTS) == 0) {
+			if (!first && timing.cycle != next) {
+				printf ("%" PRIu32 " cycles lost\n", timing.cycle - next);
+			}
+			first = 0;
+			next = timing.cycle + 1;
+
+			if (late_only) {
+				int late = (timing.end > timing.begin + timing.period_usecs);
+				for (i = 0; i < timing.client_count && !late; i++) {
+					late = is_late (&timing, &clients[i]);
+				}
+				if (!late) {
+					continue;
+				}
+			}
+
+			print_cycle (&timing, clients, late_only);
+			if (count > 0 && --count == 0) {
+				break;
+			}
+		}
+
+		fflush (stdout);
+		usleep (100000);
+	}
+
+	if (!keep_recording) {
+		jack_set_cycle_timings (client, 0);
+	}
+
+	jack_client_close (client);
+	return 0;
+}
@@ -0,0 +1,306 @@
+/*
+Copyright (C) 2026 agent
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 2.1 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*/
+
+#include "JackLinuxFutex.h"
+#include "JackAtomic.h"
+#include "JackTools.h"
+#include "JackConstants.h"
+#include "JackError.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+namespace Jack
+{
+
+// The futex is shared between processes : FUTEX_PRIVATE_FLAG cannot be used
+static inline int futex(volatile SInt32* addr, int op, int val, const struct timespec* timeout)
+{
+    return syscall(SYS_futex, addr, op, val, timeout, NULL, 0);
+}
+
+static inline long long GetMonotonicNanoSeconds()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+static inline void AddAtomic(volatile SInt32* val, SInt32 delta)
+{
+    SInt32 actual;
+    do {
+        actual = *val;
+    } while (!CAS(actual, actual + delta, val));
+}
+
+JackLinuxFutex::JackLinuxFutex():JackSynchro(), fFutex(NULL)
+{
+    // Spinning only makes sense if the signaling thread can run at the same time
+    fSpin = (sysconf(_SC_NPROCESSORS_ONLN) > 1);
+}
+
+void JackLinuxFutex::BuildName(const char* client_name, const char* server_name, char* res, int size)
+{
+    char ext_client_name[SYNC_MAX_NAME_SIZE + 1];
+    JackTools::RewriteName(client_name, ext_client_name);
+    if (getenv("JACK_PROMISCUOUS_SERVER")) {
+        snprintf(res, size, "jack_futex.%s_%s", server_name, ext_client_name);
+    } else {
+        snprintf(res, size, "jack_futex.%d_%s_%s", JackTools::GetUID(), server_name, ext_client_name);
+    }
+}
+
+bool JackLinuxFutex::Signal()
+{
+    if (!fFutex) {
+        jack_error("JackLinuxFutex::Signal name = %s already deallocated!!", fName);
+        return false;
+    }
+
+    if (fFlush)
+        return true;
+
+    AddAtomic(&fFutex->fCount, 1);
+
+    // The system call is only needed if a thread sleeps in the kernel
+    if (fFutex->fWaiters > 0 && futex(&fFutex->fCount, FUTEX_WAKE, 1, NULL) < 0) {
+        jack_error("JackLinuxFutex::Signal name = %s err = %s", fName, strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+bool JackLinuxFutex::SignalAll()
+{
+    return Signal();
+}
+
+bool JackLinuxFutex::TryWait()
+{
+    SInt32 count;
+    while ((count = fFutex->fCount) > 0) {
+        if (CAS(count, count - 1, &fFutex->fCount)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// usec < 0 : no timeout
+bool JackLinuxFutex::WaitAux(long usec)
+{
+    if (!fFutex) {
+        jack_error("JackLinuxFutex::Wait name = %s already deallocated!!", fName);
+        return false;
+    }
+
+    if (TryWait()) {
+        return true;
+    }
+
+    long long now = GetMonotonicNanoSeconds();
+    long long end = now + (long long)usec * 1000;
+
+    if (fSpin) {
+        long long spin_end = now + SYNCHRO_SPIN * 1000;
+        while (now < spin_end) {
+            if (TryWait()) {
+                return true;
+            }
+            now = GetMonotonicNanoSeconds();
+        }
+    }
+
+    bool res = true;
+    AddAtomic(&fFutex->fWaiters, 1);
+
+    while (!TryWait()) {
+        struct timespec time;
+        struct timespec* timeout = NULL;
+        if (usec >= 0) {
+            long long remaining = end - GetMonotonicNanoSeconds();
+            if (remaining <= 0) {
+                jack_error("JackLinuxFutex::TimedWait name = %s time out", fName);
+                res = false;
+                break;
+            }
+            time.tv_sec = remaining / 1000000000LL;
+            time.tv_nsec = remaining % 1000000000LL;
+            timeout = &time;
+        }
+        // Sleeps only if no signal came since the last TryWait
+        if (futex(&fFutex->fCount, FUTEX_WAIT, 0, timeout) < 0
+            && errno != EAGAIN && errno != EINTR && errno != ETIMEDOUT) {
+            jack_error("JackLinuxFutex::Wait name = %s err = %s", fName, strerror(errno));
+            res = false;
+            break;
+        }
+    }
+
+    AddAtomic(&fFutex->fWaiters, -1);
+    return res;
+}
+
+bool JackLinuxFutex::Wait()
+{
+    return WaitAux(-1);
+}
+
+bool JackLinuxFutex::TimedWait(long usec)
+{
+    return WaitAux(usec);
+}
+
+// Server side : publish the futex in the global namespace
+bool JackLinuxFutex::Allocate(const char* name, const char* server_name, int value)
+{
+    BuildName(name, server_name, fName, sizeof(fName));
+    jack_log("JackLinuxFutex::Allocate name = %s val = %ld", fName, value);
+
+    // A segment left by a crashed server would be shared with the new one
+    shm_unlink(fName);
+
+    int fd = shm_open(fName, O_CREAT | O_EXCL | O_RDWR, 0666);
+    if (fd < 0) {
+        jack_error("Allocate: can't check in futex name = %s err = %s", fName, strerror(errno));
+        return false;
+    }
+
+    if (ftruncate(fd, sizeof(JackFutexCounter)) < 0) {
+        jack_error("Allocate: can't set size of futex name = %s err = %s", fName, strerror(errno));
+        close(fd);
+        shm_unlink(fName);
+        return false;
+    }
+
+    void* addr = mmap(NULL, sizeof(JackFutexCounter), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED) {
+        jack_error("Allocate: can't map futex name = %s err = %s", fName, strerror(errno));
+        shm_unlink(fName);
+        return false;
+    }
+
+    fFutex = (JackFutexCounter*)addr;
+    fFutex->fCount = value;
+    fFutex->fWaiters = 0;
+    return true;
+}
+
+// Client side : get the published futex from server
+bool JackLinuxFutex::ConnectInput(const char* name, const char* server_name)
+{
+    BuildName(name, server_name, fName, sizeof(fName));
+    jack_log("JackLinuxFutex::Connect name = %s", fName);
+
+    if (fFutex) {
+        jack_log("Already connected name = %s", name);
+        return true;
+    }
+
+    int fd = shm_open(fName, O_RDWR, 0);
+    if (fd < 0) {
+        jack_error("Connect: can't connect futex name = %s err = %s", fName, strerror(errno));
+        return false;
+    }
+
+    void* addr = mmap(NULL, sizeof(JackFutexCounter), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED) {
+        jack_error("Connect: can't map futex name = %s err = %s", fName, strerror(errno));
+        return false;
+    }
+
+    fFutex = (JackFutexCounter*)addr;
+    jack_log("JackLinuxFutex::Connect count = %ld", fFutex->fCount);
+    return true;
+}
+
+bool JackLinuxFutex::Connect(const char* name, const char* server_name)
+{
+    return ConnectInput(name, server_name);
+}
+
+bool JackLinuxFutex::ConnectOutput(const char* name, const char* server_name)
+{
+    return ConnectInput(name, server_name);
+}
+
+bool JackLinuxFutex::Disconnect()
+{
+    if (fFutex) {
+        jack_log("JackLinuxFutex::Disconnect name = %s", fName);
+        if (munmap((void*)fFutex, sizeof(JackFutexCounter)) != 0) {
+            jack_error("Disconnect: can't disconnect futex name = %s err = %s", fName, strerror(errno));
+            return false;
+        } else {
+            fFutex = NULL;
+            return true;
+        }
+    } else {
+        return true;
+    }
+}
+
+// Server side : destroy the futex
+void JackLinuxFutex::Destroy()
+{
+    if (fFutex != NULL) {
+        jack_log("JackLinuxFutex::Destroy name = %s", fName);
+        shm_unlink(fName);
+        if (munmap((void*)fFutex, sizeof(JackFutexCounter)) != 0) {
+            jack_error("Destroy: can't destroy futex name = %s err = %s", fName, strerror(errno));
+        }
+        fFutex = NULL;
+    } else {
+        jack_error("JackLinuxFutex::Destroy futex == NULL");
+    }
+}
+
+// Client side : tells if the server published a futex for this name
+bool JackLinuxFutex::Exists(const char* name, const char* server_name)
+{
+    char futex_name[SYNC_MAX_NAME_SIZE];
+    BuildName(name, server_name, futex_name, sizeof(futex_name));
+
+    int fd = shm_open(futex_name, O_RDWR, 0);
+    if (fd < 0) {
+        return false;
+    } else {
+        close(fd);
+        return true;
+    }
+}
+
+// Server side : remove a futex that may have been published by a previous server
+void JackLinuxFutex::Unlink(const char* name, const char* server_name)
+{
+    char futex_name[SYNC_MAX_NAME_SIZE];
+    BuildName(name, server_name, futex_name, sizeof(futex_name));
+    shm_unlink(futex_name);
+}
+
+} // end of namespace
+
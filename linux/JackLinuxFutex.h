@@ -0,0 +1,86 @@
+/*
+Copyright (C) 2026 agent
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 2.1 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*/
+
+#ifndef __JackLinuxFutex__
+#define __JackLinuxFutex__
+
+#include "JackSynchro.h"
+#include "JackCompilerDeps.h"
+#include "JackTypes.h"
+
+namespace Jack
+{
+
+/*!
+\brief The futex word and the waiters count, shared between the server and the clients.
+*/
+
+struct JackFutexCounter
+{
+    volatile SInt32 fCount;     /*! Number of pending signals : the futex word */
+    volatile SInt32 fWaiters;   /*! Number of threads waiting in the kernel */
+};
+
+/*!
+\brief Inter process synchronization using a futex counter in shared memory.
+
+A signal only does a system call to wake up a waiting thread, and a wait first spins on the counter
+(on a multi CPU machine) before sleeping in the kernel.
+*/
+
+class SERVER_EXPORT JackLinuxFutex : public detail::JackSynchro
+{
+
+    private:
+
+        JackFutexCounter* fFutex;
+        bool fSpin;
+
+        bool TryWait();
+        bool WaitAux(long usec);
+
+    protected:
+
+        static void BuildName(const char* name, const char* server_name, char* res, int size);
+
+    public:
+
+        JackLinuxFutex();
+
+        bool Signal();
+        bool SignalAll();
+        bool Wait();
+        bool TimedWait(long usec);
+
+        bool Allocate(const char* name, const char* server_name, int value);
+        bool Connect(const char* name, const char* server_name);
+        bool ConnectInput(const char* name, const char* server_name);
+        bool ConnectOutput(const char* name, const char* server_name);
+        bool Disconnect();
+        void Destroy();
+
+        static bool Exists(const char* name, const char* server_name);
+        static void Unlink(const char* name, const char* server_name);
+};
+
+} // end of namespace
+
+
+#endif
+
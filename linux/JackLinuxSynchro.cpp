@@ -0,0 +1,60 @@
+/*
+Copyright (C) 2026 agent
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 2.1 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*/
+
+#include "JackLinuxSynchro.h"
+#include "JackGlobals.h"
+#include "JackError.h"
+
+namespace Jack
+{
+
+// Server side
+bool JackLinuxSynchro::Allocate(const char* name, const char* server_name, int value)
+{
+    fUseFutex = (JackGlobals::fSynchroType == JACK_SYNCHRO_FUTEX);
+
+    if (fUseFutex) {
+        return fFutex.Allocate(name, server_name, value);
+    } else {
+        // Clients look for a futex first : one left by a previous server must not be found
+        JackLinuxFutex::Unlink(name, server_name);
+        return fSemaphore.Allocate(name, server_name, value);
+    }
+}
+
+// Client side
+bool JackLinuxSynchro::ConnectInput(const char* name, const char* server_name)
+{
+    fUseFutex = JackLinuxFutex::Exists(name, server_name);
+    jack_log("JackLinuxSynchro::Connect name = %s uses %s", name, (fUseFutex) ? "futex" : "semaphore");
+    return (fUseFutex) ? fFutex.ConnectInput(name, server_name) : fSemaphore.ConnectInput(name, server_name);
+}
+
+bool JackLinuxSynchro::Connect(const char* name, const char* server_name)
+{
+    return ConnectInput(name, server_name);
+}
+
+bool JackLinuxSynchro::ConnectOutput(const char* name, const char* server_name)
+{
+    return ConnectInput(name, server_name);
+}
+
+} // end of namespace
+
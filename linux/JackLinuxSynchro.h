@@ -0,0 +1,96 @@
+/*
+Copyright (C) 2026 agent
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 2.1 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*/
+
+#ifndef __JackLinuxSynchro__
+#define __JackLinuxSynchro__
+
+#include "JackSynchro.h"
+#include "JackLinuxFutex.h"
+#include "JackPosixSemaphore.h"
+
+namespace Jack
+{
+
+/*!
+\brief Client activation synchro : a futex or a POSIX semaphore, chosen when the server starts.
+
+The server allocates the kind of synchro given by JackGlobals::fSynchroType, clients use the kind the server has published.
+*/
+
+class SERVER_EXPORT JackLinuxSynchro : public detail::JackSynchro
+{
+
+    private:
+
+        JackLinuxFutex fFutex;
+        JackPosixSemaphore fSemaphore;
+        bool fUseFutex;
+
+    public:
+
+        JackLinuxSynchro():JackSynchro(), fUseFutex(false)
+        {}
+
+        bool Signal()
+        {
+            return (fUseFutex) ? fFutex.Signal() : fSemaphore.Signal();
+        }
+        bool SignalAll()
+        {
+            return (fUseFutex) ? fFutex.SignalAll() : fSemaphore.SignalAll();
+        }
+        bool Wait()
+        {
+            return (fUseFutex) ? fFutex.Wait() : fSemaphore.Wait();
+        }
+        bool TimedWait(long usec)
+        {
+            return (fUseFutex) ? fFutex.TimedWait(usec) : fSemaphore.TimedWait(usec);
+        }
+
+        bool Allocate(const char* name, const char* server_name, int value);
+        bool Connect(const char* name, const char* server_name);
+        bool ConnectInput(const char* name, const char* server_name);
+        bool ConnectOutput(const char* name, const char* server_name);
+
+        bool Disconnect()
+        {
+            return (fUseFutex) ? fFutex.Disconnect() : fSemaphore.Disconnect();
+        }
+        void Destroy()
+        {
+            if (fUseFutex) {
+                fFutex.Destroy();
+            } else {
+                fSemaphore.Destroy();
+            }
+        }
+
+        void SetFlush(bool mode)
+        {
+            fFutex.SetFlush(mode);
+            fSemaphore.SetFlush(mode);
+        }
+};
+
+} // end of namespace
+
+
+#endif
+
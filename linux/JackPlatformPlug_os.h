@@ -20,6 +20,8 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 #ifndef __JackPlatformPlug_linux__
 #define __JackPlatformPlug_linux__
 
+#include "config.h"
+
 #define jack_server_dir "/dev/shm"
 #define jack_client_dir "/dev/shm"
 #define JACK_DEFAULT_DRIVER "alsa"
@@ -34,6 +36,8 @@ namespace Jack
     class JackFifo;
     class JackSocketServerChannel;
     class JackSocketClientChannel;
+    class JackShmServerChannel;
+    class JackShmClientChannel;
     class JackSocketServerNotifyChannel;
     class JackSocketNotifyChannel;
     class JackClientSocket;
@@ -54,8 +58,13 @@ namespace Jack { typedef JackPosixThread JackThread; }
 namespace Jack { typedef JackFifo JackSynchro; }
 */
 
+/*
 #include "JackPosixSemaphore.h"
 namespace Jack { typedef JackPosixSemaphore JackSynchro; }
+*/
+
+#include "JackLinuxSynchro.h"
+namespace Jack { typedef JackLinuxSynchro JackSynchro; }
 
 /* __JackPlatformChannelTransaction__ */
 /*
@@ -68,12 +77,22 @@ namespace Jack { typedef JackClientSocket JackChannelTransaction; }
 namespace Jack { typedef JackPosixProcessSync JackProcessSync; }
 
 /* __JackPlatformServerChannel__ */
+#ifdef JACK_SHM_CHANNEL
+#include "JackShmServerChannel.h"
+namespace Jack { typedef JackShmServerChannel JackServerChannel; }
+#else
 #include "JackSocketServerChannel.h"
 namespace Jack { typedef JackSocketServerChannel JackServerChannel; }
+#endif
 
 /* __JackPlatformClientChannel__ */
+#ifdef JACK_SHM_CHANNEL
+#include "JackShmClientChannel.h"
+namespace Jack { typedef JackShmClientChannel JackClientChannel; }
+#else
 #include "JackSocketClientChannel.h"
 namespace Jack { typedef JackSocketClientChannel JackClientChannel; }
+#endif
 
 /* __JackPlatformServerNotifyChannel__ */
 #include "JackSocketServerNotifyChannel.h"
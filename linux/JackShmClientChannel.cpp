@@ -0,0 +1,117 @@
+/*
+Copyright (C) 2026 agent
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 2.1 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*/
+
+#include "JackShmClientChannel.h"
+#include "JackRequest.h"
+#include "JackGlobals.h"
+#include "JackError.h"
+
+namespace Jack
+{
+
+JackShmClientChannel::JackShmClientChannel()
+    :JackSocketClientChannel(), JackLockAble("JackShmClientChannel")
+{
+    fSocket = fRequest;
+    fServerName[0] = 0;
+}
+
+JackShmClientChannel::~JackShmClientChannel()
+{
+    // The socket is deleted by JackSocketClientChannel
+    RingClose();
+}
+
+int JackShmClientChannel::Open(const char* server_name, const char* name, int uuid, char* name_res, JackClient* client, jack_options_t options, jack_status_t* status)
+{
+    strncpy(fServerName, server_name, sizeof(fServerName));
+    fServerName[sizeof(fServerName) - 1] = 0;
+    return JackSocketClientChannel::Open(server_name, name, uuid, name_res, client, options, status);
+}
+
+void JackShmClientChannel::Close()
+{
+    RingClose();
+    JackSocketClientChannel::Close();
+}
+
+void JackShmClientChannel::RingOpen(const char* name)
+{
+    if (fRing.Allocate(name, fServerName, &JackGlobals::fServerRunning) < 0) {
+        jack_log("JackShmClientChannel::RingOpen : requests are sent on the socket");
+        return;
+    }
+
+    JackClientRequestRingRequest req(name);
+    JackResult res;
+    int result;
+    ServerSyncCall(&req, &res, &result);
+
+    // The segment is connected by the server (or will never be)
+    fRing.Unlink();
+
+    if (result < 0) {
+        jack_log("JackShmClientChannel::RingOpen : server refused request channel, requests are sent on the socket");
+        fRing.Close();
+    } else {
+        JackLock lock(this);
+        fRequest = &fRing;
+    }
+}
+
+void JackShmClientChannel::RingClose()
+{
+    JackLock lock(this);
+    fRequest = fSocket;
+    fRing.Shutdown();
+    fRing.Close();
+}
+
+void JackShmClientChannel::ClientOpen(const char* name, int pid, int uuid, int* shared_engine, int* shared_client, int* shared_graph, int* result)
+{
+    JackSocketClientChannel::ClientOpen(name, pid, uuid, shared_engine, shared_client, shared_graph, result);
+    if (*result == 0) {
+        RingOpen(name);
+    }
+}
+
+void JackShmClientChannel::ClientClose(int refnum, int* result)
+{
+    {
+        // The server identifies the closing client by its socket, and then stops reading the ring
+        JackLock lock(this);
+        fRequest = fSocket;
+    }
+    JackSocketClientChannel::ClientClose(refnum, result);
+    RingClose();
+}
+
+void JackShmClientChannel::ServerSyncCall(JackRequest* req, JackResult* res, int* result)
+{
+    JackLock lock(this);
+    JackSocketClientChannel::ServerSyncCall(req, res, result);
+}
+
+void JackShmClientChannel::ServerAsyncCall(JackRequest* req, JackResult* res, int* result)
+{
+    JackLock lock(this);
+    JackSocketClientChannel::ServerAsyncCall(req, res, result);
+}
+
+} // end of namespace
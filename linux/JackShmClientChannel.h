@@ -0,0 +1,69 @@
+/*
+Copyright (C) 2026 agent
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 2.1 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*/
+
+#ifndef __JackShmClientChannel__
+#define __JackShmClientChannel__
+
+#include "JackSocketClientChannel.h"
+#include "JackShmRequestRing.h"
+#include "JackConstants.h"
+#include "JackMutex.h"
+
+namespace Jack
+{
+
+/*!
+\brief JackClientChannel using a socket to open and close the client, and a shared memory channel for the other requests.
+
+If the server cannot open the shared memory channel, all requests are sent on the socket.
+*/
+
+class JackShmClientChannel : public JackSocketClientChannel, public JackLockAble
+{
+
+    private:
+
+        detail::JackClientRequestInterface* fSocket;    // fRequest is either the socket or the ring
+        JackShmRequestRing fRing;
+        char fServerName[JACK_SERVER_NAME_SIZE + 1];
+
+        void RingOpen(const char* name);
+        void RingClose();
+
+    protected:
+
+        // The ring has a single producer : calls from several client threads are serialized
+        void ServerSyncCall(JackRequest* req, JackResult* res, int* result);
+        void ServerAsyncCall(JackRequest* req, JackResult* res, int* result);
+
+    public:
+
+        JackShmClientChannel();
+        virtual ~JackShmClientChannel();
+
+        int Open(const char* server_name, const char* name, int uuid, char* name_res, JackClient* client, jack_options_t options, jack_status_t* status);
+        void Close();
+
+        void ClientOpen(const char* name, int pid, int uuid, int* shared_engine, int* shared_client, int* shared_graph, int* result);
+        void ClientClose(int refnum, int* result);
+};
+
+} // end of namespace
+
+#endif
@@ -0,0 +1,291 @@
+/*
+Copyright (C) 2026 agent
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 2.1 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*/
+
+#include "JackShmRequestRing.h"
+#include "JackTools.h"
+#include "JackError.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+#include <limits.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
+
+namespace Jack
+{
+
+// The segment is shared between processes : FUTEX_PRIVATE_FLAG cannot be used
+static inline int futex(volatile SInt32* addr, int op, int val, const struct timespec* timeout)
+{
+    return syscall(SYS_futex, addr, op, val, timeout, NULL, 0);
+}
+
+static inline long long GetMonotonicMicroSeconds()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000LL + ts.tv_nsec / 1000;
+}
+
+// Waits until the position moves from value, the side sleeping in the kernel is flagged for the other one to wake it up
+static int WaitPosition(volatile SInt32* position, SInt32 value, volatile SInt32* waiting, bool spin, volatile SInt32* closed)
+{
+    if (spin) {
+        long long end = GetMonotonicMicroSeconds() + SYNCHRO_SPIN;
+        while (*position == value && GetMonotonicMicroSeconds() < end) {}
+    }
+
+    while (*position == value) {
+        if (*closed) {
+            return -1;
+        }
+        *waiting = 1;
+        __sync_synchronize();
+        // Sleeps only if the position did not move since the flag has been seen by the other side
+        if (*position == value) {
+            struct timespec timeout = { 0, REQUEST_RING_TIME_OUT * 1000 };
+            if (futex(position, FUTEX_WAIT, value, &timeout) < 0
+                && errno != EAGAIN && errno != EINTR && errno != ETIMEDOUT) {
+                jack_error("JackShmRequestRing wait err = %s", strerror(errno));
+                *waiting = 0;
+                return -1;
+            }
+        }
+        *waiting = 0;
+    }
+    return 0;
+}
+
+static inline void MovePosition(volatile SInt32* position, SInt32 value, volatile SInt32* waiting)
+{
+    // The buffer content is visible before the new position, which is visible before the waiting flag is read
+    __sync_synchronize();
+    *position = value;
+    __sync_synchronize();
+    if (*waiting) {
+        futex(position, FUTEX_WAKE, 1, NULL);
+    }
+}
+
+JackShmRequestRing::JackShmRequestRing()
+    :JackClientRequestInterface(), fBlock(NULL), fInput(NULL), fOutput(NULL), fRunning(NULL)
+{
+    fName[0] = 0;
+    // Spinning only makes sense if the other side can run at the same time
+    fSpin = (sysconf(_SC_NPROCESSORS_ONLN) > 1);
+}
+
+JackShmRequestRing::~JackShmRequestRing()
+{
+    Close();
+}
+
+void JackShmRequestRing::BuildName(const char* client_name, const char* server_name, char* res, int size)
+{
+    char ext_client_name[SYNC_MAX_NAME_SIZE + 1];
+    JackTools::RewriteName(client_name, ext_client_name);
+    if (getenv("JACK_PROMISCUOUS_SERVER")) {
+        snprintf(res, size, "/jack_request.%s_%s", server_name, ext_client_name);
+    } else {
+        snprintf(res, size, "/jack_request.%d_%s_%s", JackTools::GetUID(), server_name, ext_client_name);
+    }
+}
+
+int JackShmRequestRing::Map(int fd, bool client_side)
+{
+    void* addr = mmap(NULL, sizeof(JackRequestRingBlock), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (addr == MAP_FAILED) {
+        jack_error("JackShmRequestRing : can't map segment name = %s err = %s", fName, strerror(errno));
+        return -1;
+    }
+
+    fBlock = (JackRequestRingBlock*)addr;
+    fInput = (client_side) ? &fBlock->fResult : &fBlock->fRequest;
+    fOutput = (client_side) ? &fBlock->fRequest : &fBlock->fResult;
+    return 0;
+}
+
+// Client side : the segment is created, then connected by the server
+int JackShmRequestRing::Allocate(const char* client_name, const char* server_name, volatile bool* running)
+{
+    fRunning = running;
+    BuildName(client_name, server_name, fName, sizeof(fName));
+    jack_log("JackShmRequestRing::Allocate name = %s", fName);
+
+    // A segment left by a crashed client would be shared with the new one
+    shm_unlink(fName);
+
+    int fd = shm_open(fName, O_CREAT | O_EXCL | O_RDWR, 0666);
+    if (fd < 0) {
+        jack_error("JackShmRequestRing::Allocate : can't create segment name = %s err = %s", fName, strerror(errno));
+        return -1;
+    }
+
+    if (ftruncate(fd, sizeof(JackRequestRingBlock)) < 0) {
+        jack_error("JackShmRequestRing::Allocate : can't set size of segment name = %s err = %s", fName, strerror(errno));
+        close(fd);
+        Unlink();
+        return -1;
+    }
+
+    if (Map(fd, true) < 0) {
+        Unlink();
+        return -1;
+    }
+
+    // ftruncate gives a zeroed segment : positions are 0 and the channel is opened
+    return 0;
+}
+
+// Client side : once the server has connected the segment, its name is no more needed
+void JackShmRequestRing::Unlink()
+{
+    if (fName[0]) {
+        shm_unlink(fName);
+        fName[0] = 0;
+    }
+}
+
+// Server side : connect the segment allocated by the client
+int JackShmRequestRing::Attach(const char* client_name, const char* server_name)
+{
+    fRunning = NULL;
+    BuildName(client_name, server_name, fName, sizeof(fName));
+    jack_log("JackShmRequestRing::Attach name = %s", fName);
+
+    int fd = shm_open(fName, O_RDWR, 0);
+    if (fd < 0) {
+        jack_error("JackShmRequestRing::Attach : can't connect segment name = %s err = %s", fName, strerror(errno));
+        return -1;
+    }
+
+    struct stat infos;
+    if (fstat(fd, &infos) < 0 || infos.st_size != sizeof(JackRequestRingBlock)) {
+        jack_error("JackShmRequestRing::Attach : wrong segment size name = %s", fName);
+        close(fd);
+        return -1;
+    }
+
+    return Map(fd, false);
+}
+
+int JackShmRequestRing::Close()
+{
+    if (fBlock) {
+        jack_log("JackShmRequestRing::Close name = %s", fName);
+        munmap((void*)fBlock, sizeof(JackRequestRingBlock));
+        fBlock = NULL;
+        fInput = fOutput = NULL;
+        return 0;
+    } else {
+        return -1;
+    }
+}
+
+// Both sides waiting on the channel are woken up and will see it closed
+void JackShmRequestRing::Shutdown()
+{
+    if (fBlock) {
+        fBlock->fClosed = 1;
+        __sync_synchronize();
+        futex(&fBlock->fRequest.fWrite, FUTEX_WAKE, INT_MAX, NULL);
+        futex(&fBlock->fRequest.fRead, FUTEX_WAKE, INT_MAX, NULL);
+        futex(&fBlock->fResult.fWrite, FUTEX_WAKE, INT_MAX, NULL);
+        futex(&fBlock->fResult.fRead, FUTEX_WAKE, INT_MAX, NULL);
+    }
+}
+
+bool JackShmRequestRing::IsOpened()
+{
+    // On client side, the server may have quit without closing the channel
+    if (fRunning && !*fRunning) {
+        fBlock->fClosed = 1;
+    }
+    return !fBlock->fClosed;
+}
+
+int JackShmRequestRing::Read(void* data, int len)
+{
+    if (!fBlock) {
+        return -1;
+    }
+
+    char* dst = (char*)data;
+    while (len > 0) {
+        SInt32 read = fInput->fRead;
+        SInt32 available = (SInt32)((UInt32)fInput->fWrite - (UInt32)read);
+        if (available == 0) {
+            if (!IsOpened() || WaitPosition(&fInput->fWrite, read, &fInput->fReaderWaiting, fSpin, &fBlock->fClosed) < 0) {
+                return -1;
+            }
+            continue;
+        }
+
+        __sync_synchronize();
+        int count = (available < len) ? available : len;
+        int pos = read & (REQUEST_RING_SIZE - 1);
+        int first = (count < REQUEST_RING_SIZE - pos) ? count : REQUEST_RING_SIZE - pos;
+        memcpy(dst, fInput->fBuffer + pos, first);
+        memcpy(dst + first, fInput->fBuffer, count - first);
+        MovePosition(&fInput->fRead, (SInt32)((UInt32)read + count), &fInput->fWriterWaiting);
+
+        dst += count;
+        len -= count;
+    }
+    return 0;
+}
+
+int JackShmRequestRing::Write(void* data, int len)
+{
+    if (!fBlock || !IsOpened()) {
+        return -1;
+    }
+
+    char* src = (char*)data;
+    while (len > 0) {
+        SInt32 write = fOutput->fWrite;
+        SInt32 space = REQUEST_RING_SIZE - (SInt32)((UInt32)write - (UInt32)fOutput->fRead);
+        if (space == 0) {
+            // A message bigger than the ring is sent in several parts
+            if (!IsOpened() || WaitPosition(&fOutput->fRead, (SInt32)((UInt32)write - REQUEST_RING_SIZE), &fOutput->fWriterWaiting, fSpin, &fBlock->fClosed) < 0) {
+                return -1;
+            }
+            continue;
+        }
+
+        int count = (space < len) ? space : len;
+        int pos = write & (REQUEST_RING_SIZE - 1);
+        int first = (count < REQUEST_RING_SIZE - pos) ? count : REQUEST_RING_SIZE - pos;
+        memcpy(fOutput->fBuffer + pos, src, first);
+        memcpy(fOutput->fBuffer, src + first, count - first);
+        MovePosition(&fOutput->fWrite, (SInt32)((UInt32)write + count), &fOutput->fReaderWaiting);
+
+        src += count;
+        len -= count;
+    }
+    return 0;
+}
+
+} // end of namespace
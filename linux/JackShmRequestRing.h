@@ -0,0 +1,103 @@
+/*
+Copyright (C) 2026 agent
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 2.1 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*/
+
+#ifndef __JackShmRequestRing__
+#define __JackShmRequestRing__
+
+#include "JackChannel.h"
+#include "JackCompilerDeps.h"
+#include "JackConstants.h"
+#include "JackTypes.h"
+
+namespace Jack
+{
+
+#define REQUEST_RING_SIZE 65536         // Has to be a power of two
+#define REQUEST_RING_TIME_OUT 100000    // in usec, a waiting side checks if the channel is still open at this rate
+
+/*!
+\brief One direction of the request channel : a single producer single consumer ring of bytes.
+
+The positions only grow (modulo 2^32), and are also the futex words the sides wait on : the consumer waits on fWrite when
+the ring is empty, the producer waits on fRead when it is full.
+*/
+
+struct JackRequestRingBuffer
+{
+    volatile SInt32 fWrite;             /*! Bytes written since the creation, only changed by the producer */
+    volatile SInt32 fRead;              /*! Bytes read since the creation, only changed by the consumer */
+    volatile SInt32 fReaderWaiting;     /*! The consumer sleeps in the kernel */
+    volatile SInt32 fWriterWaiting;     /*! The producer sleeps in the kernel */
+    char fBuffer[REQUEST_RING_SIZE];
+};
+
+/*!
+\brief Shared memory segment of a client request channel.
+*/
+
+struct JackRequestRingBlock
+{
+    JackRequestRingBuffer fRequest;     /*! Client to server */
+    JackRequestRingBuffer fResult;      /*! Server to client */
+    volatile SInt32 fClosed;            /*! Set by the side that closes the channel */
+};
+
+/*!
+\brief Request channel in a shared memory segment allocated by the client, connected by the server.
+*/
+
+class SERVER_EXPORT JackShmRequestRing : public detail::JackClientRequestInterface
+{
+
+    private:
+
+        JackRequestRingBlock* fBlock;
+        JackRequestRingBuffer* fInput;
+        JackRequestRingBuffer* fOutput;
+        char fName[SYNC_MAX_NAME_SIZE];
+        volatile bool* fRunning;
+        bool fSpin;
+
+        int Map(int fd, bool client_side);
+        bool IsOpened();
+
+    public:
+
+        JackShmRequestRing();
+        virtual ~JackShmRequestRing();
+
+        static void BuildName(const char* client_name, const char* server_name, char* res, int size);
+
+        // Client side, running (if given) is cleared when the server quits
+        int Allocate(const char* client_name, const char* server_name, volatile bool* running = NULL);
+        void Unlink();
+
+        // Server side
+        int Attach(const char* client_name, const char* server_name);
+
+        int Close();
+        void Shutdown();
+
+        int Read(void* data, int len);
+        int Write(void* data, int len);
+};
+
+} // end of namespace
+
+#endif
@@ -0,0 +1,202 @@
+/*
+Copyright (C) 2026 agent
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 2.1 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*/
+
+#include "JackShmServerChannel.h"
+#include "JackRequest.h"
+#include "JackServer.h"
+#include "JackLockedEngine.h"
+#include "JackError.h"
+
+#include <assert.h>
+
+using namespace std;
+
+namespace Jack
+{
+
+JackShmRequestThread::JackShmRequestThread(JackRequestDecoder* decoder, JackLockAble* decoder_lock)
+    :fThread(this), fDecoder(decoder), fDecoderLock(decoder_lock)
+{}
+
+JackShmRequestThread::~JackShmRequestThread()
+{
+    Close();
+}
+
+int JackShmRequestThread::Open(const char* client_name, const char* server_name)
+{
+    if (fRing.Attach(client_name, server_name) < 0) {
+        return -1;
+    }
+
+    if (fThread.Start() != 0) {
+        jack_error("Cannot start request channel thread for client = %s", client_name);
+        fRing.Close();
+        return -1;
+    }
+
+    return 0;
+}
+
+void JackShmRequestThread::Shutdown()
+{
+    fRing.Shutdown();
+}
+
+void JackShmRequestThread::Close()
+{
+    // The thread quits as soon as the channel has been shutdown
+    fRing.Shutdown();
+    fThread.Stop();
+    fRing.Close();
+}
+
+bool JackShmRequestThread::Execute()
+{
+    JackRequest header;
+    if (header.Read(&fRing) < 0) {
+        jack_log("JackShmRequestThread::Execute : channel closed");
+        return false;
+    }
+
+    switch (header.fType) {
+        // Requests that identify the client by its socket, or that only the server sends
+        case JackRequest::kClientCheck:
+        case JackRequest::kClientOpen:
+        case JackRequest::kClientClose:
+        case JackRequest::kClientRequestRing:
+        case JackRequest::kNotification:
+            jack_error("JackShmRequestThread::Execute : request %ld has to be sent on the client socket", header.fType);
+            return false;
+        default: {
+            JackLock lock(fDecoderLock);
+            fDecoder->HandleRequest(&fRing, header.fType);
+            return true;
+        }
+    }
+}
+
+JackShmServerChannel::JackShmServerChannel()
+    :JackSocketServerChannel(), JackLockAble("JackShmServerChannel")
+{
+    fServerName[0] = 0;
+}
+
+JackShmServerChannel::~JackShmServerChannel()
+{}
+
+int JackShmServerChannel::Open(const char* server_name, JackServer* server)
+{
+    jack_log("JackShmServerChannel::Open");
+    strncpy(fServerName, server_name, sizeof(fServerName));
+    fServerName[sizeof(fServerName) - 1] = 0;
+    return JackSocketServerChannel::Open(server_name, server);
+}
+
+void JackShmServerChannel::Close()
+{
+    // Stop decoding requests before the decoder is deleted
+    std::map<int, JackShmRequestThread*>::iterator it;
+    for (it = fRingTable.begin(); it != fRingTable.end(); it++) {
+        (*it).second->Shutdown();
+        fClosedRings.push_back((*it).second);
+    }
+    fRingTable.clear();
+    RingClose();
+
+    JackSocketServerChannel::Close();
+}
+
+void JackShmServerChannel::RingShutdown(int fd)
+{
+    std::map<int, JackShmRequestThread*>::iterator it = fRingTable.find(fd);
+    if (it != fRingTable.end()) {
+        jack_log("JackShmServerChannel::RingShutdown fd = %d", fd);
+        // The thread may wait for the decoder lock : it is joined later
+        (*it).second->Shutdown();
+        fClosedRings.push_back((*it).second);
+        fRingTable.erase(it);
+    }
+}
+
+void JackShmServerChannel::RingClose()
+{
+    std::list<JackShmRequestThread*>::iterator it;
+    for (it = fClosedRings.begin(); it != fClosedRings.end(); it++) {
+        delete (*it);
+    }
+    fClosedRings.clear();
+}
+
+int JackShmServerChannel::RequestChannelOpen(detail::JackChannelTransactionInterface* socket_aux, const char* name)
+{
+    JackClientSocket* socket = dynamic_cast<JackClientSocket*>(socket_aux);
+    assert(socket);
+    int fd = GetFd(socket);
+    assert(fd >= 0);
+
+    // Only the client opened on this socket can move its requests
+    int refnum = fServer->GetEngine()->GetClientRefNum(name);
+    if (refnum < 0 || fSocketTable[fd].first != refnum || fRingTable.find(fd) != fRingTable.end()) {
+        jack_error("JackShmServerChannel::RequestChannelOpen : client = %s cannot open request channel", name);
+        return -1;
+    }
+
+    JackShmRequestThread* ring = new JackShmRequestThread(fDecoder, this);
+    if (ring->Open(name, fServerName) < 0) {
+        delete ring;
+        return -1;
+    }
+
+    jack_log("JackShmServerChannel::RequestChannelOpen ref = %d fd = %d", refnum, fd);
+    fRingTable[fd] = ring;
+    return 0;
+}
+
+void JackShmServerChannel::ClientRemove(detail::JackChannelTransactionInterface* socket_aux, int refnum)
+{
+    JackClientSocket* socket = dynamic_cast<JackClientSocket*>(socket_aux);
+    assert(socket);
+    RingShutdown(GetFd(socket));
+    JackSocketServerChannel::ClientRemove(socket_aux, refnum);
+}
+
+void JackShmServerChannel::ClientKill(int fd)
+{
+    // The ring thread of a client that died in the middle of a request waits for the rest of it with the decoder lock held :
+    // the ring is shutdown first so that the thread releases the lock (the ring table is only used by this thread)
+    RingShutdown(fd);
+    JackLock lock(this);
+    JackSocketServerChannel::ClientKill(fd);
+}
+
+void JackShmServerChannel::ClientRequest(int fd)
+{
+    JackLock lock(this);
+    JackSocketServerChannel::ClientRequest(fd);
+}
+
+bool JackShmServerChannel::Execute()
+{
+    bool res = JackSocketServerChannel::Execute();
+    RingClose();
+    return res;
+}
+
+} // end of namespace
@@ -0,0 +1,100 @@
+/*
+Copyright (C) 2026 agent
+
+This program is free software; you can redistribute it and/or modify
+it under the terms of the GNU Lesser General Public License as published by
+the Free Software Foundation; either version 2.1 of the License, or
+(at your option) any later version.
+
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU Lesser General Public License for more details.
+
+You should have received a copy of the GNU Lesser General Public License
+along with this program; if not, write to the Free Software
+Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+
+*/
+
+#ifndef __JackShmServerChannel__
+#define __JackShmServerChannel__
+
+#include "JackSocketServerChannel.h"
+#include "JackShmRequestRing.h"
+#include "JackConstants.h"
+#include "JackMutex.h"
+
+#include <list>
+
+namespace Jack
+{
+
+/*!
+\brief Thread decoding the requests a client sends in its shared memory channel.
+*/
+
+class JackShmRequestThread : public JackRunnableInterface
+{
+
+    private:
+
+        JackShmRequestRing fRing;
+        JackThread fThread;
+        JackRequestDecoder* fDecoder;
+        JackLockAble* fDecoderLock;
+
+    public:
+
+        JackShmRequestThread(JackRequestDecoder* decoder, JackLockAble* decoder_lock);
+        virtual ~JackShmRequestThread();
+
+        int Open(const char* client_name, const char* server_name);
+        void Shutdown();
+        void Close();
+
+        // JackRunnableInterface interface
+        bool Execute();
+};
+
+/*!
+\brief JackServerChannel using sockets to open and close clients, and a shared memory channel per client for the other requests.
+
+The requests of all clients are still decoded one at a time : the decoder is locked by the thread using it.
+*/
+
+class JackShmServerChannel : public JackSocketServerChannel, public JackLockAble
+{
+
+    private:
+
+        char fServerName[JACK_SERVER_NAME_SIZE + 1];
+        std::map<int, JackShmRequestThread*> fRingTable;    // Indexed by client socket fd
+        std::list<JackShmRequestThread*> fClosedRings;      // Joined and deleted out of the decoder lock
+
+        void RingShutdown(int fd);
+        void RingClose();
+
+    protected:
+
+        void ClientKill(int fd);
+        void ClientRequest(int fd);
+
+        void ClientRemove(detail::JackChannelTransactionInterface* socket, int refnum);
+        int RequestChannelOpen(detail::JackChannelTransactionInterface* socket, const char* name);
+
+    public:
+
+        JackShmServerChannel();
+        virtual ~JackShmServerChannel();
+
+        int Open(const char* server_name, JackServer* server);
+        void Close();
+
+        // JackRunnableInterface interface
+        bool Execute();
+};
+
+} // end of namespace
+
+#endif
@@ -75,11 +75,14 @@ int JackAlsaDriver::SetBufferSize(jack_nframes_t buffer_size)
                                            ((alsa_driver_t *)fDriver)->frame_rate);
 
     if (res == 0) { // update fEngineControl and fGraphManager
-        JackAudioDriver::SetBufferSize(buffer_size);  // Generic change, never fails
+        res = JackAudioDriver::SetBufferSize(buffer_size);  // Generic change, fails if port buffers cannot be allocated
+    }
+
+    if (res == 0) {
         // ALSA specific
         UpdateLatencies();
     } else {
-        // Restore old values
+        // Restore old values, still in fEngineControl
         alsa_driver_reset_parameters((alsa_driver_t *)fDriver, fEngineControl->fBufferSize,
                                      ((alsa_driver_t *)fDriver)->user_nperiods,
                                      ((alsa_driver_t *)fDriver)->frame_rate);
@@ -113,7 +116,6 @@ void JackAlsaDriver::UpdateLatencies()
 
 int JackAlsaDriver::Attach()
 {
-    JackPort* port;
     jack_port_id_t port_index;
     unsigned long port_flags = (unsigned long)CaptureDriverFlags;
     char name[REAL_JACK_PORT_NAME_SIZE];
@@ -128,7 +130,10 @@ int JackAlsaDriver::Attach()
         port_flags |= JackPortCanMonitor;
 
     // ALSA driver may have changed the values
-    JackAudioDriver::SetBufferSize(alsa_driver->frames_per_cycle);
+    if (JackAudioDriver::SetBufferSize(alsa_driver->frames_per_cycle) < 0) {
+        jack_error("JackAlsaDriver::Attach : cannot set buffer size = %ld", alsa_driver->frames_per_cycle);
+        return -1;
+    }
     JackAudioDriver::SetSampleRate(alsa_driver->frame_rate);
 
     jack_log("JackAlsaDriver::Attach fBufferSize %ld fSampleRate %ld", fEngineControl->fBufferSize, fEngineControl->fSampleRate);
@@ -140,8 +145,7 @@ int JackAlsaDriver::Attach()
             jack_error("driver: cannot register port for %s", name);
             return -1;
         }
-        port = fGraphManager->GetPort(port_index);
-        port->SetAlias(alias);
+        fGraphManager->SetPortAlias(port_index, alias);
         fCapturePortList[i] = port_index;
         jack_log("JackAlsaDriver::Attach fCapturePortList[i] %ld ", port_index);
     }
@@ -155,8 +159,7 @@ int JackAlsaDriver::Attach()
             jack_error("driver: cannot register port for %s", name);
             return -1;
         }
-        port = fGraphManager->GetPort(port_index);
-        port->SetAlias(alias);
+        fGraphManager->SetPortAlias(port_index, alias);
         fPlaybackPortList[i] = port_index;
         jack_log("JackAlsaDriver::Attach fPlaybackPortList[i] %ld ", port_index);
 
@@ -516,7 +519,7 @@ void* JackAlsaDriver::port_get_buffer(int port, jack_nframes_t nframes)
 
 int  JackAlsaDriver::port_set_alias(int port, const char* name)
 {
-    return fGraphManager->GetPort(port)->SetAlias(name);
+    return fGraphManager->SetPortAlias(port, name);
 }
 
 jack_nframes_t JackAlsaDriver::get_sample_rate() const
@@ -78,7 +78,7 @@ JackALSARawMidiDriver::Attach()
         }
         alias = input_port->GetAlias();
         port = fGraphManager->GetPort(index);
-        port->SetAlias(alias);
+        fGraphManager->SetPortAlias(index, alias);
         port->SetLatencyRange(JackCaptureLatency, &latency_range);
         fCapturePortList[i] = index;
 
@@ -104,7 +104,7 @@ JackALSARawMidiDriver::Attach()
         }
         alias = output_port->GetAlias();
         port = fGraphManager->GetPort(index);
-        port->SetAlias(alias);
+        fGraphManager->SetPortAlias(index, alias);
         port->SetLatencyRange(JackPlaybackLatency, &latency_range);
         fPlaybackPortList[i] = index;
 
@@ -348,8 +348,11 @@ JackFFADODriver::SetBufferSize (jack_nframes_t nframes)
     // properly update to the changes.
     sleep(1);
 
-    /* tell the engine to change its buffer size */
-    JackAudioDriver::SetBufferSize(nframes);  // Generic change, never fails
+    /* tell the engine to change its buffer size, the server sets the previous one again on failure */
+    if (JackAudioDriver::SetBufferSize(nframes) < 0) {
+	    printError("could not allocate port buffers for the new period size");
+	    return -1;
+    }
 
     UpdateLatencies();
 
@@ -430,7 +433,6 @@ JackFFADODriver::ffado_driver_delete (ffado_driver_t *driver)
 
 int JackFFADODriver::Attach()
 {
-    JackPort* port;
     jack_port_id_t port_index;
     char buf[REAL_JACK_PORT_NAME_SIZE];
     char portname[REAL_JACK_PORT_NAME_SIZE];
@@ -518,10 +520,9 @@ int JackFFADODriver::Attach()
             }
             ffado_streaming_capture_stream_onoff(driver->dev, chn, 0);
 
-            port = fGraphManager->GetPort(port_index);
             // capture port aliases (jackd1 style port names)
             snprintf(buf, sizeof(buf), "%s:capture_%i", fClientControl.fName, (int) chn + 1);
-            port->SetAlias(buf);
+            fGraphManager->SetPortAlias(port_index, buf);
             fCapturePortList[chn] = port_index;
             jack_log("JackFFADODriver::Attach fCapturePortList[i] %ld ", port_index);
             fCaptureChannels++;
@@ -589,11 +590,10 @@ int JackFFADODriver::Attach()
                 printError(" cannot enable port %s", buf);
             }
 
-            port = fGraphManager->GetPort(port_index);
             // Add one buffer more latency if "async" mode is used...
             // playback port aliases (jackd1 style port names)
             snprintf(buf, sizeof(buf), "%s:playback_%i", fClientControl.fName, (int) chn + 1);
-            port->SetAlias(buf);
+            fGraphManager->SetPortAlias(port_index, buf);
             fPlaybackPortList[chn] = port_index;
             jack_log("JackFFADODriver::Attach fPlaybackPortList[i] %ld ", port_index);
             fPlaybackChannels++;
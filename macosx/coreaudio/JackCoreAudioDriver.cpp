@@ -2249,7 +2249,6 @@ void JackCoreAudioDriver::UpdateLatencies()
 int JackCoreAudioDriver::Attach()
 {
     OSStatus err;
-    JackPort* port;
     jack_port_id_t port_index;
     UInt32 size;
     Boolean isWritable;
@@ -2282,8 +2281,7 @@ int JackCoreAudioDriver::Attach()
             return -1;
         }
 
-        port = fGraphManager->GetPort(port_index);
-        port->SetAlias(alias);
+        fGraphManager->SetPortAlias(port_index, alias);
         fCapturePortList[i] = port_index;
     }
 
@@ -2310,8 +2308,7 @@ int JackCoreAudioDriver::Attach()
             return -1;
         }
 
-        port = fGraphManager->GetPort(port_index);
-        port->SetAlias(alias);
+        fGraphManager->SetPortAlias(port_index, alias);
         fPlaybackPortList[i] = port_index;
 
         // Monitor ports
@@ -2331,8 +2328,7 @@ int JackCoreAudioDriver::Attach()
         // Setup specific AC3 channels names
         for (int i = 0; i < fPlaybackChannels; i++) {
             fAC3Encoder->GetChannelName("coreaudio", "", alias, i);
-            port = fGraphManager->GetPort(fPlaybackPortList[i]);
-            port->SetAlias(alias);
+            fGraphManager->SetPortAlias(fPlaybackPortList[i], alias);
         }
     }
 
@@ -2390,7 +2386,10 @@ int JackCoreAudioDriver::SetBufferSize(jack_nframes_t buffer_size)
         return -1;
     }
 
-    JackAudioDriver::SetBufferSize(buffer_size); // Generic change, never fails
+    // Generic change, fails if port buffers cannot be allocated : the server then sets the previous buffer size again
+    if (JackAudioDriver::SetBufferSize(buffer_size) < 0) {
+        return -1;
+    }
 
     // CoreAudio specific
     UpdateLatencies();
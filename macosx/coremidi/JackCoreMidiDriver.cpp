@@ -369,7 +369,7 @@ JackCoreMidiDriver::Attach()
             return -1;
         }
         port = fGraphManager->GetPort(index);
-        port->SetAlias(port_obj->GetAlias());
+        fGraphManager->SetPortAlias(index, port_obj->GetAlias());
         port->SetLatencyRange(JackCaptureLatency, &latency_range);
         fCapturePortList[i] = index;
     }
@@ -387,7 +387,7 @@ JackCoreMidiDriver::Attach()
             return -1;
         }
         port = fGraphManager->GetPort(index);
-        port->SetAlias(port_obj->GetAlias());
+        fGraphManager->SetPortAlias(index, port_obj->GetAlias());
         port->SetLatencyRange(JackCaptureLatency, &latency_range);
         fCapturePortList[num_physical_inputs + i] = index;
     }
@@ -412,7 +412,7 @@ JackCoreMidiDriver::Attach()
             return -1;
         }
         port = fGraphManager->GetPort(index);
-        port->SetAlias(port_obj->GetAlias());
+        fGraphManager->SetPortAlias(index, port_obj->GetAlias());
         port->SetLatencyRange(JackPlaybackLatency, &latency_range);
         fPlaybackPortList[i] = index;
     }
@@ -431,7 +431,7 @@ JackCoreMidiDriver::Attach()
             return -1;
         }
         port = fGraphManager->GetPort(index);
-        port->SetAlias(port_obj->GetAlias());
+        fGraphManager->SetPortAlias(index, port_obj->GetAlias());
         port->SetLatencyRange(JackPlaybackLatency, &latency_range);
         fPlaybackPortList[num_physical_outputs + i] = index;
     }
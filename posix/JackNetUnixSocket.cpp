@@ -50,6 +50,9 @@ namespace Jack
         fRecvAddr.sin_family = AF_INET;
         fRecvAddr.sin_addr.s_addr = htonl(INADDR_ANY);
         memset(&fRecvAddr.sin_zero, 0, 8);
+    #ifdef NET_BATCH_IO
+        InitBatch();
+    #endif
     }
 
     JackNetUnixSocket::JackNetUnixSocket(const char* ip, int port)
@@ -65,6 +68,9 @@ namespace Jack
         fRecvAddr.sin_port = htons(port);
         fRecvAddr.sin_addr.s_addr = htonl(INADDR_ANY);
         memset(&fRecvAddr.sin_zero, 0, 8);
+    #ifdef NET_BATCH_IO
+        InitBatch();
+    #endif
     }
 
     JackNetUnixSocket::JackNetUnixSocket(const JackNetUnixSocket& socket)
@@ -74,11 +80,17 @@ namespace Jack
         fPort = socket.fPort;
         fSendAddr = socket.fSendAddr;
         fRecvAddr = socket.fRecvAddr;
+    #ifdef NET_BATCH_IO
+        InitBatch();
+    #endif
     }
 
     JackNetUnixSocket::~JackNetUnixSocket()
     {
         Close();
+    #ifdef NET_BATCH_IO
+        SetRecvBatch(0, 0);
+    #endif
     }
 
     JackNetUnixSocket& JackNetUnixSocket::operator=(const JackNetUnixSocket& socket)
@@ -88,6 +100,10 @@ namespace Jack
             fPort = socket.fPort;
             fSendAddr = socket.fSendAddr;
             fRecvAddr = socket.fRecvAddr;
+        #ifdef NET_BATCH_IO
+            // Like a copied socket, starts without batch : the previous one is released, then reset by InitBatch
+            SetRecvBatch(0, 0);
+        #endif
         }
         return *this;
     }
@@ -177,6 +193,11 @@ namespace Jack
             close(fSockfd);
         }
         fSockfd = 0;
+    #ifdef NET_BATCH_IO
+        // Packets of the closed socket not read yet are dropped
+        fRecvBatchCount = 0;
+        fRecvBatchIndex = 0;
+    #endif
     }
 
     void JackNetUnixSocket::Reset()
@@ -427,6 +448,11 @@ namespace Jack
         if (WaitRead() < 0) {
             return -1;
         }
+    #endif
+    #ifdef NET_BATCH_IO
+        if (fRecvBatchSize > 0) {
+            return RecvBatch(buffer, nbytes, flags);
+        }
     #endif
         int res;
         if ((res = recv(fSockfd, buffer, nbytes, flags)) < 0) {
@@ -450,6 +476,89 @@ namespace Jack
         return res;                
     }
 
+#ifdef NET_BATCH_IO
+
+    //batched network operations******************************************************************************************
+    void JackNetUnixSocket::InitBatch()
+    {
+        fRecvBatch = NULL;
+        fRecvBatchIov = NULL;
+        fRecvBatchBuffer = NULL;
+        fRecvBatchSize = 0;
+        fRecvBatchCount = 0;
+        fRecvBatchIndex = 0;
+    }
+
+    int JackNetUnixSocket::SetRecvBatch(int count, size_t packet_size)
+    {
+        delete[] fRecvBatch;
+        delete[] fRecvBatchIov;
+        delete[] fRecvBatchBuffer;
+        InitBatch();
+
+        if (count > 0) {
+            jack_log("JackNetUnixSocket::SetRecvBatch %d packets of %d bytes", count, packet_size);
+            fRecvBatch = new struct mmsghdr[count];
+            fRecvBatchIov = new struct iovec[count];
+            fRecvBatchBuffer = new char[count * packet_size];
+            memset(fRecvBatch, 0, count * sizeof(struct mmsghdr));
+            for (int i = 0; i < count; i++) {
+                fRecvBatchIov[i].iov_base = fRecvBatchBuffer + i * packet_size;
+                fRecvBatchIov[i].iov_len = packet_size;
+                fRecvBatch[i].msg_hdr.msg_iov = &fRecvBatchIov[i];
+                fRecvBatch[i].msg_hdr.msg_iovlen = 1;
+            }
+            fRecvBatchSize = count;
+        }
+        return 0;
+    }
+
+    int JackNetUnixSocket::RecvBatch(void* buffer, size_t nbytes, int flags)
+    {
+        // All received packets have been read : wait for the next one, and take the already queued ones with it
+        if (fRecvBatchIndex == fRecvBatchCount) {
+            fRecvBatchIndex = 0;
+            fRecvBatchCount = 0;
+            int res;
+            if ((res = recvmmsg(fSockfd, fRecvBatch, fRecvBatchSize, MSG_WAITFORONE, NULL)) < 0) {
+                jack_error("RecvBatch fd = %ld err = %s", fSockfd, strerror(errno));
+                return res;
+            }
+            fRecvBatchCount = res;
+        }
+
+        // Like recv, the part of the packet not fitting in the buffer is lost, unless the packet is only peeked
+        struct mmsghdr* packet = &fRecvBatch[fRecvBatchIndex];
+        size_t size = (packet->msg_len < nbytes) ? packet->msg_len : nbytes;
+        memcpy(buffer, packet->msg_hdr.msg_iov[0].iov_base, size);
+        if (!(flags & MSG_PEEK)) {
+            fRecvBatchIndex++;
+        }
+        return size;
+    }
+
+    int JackNetUnixSocket::SendBatch(struct mmsghdr* packets, unsigned int count, int flags)
+    {
+        int tx_bytes = 0;
+        unsigned int sent = 0;
+
+        // sendmmsg may send less packets than asked, send the remaining ones
+        while (sent < count) {
+            int res;
+            if ((res = sendmmsg(fSockfd, packets + sent, count - sent, flags)) < 0) {
+                jack_error("SendBatch fd = %ld err = %s", fSockfd, strerror(errno));
+                return res;
+            }
+            for (int i = 0; i < res; i++) {
+                tx_bytes += packets[sent + i].msg_len;
+            }
+            sent += res;
+        }
+        return tx_bytes;
+    }
+
+#endif
+
     net_error_t JackNetUnixSocket::GetError()
     {
         switch (errno) {
@@ -33,6 +33,11 @@ namespace Jack
 #define SOCKET_ERROR -1
 #define StrError strerror
 
+#ifdef __linux__
+#define NET_BATCH_IO            // sendmmsg/recvmmsg : several packets per system call
+#define NET_BATCH_MAX   64      // maximum packets per system call
+#endif
+
     typedef struct sockaddr socket_address_t;
     typedef struct in_addr address_t;
 
@@ -52,6 +57,19 @@ namespace Jack
             int WaitWrite();
         #endif
 
+        #ifdef NET_BATCH_IO
+            // packets received by the last recvmmsg call, read one by one by Recv
+            struct mmsghdr* fRecvBatch;
+            struct iovec* fRecvBatchIov;
+            char* fRecvBatchBuffer;
+            int fRecvBatchSize;
+            int fRecvBatchCount;
+            int fRecvBatchIndex;
+
+            void InitBatch();
+            int RecvBatch(void* buffer, size_t nbytes, int flags);
+        #endif
+
         public:
 
             JackNetUnixSocket();
@@ -105,6 +123,12 @@ namespace Jack
             int Recv(void* buffer, size_t nbytes, int flags);
             int CatchHost(void* buffer, size_t nbytes, int flags);
 
+        #ifdef NET_BATCH_IO
+            //batched network operations
+            int SetRecvBatch(int count, size_t packet_size);
+            int SendBatch(struct mmsghdr* packets, unsigned int count, int flags);
+        #endif
+
             //error management
             net_error_t GetError();
             void PrintError();
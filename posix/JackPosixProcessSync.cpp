@@ -122,10 +122,10 @@ bool JackPosixProcessSync::TimedWait(long usec)
     time.tv_nsec = (next_date_usec % 1000000) * 1000;
 
     res = pthread_cond_timedwait(&fCond, &fMutex, &time);
+    // The mutex is locked again even when the wait times out
+    fOwner = pthread_self();
     if (res != 0) {
         jack_error("JackPosixProcessSync::TimedWait error usec = %ld err = %s", usec, strerror(res));
-    } else {
-        fOwner = pthread_self();
     }
 
     gettimeofday(&T1, 0);
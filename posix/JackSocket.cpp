@@ -184,7 +184,11 @@ int JackClientSocket::Read(void* data, int len)
     }
 #endif
 
-    if ((res = read(fSocket, data, len)) != len) {
+    // A big request may be received in several parts
+    int count = 0;
+    while ((res = read(fSocket, (char*)data + count, len - count)) > 0 && (count += res) < len) {}
+
+    if (count != len) {
         if (errno == EWOULDBLOCK || errno == EAGAIN) {
             jack_error("JackClientSocket::Read time out");
             return 0;  // For a non blocking socket, a read failure is not considered as an error
@@ -230,7 +234,11 @@ int JackClientSocket::Write(void* data, int len)
    }
 #endif
 
-    if ((res = write(fSocket, data, len)) != len) {
+    // A big request may be sent in several parts
+    int count = 0;
+    while ((res = write(fSocket, (char*)data + count, len - count)) > 0 && (count += res) < len) {}
+
+    if (count != len) {
         if (errno == EWOULDBLOCK || errno == EAGAIN) {
             jack_log("JackClientSocket::Write time out");
             return 0;  // For a non blocking socket, a write failure is not considered as an error
@@ -17,12 +17,14 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 
 */
 
+// Included before the guard : the platform channel may be defined on top of this one
+#include "JackPlatformPlug.h"
+
 #ifndef __JackSocketClientChannel__
 #define __JackSocketClientChannel__
 
 #include "JackGenericClientChannel.h"
 #include "JackSocket.h"
-#include "JackPlatformPlug.h"
 #include "JackThread.h"
 
 namespace Jack
@@ -21,6 +21,9 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 #include "JackSocketNotifyChannel.h"
 #include "JackError.h"
 #include "JackConstants.h"
+#include "JackTime.h"
+
+#include <poll.h>
 
 namespace Jack
 {
@@ -73,6 +76,91 @@ void JackSocketNotifyChannel::ClientNotify(int refnum, const char* name, int not
     }
 }
 
-} // end of namespace
+int JackSocketNotifyChannel::ClientNotifyPost(int refnum, const char* name, int notify, const char* message, int value1, int value2)
+{
+    JackClientNotification event(name, refnum, notify, true, message, value1, value2);
 
+    // Send notification, the result is read later
+    if (event.Write(&fNotifySocket) < 0) {
+        jack_error("Could not write notification");
+        return -1;
+    }
+    return 0;
+}
+
+/*
+    The results of the posted notifications are read as they arrive, all sockets being polled together,
+    so that the reply time of each client is not delayed by the slower ones. A channel appearing several
+    times (a new client receiving a notification for each existing client) has its results read in order.
+*/
 
+int JackSocketNotifyChannel::ClientNotifyResults(JackSocketNotifyChannel** channels, int* results, jack_time_t* reply_times, int count, jack_time_t deadline)
+{
+    struct pollfd pfds[CLIENT_NUM];
+    int indexes[CLIENT_NUM];
+    bool done[CLIENT_NUM];
+    int remaining = count;
+    int res = 0;
+
+    for (int i = 0; i < count; i++) {
+        results[i] = -1;
+        reply_times[i] = 0;
+        done[i] = false;
+    }
+
+    while (remaining > 0) {
+        // Poll the first pending result of each channel
+        int nfds = 0;
+        for (int i = 0; i < count; i++) {
+            if (done[i]) {
+                continue;
+            }
+            bool first = true;
+            for (int j = 0; j < i && first; j++) {
+                first = (done[j] || channels[j] != channels[i]);
+            }
+            if (first) {
+                pfds[nfds].fd = channels[i]->fNotifySocket.GetFd();
+                pfds[nfds].events = POLLIN;
+                pfds[nfds].revents = 0;
+                indexes[nfds++] = i;
+            }
+        }
+
+        jack_time_t cur_time = GetMicroSeconds();
+        if (cur_time >= deadline) {
+            break;
+        }
+
+        int ready = poll(pfds, nfds, int((deadline - cur_time + 999) / 1000));
+        if (ready < 0 && errno == EINTR) {
+            continue;
+        } else if (ready <= 0) {
+            break;
+        }
+
+        for (int k = 0; k < nfds; k++) {
+            if (pfds[k].revents != 0) {
+                int i = indexes[k];
+                JackResult result;
+                // Read with the socket time out
+                if (result.Read(&channels[i]->fNotifySocket) < 0) {
+                    jack_error("Could not read notification result");
+                } else {
+                    results[i] = result.fResult;
+                }
+                reply_times[i] = GetMicroSeconds();
+                done[i] = true;
+                remaining--;
+            }
+        }
+    }
+
+    if (remaining > 0) {
+        jack_error("Notification results not received in time");
+        res = -1;
+    }
+    return res;
+}
+
+} // end of namespace
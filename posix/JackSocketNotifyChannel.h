@@ -46,6 +46,10 @@ class JackSocketNotifyChannel
         void Close();					// Close the Server/Client connection
 
         void ClientNotify(int refnum, const char* name, int notify, int sync, const char* message, int value1, int value2, int* result);
+
+        // Synchronous notification in two steps, so that several clients can be notified at once
+        int ClientNotifyPost(int refnum, const char* name, int notify, const char* message, int value1, int value2);
+        static int ClientNotifyResults(JackSocketNotifyChannel** channels, int* results, jack_time_t* reply_times, int count, jack_time_t deadline);
 };
 
 } // end of namespace
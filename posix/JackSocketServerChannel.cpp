@@ -183,6 +183,21 @@ void JackSocketServerChannel::ClientKill(int fd)
     fRebuild = true;
 }
 
+void JackSocketServerChannel::ClientRequest(int fd)
+{
+    JackClientSocket* socket = fSocketTable[fd].second;
+    // Decode header
+    JackRequest header;
+    if (header.Read(socket) < 0) {
+        jack_log("JackSocketServerChannel::ClientRequest : cannot decode header");
+        ClientKill(fd);
+    // Decode request
+    } else {
+        // Result is not needed here
+        fDecoder->HandleRequest(socket, header.fType);
+    }
+}
+
 void JackSocketServerChannel::BuildPoolTable()
 {
     if (fRebuild) {
@@ -235,17 +250,7 @@ bool JackSocketServerChannel::Execute()
                     jack_log("JackSocketServerChannel::Execute : poll client error err = %s", strerror(errno));
                     ClientKill(fd);
                 } else if (fPollTable[i].revents & POLLIN) {
-                    JackClientSocket* socket = fSocketTable[fd].second;
-                    // Decode header
-                    JackRequest header;
-                    if (header.Read(socket) < 0) {
-                        jack_log("JackSocketServerChannel::Execute : cannot decode header");
-                        ClientKill(fd);
-                    // Decode request
-                    } else {
-                        // Result is not needed here
-                        fDecoder->HandleRequest(socket, header.fType);
-                    }
+                    ClientRequest(fd);
                 }
             }
 
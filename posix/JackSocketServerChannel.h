@@ -17,11 +17,13 @@ Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 
 */
 
+// Included before the guard : the platform channel may be defined on top of this one
+#include "JackPlatformPlug.h"
+
 #ifndef __JackSocketServerChannel__
 #define __JackSocketServerChannel__
 
 #include "JackSocket.h"
-#include "JackPlatformPlug.h"
 #include "JackRequestDecoder.h"
 
 #include <poll.h>
@@ -43,18 +45,23 @@ class JackSocketServerChannel : public JackRunnableInterface, public JackClientH
 
         JackServerSocket fRequestListenSocket;  // Socket to create request socket for the client
         JackThread fThread;                     // Thread to execute the event loop
-        JackRequestDecoder* fDecoder;
-        JackServer* fServer;
 
         pollfd* fPollTable;
         bool fRebuild;
-        std::map<int, std::pair<int, JackClientSocket*> > fSocketTable;
 
         void BuildPoolTable();
 
         void ClientCreate();
-        void ClientKill(int fd);
-  
+
+    protected:
+
+        JackRequestDecoder* fDecoder;
+        JackServer* fServer;
+        std::map<int, std::pair<int, JackClientSocket*> > fSocketTable;
+
+        virtual void ClientKill(int fd);
+        virtual void ClientRequest(int fd);
+
         void ClientAdd(detail::JackChannelTransactionInterface* socket, JackClientOpenRequest* req, JackClientOpenResult *res);
         void ClientRemove(detail::JackChannelTransactionInterface* socket, int refnum);
 
@@ -63,10 +70,10 @@ class JackSocketServerChannel : public JackRunnableInterface, public JackClientH
     public:
 
         JackSocketServerChannel();
-        ~JackSocketServerChannel();
+        virtual ~JackSocketServerChannel();
 
-        int Open(const char* server_name, JackServer* server);  // Open the Server/Client connection
-        void Close();                                           // Close the Server/Client connection
+        virtual int Open(const char* server_name, JackServer* server);  // Open the Server/Client connection
+        virtual void Close();                                           // Close the Server/Client connection
 
         int Start();
         void Stop();
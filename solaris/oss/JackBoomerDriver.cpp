@@ -804,8 +804,9 @@ void JackBoomerDriver::SynchronizeWrite()
 int JackBoomerDriver::SetBufferSize(jack_nframes_t buffer_size)
 {
     CloseAux();
-    JackAudioDriver::SetBufferSize(buffer_size); // Generic change, never fails
-    return OpenAux();
+    // Generic change, fails if port buffers cannot be allocated : the device is opened again with the previous buffer size
+    int res = JackAudioDriver::SetBufferSize(buffer_size);
+    return (OpenAux() == 0) ? res : -1;
 }
 
 } // end of namespace
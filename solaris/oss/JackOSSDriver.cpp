@@ -296,7 +296,9 @@ int JackOSSDriver::OpenInput()
        if (fIgnoreHW) {
            int new_buffer_size = fInputBufferSize / (fSampleSize * fCaptureChannels);
            jack_info("JackOSSDriver::OpenInput driver forced buffer size %ld", new_buffer_size);
-           JackAudioDriver::SetBufferSize(new_buffer_size); // never fails
+           if (JackAudioDriver::SetBufferSize(new_buffer_size) < 0) {
+               goto error;
+           }
        } else {
            jack_error("JackOSSDriver::OpenInput wanted buffer size cannot be obtained");
            goto error;
@@ -379,7 +381,9 @@ int JackOSSDriver::OpenOutput()
        if (fIgnoreHW) {
            int new_buffer_size = fOutputBufferSize / (fSampleSize * fPlaybackChannels);
            jack_info("JackOSSDriver::OpenOutput driver forced buffer size %ld", new_buffer_size);
-           JackAudioDriver::SetBufferSize(new_buffer_size); // never fails
+           if (JackAudioDriver::SetBufferSize(new_buffer_size) < 0) {
+               goto error;
+           }
        } else {
            jack_error("JackOSSDriver::OpenInput wanted buffer size cannot be obtained");
            goto error;
@@ -698,8 +702,9 @@ int JackOSSDriver::Write()
 int JackOSSDriver::SetBufferSize(jack_nframes_t buffer_size)
 {
     CloseAux();
-    JackAudioDriver::SetBufferSize(buffer_size); // Generic change, never fails
-    return OpenAux();
+    // Generic change, fails if port buffers cannot be allocated : the device is opened again with the previous buffer size
+    int res = JackAudioDriver::SetBufferSize(buffer_size);
+    return (OpenAux() == 0) ? res : -1;
 }
 
 int JackOSSDriver::ProcessSync()
@@ -0,0 +1,139 @@
+/*
+	Copyright (C) 2026 agent
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/*
+    Cost of the audio input mixdown with 2 to 64 connected sources : each mixdown implementation supported by the CPU
+    is compared with the source by source mix, and its result is checked against it.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#if defined (__SSE__) && !defined (__sun__)
+#include <xmmintrin.h>
+#endif
+
+#include "JackPortType.h"
+#include "types.h"
+
+using namespace Jack;
+
+#define LOOPS 20000
+#define MAX_SOURCES 64
+
+static double GetTime()
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return double(tv.tv_sec) * 1e6 + double(tv.tv_usec);
+}
+
+// Copy the first source, then add the next ones one by one (the previous audio port implementation)
+static void SourceBySourceMixdown(void* mixbuffer, void** src_buffers, int src_count, jack_nframes_t nframes)
+{
+    memcpy(mixbuffer, src_buffers[0], nframes * sizeof(jack_default_audio_sample_t));
+
+    for (int i = 1; i < src_count; i++) {
+        jack_default_audio_sample_t* target = static_cast<jack_default_audio_sample_t*>(mixbuffer);
+        jack_default_audio_sample_t* source = static_cast<jack_default_audio_sample_t*>(src_buffers[i]);
+        jack_nframes_t j = 0;
+    #if defined (__SSE__) && !defined (__sun__)
+        for (; j + 4 <= nframes; j += 4) {
+            _mm_store_ps(target + j, _mm_add_ps(_mm_load_ps(target + j), _mm_load_ps(source + j)));
+        }
+    #endif
+        for (; j < nframes; j++) {
+            target[j] += source[j];
+        }
+    }
+}
+
+static double Measure(JackPortMixdownFunction mixdown, void* mixbuffer, void** src_buffers, int src_count, jack_nframes_t nframes)
+{
+    double start = GetTime();
+    for (int i = 0; i < LOOPS; i++) {
+        mixdown(mixbuffer, src_buffers, src_count, nframes);
+    }
+    return (GetTime() - start) / LOOPS;
+}
+
+int main(int argc, char* argv[])
+{
+    static const int source_counts[] = { 2, 4, 8, 16, 40, 64 };
+    static const jack_nframes_t buffer_sizes[] = { 67, 256, 1024 };    // 67 checks the frames not filling a vector
+
+    int mixdown_count;
+    const JackAudioMixdown* mixdowns = GetAudioMixdowns(&mixdown_count);
+    void* sources[MAX_SOURCES];
+    void* reference;
+    void* result;
+    int res = 0;
+
+    for (int i = 0; i < MAX_SOURCES; i++) {
+        if (posix_memalign(&sources[i], 64, 1024 * sizeof(jack_default_audio_sample_t)) != 0) {
+            return 1;
+        }
+        jack_default_audio_sample_t* source = static_cast<jack_default_audio_sample_t*>(sources[i]);
+        for (int j = 0; j < 1024; j++) {
+            source[j] = float(rand()) / float(RAND_MAX) - 0.5f;
+        }
+    }
+    if (posix_memalign(&reference, 64, 1024 * sizeof(jack_default_audio_sample_t)) != 0
+        || posix_memalign(&result, 64, 1024 * sizeof(jack_default_audio_sample_t)) != 0) {
+        return 1;
+    }
+
+    printf("Audio mixdown, usec per mixdown (the last implementation is used by the audio ports)\n");
+    printf("%8s %8s %14s", "frames", "sources", "source/source");
+    for (int k = 0; k < mixdown_count; k++) {
+        printf(" %10s", mixdowns[k].fName);
+    }
+    printf("\n");
+
+    for (size_t b = 0; b < sizeof(buffer_sizes) / sizeof(buffer_sizes[0]); b++) {
+        for (size_t s = 0; s < sizeof(source_counts) / sizeof(source_counts[0]); s++) {
+            jack_nframes_t nframes = buffer_sizes[b];
+            int src_count = source_counts[s];
+
+            SourceBySourceMixdown(reference, sources, src_count, nframes);
+            printf("%8d %8d %14.3f", nframes, src_count, Measure(SourceBySourceMixdown, reference, sources, src_count, nframes));
+
+            for (int k = 0; k < mixdown_count; k++) {
+                memset(result, 0, 1024 * sizeof(jack_default_audio_sample_t));
+                mixdowns[k].fMixdown(result, sources, src_count, nframes);
+                // Sources are added in the same order : the result has to be exactly the same
+                if (memcmp(result, reference, nframes * sizeof(jack_default_audio_sample_t)) != 0) {
+                    printf("\n%s mixdown of %d sources differs from the source by source mix\n", mixdowns[k].fName, src_count);
+                    res = 1;
+                }
+                printf(" %10.3f", Measure(mixdowns[k].fMixdown, result, sources, src_count, nframes));
+            }
+            printf("\n");
+        }
+    }
+
+    for (int i = 0; i < MAX_SOURCES; i++) {
+        free(sources[i]);
+    }
+    free(reference);
+    free(result);
+    return res;
+}
@@ -0,0 +1,172 @@
+/*
+	Copyright (C) 2026 agent
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/*
+    Per client load : the server updates the load of each client with its timing at the end of a cycle. Averages are
+    checked after a rolling window, max values, late cycles and percentiles after a known distribution of DSP times,
+    then after a reset. The DSP time histogram buckets have to hold their values within 25 percent. The cost of an
+    update, done for each client at each cycle, is measured.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+
+#include "JackClientLoad.h"
+#include "JackConnectionManager.h"
+#include "JackEngineControl.h"
+
+using namespace Jack;
+
+#define PERIOD_USECS 1000
+#define BENCH_UPDATES 10000000
+
+static double GetTime()
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return double(tv.tv_sec) * 1e6 + double(tv.tv_usec);
+}
+
+static int gErrors = 0;
+
+static void Check(bool cond, const char* what, long long value, long long expected)
+{
+    if (!cond) {
+        printf("%s : %lld, expected %lld\n", what, value, expected);
+        gErrors++;
+    }
+}
+
+// Runs a cycle of the client : signaled at 10 usecs, woken up 'wakeup' usecs later, running for 'dsp' usecs
+static void RunCycle(JackClientLoad* load, jack_time_t* begin, jack_time_t wakeup, jack_time_t dsp, jack_client_state_t status, UInt32 reset)
+{
+    JackClientTiming timing;
+    timing.fSignaledAt = *begin + 10;
+    timing.fAwakeAt = (status == Triggered) ? 0 : timing.fSignaledAt + wakeup;
+    timing.fFinishedAt = (status == Finished) ? timing.fAwakeAt + dsp : 0;
+    timing.fStatus = status;
+    load->Update(&timing, *begin, *begin + PERIOD_USECS, PERIOD_USECS, reset);
+    *begin += PERIOD_USECS;
+}
+
+static void TestBuckets()
+{
+    int last = 0;
+    for (jack_time_t usecs = 0; usecs < 200000; usecs++) {
+        int bucket = JackClientLoad::GetBucket(usecs);
+        jack_time_t max = JackClientLoad::GetBucketMax(bucket);
+        if (bucket < last) {
+            Check(false, "Bucket order", bucket, last);
+        }
+        last = bucket;
+        if (bucket == CLIENT_LOAD_BUCKETS - 1) {
+            continue;
+        }
+        Check(max >= usecs, "Bucket max below value", max, usecs);
+        Check(max * 4 <= usecs * 5 + 4, "Bucket max above 125% of value", max, usecs);
+        Check(JackClientLoad::GetBucket(max) == bucket, "Bucket of bucket max", JackClientLoad::GetBucket(max), bucket);
+    }
+    Check(JackClientLoad::GetBucket(jack_time_t(1) << 40) == CLIENT_LOAD_BUCKETS - 1, "Bucket of huge value",
+          JackClientLoad::GetBucket(jack_time_t(1) << 40), CLIENT_LOAD_BUCKETS - 1);
+}
+
+static void TestLoad()
+{
+    JackClientLoad load;
+    jack_time_t begin = 1000000;
+    UInt32 reset = 0;
+    load.Init("client");
+
+    // Not triggered clients are not counted
+    RunCycle(&load, &begin, 5, 100, NotTriggered, reset);
+    Check(load.fMaxDSPUsecs == 0, "Not triggered max DSP", load.fMaxDSPUsecs, 0);
+
+    // A full rolling window : DSP 100 to 131 usecs, wake-up 5 usecs
+    for (int i = 0; i < JACK_ENGINE_ROLLING_COUNT; i++) {
+        RunCycle(&load, &begin, 5, 100 + i, Finished, reset);
+    }
+    Check(load.fAverageDSPUsecs == 115, "Average DSP", load.fAverageDSPUsecs, 115);
+    Check(load.fAverageWakeUpUsecs == 5, "Average wake-up", load.fAverageWakeUpUsecs, 5);
+    Check(load.fMaxDSPUsecs == 131, "Max DSP", load.fMaxDSPUsecs, 131);
+    Check(load.fDSPUsecs == 131, "Last DSP", load.fDSPUsecs, 131);
+    Check(int(load.fCPULoad * 10.f + 0.5f) == 115, "CPU load x 10", int(load.fCPULoad * 10.f + 0.5f), 115);
+    Check(load.fLateCycles == 0, "Late cycles", load.fLateCycles, 0);
+
+    // Finished after the period, still running and not woken up at the next cycle begin are late
+    RunCycle(&load, &begin, 5, PERIOD_USECS, Finished, reset);
+    RunCycle(&load, &begin, 300, 0, Running, reset);
+    Check(load.fDSPUsecs == PERIOD_USECS - 310, "Running DSP", load.fDSPUsecs, PERIOD_USECS - 310);
+    RunCycle(&load, &begin, 0, 0, Triggered, reset);
+    Check(load.fWakeUpUsecs == PERIOD_USECS - 10, "Triggered wake-up", load.fWakeUpUsecs, PERIOD_USECS - 10);
+    Check(load.fLateCycles == 3, "Late cycles", load.fLateCycles, 3);
+    Check(load.fMaxDSPUsecs == PERIOD_USECS, "Max DSP", load.fMaxDSPUsecs, PERIOD_USECS);
+    Check(load.fMaxWakeUpUsecs == PERIOD_USECS - 10, "Max wake-up", load.fMaxWakeUpUsecs, PERIOD_USECS - 10);
+
+    // Reset, then 99 cycles of 50 usecs and one of 800 usecs
+    reset++;
+    for (int i = 0; i < 100; i++) {
+        RunCycle(&load, &begin, 5, (i == 42) ? 800 : 50, Finished, reset);
+    }
+    Check(load.fLateCycles == 0, "Late cycles after reset", load.fLateCycles, 0);
+    Check(load.fMaxDSPUsecs == 800, "Max DSP after reset", load.fMaxDSPUsecs, 800);
+    Check(load.fMaxWakeUpUsecs == 5, "Max wake-up after reset", load.fMaxWakeUpUsecs, 5);
+
+    jack_time_t p50 = load.GetDSPPercentile(50.f);
+    jack_time_t p99 = load.GetDSPPercentile(99.f);
+    jack_time_t p100 = load.GetDSPPercentile(100.f);
+    Check(p50 >= 50 && p50 * 4 <= 50 * 5, "50th percentile", p50, 50);
+    Check(p99 >= 50 && p99 * 4 <= 50 * 5, "99th percentile", p99, 50);
+    Check(p100 >= 800 && p100 * 4 <= 800 * 5, "100th percentile", p100, 800);
+
+    // A new client in the same slot starts from scratch
+    load.Init("other");
+    Check(load.GetDSPPercentile(99.f) == 0, "Percentile of new client", load.GetDSPPercentile(99.f), 0);
+    Check(load.fMaxDSPUsecs == 0, "Max DSP of new client", load.fMaxDSPUsecs, 0);
+}
+
+static void BenchUpdate()
+{
+    JackClientLoad load;
+    JackClientTiming timing;
+    jack_time_t begin = 1000000;
+    load.Init("client");
+
+    double start = GetTime();
+    for (int i = 0; i < BENCH_UPDATES; i++) {
+        timing.fSignaledAt = begin + 10;
+        timing.fAwakeAt = begin + 20;
+        timing.fFinishedAt = begin + 20 + (i & 255);
+        timing.fStatus = Finished;
+        load.Update(&timing, begin, begin + PERIOD_USECS, PERIOD_USECS, 0);
+        begin += PERIOD_USECS;
+    }
+    double duration = GetTime() - start;
+    printf("Client load update %6.1f ns (max DSP %lu usecs)\n", duration * 1000. / BENCH_UPDATES, (unsigned long)load.fMaxDSPUsecs);
+}
+
+int main(int argc, char* argv[])
+{
+    TestBuckets();
+    TestLoad();
+    BenchUpdate();
+
+    printf("%s\n", (gErrors == 0) ? "Client load test OK" : "Client load test FAILED");
+    return (gErrors == 0) ? 0 : 1;
+}
@@ -0,0 +1,140 @@
+/*
+	Copyright (C) 2026 agent
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/*
+    Cost of making a lot of connections (as when a session is restored) on a running server : one jack_connect
+    request per connection is compared with the jack_connect_list request, and the resulting graph is checked.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include <jack/jack.h>
+
+#define MAX_CONNECTIONS 500
+
+static double GetTime()
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return double(tv.tv_sec) * 1e6 + double(tv.tv_usec);
+}
+
+static jack_port_t* gOutputs[MAX_CONNECTIONS];
+static jack_port_t* gInputs[MAX_CONNECTIONS];
+static const char* gSources[MAX_CONNECTIONS];
+static const char* gDestinations[MAX_CONNECTIONS];
+
+static int CheckConnections(jack_client_t* client, int count, bool connected)
+{
+    for (int i = 0; i < count; i++) {
+        if ((jack_port_connected_to(gOutputs[i], gDestinations[i]) != 0) != connected) {
+            printf("Port %s is %sconnected to %s\n", gSources[i], connected ? "not " : "", gDestinations[i]);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void Disconnect(jack_client_t* client, int count)
+{
+    for (int i = 0; i < count; i++) {
+        jack_disconnect(client, gSources[i], gDestinations[i]);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    static const int connection_counts[] = { 10, 100, MAX_CONNECTIONS };
+    int results[MAX_CONNECTIONS];
+    int res = 0;
+
+    jack_client_t* client = jack_client_open("test_connect_list", JackNoStartServer, NULL);
+    if (!client) {
+        printf("Cannot open client, is the server running ?\n");
+        return 1;
+    }
+
+    for (int i = 0; i < MAX_CONNECTIONS; i++) {
+        char name[32];
+        snprintf(name, sizeof(name), "out%d", i);
+        gOutputs[i] = jack_port_register(client, name, JACK_DEFAULT_AUDIO_TYPE, JackPortIsOutput, 0);
+        snprintf(name, sizeof(name), "in%d", i);
+        gInputs[i] = jack_port_register(client, name, JACK_DEFAULT_AUDIO_TYPE, JackPortIsInput, 0);
+        if (!gOutputs[i] || !gInputs[i]) {
+            printf("Cannot register ports\n");
+            jack_client_close(client);
+            return 1;
+        }
+        gSources[i] = jack_port_name(gOutputs[i]);
+        gDestinations[i] = jack_port_name(gInputs[i]);
+    }
+
+    if (jack_activate(client) != 0) {
+        printf("Cannot activate client\n");
+        jack_client_close(client);
+        return 1;
+    }
+
+    printf("usec to make the connections\n");
+    printf("%12s %12s %12s %8s\n", "connections", "one by one", "list", "speedup");
+
+    for (size_t c = 0; c < sizeof(connection_counts) / sizeof(connection_counts[0]); c++) {
+        int count = connection_counts[c];
+
+        double start = GetTime();
+        for (int i = 0; i < count; i++) {
+            res |= (jack_connect(client, gSources[i], gDestinations[i]) != 0);
+        }
+        double one_by_one = GetTime() - start;
+        res |= CheckConnections(client, count, true);
+        Disconnect(client, count);
+
+        start = GetTime();
+        if (jack_connect_list(client, gSources, gDestinations, count, results) != 0) {
+            printf("jack_connect_list of %d connections failed\n", count);
+            res = 1;
+        }
+        double list = GetTime() - start;
+        res |= CheckConnections(client, count, true);
+
+        // Existing connections are reported for each of them
+        if (jack_connect_list(client, gSources, gDestinations, count, results) == 0) {
+            printf("jack_connect_list of %d existing connections succeeded\n", count);
+            res = 1;
+        }
+        for (int i = 0; i < count; i++) {
+            if (results[i] == 0) {
+                printf("Existing connection %d has been made again\n", i);
+                res = 1;
+                break;
+            }
+        }
+        Disconnect(client, count);
+        res |= CheckConnections(client, count, false);
+
+        printf("%12d %12.0f %12.0f %8.2f\n", count, one_by_one, list, one_by_one / list);
+    }
+
+    jack_deactivate(client);
+    jack_client_close(client);
+    return res;
+}
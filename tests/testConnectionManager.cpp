@@ -0,0 +1,190 @@
+/*
+	Copyright (C) 2026 agent
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/*
+    Connect/disconnect throughput of the double buffered connection state, comparing :
+    - dirty regions copy (only the regions changed by the last write are copied when switching states)
+    - complete state copy (used part of the connection pool only)
+    - plain memcpy of the whole JackConnectionManager
+*/
+
+#include <iostream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include "JackConnectionManager.h"
+#include "JackAtomicState.h"
+
+using namespace Jack;
+
+#define CLIENTS 16
+#define PORTS_PER_CLIENT 16
+#define LOOPS 20000
+
+enum CopyMode { kDirtyCopy, kStateCopy, kMemCopy };
+
+class TestGraph : public JackAtomicState<JackConnectionManager>
+{
+
+    public:
+
+        void Setup()
+        {
+            JackConnectionManager* manager = WriteNextStateStart();
+            for (int ref = 0; ref < CLIENTS; ref++) {
+                for (int port = 0; port < PORTS_PER_CLIENT; port++) {
+                    manager->AddInputPort(ref, Port(ref, port, true));
+                    manager->AddOutputPort(ref, Port(ref, port, false));
+                }
+            }
+            WriteNextStateStop();
+            TrySwitchState();
+        }
+
+        static jack_port_id_t Port(int ref, int port, bool input)
+        {
+            return FIRST_AVAILABLE_PORT + (ref * PORTS_PER_CLIENT + port) * 2 + (input ? 0 : 1);
+        }
+
+        void Modify(JackConnectionManager* manager, int i, bool connect)
+        {
+            int ref1 = i % CLIENTS;
+            int ref2 = (i / CLIENTS + ref1 + 1) % CLIENTS;
+            jack_port_id_t src = Port(ref1, (i / 7) % PORTS_PER_CLIENT, false);
+            jack_port_id_t dst = Port(ref2, (i / 3) % PORTS_PER_CLIENT, true);
+
+            if (connect) {
+                if (!manager->IsConnected(src, dst)) {
+                    manager->Connect(src, dst);
+                    manager->Connect(dst, src);
+                    manager->DirectConnect(ref1, ref2);
+                }
+            } else {
+                if (manager->IsConnected(src, dst)) {
+                    manager->Disconnect(src, dst);
+                    manager->Disconnect(dst, src);
+                    manager->DirectDisconnect(ref1, ref2);
+                }
+            }
+        }
+
+        // After a write operation, both states must describe the same graph
+        bool Check()
+        {
+            JackConnectionManager* next = WriteNextStateStart();
+            JackConnectionManager* cur = ReadCurrentState();
+            jack_int_t connections1[CONNECTION_NUM_FOR_PORT];
+            jack_int_t connections2[CONNECTION_NUM_FOR_PORT];
+            bool res = true;
+
+            for (jack_port_id_t port = 0; port < PORT_NUM_MAX; port++) {
+                int count1 = cur->GetConnections(port, connections1);
+                int count2 = next->GetConnections(port, connections2);
+                if (count1 != count2 || memcmp(connections1, connections2, count1 * sizeof(jack_int_t)) != 0) {
+                    res = false;
+                }
+            }
+            for (int ref1 = 0; ref1 < CLIENT_NUM; ref1++) {
+                for (int ref2 = 0; ref2 < CLIENT_NUM; ref2++) {
+                    if (cur->IsDirectConnection(ref1, ref2) != next->IsDirectConnection(ref1, ref2)) {
+                        res = false;
+                    }
+                }
+            }
+
+            WriteNextStateStop();
+            return res;
+        }
+
+        // One write operation followed by a RT thread switch
+        void Cycle(CopyMode mode, int i, bool connect)
+        {
+            if (mode == kMemCopy) {
+                JackConnectionManager* cur = ReadCurrentState();
+                JackConnectionManager* next = &fState[NextArrayIndex(fCounter)];
+                // Whole state copy as done before JackCopyState, the class is plain data so it is copied as raw memory
+                memcpy((void*)next, (const void*)cur, sizeof(JackConnectionManager));
+                WriteNextStateStart(); // No copy since the state is already valid
+                Modify(next, i, connect);
+                WriteNextStateStop();
+            } else {
+                JackConnectionManager* manager = WriteNextStateStart();
+                Modify(manager, i, connect);
+                if (mode == kStateCopy) {
+                    manager->Invalidate();
+                }
+                WriteNextStateStop();
+            }
+            TrySwitchState();
+        }
+
+};
+
+static double GetTime()
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return double(tv.tv_sec) * 1e6 + double(tv.tv_usec);
+}
+
+static double Run(TestGraph* graph, CopyMode mode, bool* check)
+{
+    double start = GetTime();
+    for (int i = 0; i < LOOPS; i++) {
+        graph->Cycle(mode, i, true);
+    }
+    double duration = GetTime() - start;
+    *check = graph->Check();
+    graph->TrySwitchState();
+
+    start = GetTime();
+    for (int i = 0; i < LOOPS; i++) {
+        graph->Cycle(mode, i, false);
+    }
+    duration += GetTime() - start;
+    *check &= graph->Check();
+    return duration;
+}
+
+int main(int argc, char* argv[])
+{
+    const char* names[] = { "dirty regions copy", "complete state copy", "memcpy of the state" };
+    int res = 0;
+
+    printf("JackConnectionManager size = %ld bytes, %d clients, %d ports per client, %d connect + %d disconnect\n",
+            (long)sizeof(JackConnectionManager), CLIENTS, PORTS_PER_CLIENT, LOOPS, LOOPS);
+
+    for (int mode = kDirtyCopy; mode <= kMemCopy; mode++) {
+        // The graph is too big for the stack
+        TestGraph* graph = new TestGraph();
+        graph->Setup();
+        bool check;
+        double duration = Run(graph, CopyMode(mode), &check);
+        printf("%-22s : %10.2f usec total, %8.3f usec per operation, %10.0f operations/sec, states %s\n",
+                names[mode], duration, duration / (2 * LOOPS), (2 * LOOPS) / (duration / 1e6), check ? "identical" : "DIFFERENT");
+        if (!check) {
+            res = 1;
+        }
+        delete graph;
+    }
+
+    return res;
+}
@@ -0,0 +1,222 @@
+/*
+	Copyright (C) 2026 agent
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/*
+    Driver descriptor cache : the drivers and internal clients of the driver directory (JACK_DRIVER_DIR) are scanned
+    without cache, then with a cache file created by a first scan. All descriptors (parameters, default values,
+    constraints) have to be the same in the three cases, and the cache file must not be rewritten when nothing changed.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+
+#include <string>
+
+#include "jack/control.h"
+
+#define SCAN_COUNT 10
+
+static double GetTime()
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return double(tv.tv_sec) * 1e6 + double(tv.tv_usec);
+}
+
+static void DescribeValue(std::string& res, jackctl_param_type_t type, union jackctl_parameter_value value)
+{
+    char buffer[JACK_PARAM_STRING_MAX + 64];
+    switch (type) {
+        case JackParamInt:
+            snprintf(buffer, sizeof(buffer), "%d", value.i);
+            break;
+        case JackParamUInt:
+            snprintf(buffer, sizeof(buffer), "%u", value.ui);
+            break;
+        case JackParamChar:
+            snprintf(buffer, sizeof(buffer), "%c", value.c);
+            break;
+        case JackParamString:
+            snprintf(buffer, sizeof(buffer), "%s", value.str);
+            break;
+        case JackParamBool:
+            snprintf(buffer, sizeof(buffer), "%s", value.b ? "true" : "false");
+            break;
+        default:
+            snprintf(buffer, sizeof(buffer), "?");
+            break;
+    }
+    res += buffer;
+}
+
+static void DescribeParameters(std::string& res, const JSList* parameters)
+{
+    for (const JSList* node = parameters; node; node = jack_slist_next(node)) {
+        jackctl_parameter_t* parameter = (jackctl_parameter_t*)node->data;
+        jackctl_param_type_t type = jackctl_parameter_get_type(parameter);
+        char buffer[64];
+
+        snprintf(buffer, sizeof(buffer), "  -%c %d ", jackctl_parameter_get_id(parameter), type);
+        res += buffer;
+        res += jackctl_parameter_get_name(parameter);
+        res += " : ";
+        res += jackctl_parameter_get_short_description(parameter);
+        res += " / ";
+        res += jackctl_parameter_get_long_description(parameter);
+        res += " = ";
+        DescribeValue(res, type, jackctl_parameter_get_default_value(parameter));
+
+        if (jackctl_parameter_has_range_constraint(parameter)) {
+            union jackctl_parameter_value min, max;
+            jackctl_parameter_get_range_constraint(parameter, &min, &max);
+            res += " range ";
+            DescribeValue(res, type, min);
+            res += " ";
+            DescribeValue(res, type, max);
+        }
+
+        if (jackctl_parameter_has_enum_constraint(parameter)) {
+            uint32_t count = jackctl_parameter_get_enum_constraints_count(parameter);
+            res += " enum";
+            for (uint32_t i = 0; i < count; i++) {
+                res += " ";
+                DescribeValue(res, type, jackctl_parameter_get_enum_constraint_value(parameter, i));
+                res += " (";
+                res += jackctl_parameter_get_enum_constraint_description(parameter, i);
+                res += ")";
+            }
+            if (jackctl_parameter_constraint_is_strict(parameter)) {
+                res += " strict";
+            }
+            if (jackctl_parameter_constraint_is_fake_value(parameter)) {
+                res += " fake";
+            }
+        }
+        res += "\n";
+    }
+}
+
+// Scans the driver directory, returns the description of all drivers and internals
+static bool Scan(std::string& res, double* duration, int* drivers, int* internals)
+{
+    double begin = GetTime();
+    jackctl_server_t* server = jackctl_server_create(NULL, NULL);
+    *duration = GetTime() - begin;
+    if (!server) {
+        return false;
+    }
+
+    res.clear();
+    *drivers = *internals = 0;
+
+    for (const JSList* node = jackctl_server_get_drivers_list(server); node; node = jack_slist_next(node)) {
+        jackctl_driver_t* driver = (jackctl_driver_t*)node->data;
+        res += "driver ";
+        res += jackctl_driver_get_name(driver);
+        res += (jackctl_driver_get_type(driver) == JackMaster) ? " master\n" : " slave\n";
+        DescribeParameters(res, jackctl_driver_get_parameters(driver));
+        (*drivers)++;
+    }
+
+    for (const JSList* node = jackctl_server_get_internals_list(server); node; node = jack_slist_next(node)) {
+        jackctl_internal_t* internal = (jackctl_internal_t*)node->data;
+        res += "internal ";
+        res += jackctl_internal_get_name(internal);
+        res += "\n";
+        DescribeParameters(res, jackctl_internal_get_parameters(internal));
+        (*internals)++;
+    }
+
+    jackctl_server_destroy(server);
+    return true;
+}
+
+static bool MeanScan(std::string& res, double* mean, int* drivers, int* internals)
+{
+    double duration;
+    *mean = 0;
+    for (int i = 0; i < SCAN_COUNT; i++) {
+        if (!Scan(res, &duration, drivers, internals)) {
+            return false;
+        }
+        *mean += duration / SCAN_COUNT;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    char cache_path[256];
+    std::string uncached, first, cached;
+    double uncached_time, first_time, cached_time;
+    int drivers, internals;
+    struct stat st1, st2;
+    int res = 0;
+
+    snprintf(cache_path, sizeof(cache_path), "/tmp/jack_test_driver_cache.%d", getpid());
+    unlink(cache_path);
+
+    // No cache
+    setenv("JACK_DRIVER_CACHE", "", 1);
+    if (!MeanScan(uncached, &uncached_time, &drivers, &internals)) {
+        printf("Cannot scan driver directory (set JACK_DRIVER_DIR)\n");
+        return 1;
+    }
+    if (stat(cache_path, &st1) == 0) {
+        printf("Cache written while disabled\n");
+        res = 1;
+    }
+
+    // First scan creates the cache
+    setenv("JACK_DRIVER_CACHE", cache_path, 1);
+    Scan(first, &first_time, &drivers, &internals);
+    if (stat(cache_path, &st1) < 0) {
+        printf("Cache file %s not written\n", cache_path);
+        unlink(cache_path);
+        return 1;
+    }
+
+    // Next ones only read it
+    MeanScan(cached, &cached_time, &drivers, &internals);
+    if (stat(cache_path, &st2) < 0 || st1.st_ino != st2.st_ino || st1.st_size != st2.st_size) {
+        printf("Cache file rewritten while nothing changed\n");
+        res = 1;
+    }
+
+    if (first != uncached) {
+        printf("Descriptors differ after the first scan with cache\n");
+        res = 1;
+    }
+    if (cached != uncached) {
+        printf("Descriptors read from the cache differ\n");
+        res = 1;
+    }
+
+    printf("%d drivers, %d internals, cache %ld bytes\n", drivers, internals, long(st1.st_size));
+    printf("Scan without cache %8.3f ms, creating cache %8.3f ms, with cache %8.3f ms\n",
+           uncached_time / 1000., first_time / 1000., cached_time / 1000.);
+
+    unlink(cache_path);
+    printf("%s\n", (res == 0) ? "Driver cache test OK" : "Driver cache test FAILED");
+    return res;
+}
@@ -0,0 +1,167 @@
+/*
+	Copyright (C) 2026 agent
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/*
+    Per cycle overhead of the graph activation with 16, 64 and 256 refnum (driver included) :
+    - activation : ResetGraph, then ResumeRefNum of the driver and of each client (synchro are flushed, so no system call is done)
+    - client loop : per cycle walk on opened clients (like CheckXRun or CalcCPULoad), using the refnum set or scanning the whole client table
+    The driver is connected to every client and every client is connected back to the driver.
+*/
+
+#include <iostream>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include "JackConnectionManager.h"
+#include "JackClientControl.h"
+#include "JackPlatformPlug.h"
+#include "JackBitSet.h"
+#include "JackTime.h"
+
+using namespace Jack;
+
+#define LOOPS 20000
+
+static double GetTime()
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return double(tv.tv_sec) * 1e6 + double(tv.tv_usec);
+}
+
+static jack_port_id_t Port(int ref, bool input)
+{
+    return FIRST_AVAILABLE_PORT + ref * 4 + (input ? 0 : 1);
+}
+
+static jack_port_id_t DriverPort(int ref, bool input)
+{
+    return FIRST_AVAILABLE_PORT + ref * 4 + (input ? 2 : 3);
+}
+
+static int Run(int refnum_count)
+{
+    JackConnectionManager* manager = new JackConnectionManager();
+    JackSynchro* table = new JackSynchro[CLIENT_NUM];
+    JackClientControl* control = new JackClientControl[CLIENT_NUM];
+    JackClientTiming* timing = new JackClientTiming[CLIENT_NUM];
+    bool opened[CLIENT_NUM];
+    JackFixedBitSet<CLIENT_NUM> used_refnum;
+    int res = 0;
+
+    memset(opened, 0, sizeof(opened));
+
+    for (int ref = 0; ref < refnum_count; ref++) {
+        char name[JACK_CLIENT_NAME_SIZE + 1];
+        snprintf(name, sizeof(name), "activation_%d", ref);
+        control[ref].Init(name, 0, ref, -1);
+        if (!table[ref].Allocate(name, "activation_test", 0)) {
+            res = 1;
+            goto end;
+        }
+        table[ref].SetFlush(true);
+        opened[ref] = true;
+        used_refnum.Set(ref);
+    }
+
+    // Driver (refnum 0) => clients => driver
+    for (int ref = 1; ref < refnum_count; ref++) {
+        manager->AddOutputPort(0, DriverPort(ref, false));
+        manager->AddInputPort(0, DriverPort(ref, true));
+        manager->AddInputPort(ref, Port(ref, true));
+        manager->AddOutputPort(ref, Port(ref, false));
+        manager->Connect(DriverPort(ref, false), Port(ref, true));
+        manager->Connect(Port(ref, true), DriverPort(ref, false));
+        manager->DirectConnect(0, ref);
+        manager->Connect(Port(ref, false), DriverPort(ref, true));
+        manager->Connect(DriverPort(ref, true), Port(ref, false));
+        manager->DirectConnect(ref, 0);
+    }
+
+    {
+        double start = GetTime();
+        for (int i = 0; i < LOOPS; i++) {
+            manager->ResetGraph(timing);
+            for (int ref = 0; ref < refnum_count; ref++) {
+                res |= manager->ResumeRefNum(&control[ref], table, timing);
+            }
+        }
+        double activation = (GetTime() - start) / LOOPS;
+
+        int finished = 0;
+        start = GetTime();
+        for (int i = 0; i < LOOPS; i++) {
+            JackFixedBitSet<CLIENT_NUM>::Iterator it(used_refnum, 1);
+            for (int ref = it.Next(); ref >= 0; ref = it.Next()) {
+                if (opened[ref] && timing[ref].fStatus == Finished) {
+                    finished++;
+                }
+            }
+        }
+        double set_loop = (GetTime() - start) / LOOPS;
+
+        start = GetTime();
+        for (int i = 0; i < LOOPS; i++) {
+            for (int ref = 1; ref < CLIENT_NUM; ref++) {
+                if (opened[ref] && timing[ref].fStatus == Finished) {
+                    finished--;
+                }
+            }
+        }
+        double scan_loop = (GetTime() - start) / LOOPS;
+
+        printf("%4d refnum : activation %8.3f usec per cycle, client loop %7.3f usec per cycle (refnum set) %7.3f usec per cycle (table scan)%s\n",
+                refnum_count, activation, set_loop, scan_loop, (finished == 0 && res == 0) ? "" : " ERROR");
+        if (finished != 0) {
+            res = 1;
+        }
+    }
+
+end:
+    for (int ref = 0; ref < refnum_count; ref++) {
+        table[ref].Destroy();
+    }
+    delete [] timing;
+    delete [] control;
+    delete [] table;
+    delete manager;
+    return res;
+}
+
+int main(int argc, char* argv[])
+{
+    int counts[] = { 16, 64, 256 };
+    int res = 0;
+
+    InitTime();
+    SetClockSource(JACK_TIMER_SYSTEM_CLOCK);
+    printf("Graph activation overhead, CLIENT_NUM = %d, %d cycles\n", CLIENT_NUM, LOOPS);
+
+    for (unsigned int i = 0; i < sizeof(counts) / sizeof(counts[0]); i++) {
+        if (counts[i] > CLIENT_NUM) {
+            printf("%4d refnum : skipped, server built with %d clients\n", counts[i], CLIENT_NUM);
+        } else {
+            res |= Run(counts[i]);
+        }
+    }
+
+    return res;
+}
@@ -0,0 +1,194 @@
+/*
+	Copyright (C) 2026 agent
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/*
+    Latency computation after a change : the refnum whose capture latencies (downstream of the changed ones) and
+    playback latencies (upstream of the changed ones) have to be computed again are checked against a depth first
+    search of the direct connections, on random graphs.
+    A session load is then simulated : chains of clients connected one by one between the driver capture and playback
+    ports. The number of client latency computations for all the connections is compared with the previous full
+    computation done after each connection.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "JackConnectionManager.h"
+
+using namespace Jack;
+
+#define DRIVER_NUM 2
+#define CHANGES 2000
+#define CHAIN_LENGTH 8
+
+static int gErrors = 0;
+
+static void Reached(JackConnectionManager* manager, int ref, JackFixedBitSet<CLIENT_NUM>& reached)
+{
+    const JackFixedBitSet<CLIENT_NUM>& outputs = manager->GetOutputRefs(ref);
+    for (int i = outputs.Next(DRIVER_NUM); i >= 0; i = outputs.Next(i + 1)) {
+        if (!reached.Test(i)) {
+            reached.Set(i);
+            Reached(manager, i, reached);
+        }
+    }
+}
+
+// Expected refnum computed with a depth first search from each client
+static void ExpectedRefs(JackConnectionManager* manager, const JackFixedBitSet<CLIENT_NUM>& changed,
+                         JackFixedBitSet<CLIENT_NUM>& capture, JackFixedBitSet<CLIENT_NUM>& playback)
+{
+    for (int ref = 0; ref < DRIVER_NUM; ref++) {
+        capture.Set(ref);
+        playback.Set(ref);
+    }
+    for (int ref = 0; ref < CLIENT_NUM; ref++) {
+        if (changed.Test(ref)) {
+            capture.Set(ref);
+            playback.Set(ref);
+        }
+        if (ref < DRIVER_NUM) {
+            continue;
+        }
+        JackFixedBitSet<CLIENT_NUM> reached;
+        Reached(manager, ref, reached);
+        for (int i = reached.Next(0); i >= 0; i = reached.Next(i + 1)) {
+            if (changed.Test(ref)) {
+                capture.Set(i);
+            }
+            if (changed.Test(i)) {
+                playback.Set(ref);
+            }
+        }
+    }
+}
+
+static bool Equals(const JackFixedBitSet<CLIENT_NUM>& set1, const JackFixedBitSet<CLIENT_NUM>& set2)
+{
+    for (int i = 0; i < CLIENT_NUM; i++) {
+        if (set1.Test(i) != set2.Test(i)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void TestRandomGraph(int clients)
+{
+    // The manager is too big for the stack
+    JackConnectionManager* manager = new JackConnectionManager();
+
+    // Reachable sets are computed for the drivers
+    manager->IsLoopRefPath(DRIVER_NUM, DRIVER_NUM, DRIVER_NUM);
+
+    for (int i = 0; i < CHANGES; i++) {
+        int ref1 = DRIVER_NUM + rand() % clients;
+        int ref2 = DRIVER_NUM + rand() % clients;
+        // Connections go to higher refnum so that the graph has no loop, some go to the driver
+        if (ref1 > ref2) {
+            int tmp = ref1;
+            ref1 = ref2;
+            ref2 = tmp;
+        }
+        if (rand() % 8 == 0) {
+            ref2 = AUDIO_DRIVER_REFNUM;
+        }
+        if (manager->IsDirectConnection(ref1, ref2) && rand() % 2 == 0) {
+            manager->DirectDisconnect(ref1, ref2);
+        } else {
+            manager->DirectConnect(ref1, ref2);
+        }
+
+        JackFixedBitSet<CLIENT_NUM> changed;
+        changed.Set(ref1);
+        changed.Set(ref2);
+        if (i % 4 == 0) {
+            changed.Set(DRIVER_NUM + rand() % clients);
+        }
+
+        JackFixedBitSet<CLIENT_NUM> capture, playback, expected_capture, expected_playback;
+        manager->GetLatencyRefs(changed, DRIVER_NUM, capture, playback);
+        ExpectedRefs(manager, changed, expected_capture, expected_playback);
+        if (!Equals(capture, expected_capture) || !Equals(playback, expected_playback)) {
+            printf("%d clients, change %d : wrong refnum for the latency computation\n", clients, i);
+            gErrors++;
+        }
+    }
+
+    // Sets computed for another number of drivers are not used
+    JackFixedBitSet<CLIENT_NUM> changed, capture, playback;
+    changed.Set(DRIVER_NUM);
+    if (manager->GetLatencyRefs(changed, DRIVER_NUM + 1, capture, playback)) {
+        printf("Refnum returned for another number of drivers\n");
+        gErrors++;
+    }
+
+    delete manager;
+}
+
+static void SessionLoad(int chains)
+{
+    JackConnectionManager* manager = new JackConnectionManager();
+    long full = 0;
+    long partial = 0;
+    int connections = 0;
+
+    manager->IsLoopRefPath(DRIVER_NUM, DRIVER_NUM, DRIVER_NUM);
+
+    // Each client of a chain is activated, then connected to the previous one, the last one to the driver
+    for (int chain = 0; chain < chains; chain++) {
+        int first = DRIVER_NUM + chain * CHAIN_LENGTH;
+        for (int i = 0; i <= CHAIN_LENGTH; i++) {
+            int ref1 = (i == 0) ? AUDIO_DRIVER_REFNUM : first + i - 1;
+            int ref2 = (i == CHAIN_LENGTH) ? AUDIO_DRIVER_REFNUM : first + i;
+            manager->DirectConnect(ref1, ref2);
+            connections++;
+
+            // Previous computation : all active clients notified twice
+            full += 2 * (first + i + 1);
+
+            JackFixedBitSet<CLIENT_NUM> changed, capture, playback;
+            changed.Set(ref1);
+            changed.Set(ref2);
+            manager->GetLatencyRefs(changed, DRIVER_NUM, capture, playback);
+            partial += capture.GetCount() + playback.GetCount();
+        }
+    }
+
+    printf("%3d chains of %d clients, %4d connections : %7ld client latency computations, %6ld with the changed ones only\n",
+           chains, CHAIN_LENGTH, connections, full, partial);
+    delete manager;
+}
+
+int main(int argc, char* argv[])
+{
+    static const int client_counts[] = { 16, 64, CLIENT_NUM - DRIVER_NUM };
+    srand(1);
+
+    for (int i = 0; i < 3; i++) {
+        TestRandomGraph(client_counts[i]);
+    }
+    for (int chains = 2; chains <= 16; chains *= 2) {
+        SessionLoad(chains);
+    }
+
+    printf("%s\n", (gErrors == 0) ? "Latency refnum test OK" : "Latency refnum test FAILED");
+    return (gErrors == 0) ? 0 : 1;
+}
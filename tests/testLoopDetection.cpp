@@ -0,0 +1,261 @@
+/*
+	Copyright (C) 2026 agent
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/*
+    Loop detection on connect : random connections and disconnections between 64 to 254 clients, also connected to a
+    driver, are made as JackGraphManager::Connect does (a connection creating a loop becomes a feedback connection).
+    After each change, the reachable refnum sets are checked against a depth first search of the direct connections,
+    then removing clients and changing the number of drivers are checked.
+    The cost of a loop check is compared with the previous recursive walk, on dense random DAGs.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <vector>
+
+#include "JackConnectionManager.h"
+
+using namespace Jack;
+
+#define DRIVER_NUM 2
+#define CHANGES 4000
+#define CHECKS_PER_CHANGE 16
+#define BENCH_CHECKS 2000
+#define MAX_WALK_CALLS 10000000
+
+static double GetTime()
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return double(tv.tv_sec) * 1e6 + double(tv.tv_usec);
+}
+
+static int gErrors = 0;
+
+struct Connection
+{
+    int fRef1;
+    int fRef2;
+};
+
+// Depth first search of the direct connections between clients, with a visited set
+static bool Reaches(JackConnectionManager* manager, int ref1, int ref2, int driver_num, JackFixedBitSet<CLIENT_NUM>& visited)
+{
+    if (ref1 == ref2) {
+        return true;
+    }
+    visited.Set(ref1);
+    const JackFixedBitSet<CLIENT_NUM>& outputs = manager->GetOutputRefs(ref1);
+    for (int ref = outputs.Next(driver_num); ref >= 0; ref = outputs.Next(ref + 1)) {
+        if (!visited.Test(ref) && Reaches(manager, ref, ref2, driver_num, visited)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool IsLoopReference(JackConnectionManager* manager, int ref1, int ref2, int driver_num)
+{
+    if (ref1 < driver_num || ref2 < driver_num) {
+        return false;
+    }
+    JackFixedBitSet<CLIENT_NUM> visited;
+    return Reaches(manager, ref1, ref2, driver_num, visited);
+}
+
+// The previous implementation : recursive walk of the outputs without visited set
+static bool IsLoopWalk(JackConnectionManager* manager, int ref1, int ref2, int driver_num, long* calls)
+{
+    if (++(*calls) > MAX_WALK_CALLS) {
+        return false;
+    } else if (ref1 < driver_num || ref2 < driver_num) {
+        return false;
+    } else if (ref1 == ref2) {
+        return true;
+    } else if (manager->GetOutputRefs(ref1).Test(ref2)) {
+        return true;
+    } else {
+        const JackFixedBitSet<CLIENT_NUM>& outputs = manager->GetOutputRefs(ref1);
+        for (int ref = outputs.Next(0); ref >= 0; ref = outputs.Next(ref + 1)) {
+            if (IsLoopWalk(manager, ref, ref2, driver_num, calls)) {
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+static int RandomClient(int clients)
+{
+    return DRIVER_NUM + rand() % clients;
+}
+
+static void CheckPaths(JackConnectionManager* manager, int clients, int count, int driver_num, const char* what)
+{
+    for (int i = 0; i < count; i++) {
+        int ref1 = RandomClient(clients);
+        int ref2 = RandomClient(clients);
+        bool res = manager->IsLoopRefPath(ref1, ref2, driver_num);
+        if (res != IsLoopReference(manager, ref1, ref2, driver_num)) {
+            printf("%s : %d clients, path from %d to %d %s\n", what, clients, ref1, ref2, (res) ? "wrongly found" : "not found");
+            gErrors++;
+        }
+    }
+}
+
+// Connect as JackGraphManager::Connect does : a connection closing a loop is reversed and becomes a feedback connection
+static void Connect(JackConnectionManager* manager, std::vector<Connection>& connections, int ref1, int ref2, int* loops)
+{
+    Connection connection;
+    if (manager->IsLoopRefPath(ref2, ref1, DRIVER_NUM)) {
+        connection.fRef1 = ref2;
+        connection.fRef2 = ref1;
+        (*loops)++;
+    } else {
+        connection.fRef1 = ref1;
+        connection.fRef2 = ref2;
+    }
+    manager->DirectConnect(connection.fRef1, connection.fRef2);
+    connections.push_back(connection);
+}
+
+static void TestRandomGraph(int clients)
+{
+    // The manager is too big for the stack
+    JackConnectionManager* manager = new JackConnectionManager();
+    std::vector<Connection> connections;
+    int loops = 0;
+
+    // Clients are connected to the audio driver inputs and outputs, paths through it are not loops
+    for (int ref = DRIVER_NUM; ref < DRIVER_NUM + clients; ref++) {
+        manager->DirectConnect(AUDIO_DRIVER_REFNUM, ref);
+        manager->DirectConnect(ref, AUDIO_DRIVER_REFNUM);
+    }
+
+    for (int i = 0; i < CHANGES; i++) {
+        if (connections.size() > 0 && rand() % 3 == 0) {
+            int index = rand() % connections.size();
+            manager->DirectDisconnect(connections[index].fRef1, connections[index].fRef2);
+            connections[index] = connections.back();
+            connections.pop_back();
+        } else {
+            Connect(manager, connections, RandomClient(clients), RandomClient(clients), &loops);
+        }
+        CheckPaths(manager, clients, CHECKS_PER_CHANGE, DRIVER_NUM, "Random changes");
+    }
+
+    // Removed clients
+    for (int i = 0; i < clients / 4; i++) {
+        int ref = RandomClient(clients);
+        manager->InitRefNum(ref);
+        for (size_t j = 0; j < connections.size(); j++) {
+            if (connections[j].fRef1 == ref || connections[j].fRef2 == ref) {
+                connections[j] = connections.back();
+                connections.pop_back();
+                j--;
+            }
+        }
+        CheckPaths(manager, clients, CHECKS_PER_CHANGE * 4, DRIVER_NUM, "Removed client");
+    }
+
+    // A driver is added, then removed
+    CheckPaths(manager, clients, CHECKS_PER_CHANGE * 4, DRIVER_NUM + 1, "Added driver");
+    CheckPaths(manager, clients, CHECKS_PER_CHANGE * 4, DRIVER_NUM, "Removed driver");
+
+    printf("%3d clients : %d changes, %d loops detected, %d connections left\n", clients, CHANGES, loops, int(connections.size()));
+    delete manager;
+}
+
+// Each client is connected to 'fanout' random clients with a higher refnum : a DAG with no loops
+static void BenchDenseGraph(int clients, int fanout)
+{
+    JackConnectionManager* manager = new JackConnectionManager();
+    int last = DRIVER_NUM + clients - 2;
+
+    for (int ref = DRIVER_NUM; ref < last; ref++) {
+        for (int i = 0; i < fanout; i++) {
+            manager->DirectConnect(ref, ref + 1 + rand() % (last - ref));
+        }
+    }
+
+    // A new client connected to the first clients : all paths from them have to be explored
+    std::vector<Connection> checks;
+    for (int i = 0; i < BENCH_CHECKS; i++) {
+        Connection check;
+        check.fRef1 = last + 1;
+        check.fRef2 = DRIVER_NUM + rand() % (clients / 8);
+        checks.push_back(check);
+    }
+
+    int found = 0;
+    double start = GetTime();
+    for (int i = 0; i < BENCH_CHECKS; i++) {
+        found += manager->IsLoopRefPath(checks[i].fRef2, checks[i].fRef1, DRIVER_NUM);
+    }
+    double closure = (GetTime() - start) / BENCH_CHECKS;
+
+    start = GetTime();
+    for (int i = 0; i < BENCH_CHECKS; i++) {
+        found -= IsLoopReference(manager, checks[i].fRef2, checks[i].fRef1, DRIVER_NUM);
+    }
+    double search = (GetTime() - start) / BENCH_CHECKS;
+
+    // The walk can be too long : it is stopped after MAX_WALK_CALLS calls
+    long calls = 0;
+    int walks = 0;
+    start = GetTime();
+    for (int i = 0; i < BENCH_CHECKS && calls < MAX_WALK_CALLS; i++, walks++) {
+        IsLoopWalk(manager, checks[i].fRef2, checks[i].fRef1, DRIVER_NUM, &calls);
+    }
+    double walk = (GetTime() - start) / walks;
+
+    // Cost of a connection and a disconnection, updating the reachable sets
+    start = GetTime();
+    for (int i = 0; i < BENCH_CHECKS; i++) {
+        manager->DirectConnect(checks[i].fRef2, checks[i].fRef1);
+        manager->DirectDisconnect(checks[i].fRef2, checks[i].fRef1);
+    }
+    double update = (GetTime() - start) / BENCH_CHECKS;
+
+    printf("%3d clients, fanout %d : closure %7.3f usecs, search %7.3f usecs, previous walk %10.3f usecs%s, connect + disconnect %7.3f usecs\n",
+           clients, fanout, closure, search, walk, (calls >= MAX_WALK_CALLS) ? " (stopped)" : "", update);
+    if (found != 0) {
+        printf("Closure and search results differ\n");
+        gErrors++;
+    }
+    delete manager;
+}
+
+int main(int argc, char* argv[])
+{
+    static const int client_counts[] = { 64, 128, CLIENT_NUM - DRIVER_NUM };
+    srand(1);
+
+    for (int i = 0; i < 3; i++) {
+        TestRandomGraph(client_counts[i]);
+    }
+    for (int i = 0; i < 3; i++) {
+        BenchDenseGraph(client_counts[i], 4);
+    }
+
+    printf("%s\n", (gErrors == 0) ? "Loop detection test OK" : "Loop detection test FAILED");
+    return (gErrors == 0) ? 0 : 1;
+}
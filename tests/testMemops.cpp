@@ -0,0 +1,153 @@
+/*
+	Copyright (C) 2026 agent
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/*
+    Sample conversions between port buffers and an interleaved period, for the packed 24 bit and 16 bit formats of
+    the ALSA driver, which have SSE paths : each native conversion is checked against its byte swapped version (which has no SSE path) on the
+    same samples, and their timing is compared. Odd sample counts check the scalar tail of the SSE loops.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include "memops.h"
+
+#define LOOPS 200
+#define NFRAMES 1024
+#define CHANNELS 8
+
+typedef void (*ReadFunction) (jack_default_audio_sample_t *dst, char *src, unsigned long nsamples, unsigned long src_skip);
+typedef void (*WriteFunction) (char *dst, jack_default_audio_sample_t *src, unsigned long nsamples, unsigned long dst_skip, dither_state_t *state);
+
+static double GetTime()
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return double(tv.tv_sec) * 1e6 + double(tv.tv_usec);
+}
+
+struct Format
+{
+    const char* fName;
+    ReadFunction fRead;
+    ReadFunction fReadSwapped;
+    WriteFunction fWrite;
+    WriteFunction fWriteSwapped;
+    unsigned long fSampleBytes;
+};
+
+static const Format gFormats[] = {
+    { "24", sample_move_dS_s24, sample_move_dS_s24s, sample_move_d24_sS, sample_move_d24_sSs, 3 },
+    { "16", sample_move_dS_s16, sample_move_dS_s16s, sample_move_d16_sS, sample_move_d16_sSs, 2 },
+};
+
+static jack_default_audio_sample_t gPort[NFRAMES];
+static jack_default_audio_sample_t gResult[NFRAMES];
+static jack_default_audio_sample_t gExpected[NFRAMES];
+static char gArea[NFRAMES * CHANNELS * 3];
+static char gSwappedArea[NFRAMES * CHANNELS * 3];
+
+// Second channel of the period, so that the other channels around it are checked to be left untouched
+#define CHANNEL(area, format) ((area) + (format).fSampleBytes)
+#define SKIP(format) (CHANNELS * (format).fSampleBytes)
+
+static void SwapArea(const Format& format, char* dst, const char* src)
+{
+    for (unsigned long i = 0; i < NFRAMES * CHANNELS * format.fSampleBytes; i += format.fSampleBytes) {
+        for (unsigned long b = 0; b < format.fSampleBytes; b++) {
+            dst[i + b] = src[i + format.fSampleBytes - 1 - b];
+        }
+    }
+}
+
+static int CheckWrite(const Format& format, unsigned long nsamples)
+{
+    char reference[sizeof(gArea)];
+
+    memset(gArea, 0x55, sizeof(gArea));
+    memset(reference, 0x55, sizeof(reference));
+    format.fWrite(CHANNEL(gArea, format), gPort, nsamples, SKIP(format), NULL);
+    format.fWriteSwapped(CHANNEL(reference, format), gPort, nsamples, SKIP(format), NULL);
+    SwapArea(format, gSwappedArea, reference);
+
+    if (memcmp(gArea, gSwappedArea, NFRAMES * SKIP(format)) != 0) {
+        printf("Write %s of %lu samples differs from the byte swapped conversion\n", format.fName, nsamples);
+        return 1;
+    }
+    return 0;
+}
+
+static int CheckRead(const Format& format, unsigned long nsamples)
+{
+    for (unsigned long i = 0; i < sizeof(gArea); i++) {
+        gArea[i] = char(rand());
+    }
+    SwapArea(format, gSwappedArea, gArea);
+    memset(gResult, 0, sizeof(gResult));
+    memset(gExpected, 0, sizeof(gExpected));
+    format.fRead(gResult, CHANNEL(gArea, format), nsamples, SKIP(format));
+    format.fReadSwapped(gExpected, CHANNEL(gSwappedArea, format), nsamples, SKIP(format));
+
+    if (memcmp(gResult, gExpected, sizeof(gResult)) != 0) {
+        printf("Read %s of %lu samples differs from the byte swapped conversion\n", format.fName, nsamples);
+        return 1;
+    }
+    return 0;
+}
+
+static double Measure(const Format& format, bool write, bool swapped)
+{
+    double start = GetTime();
+    for (int i = 0; i < LOOPS; i++) {
+        if (write) {
+            (swapped ? format.fWriteSwapped : format.fWrite)(gArea, gPort, NFRAMES, SKIP(format), NULL);
+        } else {
+            (swapped ? format.fReadSwapped : format.fRead)(gResult, gArea, NFRAMES, SKIP(format));
+        }
+    }
+    return (GetTime() - start) / LOOPS;
+}
+
+int main(int argc, char* argv[])
+{
+    static const unsigned long sample_counts[] = { NFRAMES, NFRAMES - 1, 7, 3, 1 };
+    int res = 0;
+
+    for (int i = 0; i < NFRAMES; i++) {
+        // A few samples out of the normalized range to check clipping
+        gPort[i] = (float(rand()) / float(RAND_MAX) - 0.5f) * 2.1f;
+    }
+
+    for (size_t f = 0; f < sizeof(gFormats) / sizeof(gFormats[0]); f++) {
+        for (size_t c = 0; c < sizeof(sample_counts) / sizeof(sample_counts[0]); c++) {
+            res |= CheckWrite(gFormats[f], sample_counts[c]);
+            res |= CheckRead(gFormats[f], sample_counts[c]);
+        }
+    }
+
+    printf("Channel of %d frames in a %d channels period, usec per conversion\n", NFRAMES, CHANNELS);
+    printf("%-8s %8s %12s %12s\n", "format", "", "native", "swapped");
+    for (size_t f = 0; f < sizeof(gFormats) / sizeof(gFormats[0]); f++) {
+        printf("%-8s %8s %12.2f %12.2f\n", gFormats[f].fName, "read", Measure(gFormats[f], false, false), Measure(gFormats[f], false, true));
+        printf("%-8s %8s %12.2f %12.2f\n", gFormats[f].fName, "write", Measure(gFormats[f], true, false), Measure(gFormats[f], true, true));
+    }
+    return res;
+}
@@ -0,0 +1,410 @@
+/*
+	Copyright (C) 2026 agent
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/*
+    RT message buffer : messages logged by threads using the message buffer (as the server RT threads) are formatted
+    by the message thread. The deferred formatting has to give the same messages as snprintf, and messages lost when
+    the ring is full are counted per thread. The cost of logging in the writing threads is compared with the previous
+    implementation (formatting in the writing thread, then copy in a ring guarded by a lock), for 1 and 4 writers.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdarg.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/time.h>
+
+#include <string>
+#include <vector>
+
+#include "JackMessageBuffer.h"
+#include "JackError.h"
+
+using namespace Jack;
+
+#define BENCH_MESSAGES 20000    // By each writer
+#define BENCH_BURST 32          // Messages logged in a cycle
+#define BENCH_PERIOD 1000       // Cycle duration in usec
+#define OVERRUN_MESSAGES 4096  // Logged at once to fill the ring
+#define WAIT_USEC 2000000
+
+extern "C" SERVER_EXPORT int set_threaded_log_function();
+
+static pthread_mutex_t gCaptureMutex = PTHREAD_MUTEX_INITIALIZER;
+static std::vector<std::string> gCaptured;
+static volatile int gCapturedCount = 0;
+
+static double GetTime()
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return double(tv.tv_sec) * 1e6 + double(tv.tv_usec);
+}
+
+static void CaptureCallback(const char* message)
+{
+    pthread_mutex_lock(&gCaptureMutex);
+    gCaptured.push_back(message);
+    gCapturedCount++;
+    pthread_mutex_unlock(&gCaptureMutex);
+}
+
+static void CountCallback(const char* message)
+{
+    __sync_fetch_and_add(&gCapturedCount, 1);
+}
+
+static volatile int gErrorCount = 0;
+static volatile int gReportedLost = 0;
+
+static void ErrorCallback(const char* message)
+{
+    unsigned int lost;
+    if (sscanf(message, "WARNING: %u messages lost", &lost) == 1) {
+        __sync_fetch_and_add(&gReportedLost, lost);
+    }
+    __sync_fetch_and_add(&gErrorCount, 1);
+}
+
+static void ResetCapture()
+{
+    pthread_mutex_lock(&gCaptureMutex);
+    gCaptured.clear();
+    gCapturedCount = 0;
+    pthread_mutex_unlock(&gCaptureMutex);
+}
+
+static bool WaitCapture(int count)
+{
+    double end = GetTime() + WAIT_USEC;
+    while (gCapturedCount < count && GetTime() < end) {
+        usleep(1000);
+    }
+    return gCapturedCount >= count;
+}
+
+/*
+Previous implementation, as reference : messages are formatted by the writer, then copied in a ring if its lock can be taken.
+*/
+
+#define OLD_BUFFERS 128
+#define OLD_BUFFERSIZE 256
+
+struct OldMessageBuffer
+{
+    struct {
+        int level;
+        char message[OLD_BUFFERSIZE];
+    } fBuffers[OLD_BUFFERS];
+    pthread_mutex_t fMutex;
+    pthread_cond_t fCond;
+    volatile unsigned int fInBuffer;
+    volatile unsigned int fOutBuffer;
+    volatile int fOverruns;
+    volatile bool fRunning;
+    pthread_t fThread;
+
+    OldMessageBuffer():fInBuffer(0), fOutBuffer(0), fOverruns(0), fRunning(true)
+    {
+        pthread_mutex_init(&fMutex, NULL);
+        pthread_cond_init(&fCond, NULL);
+        pthread_create(&fThread, NULL, ThreadHandler, this);
+    }
+
+    ~OldMessageBuffer()
+    {
+        pthread_mutex_lock(&fMutex);
+        fRunning = false;
+        pthread_cond_signal(&fCond);
+        pthread_mutex_unlock(&fMutex);
+        pthread_join(fThread, NULL);
+        pthread_mutex_destroy(&fMutex);
+        pthread_cond_destroy(&fCond);
+    }
+
+    void Flush()
+    {
+        while (fOutBuffer != fInBuffer) {
+            CountCallback(fBuffers[fOutBuffer].message);
+            fOutBuffer = (fOutBuffer + 1) & (OLD_BUFFERS - 1);
+        }
+    }
+
+    static void* ThreadHandler(void* arg)
+    {
+        OldMessageBuffer* buffer = (OldMessageBuffer*)arg;
+        pthread_mutex_lock(&buffer->fMutex);
+        while (buffer->fRunning) {
+            pthread_cond_wait(&buffer->fCond, &buffer->fMutex);
+            pthread_mutex_unlock(&buffer->fMutex);
+            buffer->Flush();
+            pthread_mutex_lock(&buffer->fMutex);
+        }
+        pthread_mutex_unlock(&buffer->fMutex);
+        return NULL;
+    }
+
+    void Log(const char* prefix, const char* fmt, ...)
+    {
+        char message[OLD_BUFFERSIZE];
+        size_t len = strlen(prefix);
+        memcpy(message, prefix, len);
+        va_list ap;
+        va_start(ap, fmt);
+        vsnprintf(message + len, sizeof(message) - len, fmt, ap);
+        va_end(ap);
+
+        if (pthread_mutex_trylock(&fMutex) == 0) {
+            fBuffers[fInBuffer].level = LOG_LEVEL_INFO;
+            strncpy(fBuffers[fInBuffer].message, message, OLD_BUFFERSIZE);
+            fInBuffer = (fInBuffer + 1) & (OLD_BUFFERS - 1);
+            pthread_cond_signal(&fCond);
+            pthread_mutex_unlock(&fMutex);
+        } else {
+            __sync_fetch_and_add(&fOverruns, 1);
+        }
+    }
+};
+
+static OldMessageBuffer* gOldBuffer = NULL;
+
+/*
+Deferred formatting
+*/
+
+struct CheckThreadArg
+{
+    int fErrors;
+};
+
+#define CHECK(...) \
+    { \
+        char expected[MB_BUFFERSIZE]; \
+        snprintf(expected, sizeof(expected), __VA_ARGS__); \
+        expecteds.push_back(expected); \
+        jack_info(__VA_ARGS__); \
+    }
+
+static void* CheckThread(void* arg)
+{
+    CheckThreadArg* check = (CheckThreadArg*)arg;
+    std::vector<std::string> expecteds;
+    std::string long_string(300, 'x');
+    const char* volatile null_string = NULL;
+    int value = 42;
+
+    set_threaded_log_function();
+    ResetCapture();
+
+    CHECK("no argument");
+    CHECK("100%% done");
+    CHECK("int %d unsigned %u hex %x %08X octal %o char %c", -12, 4000000000u, 255, 0xBEEF, 8, 'j');
+    CHECK("short %hd %hhu long %ld %lu long long %lld %llu", (short)-3, (unsigned char)200, -123456789L, 123456789UL, -1234567890123LL, 12345678901234ULL);
+    CHECK("size %zu ptrdiff %td intmax %jd", (size_t)123456, (ptrdiff_t)-77, (intmax_t)-99999999999LL);
+    CHECK("double %f %.3f %e %g %10.2f|%-10.2f|", 3.14159, 2.71828, 1e-9, 123456789.0, 1.5, -1.5);
+    CHECK("long double %Lf", (long double)0.25);
+    CHECK("width %*d precision %.*f both %*.*f", 6, 42, 2, 3.14159, 8, 3, 2.5);
+    CHECK("string %s %10s|%-10s|%.3s", "port", "right", "left", "truncated");
+    CHECK("null %s", null_string);
+    CHECK("pointer %p", (void*)&value);
+    CHECK("long string %s end", long_string.c_str());
+    CHECK("strings %s %s %s %s %s %s", long_string.c_str(), "a", "b", "c", "d", "e");
+    CHECK("too many %d %d %d %d %d %d %d %d %d %d", 1, 2, 3, 4, 5, 6, 7, 8, 9, 10);
+    CHECK("client %s port %d load %f xrun %ld", "system", 3, 12.5, 7L);
+
+    // The format is copied in the record : the caller can reuse its buffer at once
+    char format[32];
+    strcpy(format, "format %d in a buffer");
+    CHECK(format, 7);
+    strcpy(format, "overwritten %d");
+
+    if (!WaitCapture(int(expecteds.size()))) {
+        printf("Messages not all logged : %d on %d\n", gCapturedCount, int(expecteds.size()));
+        check->fErrors++;
+        return NULL;
+    }
+
+    for (size_t i = 0; i < expecteds.size(); i++) {
+        std::string captured = gCaptured[i];
+        if (captured != expecteds[i]) {
+            // Arguments that are not deferred are limited by the record
+            if (captured.size() < expecteds[i].size() && expecteds[i].compare(0, captured.size(), captured) == 0) {
+                printf("Truncated message : '%s'\n", captured.c_str());
+            } else {
+                printf("Wrong message : '%s' instead of '%s'\n", captured.c_str(), expecteds[i].c_str());
+                check->fErrors++;
+            }
+        }
+    }
+    return NULL;
+}
+
+/*
+Overruns : the messages lost by a thread are counted, and reported with its next message. The message thread
+may run during the burst : messages lost before the last written one are then already reported.
+*/
+
+static bool WaitOverrun(int count, unsigned int lost)
+{
+    double end = GetTime() + WAIT_USEC;
+    while (gCapturedCount + gReportedLost + int(lost) < count && GetTime() < end) {
+        usleep(1000);
+    }
+    return gCapturedCount + gReportedLost + int(lost) >= count;
+}
+
+static void* OverrunThread(void* arg)
+{
+    CheckThreadArg* check = (CheckThreadArg*)arg;
+
+    set_threaded_log_function();
+    ResetCapture();
+    gErrorCount = 0;
+    gReportedLost = 0;
+
+    for (int i = 0; i < OVERRUN_MESSAGES; i++) {
+        jack_info("Overrun %d", i);
+    }
+
+    // Lost since the last written message, not reported yet
+    unsigned int lost = JackMessageBuffer::GetThreadOverruns();
+    WaitOverrun(OVERRUN_MESSAGES, lost);
+    usleep(100000);
+    printf("%u messages lost on %d logged at once\n", lost + gReportedLost, OVERRUN_MESSAGES);
+
+    if (gCapturedCount + gReportedLost + int(lost) != OVERRUN_MESSAGES) {
+        printf("Lost messages not counted : %d logged\n", gCapturedCount);
+        check->fErrors++;
+    }
+
+    if (lost > 0) {
+        jack_info("After overrun");
+        WaitOverrun(OVERRUN_MESSAGES + 1, 0);
+        if (gCapturedCount + gReportedLost != OVERRUN_MESSAGES + 1 || JackMessageBuffer::GetThreadOverruns() != 0) {
+            printf("Lost messages not reported\n");
+            check->fErrors++;
+        }
+    }
+    return NULL;
+}
+
+/*
+Benchmark : writers log bursts of messages each cycle, as a RT thread would.
+*/
+
+struct BenchThreadArg
+{
+    bool fOld;
+    double fDuration;       // Spent in logging
+    unsigned int fLost;
+};
+
+static void* BenchThread(void* arg)
+{
+    BenchThreadArg* bench = (BenchThreadArg*)arg;
+    const char* client = "system";
+    bench->fDuration = 0;
+
+    set_threaded_log_function();
+
+    for (int cycle = 0; cycle < BENCH_MESSAGES / BENCH_BURST; cycle++) {
+        double begin = GetTime();
+        for (int i = 0; i < BENCH_BURST; i++) {
+            if (bench->fOld) {
+                gOldBuffer->Log("", "Cycle %d client %s delta %ld usec load %f", cycle, client, long(i), 0.5f * i);
+            } else {
+                jack_info("Cycle %d client %s delta %ld usec load %f", cycle, client, long(i), 0.5f * i);
+            }
+        }
+        bench->fDuration += GetTime() - begin;
+        usleep(BENCH_PERIOD);
+    }
+
+    bench->fLost = JackMessageBuffer::GetThreadOverruns();
+    return NULL;
+}
+
+static void Bench(int writers, bool old)
+{
+    pthread_t threads[writers];
+    BenchThreadArg args[writers];
+    double duration = 0;
+    unsigned int lost = 0;
+
+    ResetCapture();
+    if (old) {
+        gOldBuffer = new OldMessageBuffer();
+    }
+
+    for (int i = 0; i < writers; i++) {
+        args[i].fOld = old;
+        pthread_create(&threads[i], NULL, BenchThread, &args[i]);
+    }
+    for (int i = 0; i < writers; i++) {
+        pthread_join(threads[i], NULL);
+        duration += args[i].fDuration;
+        lost += args[i].fLost;
+    }
+
+    if (old) {
+        lost = gOldBuffer->fOverruns;
+        usleep(100000);
+        delete gOldBuffer;
+        gOldBuffer = NULL;
+    } else {
+        WaitCapture(writers * BENCH_MESSAGES - lost);
+        usleep(100000);
+    }
+
+    printf("%s, %d writer(s) : %6.1f ns per message, %d messages lost on %d (%s)\n",
+           (old) ? "Formatted in the writer " : "Deferred formatting     ",
+           writers, duration * 1000. / (writers * BENCH_MESSAGES), writers * BENCH_MESSAGES - gCapturedCount,
+           writers * BENCH_MESSAGES, (lost == unsigned(writers * BENCH_MESSAGES - gCapturedCount)) ? "all counted" : "not all counted");
+}
+
+int main(int argc, char* argv[])
+{
+    pthread_t thread;
+    CheckThreadArg check;
+    check.fErrors = 0;
+
+    jack_info_callback = CaptureCallback;
+    JackMessageBuffer::Create();
+
+    pthread_create(&thread, NULL, CheckThread, &check);
+    pthread_join(thread, NULL);
+
+    jack_info_callback = CountCallback;
+    jack_error_callback = ErrorCallback;
+
+    pthread_create(&thread, NULL, OverrunThread, &check);
+    pthread_join(thread, NULL);
+
+    Bench(1, true);
+    Bench(1, false);
+    Bench(4, true);
+    Bench(4, false);
+
+    JackMessageBuffer::Destroy();
+
+    printf("%s\n", (check.fErrors == 0) ? "Message buffer test OK" : "Message buffer test FAILED");
+    return (check.fErrors == 0) ? 0 : 1;
+}
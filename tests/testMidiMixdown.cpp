@@ -0,0 +1,185 @@
+/*
+	Copyright (C) 2026 agent
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/*
+    Cost of the MIDI input mixdown for an increasing number of events and sources : the port mixdown is compared
+    with the linear scan of the sources done for each event, and its result is checked against it.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "JackMidiPort.h"
+#include "JackPortType.h"
+#include "JackError.h"
+
+using namespace Jack;
+
+#define LOOPS 200
+#define MAX_SOURCES 64
+#define NFRAMES 1024
+
+static double GetTime()
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return double(tv.tv_sec) * 1e6 + double(tv.tv_usec);
+}
+
+// Look for the earliest event in all sources each time (the previous MIDI port implementation)
+static void LinearScanMixdown(void* mixbuffer, void** src_buffers, int src_count, jack_nframes_t nframes)
+{
+    JackMidiBuffer* mix = static_cast<JackMidiBuffer*>(mixbuffer);
+    mix->Reset(nframes);
+
+    int event_count = 0;
+    for (int i = 0; i < src_count; ++i) {
+        JackMidiBuffer* buf = static_cast<JackMidiBuffer*>(src_buffers[i]);
+        buf->mix_index = 0;
+        event_count += buf->event_count;
+        mix->lost_events += buf->lost_events;
+    }
+
+    int events_done;
+    for (events_done = 0; events_done < event_count; ++events_done) {
+        JackMidiBuffer* next_buf = 0;
+        JackMidiEvent* next_event = 0;
+        for (int i = 0; i < src_count; ++i) {
+            JackMidiBuffer* buf = static_cast<JackMidiBuffer*>(src_buffers[i]);
+            if (buf->mix_index >= buf->event_count)
+                continue;
+            JackMidiEvent* e = &buf->events[buf->mix_index];
+            if (!next_event || e->time < next_event->time) {
+                next_event = e;
+                next_buf = buf;
+            }
+        }
+        jack_midi_data_t* dest = mix->ReserveEvent(next_event->time, next_event->size);
+        if (!dest) {
+            break;
+        }
+        memcpy(dest, next_event->GetData(next_buf), next_event->size);
+        next_buf->mix_index++;
+    }
+    mix->lost_events += event_count - events_done;
+}
+
+static double Measure(JackPortMixdownFunction mixdown, void* mixbuffer, void** src_buffers, int src_count)
+{
+    double start = GetTime();
+    for (int i = 0; i < LOOPS; i++) {
+        mixdown(mixbuffer, src_buffers, src_count, NFRAMES);
+    }
+    return (GetTime() - start) / LOOPS;
+}
+
+// Controller changes spread over the sources, with a few SysEx messages stored out of the events array
+static void FillSources(void** src_buffers, int src_count, int event_count)
+{
+    for (int i = 0; i < src_count; i++) {
+        static_cast<JackMidiBuffer*>(src_buffers[i])->Reset(NFRAMES);
+    }
+
+    std::vector<jack_nframes_t> times(event_count);
+    for (int i = 0; i < event_count; i++) {
+        times[i] = rand() % NFRAMES;
+    }
+    std::sort(times.begin(), times.end());
+
+    for (int i = 0; i < event_count; i++) {
+        JackMidiBuffer* buf = static_cast<JackMidiBuffer*>(src_buffers[rand() % src_count]);
+        jack_shmsize_t size = (rand() % 64 == 0) ? 12 : 3;
+        jack_midi_data_t* data = buf->ReserveEvent(times[i], size);
+        if (data) {
+            for (jack_shmsize_t j = 0; j < size; j++) {
+                data[j] = jack_midi_data_t(rand());
+            }
+        }
+    }
+}
+
+static bool SameEvents(JackMidiBuffer* a, JackMidiBuffer* b)
+{
+    if (a->event_count != b->event_count || a->lost_events != b->lost_events) {
+        return false;
+    }
+    for (uint32_t i = 0; i < a->event_count; i++) {
+        if (a->events[i].time != b->events[i].time || a->events[i].size != b->events[i].size
+            || memcmp(a->events[i].GetData(a), b->events[i].GetData(b), a->events[i].size) != 0) {
+            return false;
+        }
+    }
+    return true;
+}
+
+int main(int argc, char* argv[])
+{
+    static const int source_counts[] = { 1, 2, 4, 8, 20, 64 };
+    static const int event_counts[] = { 16, 128, 1024, 2400 };
+
+    size_t buffer_size = BUFFER_SIZE_MAX * sizeof(jack_default_audio_sample_t);
+    void* sources[MAX_SOURCES];
+    void* reference = malloc(buffer_size);
+    void* result = malloc(buffer_size);
+    int res = 0;
+
+    // The event count overflows the buffer on purpose : the "lost events" have to be the same
+    jack_error_callback = silent_jack_error_callback;
+
+    for (int i = 0; i < MAX_SOURCES; i++) {
+        sources[i] = malloc(buffer_size);
+        MidiBufferInit(sources[i], buffer_size, NFRAMES);
+    }
+    MidiBufferInit(reference, buffer_size, NFRAMES);
+    MidiBufferInit(result, buffer_size, NFRAMES);
+
+    printf("MIDI mixdown, usec per mixdown of %d frames\n", NFRAMES);
+    printf("%8s %8s %12s %12s %8s\n", "events", "sources", "linear scan", "port", "speedup");
+
+    for (size_t e = 0; e < sizeof(event_counts) / sizeof(event_counts[0]); e++) {
+        for (size_t s = 0; s < sizeof(source_counts) / sizeof(source_counts[0]); s++) {
+            int event_count = event_counts[e];
+            int src_count = source_counts[s];
+
+            FillSources(sources, src_count, event_count);
+            LinearScanMixdown(reference, sources, src_count, NFRAMES);
+            MidiBufferMixdown(result, sources, src_count, NFRAMES);
+            if (!SameEvents(static_cast<JackMidiBuffer*>(result), static_cast<JackMidiBuffer*>(reference))) {
+                printf("Mixdown of %d events from %d sources differs from the linear scan\n", event_count, src_count);
+                res = 1;
+            }
+
+            double linear = Measure(LinearScanMixdown, reference, sources, src_count);
+            double port = Measure(MidiBufferMixdown, result, sources, src_count);
+            printf("%8d %8d %12.2f %12.2f %8.2f\n", event_count, src_count, linear, port, linear / port);
+        }
+    }
+
+    for (int i = 0; i < MAX_SOURCES; i++) {
+        free(sources[i]);
+    }
+    free(reference);
+    free(result);
+    return res;
+}
@@ -0,0 +1,214 @@
+/*
+	Copyright (C) 2026 agent
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/*
+    Network audio path over the loopback interface : the packets of a cycle are sent then received, with one system call
+    per packet (as done by default) or by batch, each packet of the batch being rendered in its own buffer.
+    Throughput and cycle latency are shown for both, and the batched packets are checked against the other ones.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include <algorithm>
+#include <vector>
+
+#include "JackNetTool.h"
+#include "JackPlatformPlug.h"
+
+using namespace Jack;
+
+#define CYCLES 2000
+#define CHANNELS 64
+#define MTU 1500
+#define UDP_PORT 19876
+#define MAX_PACKETS 256
+
+static double GetTime()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return double(ts.tv_sec) * 1e6 + double(ts.tv_nsec) / 1e3;
+}
+
+struct Packet
+{
+    char fData[MTU];
+    int fSize;
+};
+
+#ifdef NET_BATCH_IO
+static char gBatchBuffer[NET_BATCH_MAX][MTU];
+#endif
+
+static int SendCycle(JackNetSocket& socket, NetAudioBuffer* buffer, char* tx_buffer, bool batch, int active_ports)
+{
+    packet_header_t header;
+    memset(&header, 0, sizeof(header));
+    strcpy(header.fPacketType, "header");
+    header.fDataType = 'a';
+    header.fActivePorts = active_ports;
+    header.fNumPacket = buffer->GetNumPackets(active_ports);
+
+#ifdef NET_BATCH_IO
+    struct mmsghdr packets[NET_BATCH_MAX];
+    struct iovec iov[NET_BATCH_MAX];
+    unsigned int count = 0;
+#endif
+
+    for (uint subproc = 0; subproc < header.fNumPacket; subproc++) {
+        header.fSubCycle = subproc;
+        header.fIsLastPckt = (subproc == header.fNumPacket - 1) ? 1 : 0;
+
+    #ifdef NET_BATCH_IO
+        if (batch) {
+            header.fPacketSize = HEADER_SIZE + buffer->RenderToNetwork(subproc, active_ports, gBatchBuffer[count] + HEADER_SIZE);
+            PacketHeaderHToN(&header, reinterpret_cast<packet_header_t*>(gBatchBuffer[count]));
+            memset(&packets[count], 0, sizeof(struct mmsghdr));
+            iov[count].iov_base = gBatchBuffer[count];
+            iov[count].iov_len = header.fPacketSize;
+            packets[count].msg_hdr.msg_iov = &iov[count];
+            packets[count].msg_hdr.msg_iovlen = 1;
+            if (++count == NET_BATCH_MAX || header.fIsLastPckt) {
+                if (socket.SendBatch(packets, count, 0) < 0) {
+                    return -1;
+                }
+                count = 0;
+            }
+            continue;
+        }
+    #endif
+
+        header.fPacketSize = HEADER_SIZE + buffer->RenderToNetwork(subproc, active_ports);
+        PacketHeaderHToN(&header, reinterpret_cast<packet_header_t*>(tx_buffer));
+        if (socket.Send(tx_buffer, header.fPacketSize, 0) < 0) {
+            return -1;
+        }
+    }
+
+    return header.fNumPacket;
+}
+
+static int Measure(const char* name, JackNetSocket& tx, JackNetSocket& rx, NetAudioBuffer* buffer, char* tx_buffer,
+                    bool batch, std::vector<Packet>& reference, int nframes)
+{
+    std::vector<double> latency(CYCLES);
+    std::vector<Packet> received(MAX_PACKETS);
+    int num_packets = 0;
+    int res = 0;
+
+    double start = GetTime();
+
+    for (int cycle = 0; cycle < CYCLES; cycle++) {
+        double t1 = GetTime();
+        if ((num_packets = SendCycle(tx, buffer, tx_buffer, batch, CHANNELS)) < 0) {
+            printf("%s : send error\n", name);
+            return 1;
+        }
+        for (int i = 0; i < num_packets; i++) {
+            if ((received[i].fSize = rx.Recv(received[i].fData, MTU, 0)) < 0) {
+                printf("%s : receive error\n", name);
+                return 1;
+            }
+        }
+        latency[cycle] = GetTime() - t1;
+    }
+
+    double duration = GetTime() - start;
+
+    if (reference.empty()) {
+        reference.assign(received.begin(), received.begin() + num_packets);
+    } else {
+        for (int i = 0; i < num_packets; i++) {
+            if (received[i].fSize != reference[i].fSize || memcmp(received[i].fData, reference[i].fData, received[i].fSize) != 0) {
+                printf("%s : packet %d differs from the rendered one\n", name, i);
+                res = 1;
+            }
+        }
+    }
+
+    std::sort(latency.begin(), latency.end());
+    double bytes = double(CHANNELS) * nframes * sizeof(sample_t) * CYCLES;
+    printf("%8d %8d %10s %12.1f %12.0f %10.2f %10.2f %10.2f\n", nframes, num_packets, name,
+           bytes / duration, (double(num_packets) * CYCLES * 1e6) / duration,
+           latency[0], latency[CYCLES / 2], latency[(CYCLES * 99) / 100]);
+    return res;
+}
+
+int main(int argc, char* argv[])
+{
+    static const int buffer_sizes[] = { 64, 128, 256 };
+    std::vector<sample_t*> port_buffers(CHANNELS);
+    char tx_buffer[MTU];
+    int res = 0;
+
+    JackNetSocket rx("127.0.0.1", UDP_PORT);
+    JackNetSocket tx("127.0.0.1", UDP_PORT);
+
+    if (rx.NewSocket() < 0 || rx.Bind() < 0 || tx.NewSocket() < 0 || tx.Connect() < 0) {
+        printf("Cannot open the loopback sockets\n");
+        return 1;
+    }
+
+    int bufsize = 4 * 1024 * 1024;
+    rx.SetOption(SOL_SOCKET, SO_RCVBUF, &bufsize, sizeof(bufsize));
+    tx.SetOption(SOL_SOCKET, SO_SNDBUF, &bufsize, sizeof(bufsize));
+
+    for (int i = 0; i < CHANNELS; i++) {
+        port_buffers[i] = new sample_t[BUFFER_SIZE_MAX];
+        for (int j = 0; j < BUFFER_SIZE_MAX; j++) {
+            port_buffers[i][j] = float(rand()) / float(RAND_MAX) - 0.5f;
+        }
+    }
+
+    printf("Network audio path over loopback, %d channels, %d bytes MTU, latency in usec to send and receive a cycle\n", CHANNELS, MTU);
+    printf("%8s %8s %10s %12s %12s %10s %10s %10s\n", "frames", "packets", "mode", "bytes/usec", "packets/sec", "min", "median", "99%");
+
+    for (size_t b = 0; b < sizeof(buffer_sizes) / sizeof(buffer_sizes[0]); b++) {
+
+        session_params_t params;
+        memset(&params, 0, sizeof(params));
+        params.fMtu = MTU;
+        params.fPeriodSize = buffer_sizes[b];
+        params.fSampleRate = 48000;
+        params.fSendAudioChannels = CHANNELS;
+        params.fReturnAudioChannels = CHANNELS;
+
+        NetFloatAudioBuffer buffer(&params, CHANNELS, tx_buffer + HEADER_SIZE);
+        for (int i = 0; i < CHANNELS; i++) {
+            buffer.SetBuffer(i, port_buffers[i]);
+        }
+
+        std::vector<Packet> reference;
+        res |= Measure("packet", tx, rx, &buffer, tx_buffer, false, reference, buffer_sizes[b]);
+
+    #ifdef NET_BATCH_IO
+        rx.SetRecvBatch(NET_BATCH_MAX, MTU);
+        res |= Measure("batch", tx, rx, &buffer, tx_buffer, true, reference, buffer_sizes[b]);
+        rx.SetRecvBatch(0, 0);
+    #endif
+    }
+
+    for (int i = 0; i < CHANNELS; i++) {
+        delete [] port_buffers[i];
+    }
+    return res;
+}
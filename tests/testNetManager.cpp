@@ -0,0 +1,169 @@
+/*
+	Copyright (C) 2026 agent
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/*
+    NetManager receiving the slaves packets with its own threads (-t) on a running server : slaves opened with
+    the net API each send a constant value, the masters are chained (the output of a master feeding the input
+    of the next one) so that every slave but the first one has to receive the value of the previous one.
+    The number of receiving threads can be given as argument (2 by default, 0 : each master receives its packets).
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <jack/jack.h>
+#include <jack/intclient.h>
+#include <jack/net.h>
+
+#define SLAVE_COUNT 3
+#define NET_PORT 19100
+
+struct Slave
+{
+    jack_net_slave_t* fNet;
+    float fValue;               // sent to the master
+    float fExpected;            // from the previous slave
+    volatile float fReceived;
+    volatile int fCycles;
+    volatile int fGlitches;     // cycles not receiving the expected value, once it was received
+};
+
+static Slave gSlaves[SLAVE_COUNT];
+
+static int SlaveProcess(jack_nframes_t buffer_size,
+                        int audio_input, float** audio_input_buffer,
+                        int midi_input, void** midi_input_buffer,
+                        int audio_output, float** audio_output_buffer,
+                        int midi_output, void** midi_output_buffer,
+                        void* arg)
+{
+    Slave* slave = static_cast<Slave*>(arg);
+    for (jack_nframes_t i = 0; i < buffer_size; i++) {
+        audio_output_buffer[0][i] = slave->fValue;
+    }
+    bool expected = true;
+    for (jack_nframes_t i = 0; i < buffer_size; i++) {
+        expected &= (audio_input_buffer[0][i] == slave->fExpected);
+    }
+    if (!expected && slave->fReceived == slave->fExpected) {
+        slave->fGlitches++;
+    }
+    slave->fReceived = audio_input_buffer[0][buffer_size - 1];
+    slave->fCycles++;
+    return 0;
+}
+
+int main(int argc, char* argv[])
+{
+    int res = 0;
+    char name[64];
+    jack_status_t status;
+
+    jack_client_t* client = jack_client_open("test_net_manager", JackNoStartServer, NULL);
+    if (!client) {
+        printf("Cannot open client, is the server running ?\n");
+        return 1;
+    }
+
+    char init[64];
+    snprintf(init, sizeof(init), "-p %d -t %d", NET_PORT, (argc > 1) ? atoi(argv[1]) : 2);
+    snprintf(name, sizeof(name), "netmanager_%d", getpid());
+    jack_intclient_t manager = jack_internal_client_load(client, name, (jack_options_t)(JackLoadName | JackLoadInit), &status, "netmanager", init);
+    if (manager == 0) {
+        printf("Cannot load the netmanager internal client\n");
+        jack_client_close(client);
+        return 1;
+    }
+
+    for (int i = 0; i < SLAVE_COUNT; i++) {
+        jack_slave_t request = { 1, 1, 0, 0, DEFAULT_MTU, 5, JackFloatEncoder, 0, 2 };
+        jack_master_t result;
+        snprintf(name, sizeof(name), "test_slave%d", i);
+        gSlaves[i].fValue = float(i + 1) * 0.1f;
+        gSlaves[i].fExpected = float(i) * 0.1f;
+        gSlaves[i].fReceived = 0.f;
+        gSlaves[i].fCycles = 0;
+        gSlaves[i].fGlitches = 0;
+        if ((gSlaves[i].fNet = jack_net_slave_open("127.0.0.1", NET_PORT, name, &request, &result)) == NULL) {
+            printf("Cannot open slave %s\n", name);
+            res = 1;
+            goto end;
+        }
+        jack_set_net_slave_process_callback(gSlaves[i].fNet, SlaveProcess, &gSlaves[i]);
+        if (jack_net_slave_activate(gSlaves[i].fNet) != 0) {
+            printf("Cannot activate slave %s\n", name);
+            res = 1;
+            goto end;
+        }
+    }
+
+    // the masters are named after the slaves, prefixed with the host name, and may still be starting
+    for (int wait = 0; wait < 50; wait++) {
+        const char** ports = jack_get_ports(client, "test_slave", NULL, 0);
+        int count = 0;
+        while (ports && ports[count]) {
+            count++;
+        }
+        jack_free(ports);
+        if (count == 2 * SLAVE_COUNT) {
+            break;
+        }
+        usleep(100000);
+    }
+    for (int i = 1; i < SLAVE_COUNT; i++) {
+        char source[64];
+        char destination[64];
+        snprintf(source, sizeof(source), "test_slave%d:from_slave_1$", i - 1);
+        snprintf(destination, sizeof(destination), "test_slave%d:to_slave_1$", i);
+        const char** sources = jack_get_ports(client, source, NULL, 0);
+        const char** destinations = jack_get_ports(client, destination, NULL, 0);
+        if (!sources || !destinations || jack_connect(client, sources[0], destinations[0]) != 0) {
+            printf("Cannot connect %s to %s\n", source, destination);
+            res = 1;
+        }
+        jack_free(sources);
+        jack_free(destinations);
+        if (res) {
+            goto end;
+        }
+    }
+
+    sleep(2);
+    for (int i = 0; i < SLAVE_COUNT; i++) {
+        printf("test_slave%d : cycles = %d received = %f expected = %f glitches = %d\n",
+               i, gSlaves[i].fCycles, gSlaves[i].fReceived, gSlaves[i].fExpected, gSlaves[i].fGlitches);
+        if (gSlaves[i].fCycles == 0 || gSlaves[i].fReceived != gSlaves[i].fExpected) {
+            res = 1;
+        }
+    }
+
+end:
+    // the masters are removed first, the slaves do not have to detect it
+    jack_internal_client_unload(client, manager);
+    for (int i = 0; i < SLAVE_COUNT; i++) {
+        if (gSlaves[i].fNet) {
+            jack_net_slave_deactivate(gSlaves[i].fNet);
+            jack_net_slave_close(gSlaves[i].fNet);
+        }
+    }
+    jack_client_close(client);
+    return res;
+}
@@ -0,0 +1,127 @@
+/*
+	Copyright (C) 2026 agent
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/*
+    Cost of a synchronous notification on a running server : a lot of clients whose buffer size callback takes some
+    time are opened, then the buffer size is changed. As the server notifies all clients at once, the change should
+    take about the time of one callback, not the sum of them. Each client must have seen the new buffer size, and
+    the notification latency kept for each client must be the time taken by its own callback.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/time.h>
+
+#include <jack/jack.h>
+#include <jack/statistics.h>
+
+#define CLIENTS 40
+#define CALLBACK_DURATION 5000  // in usec
+
+static double GetTime()
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return double(tv.tv_sec) * 1e6 + double(tv.tv_usec);
+}
+
+static jack_client_t* gClients[CLIENTS];
+static volatile jack_nframes_t gBufferSizes[CLIENTS];
+
+static int BufferSizeCallback(jack_nframes_t nframes, void* arg)
+{
+    usleep(CALLBACK_DURATION);
+    gBufferSizes[(long)arg] = nframes;
+    return 0;
+}
+
+static int CloseClients(int count, int res)
+{
+    for (int i = 0; i < count; i++) {
+        jack_client_close(gClients[i]);
+    }
+    return res;
+}
+
+int main(int argc, char* argv[])
+{
+    int res = 0;
+
+    // Client opening is also measured : the new client is notified of all existing ones
+    double start = GetTime();
+    for (long i = 0; i < CLIENTS; i++) {
+        char name[32];
+        snprintf(name, sizeof(name), "test_notify_%ld", i);
+        gClients[i] = jack_client_open(name, JackNoStartServer, NULL);
+        if (!gClients[i]) {
+            printf("Cannot open client, is the server running ?\n");
+            return CloseClients(i, 1);
+        }
+        jack_set_buffer_size_callback(gClients[i], BufferSizeCallback, (void*)i);
+        if (jack_activate(gClients[i]) != 0) {
+            printf("Cannot activate client\n");
+            return CloseClients(i + 1, 1);
+        }
+    }
+    double open_time = GetTime() - start;
+
+    jack_nframes_t buffer_size = jack_get_buffer_size(gClients[0]);
+    jack_nframes_t new_buffer_size = (buffer_size == 512) ? 256 : 512;
+
+    start = GetTime();
+    if (jack_set_buffer_size(gClients[0], new_buffer_size) != 0) {
+        printf("Cannot change buffer size\n");
+        res = 1;
+    }
+    double change_time = GetTime() - start;
+
+    for (int i = 0; i < CLIENTS; i++) {
+        if (gBufferSizes[i] != new_buffer_size) {
+            printf("Client %d has not been notified of the new buffer size\n", i);
+            res = 1;
+        }
+    }
+
+    jack_time_t max_notify_usecs = 0;
+    for (int i = 0; i < CLIENTS; i++) {
+        jack_client_load_t load;
+        if (jack_get_client_load(gClients[0], jack_get_client_name(gClients[i]), &load) != 0) {
+            printf("Cannot get the load of client %d\n", i);
+            res = 1;
+        } else if (load.notify_usecs < CALLBACK_DURATION) {
+            printf("Client %d notification latency %lu usec is shorter than its callback\n", i, (unsigned long)load.notify_usecs);
+            res = 1;
+        } else if (load.notify_usecs > max_notify_usecs) {
+            max_notify_usecs = load.notify_usecs;
+        }
+    }
+
+    // Restore the previous buffer size
+    jack_set_buffer_size(gClients[0], buffer_size);
+
+    printf("%d clients, buffer size callback of %d usec\n", CLIENTS, CALLBACK_DURATION);
+    printf("open and activate all clients : %.0f usec\n", open_time);
+    printf("buffer size change : %.0f usec (%.0f usec if clients are notified one after the other)\n",
+        change_time, double(CLIENTS * CALLBACK_DURATION));
+    printf("longest client notification latency : %lu usec\n", (unsigned long)max_notify_usecs);
+
+    return CloseClients(CLIENTS, res);
+}
@@ -0,0 +1,290 @@
+/*
+	Copyright (C) 2026 agent
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/*
+    Port buffer pool : audio and MIDI ports of several clients are registered in a graph manager, released and
+    registered again, while the buffer size changes. Buffers are checked to be aligned, disjoint, inside the pool,
+    and contiguous for each client after a buffer size change. Every port of a graph manager is then registered as a
+    MIDI port.
+    The size of the graph manager and port buffers is compared with the previous buffers embedded in the ports, then
+    the cost of a cycle touching the buffers of 32 clients is compared with the previous layout.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <vector>
+#include <algorithm>
+
+#include "JackGraphManager.h"
+
+using namespace Jack;
+
+#define PORT_MAX 2048
+#define CLIENTS 32
+#define PORTS_PER_CLIENT 8
+#define MIDI_PORTS_PER_CLIENT 2
+#define MIDI_PORT_MAX 512
+#define MIDI_BUFFERS (MIDI_PORT_MAX - FIRST_AVAILABLE_PORT)
+#define BENCH_CYCLES 2000
+#define PREVIOUS_PORT_BUFFER_SIZE ((BUFFER_SIZE_MAX + 8) * sizeof(jack_default_audio_sample_t))
+
+static double GetTime()
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return double(tv.tv_sec) * 1e6 + double(tv.tv_usec);
+}
+
+static int gErrors = 0;
+
+struct PortBuffer
+{
+    int fRefNum;
+    size_t fStart;
+    size_t fEnd;
+
+    bool operator<(const PortBuffer& buffer) const
+    {
+        return fStart < buffer.fStart;
+    }
+};
+
+static void Check(bool cond, const char* what, int value)
+{
+    if (!cond) {
+        printf("%s : %d\n", what, value);
+        gErrors++;
+    }
+}
+
+static jack_port_id_t Register(JackGraphManager* manager, int refnum, int index, jack_nframes_t buffer_size)
+{
+    char name[REAL_JACK_PORT_NAME_SIZE];
+    bool midi = (index % PORTS_PER_CLIENT) < MIDI_PORTS_PER_CLIENT;
+    snprintf(name, sizeof(name), "client_%d:port_%d", refnum, index);
+    return manager->AllocatePort(refnum, name, (midi) ? JACK_DEFAULT_MIDI_TYPE : JACK_DEFAULT_AUDIO_TYPE,
+                                 (index & 1) ? JackPortIsOutput : JackPortIsInput, buffer_size);
+}
+
+// Audio buffers have the buffer size, MIDI ones BUFFER_SIZE_MAX frames
+static size_t BufferSize(const char* type, jack_nframes_t buffer_size)
+{
+    bool midi = (strcmp(type, JACK_DEFAULT_MIDI_TYPE) == 0);
+    return ((midi) ? BUFFER_SIZE_MAX : buffer_size) * sizeof(jack_default_audio_sample_t);
+}
+
+static void CheckBuffers(JackGraphManager* manager, jack_port_id_t* ports, int count, bool contiguous)
+{
+    JackPortBufferPool* pool = manager->GetBufferPool();
+    char* address = pool->GetAddress();
+    std::vector<PortBuffer> buffers;
+
+    for (int i = 0; i < count; i++) {
+        JackPort* port = manager->GetPort(ports[i]);
+        PortBuffer buffer;
+        buffer.fRefNum = port->GetRefNum();
+        buffer.fStart = (char*)port->GetBuffer(address) - address;
+        buffer.fEnd = buffer.fStart + BufferSize(port->GetType(), pool->GetBufferSize());
+        Check(buffer.fStart % PORT_BUFFER_ALIGN == 0, "Buffer not aligned", ports[i]);
+        Check(buffer.fEnd <= pool->GetSize(), "Buffer outside the pool", ports[i]);
+        buffers.push_back(buffer);
+
+        // Filled to check that buffers do not overlap the buffer used for released ports
+        memset(address + buffer.fStart, 0xFF, buffer.fEnd - buffer.fStart);
+    }
+
+    std::sort(buffers.begin(), buffers.end());
+    Check(buffers[0].fStart >= pool->GetUnusedBuffer() + BufferSize(JACK_DEFAULT_MIDI_TYPE, 0), "Port uses the unused buffer", 0);
+    for (size_t i = 1; i < buffers.size(); i++) {
+        Check(buffers[i].fStart >= buffers[i - 1].fEnd, "Overlapping buffers", int(i));
+    }
+
+    // Once laid out again, the buffers of a client follow each other
+    if (contiguous) {
+        for (size_t i = 1; i < buffers.size(); i++) {
+            if (buffers[i].fRefNum == buffers[i - 1].fRefNum) {
+                size_t gap = buffers[i].fStart - buffers[i - 1].fEnd;
+                Check(gap < PORT_BUFFER_ALIGN, "Buffers of a client not contiguous", buffers[i].fRefNum);
+            } else {
+                Check(buffers[i].fRefNum > buffers[i - 1].fRefNum, "Clients not laid out in order", buffers[i].fRefNum);
+            }
+        }
+    }
+}
+
+static void TestBufferSizes(JackGraphManager* manager, jack_port_id_t* ports, int count)
+{
+    static const jack_nframes_t buffer_sizes[] = { 64, 1024, 32, 4096, 128, 256 };
+
+    for (int i = 0; i < 6; i++) {
+        jack_nframes_t buffer_size = buffer_sizes[i];
+        UInt32 id = manager->GetBufferPool()->GetId();
+        Check(manager->SetBufferSize(buffer_size) == 0, "Buffer size change failed", buffer_size);
+        JackPortBufferPool* pool = manager->GetBufferPool();
+        Check(pool->GetId() != id && pool->GetBufferSize() == buffer_size, "Pool not allocated again", buffer_size);
+        CheckBuffers(manager, ports, count, true);
+
+        // Released ports are registered again after the other ports of the client when possible
+        for (int j = 0; j < count; j += 3) {
+            int refnum = manager->GetPort(ports[j])->GetRefNum();
+            manager->ReleasePort(refnum, ports[j]);
+        }
+        for (int j = 0; j < count; j += 3) {
+            ports[j] = Register(manager, j / PORTS_PER_CLIENT + 1, j, buffer_size);
+            Check(ports[j] != NO_PORT, "Cannot register port", j);
+        }
+        CheckBuffers(manager, ports, count, false);
+
+        printf("Buffer size %4d : %4d KB of port buffers, %5.1f%% used\n", int(buffer_size), int(pool->GetSize() / 1024),
+               100.0 * pool->GetUsedUnits() * JackPortBufferPool::GetUnitSize(buffer_size) / pool->GetSize());
+    }
+}
+
+static void TestMidiBuffers()
+{
+    size_t manager_size = sizeof(JackGraphManager) + MIDI_PORT_MAX * sizeof(JackPort);
+    void* memory = calloc(1, manager_size);
+    JackGraphManager* manager = new(memory) JackGraphManager(MIDI_PORT_MAX);
+    jack_port_id_t ports[MIDI_BUFFERS];
+
+    manager->SetBufferSize(64);
+
+    for (int i = 0; i < MIDI_BUFFERS; i++) {
+        char name[REAL_JACK_PORT_NAME_SIZE];
+        int refnum = i % CLIENTS + 1;
+        snprintf(name, sizeof(name), "client_%d:midi_%d", refnum, i);
+        ports[i] = manager->AllocatePort(refnum, name, JACK_DEFAULT_MIDI_TYPE, JackPortIsInput, 64);
+        if (ports[i] == NO_PORT) {
+            Check(false, "Cannot register MIDI port", i);
+            return;
+        }
+    }
+    CheckBuffers(manager, ports, MIDI_BUFFERS, false);
+    Check(manager->SetBufferSize(32) == 0, "Buffer size change failed with MIDI ports", 32);
+    CheckBuffers(manager, ports, MIDI_BUFFERS, true);
+    printf("%d MIDI ports, buffer size 32 : %d KB of port buffers\n", MIDI_BUFFERS, int(manager->GetBufferPool()->GetSize() / 1024));
+
+    JackPortBufferPool::Destroy(manager->GetBufferPool());
+    manager->~JackGraphManager();
+    free(memory);
+}
+
+// A cycle : half of the buffers are written, the other half are read
+static float RunCycle(char** buffers, int count, jack_nframes_t buffer_size)
+{
+    float sum = 0.f;
+    for (int i = 0; i < count; i++) {
+        float* buffer = (float*)buffers[i];
+        if (i & 1) {
+            for (jack_nframes_t j = 0; j < buffer_size; j++) {
+                buffer[j] = float(j);
+            }
+        } else {
+            for (jack_nframes_t j = 0; j < buffer_size; j++) {
+                sum += buffer[j];
+            }
+        }
+    }
+    return sum;
+}
+
+static void Bench(JackGraphManager* manager, jack_port_id_t* ports, int count, jack_nframes_t buffer_size)
+{
+    manager->SetBufferSize(buffer_size);
+    JackPortBufferPool* pool = manager->GetBufferPool();
+    std::vector<char*> buffers;
+    std::vector<char*> previous_buffers;
+
+    // The previous layout : a buffer in each port of the graph manager
+    char* previous = (char*)calloc(count, PREVIOUS_PORT_BUFFER_SIZE);
+    for (int i = 0; i < count; i++) {
+        JackPort* port = manager->GetPort(ports[i]);
+        if (strcmp(port->GetType(), JACK_DEFAULT_AUDIO_TYPE) == 0) {
+            buffers.push_back((char*)port->GetBuffer(pool->GetAddress()));
+            previous_buffers.push_back(previous + i * PREVIOUS_PORT_BUFFER_SIZE);
+        }
+    }
+
+    float sum = 0.f;
+    double start = GetTime();
+    for (int i = 0; i < BENCH_CYCLES; i++) {
+        sum += RunCycle(&buffers[0], buffers.size(), buffer_size);
+    }
+    double pooled = (GetTime() - start) / BENCH_CYCLES;
+
+    start = GetTime();
+    for (int i = 0; i < BENCH_CYCLES; i++) {
+        sum -= RunCycle(&previous_buffers[0], previous_buffers.size(), buffer_size);
+    }
+    double embedded = (GetTime() - start) / BENCH_CYCLES;
+
+    printf("Cycle of %d clients, %d audio ports, buffer size %d : pool %6.2f usecs, previous layout %6.2f usecs\n",
+           CLIENTS, int(buffers.size()), int(buffer_size), pooled, embedded);
+    Check(sum == 0.f, "Different cycle results", 0);
+    free(previous);
+}
+
+int main(int argc, char* argv[])
+{
+    // Port buffers are allocated in shared memory
+    if (jack_register_server("test_port_buffer_pool", 0) != 0) {
+        printf("Cannot register server\n");
+        return 1;
+    }
+
+    // Allocated in process memory, with the placement new of the shared memory objects
+    size_t manager_size = sizeof(JackGraphManager) + PORT_MAX * sizeof(JackPort);
+    void* memory = calloc(1, manager_size);
+    JackGraphManager* manager = new(memory) JackGraphManager(PORT_MAX);
+    jack_port_id_t ports[CLIENTS * PORTS_PER_CLIENT];
+    int count = CLIENTS * PORTS_PER_CLIENT;
+
+    Check(manager->GetBufferPool() == NULL, "Port buffers allocated before the buffer size is known", 0);
+    manager->SetBufferSize(256);
+
+    // Clients register their ports in turn
+    for (int i = 0; i < PORTS_PER_CLIENT; i++) {
+        for (int refnum = 1; refnum <= CLIENTS; refnum++) {
+            int index = (refnum - 1) * PORTS_PER_CLIENT + i;
+            ports[index] = Register(manager, refnum, index, 256);
+            Check(ports[index] != NO_PORT, "Cannot register port", index);
+        }
+    }
+    CheckBuffers(manager, ports, count, false);
+    TestBufferSizes(manager, ports, count);
+
+    size_t previous_size = sizeof(JackGraphManager) + PORT_MAX * (sizeof(JackPort) + PREVIOUS_PORT_BUFFER_SIZE);
+    printf("%d ports, buffer size 256 : graph manager %d KB + port buffers %d KB, previously %d KB\n", PORT_MAX,
+           int(manager_size / 1024), int(manager->GetBufferPool()->GetSize() / 1024), int(previous_size / 1024));
+
+    Bench(manager, ports, count, 64);
+    Bench(manager, ports, count, 256);
+
+    JackPortBufferPool::Destroy(manager->GetBufferPool());
+    manager->~JackGraphManager();
+    free(memory);
+
+    TestMidiBuffers();
+    jack_unregister_server("test_port_buffer_pool");
+
+    printf("%s\n", (gErrors == 0) ? "Port buffer pool test OK" : "Port buffer pool test FAILED");
+    return (gErrors == 0) ? 0 : 1;
+}
@@ -0,0 +1,215 @@
+/*
+	Copyright (C) 2026 agent
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/*
+    Port name index : ports are registered in a graph manager, then looked up by name and alias after renames,
+    alias changes and releases. Ports are released and registered again until the index is rebuilt several times.
+    The cost of a lookup by name with the index is compared with the previous linear scan of the port array.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include "JackGraphManager.h"
+#include "JackPortType.h"
+
+using namespace Jack;
+
+#define PORT_MAX 2048
+#define PORTS_PER_CLIENT 100
+#define BENCH_LOOPS 20
+
+static double GetTime()
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return double(tv.tv_sec) * 1e6 + double(tv.tv_usec);
+}
+
+static int gErrors = 0;
+
+static void Check(bool cond, const char* what, const char* name)
+{
+    if (!cond) {
+        printf("%s : %s\n", what, name);
+        gErrors++;
+    }
+}
+
+// The previous implementation of JackGraphManager::GetPort(const char* name)
+static jack_port_id_t FindLinear(JackGraphManager* manager, const char* name)
+{
+    for (unsigned int i = 0; i < PORT_MAX; i++) {
+        JackPort* port = manager->GetPort(i);
+        if (port->GetRefNum() >= 0 && port->NameEquals(name)) {
+            return i;
+        }
+    }
+    return NO_PORT;
+}
+
+static void PortName(char* name, int index)
+{
+    snprintf(name, REAL_JACK_PORT_NAME_SIZE, "client_%d:out_%d", index / PORTS_PER_CLIENT, index);
+}
+
+static jack_port_id_t Register(JackGraphManager* manager, const char* name, int index)
+{
+    return manager->AllocatePort(index / PORTS_PER_CLIENT + 1, name, JACK_DEFAULT_AUDIO_TYPE, JackPortIsOutput, 256);
+}
+
+static void TestLookups(JackGraphManager* manager, jack_port_id_t* ports, int count)
+{
+    char name[REAL_JACK_PORT_NAME_SIZE];
+
+    for (int i = 0; i < count; i++) {
+        PortName(name, i);
+        Check(manager->GetPort(name) == ports[i], "Port not found", name);
+    }
+    Check(manager->GetPort("client_0:missing") == NO_PORT, "Unknown port found", "client_0:missing");
+}
+
+static void TestChanges(JackGraphManager* manager, jack_port_id_t port)
+{
+    char old_name[REAL_JACK_PORT_NAME_SIZE];
+    strcpy(old_name, manager->GetPort(port)->GetName());
+
+    // Rename
+    manager->SetPortName(port, "renamed");
+    Check(manager->GetPort(old_name) == NO_PORT, "Old name found", old_name);
+    Check(manager->GetPort("client_0:renamed") == port, "New name not found", "client_0:renamed");
+
+    // Aliases
+    Check(manager->SetPortAlias(port, "alias_1") == 0, "Set alias", "alias_1");
+    Check(manager->SetPortAlias(port, "alias_2") == 0, "Set alias", "alias_2");
+    Check(manager->SetPortAlias(port, "alias_3") < 0, "Third alias set", "alias_3");
+    Check(manager->GetPort("alias_1") == port, "Alias not found", "alias_1");
+    Check(manager->GetPort("alias_2") == port, "Alias not found", "alias_2");
+    Check(manager->GetPort("alias_3") == NO_PORT, "Third alias found", "alias_3");
+    manager->UnsetPortAlias(port, "alias_1");
+    Check(manager->GetPort("alias_1") == NO_PORT, "Unset alias found", "alias_1");
+    Check(manager->GetPort("alias_2") == port, "Alias not found after unset", "alias_2");
+
+    // Back to the previous name, an alias is kept
+    manager->SetPortName(port, strchr(old_name, ':') + 1);
+    Check(manager->GetPort(old_name) == port, "Name not found after rename", old_name);
+    Check(manager->GetPort("client_0:renamed") == NO_PORT, "Previous name found", "client_0:renamed");
+    manager->UnsetPortAlias(port, "alias_2");
+}
+
+static void TestAlsaNames(JackGraphManager* manager)
+{
+    jack_port_id_t port = manager->AllocatePort(CLIENT_NUM - 1, "alsa_pcm:capture_1", JACK_DEFAULT_AUDIO_TYPE, JackPortIsOutput, 256);
+    Check(manager->GetPort("ALSA:capture_1") == port, "ALSA name not found", "ALSA:capture_1");
+    manager->ReleasePort(CLIENT_NUM - 1, port);
+    Check(manager->GetPort("alsa_pcm:capture_1") == NO_PORT, "Released port found", "alsa_pcm:capture_1");
+}
+
+// Released ports are marked in the index, until it is rebuilt
+static void TestChurn(JackGraphManager* manager, jack_port_id_t* ports, int count)
+{
+    char name[REAL_JACK_PORT_NAME_SIZE];
+
+    for (int loop = 0; loop < 4 * PORT_NAME_INDEX_SIZE / count; loop++) {
+        for (int i = 0; i < count; i += 2) {
+            manager->ReleasePort(i / PORTS_PER_CLIENT + 1, ports[i]);
+        }
+        for (int i = 0; i < count; i += 2) {
+            PortName(name, i);
+            Check(manager->GetPort(name) == NO_PORT, "Released port found", name);
+            ports[i] = Register(manager, name, i);
+            manager->SetPortAlias(ports[i], name + 1);
+        }
+        for (int i = 0; i < count; i += 2) {
+            PortName(name, i);
+            Check(manager->GetPort(name + 1) == ports[i], "Alias not found after churn", name + 1);
+        }
+        TestLookups(manager, ports, count);
+    }
+}
+
+static void Bench(JackGraphManager* manager, int count)
+{
+    char name[REAL_JACK_PORT_NAME_SIZE];
+    jack_port_id_t res = 0;
+
+    double start = GetTime();
+    for (int loop = 0; loop < BENCH_LOOPS; loop++) {
+        for (int i = 0; i < count; i++) {
+            PortName(name, i);
+            res += manager->GetPort(name);
+        }
+    }
+    double indexed = (GetTime() - start) / (BENCH_LOOPS * count);
+
+    start = GetTime();
+    for (int loop = 0; loop < BENCH_LOOPS; loop++) {
+        for (int i = 0; i < count; i++) {
+            PortName(name, i);
+            res -= FindLinear(manager, name);
+        }
+    }
+    double linear = (GetTime() - start) / (BENCH_LOOPS * count);
+
+    printf("Lookup of %d ports : indexed %6.3f usecs, linear %6.3f usecs (%s)\n", count, indexed, linear, (res == 0) ? "same results" : "different results");
+    Check(res == 0, "Indexed and linear lookups differ", "");
+}
+
+int main(int argc, char* argv[])
+{
+    // Port buffers are allocated in shared memory
+    if (jack_register_server("test_port_name_index", 0) != 0) {
+        printf("Cannot register server\n");
+        return 1;
+    }
+
+    // Allocated in process memory, with the placement new of the shared memory objects
+    void* memory = calloc(1, sizeof(JackGraphManager) + PORT_MAX * sizeof(JackPort));
+    JackGraphManager* manager = new(memory) JackGraphManager(PORT_MAX);
+    jack_port_id_t ports[PORT_MAX];
+    char name[REAL_JACK_PORT_NAME_SIZE];
+    int count = PORT_MAX - 2;
+
+    manager->SetBufferSize(256);
+
+    for (int i = 0; i < count; i++) {
+        PortName(name, i);
+        ports[i] = Register(manager, name, i);
+        if (ports[i] == NO_PORT) {
+            printf("Cannot register port %s\n", name);
+            return 1;
+        }
+    }
+
+    TestLookups(manager, ports, count);
+    TestChanges(manager, ports[0]);
+    TestAlsaNames(manager);
+    TestChurn(manager, ports, count);
+    Bench(manager, count);
+
+    JackPortBufferPool::Destroy(manager->GetBufferPool());
+    manager->~JackGraphManager();
+    free(memory);
+    jack_unregister_server("test_port_name_index");
+
+    printf("%s\n", (gErrors == 0) ? "Port name index test OK" : "Port name index test FAILED");
+    return (gErrors == 0) ? 0 : 1;
+}
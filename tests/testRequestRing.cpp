@@ -0,0 +1,267 @@
+/*
+	Copyright (C) 2026 agent
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/*
+    Round trip of a client request : a thread plays the server, decoding requests and writing results as the server
+    channels do. The client socket is compared with the shared memory request ring, for a small request (jack_connect)
+    and a request bigger than the ring (jack_connect_list), whose results are checked.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <pthread.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "JackRequest.h"
+#include "JackSocket.h"
+#include "JackShmRequestRing.h"
+#include "JackPlatformPlug.h"
+
+using namespace Jack;
+
+#define ROUND_TRIPS 20000
+#define LIST_ROUND_TRIPS 200
+#define TEST_NAME "test_request_ring"
+
+static double GetTime()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return double(ts.tv_sec) * 1e6 + double(ts.tv_nsec) / 1e3;
+}
+
+// Result of a connection as computed by the "server"
+static int ConnectResult(const char* src, const char* dst)
+{
+    return int(strlen(src) + strlen(dst));
+}
+
+// Decodes requests until a ClientClose one
+static void* ServerLoop(void* arg)
+{
+    detail::JackChannelTransactionInterface* trans = (detail::JackChannelTransactionInterface*)arg;
+
+    while (true) {
+        JackRequest header;
+        JackRequestBuffer buffer;
+        if (header.Read(trans) < 0 || buffer.Fill(trans) < 0) {
+            printf("Server cannot read request\n");
+            return NULL;
+        }
+
+        if (header.fType == JackRequest::kConnectNamePorts) {
+            JackPortConnectNameRequest req;
+            JackResult res;
+            req.Read(&buffer);
+            res.fResult = ConnectResult(req.fSrc, req.fDst);
+            JackRequestBuffer out;
+            res.Write(&out);
+            out.Flush(trans);
+        } else if (header.fType == JackRequest::kConnectNamePortsList) {
+            JackPortConnectNameListRequest req;
+            JackPortConnectNameListResult res;
+            req.Read(&buffer);
+            res.fCount = req.fCount;
+            res.fResult = 0;
+            for (int i = 0; i < req.fCount; i++) {
+                res.fResults[i] = ConnectResult(req.fConnections[i].fSrc, req.fConnections[i].fDst);
+            }
+            JackRequestBuffer out;
+            res.Write(&out);
+            out.Flush(trans);
+        } else {
+            JackResult res(0);
+            JackRequestBuffer out;
+            res.Write(&out);
+            out.Flush(trans);
+            return NULL;
+        }
+    }
+}
+
+// Sends a request and waits for its result, as JackGenericClientChannel::ServerSyncCall
+static int ServerSyncCall(detail::JackClientRequestInterface* trans, JackRequest* req, JackResult* res)
+{
+    JackRequestBuffer buffer;
+    if (req->Write(&buffer) < 0 || buffer.Flush(trans) < 0) {
+        return -1;
+    }
+    return res->Read(trans);
+}
+
+struct Timing
+{
+    double fMean;
+    double fMedian;
+    double fMax;
+};
+
+static Timing GetTiming(std::vector<double>& durations)
+{
+    Timing timing;
+    double sum = 0;
+    for (size_t i = 0; i < durations.size(); i++) {
+        sum += durations[i];
+    }
+    std::sort(durations.begin(), durations.end());
+    timing.fMean = sum / durations.size();
+    timing.fMedian = durations[durations.size() / 2];
+    timing.fMax = durations.back();
+    return timing;
+}
+
+static int RunClient(detail::JackClientRequestInterface* trans, Timing* connect, Timing* list)
+{
+    int res = 0;
+    char src[REAL_JACK_PORT_NAME_SIZE + 1];
+    char dst[REAL_JACK_PORT_NAME_SIZE + 1];
+    std::vector<double> durations;
+
+    for (int i = 0; i < ROUND_TRIPS; i++) {
+        snprintf(src, sizeof(src), "system:capture_%d", i);
+        snprintf(dst, sizeof(dst), "client_%d:input", i);
+        JackPortConnectNameRequest req(0, src, dst);
+        JackResult result;
+        double start = GetTime();
+        if (ServerSyncCall(trans, &req, &result) < 0) {
+            printf("Connect request %d failed\n", i);
+            return 1;
+        }
+        durations.push_back(GetTime() - start);
+        if (result.fResult != ConnectResult(src, dst)) {
+            printf("Connect request %d : wrong result %d\n", i, result.fResult);
+            res = 1;
+        }
+    }
+    *connect = GetTiming(durations);
+
+    // More than REQUEST_RING_SIZE bytes : the ring is written and read in several parts
+    std::vector<std::string> src_names(CONNECTION_LIST_SIZE);
+    std::vector<std::string> dst_names(CONNECTION_LIST_SIZE);
+    const char* src_list[CONNECTION_LIST_SIZE];
+    const char* dst_list[CONNECTION_LIST_SIZE];
+    durations.clear();
+
+    for (int i = 0; i < LIST_ROUND_TRIPS; i++) {
+        for (int j = 0; j < CONNECTION_LIST_SIZE; j++) {
+            snprintf(src, sizeof(src), "system:capture_%d", i * j);
+            snprintf(dst, sizeof(dst), "client_%d:input_%d", i, j);
+            src_names[j] = src;
+            dst_names[j] = dst;
+            src_list[j] = src_names[j].c_str();
+            dst_list[j] = dst_names[j].c_str();
+        }
+        JackPortConnectNameListRequest req(0, src_list, dst_list, CONNECTION_LIST_SIZE);
+        JackPortConnectNameListResult result;
+        double start = GetTime();
+        if (ServerSyncCall(trans, &req, &result) < 0) {
+            printf("Connect list request %d failed\n", i);
+            return 1;
+        }
+        durations.push_back(GetTime() - start);
+        if (result.fCount != CONNECTION_LIST_SIZE) {
+            printf("Connect list request %d : wrong count %d\n", i, result.fCount);
+            res = 1;
+            continue;
+        }
+        for (int j = 0; j < CONNECTION_LIST_SIZE; j++) {
+            if (result.fResults[j] != ConnectResult(src_list[j], dst_list[j])) {
+                printf("Connect list request %d : wrong result %d for connection %d\n", i, result.fResults[j], j);
+                res = 1;
+                break;
+            }
+        }
+    }
+    *list = GetTiming(durations);
+
+    JackClientCloseRequest req(0);
+    JackResult result;
+    ServerSyncCall(trans, &req, &result);
+    return res;
+}
+
+static void PrintTiming(const char* channel, const char* request, const Timing& timing)
+{
+    printf("%8s %14s %10.2f %10.2f %10.2f\n", channel, request, timing.fMean, timing.fMedian, timing.fMax);
+}
+
+int main(int argc, char* argv[])
+{
+    int res = 0;
+    pthread_t thread;
+    Timing socket_connect, socket_list, ring_connect, ring_list;
+
+    // Socket channel
+    JackServerSocket listen_socket;
+    JackClientSocket client_socket;
+    if (listen_socket.Bind(jack_server_dir, TEST_NAME, 0) < 0) {
+        printf("Cannot bind server socket\n");
+        return 1;
+    }
+    if (client_socket.Connect(jack_server_dir, TEST_NAME, 0) < 0) {
+        printf("Cannot connect client socket\n");
+        return 1;
+    }
+    JackClientSocket* server_socket = listen_socket.Accept();
+    if (!server_socket) {
+        printf("Cannot accept client socket\n");
+        return 1;
+    }
+
+    pthread_create(&thread, NULL, ServerLoop, server_socket);
+    res |= RunClient(&client_socket, &socket_connect, &socket_list);
+    pthread_join(thread, NULL);
+
+    client_socket.Close();
+    server_socket->Close();
+    delete server_socket;
+    listen_socket.Close();
+
+    // Shared memory channel
+    JackShmRequestRing client_ring;
+    JackShmRequestRing server_ring;
+    if (client_ring.Allocate(TEST_NAME, "default") < 0 || server_ring.Attach(TEST_NAME, "default") < 0) {
+        printf("Cannot open request ring\n");
+        return 1;
+    }
+    client_ring.Unlink();
+
+    pthread_create(&thread, NULL, ServerLoop, &server_ring);
+    res |= RunClient(&client_ring, &ring_connect, &ring_list);
+    pthread_join(thread, NULL);
+
+    client_ring.Shutdown();
+    client_ring.Close();
+    server_ring.Close();
+
+    printf("usec per request round trip (%d connect, %d connect list of %d connections)\n", ROUND_TRIPS, LIST_ROUND_TRIPS, CONNECTION_LIST_SIZE);
+    printf("%8s %14s %10s %10s %10s\n", "channel", "request", "mean", "median", "max");
+    PrintTiming("socket", "connect", socket_connect);
+    PrintTiming("ring", "connect", ring_connect);
+    PrintTiming("socket", "connect list", socket_list);
+    PrintTiming("ring", "connect list", ring_list);
+    printf("ring speedup : connect %.2f, connect list %.2f\n", socket_connect.fMean / ring_connect.fMean, socket_list.fMean / ring_list.fMean);
+
+    return res;
+}
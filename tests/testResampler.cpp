@@ -0,0 +1,425 @@
+/*
+	Copyright (C) 2026 agent
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/*
+    Quality and cost of the polyphase resampler used by the audio adapters. Sines are resampled with fixed and drifting
+    ratios, on the capture (WriteResample) and playback (ReadResample) sides : the output is compared with the ideal
+    resampled sine (THD+N), and a tone above the output Nyquist frequency has to be removed (alias rejection). All channels
+    resampled at once have to give the same result as channel by channel, whose cost is then compared for 32 channels.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <sys/time.h>
+
+#include <vector>
+
+#include "JackPolyphaseResampler.h"
+
+using namespace Jack;
+
+#define SAMPLE_RATE 48000
+#define BUFFER_SIZE 256
+#define TEST_BLOCKS 500
+#define BENCH_CHANNELS 32
+#define BENCH_BLOCKS 500
+#define RING_FILL 4096      // Input frames kept in the ring on the playback side
+#define SIGNAL_FRAMES (2 * SAMPLE_RATE)      // Multiple of BUFFER_SIZE
+
+static double GetTime()
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return double(tv.tv_sec) * 1e6 + double(tv.tv_usec);
+}
+
+static double FixedRatio(double ratio, int block)
+{
+    return ratio;
+}
+
+// As the PI controler of the adapters, slowly moving around the nominal ratio
+static double DriftingRatio(double ratio, int block)
+{
+    return ratio * (1 + 0.002 * sin(2 * M_PI * block / 150.));
+}
+
+typedef double (*RatioFunction)(double ratio, int block);
+
+static void MakeSine(std::vector<float>& signal, double frequency, double amplitude, size_t frames)
+{
+    signal.resize(frames);
+    for (size_t i = 0; i < frames; i++) {
+        signal[i] = float(amplitude * sin(2 * M_PI * frequency * i / SAMPLE_RATE));
+    }
+}
+
+static void ResetResampler(JackResampler* resampler)
+{
+    // The ringbuffer starts half full : its content is dropped
+    std::vector<float> frames(DEFAULT_RB_SIZE);
+    resampler->Reset(DEFAULT_RB_SIZE);
+    resampler->Read(&frames[0], resampler->ReadSpace());
+}
+
+/*
+Capture side : blocks of input frames are resampled in the ringbuffer. All output frames produced in a call use its
+ratio (as kept by the resampler), so the input position of each output frame is known.
+*/
+
+static bool WriteResampled(JackResampler* resampler, const std::vector<float>& input, RatioFunction ratio_function, double ratio,
+                           std::vector<float>& output, std::vector<double>& positions)
+{
+    double position = 0;
+    float frames[DEFAULT_RB_SIZE];
+    ResetResampler(resampler);
+
+    for (int i = 0; (i + 1) * BUFFER_SIZE <= int(input.size()); i++) {
+        resampler->SetRatio(ratio_function(ratio, i));
+        double block_ratio = resampler->GetRatio();
+        if (resampler->WriteResample((float*)&input[i * BUFFER_SIZE], BUFFER_SIZE) != BUFFER_SIZE) {
+            printf("WriteResample failed\n");
+            return false;
+        }
+        unsigned int count = resampler->ReadSpace();
+        resampler->Read(frames, count);
+        for (unsigned int j = 0; j < count; j++) {
+            output.push_back(frames[j]);
+            positions.push_back(position);
+            position += 1 / block_ratio;
+        }
+    }
+
+    return true;
+}
+
+// Playback side : input frames are written in the ringbuffer, blocks of output frames are resampled from it
+static bool ReadResampled(JackResampler* resampler, const std::vector<float>& input, RatioFunction ratio_function, double ratio,
+                          std::vector<float>& output, std::vector<double>& positions)
+{
+    double position = 0;
+    size_t written = 0;
+    float frames[BUFFER_SIZE];
+    ResetResampler(resampler);
+
+    for (int i = 0; i < TEST_BLOCKS; i++) {
+        while (resampler->ReadSpace() < RING_FILL && written + BUFFER_SIZE <= input.size()) {
+            resampler->Write((float*)&input[written], BUFFER_SIZE);
+            written += BUFFER_SIZE;
+        }
+        if (resampler->ReadSpace() < RING_FILL) {
+            break;
+        }
+        resampler->SetRatio(ratio_function(ratio, i));
+        double block_ratio = resampler->GetRatio();
+        if (resampler->ReadResample(frames, BUFFER_SIZE) != BUFFER_SIZE) {
+            printf("ReadResample failed\n");
+            return false;
+        }
+        for (int j = 0; j < BUFFER_SIZE; j++) {
+            output.push_back(frames[j]);
+            positions.push_back(position);
+            position += 1 / block_ratio;
+        }
+    }
+
+    return true;
+}
+
+// Power of the difference between the output and the ideal resampled sine, relatively to the sine (in dB)
+static double Distortion(const std::vector<float>& output, const std::vector<double>& positions, double frequency, double amplitude,
+                         double input_frames, bool ideal)
+{
+    double noise = 0;
+    double signal = 0;
+
+    for (size_t i = 0; i < output.size(); i++) {
+        // The first and last frames are resampled with missing input
+        if (positions[i] < POLYPHASE_TAPS || positions[i] > input_frames - 2 * POLYPHASE_TAPS) {
+            continue;
+        }
+        double sine = amplitude * sin(2 * M_PI * frequency * positions[i] / SAMPLE_RATE);
+        double error = output[i] - ((ideal) ? sine : 0);
+        noise += error * error;
+        signal += sine * sine;
+    }
+
+    return 10 * log10(noise / signal);
+}
+
+struct QualityTest
+{
+    const char* fName;
+    double fFrequency;
+    double fRatio;
+    RatioFunction fRatioFunction;
+    bool fAlias;        // Tone above the output Nyquist frequency : the ideal output is silence
+    double fMaxDistortion;
+};
+
+static int TestQuality()
+{
+    static const QualityTest tests[] = {
+        { "1 kHz, ratio 1", 1000, 1, FixedRatio, false, -85 },
+        { "1 kHz, ratio 1.001", 1000, 1.001, FixedRatio, false, -85 },
+        { "1 kHz, ratio 0.999", 1000, 0.999, FixedRatio, false, -85 },
+        { "1 kHz, drifting ratio", 1000, 1, DriftingRatio, false, -85 },
+        { "10 kHz, drifting ratio", 10000, 1, DriftingRatio, false, -85 },
+        { "18 kHz, ratio 1.02", 18000, 1.02, FixedRatio, false, -80 },
+        { "23.5 kHz, ratio 0.97", 23500, 0.97, FixedRatio, true, -75 },
+        { "23.8 kHz, drifting ratio 0.99", 23800, 0.99, DriftingRatio, true, -75 },
+    };
+
+    int res = 0;
+    JackPolyphaseResampler resampler;
+
+    printf("%32s %14s %14s %10s\n", "signal", "capture (dB)", "playback (dB)", "max (dB)");
+
+    for (size_t i = 0; i < sizeof(tests) / sizeof(tests[0]); i++) {
+        const QualityTest& test = tests[i];
+        std::vector<float> input, write_output, read_output;
+        std::vector<double> write_positions, read_positions;
+        MakeSine(input, test.fFrequency, 0.5, TEST_BLOCKS * BUFFER_SIZE);
+
+        if (!WriteResampled(&resampler, input, test.fRatioFunction, test.fRatio, write_output, write_positions)
+            || !ReadResampled(&resampler, input, test.fRatioFunction, test.fRatio, read_output, read_positions)) {
+            return 1;
+        }
+
+        double write_distortion = Distortion(write_output, write_positions, test.fFrequency, 0.5, input.size(), !test.fAlias);
+        double read_distortion = Distortion(read_output, read_positions, test.fFrequency, 0.5, input.size(), !test.fAlias);
+        printf("%32s %14.1f %14.1f %10.1f\n", test.fName, write_distortion, read_distortion, test.fMaxDistortion);
+
+        if (write_distortion > test.fMaxDistortion || read_distortion > test.fMaxDistortion) {
+            printf("%s : distortion too high\n", test.fName);
+            res = 1;
+        }
+    }
+
+    return res;
+}
+
+/*
+Channels resampled at once or one by one, on both sides : results have to be the same. A NULL input channel is
+resampled as silence.
+*/
+
+struct Channels
+{
+    std::vector<JackResampler*> fResamplers;
+    std::vector<std::vector<float> > fSignals;     // A sine per channel, repeated every SIGNAL_FRAMES
+    std::vector<std::vector<float> > fBuffers;
+    std::vector<float*> fPointers;
+
+    Channels(int count) : fResamplers(count), fSignals(count), fBuffers(count, std::vector<float>(BUFFER_SIZE)), fPointers(count)
+    {
+        for (int i = 0; i < count; i++) {
+            fResamplers[i] = new JackPolyphaseResampler();
+            ResetResampler(fResamplers[i]);
+            MakeSine(fSignals[i], 200 * (i + 1), 0.5, SIGNAL_FRAMES);
+            fPointers[i] = &fBuffers[i][0];
+        }
+    }
+
+    ~Channels()
+    {
+        for (size_t i = 0; i < fResamplers.size(); i++) {
+            delete fResamplers[i];
+        }
+    }
+
+    void SetRatio(double ratio)
+    {
+        for (size_t i = 0; i < fResamplers.size(); i++) {
+            fResamplers[i]->SetRatio(ratio);
+        }
+    }
+
+    bool Write(bool all)
+    {
+        int count = int(fResamplers.size());
+        if (all) {
+            return fResamplers[0]->WriteResampleChannels(&fResamplers[0], &fPointers[0], count, BUFFER_SIZE) == BUFFER_SIZE;
+        }
+        for (int i = 0; i < count; i++) {
+            if (fResamplers[i]->WriteResample(fPointers[i], BUFFER_SIZE) != BUFFER_SIZE) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    bool Read(bool all)
+    {
+        int count = int(fResamplers.size());
+        if (all) {
+            return fResamplers[0]->ReadResampleChannels(&fResamplers[0], &fPointers[0], count, BUFFER_SIZE) == BUFFER_SIZE;
+        }
+        for (int i = 0; i < count; i++) {
+            if (fResamplers[i]->ReadResample(fPointers[i], BUFFER_SIZE) != BUFFER_SIZE) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+static void FillInput(Channels& channels, int block)
+{
+    size_t offset = (size_t(block) * BUFFER_SIZE) % SIGNAL_FRAMES;
+    for (size_t i = 0; i < channels.fBuffers.size(); i++) {
+        memcpy(&channels.fBuffers[i][0], &channels.fSignals[i][offset], BUFFER_SIZE * sizeof(float));
+    }
+}
+
+// Capture side : channels are resampled in the ringbuffer, which is then read
+static bool RunCapture(Channels& channels, int blocks, bool all, std::vector<std::vector<float> >* results)
+{
+    std::vector<float> frames(DEFAULT_RB_SIZE);
+    for (int i = 0; i < blocks; i++) {
+        FillInput(channels, i);
+        channels.SetRatio(DriftingRatio(1, i));
+        if (!channels.Write(all)) {
+            return false;
+        }
+        for (size_t j = 0; j < channels.fResamplers.size(); j++) {
+            unsigned int count = channels.fResamplers[j]->ReadSpace();
+            channels.fResamplers[j]->Read(&frames[0], count);
+            if (results) {
+                (*results)[j].insert((*results)[j].end(), frames.begin(), frames.begin() + count);
+            }
+        }
+    }
+    return true;
+}
+
+// Playback side : the ringbuffer is filled, then channels are resampled from it
+static bool RunPlayback(Channels& channels, int blocks, bool all, std::vector<std::vector<float> >* results)
+{
+    int input_block = 0;
+    for (int i = 0; i < blocks; i++) {
+        while (channels.fResamplers[0]->ReadSpace() < RING_FILL) {
+            FillInput(channels, input_block++);
+            for (size_t j = 0; j < channels.fResamplers.size(); j++) {
+                channels.fResamplers[j]->Write(channels.fPointers[j], BUFFER_SIZE);
+            }
+        }
+        channels.SetRatio(DriftingRatio(1, i));
+        if (!channels.Read(all)) {
+            return false;
+        }
+        if (results) {
+            for (size_t j = 0; j < channels.fResamplers.size(); j++) {
+                float* buffer = channels.fPointers[j];
+                (*results)[j].insert((*results)[j].end(), buffer, buffer + BUFFER_SIZE);
+            }
+        }
+    }
+    return true;
+}
+
+static int TestChannels()
+{
+    const int count = 5;
+    std::vector<std::vector<float> > one_by_one(count), all_at_once(count);
+    int res = 0;
+
+    {
+        Channels channels(count);
+        if (!RunCapture(channels, TEST_BLOCKS / 5, false, &one_by_one) || !RunPlayback(channels, TEST_BLOCKS / 5, false, &one_by_one)) {
+            printf("Channel by channel resampling failed\n");
+            return 1;
+        }
+    }
+    {
+        Channels channels(count);
+        if (!RunCapture(channels, TEST_BLOCKS / 5, true, &all_at_once) || !RunPlayback(channels, TEST_BLOCKS / 5, true, &all_at_once)) {
+            printf("Resampling of all channels failed\n");
+            return 1;
+        }
+    }
+
+    for (int i = 0; i < count; i++) {
+        if (one_by_one[i] != all_at_once[i]) {
+            printf("Channel %d : resampling all channels at once differs from channel by channel\n", i);
+            res = 1;
+        }
+    }
+
+    // A NULL input channel is silence, the other channels still being resampled
+    Channels channels(2);
+    std::vector<float> frames(DEFAULT_RB_SIZE);
+    FillInput(channels, 1);
+    channels.fPointers[1] = NULL;
+    for (int i = 0; i < 4; i++) {
+        if (channels.fResamplers[0]->WriteResampleChannels(&channels.fResamplers[0], &channels.fPointers[0], 2, BUFFER_SIZE) != BUFFER_SIZE) {
+            printf("Resampling with a NULL channel failed\n");
+            return 1;
+        }
+    }
+    unsigned int frames0 = channels.fResamplers[0]->ReadSpace();
+    unsigned int frames1 = channels.fResamplers[1]->ReadSpace();
+    channels.fResamplers[1]->Read(&frames[0], frames1);
+    for (unsigned int i = 0; i < frames1; i++) {
+        if (frames[i] != 0) {
+            printf("NULL channel is not resampled as silence\n");
+            res = 1;
+            break;
+        }
+    }
+    if (frames0 != frames1) {
+        printf("NULL channel : %d frames resampled instead of %d\n", frames1, frames0);
+        res = 1;
+    }
+
+    return res;
+}
+
+static void Benchmark()
+{
+    double block_duration = 1e6 * BUFFER_SIZE / SAMPLE_RATE;
+    double capture[2], playback[2];
+
+    for (int all = 0; all < 2; all++) {
+        Channels channels(BENCH_CHANNELS);
+        double start = GetTime();
+        RunCapture(channels, BENCH_BLOCKS, all, NULL);
+        capture[all] = (GetTime() - start) / BENCH_BLOCKS;
+        start = GetTime();
+        RunPlayback(channels, BENCH_BLOCKS, all, NULL);
+        playback[all] = (GetTime() - start) / BENCH_BLOCKS;
+    }
+
+    printf("%d channels, %d frames at %d Hz, drifting ratio (%s kernel)\n", BENCH_CHANNELS, BUFFER_SIZE, SAMPLE_RATE, JackPolyphaseResampler::GetKernelName());
+    printf("%10s %26s %26s\n", "", "channel by channel", "all channels");
+    printf("%10s %14.1f usec (%4.1f%%) %14.1f usec (%4.1f%%)\n", "capture",
+        capture[0], 100 * capture[0] / block_duration, capture[1], 100 * capture[1] / block_duration);
+    printf("%10s %14.1f usec (%4.1f%%) %14.1f usec (%4.1f%%)\n", "playback",
+        playback[0], 100 * playback[0] / block_duration, playback[1], 100 * playback[1] / block_duration);
+}
+
+int main(int argc, char* argv[])
+{
+    int res = TestQuality();
+    res |= TestChannels();
+    Benchmark();
+    return res;
+}
@@ -0,0 +1,305 @@
+/*
+	Copyright (C) 2026 agent
+
+	This program is free software; you can redistribute it and/or modify
+	it under the terms of the GNU General Public License as published by
+	the Free Software Foundation; either version 2 of the License, or
+	(at your option) any later version.
+
+	This program is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+	GNU General Public License for more details.
+
+	You should have received a copy of the GNU General Public License
+	along with this program; if not, write to the Free Software
+	Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+
+*/
+
+/*
+    Pages of the shared memory segments : a cycle of 32 chained clients reads its input buffers and writes its output
+    buffers through a graph manager and port buffers allocated in shared memory, once with normal pages and once with
+    huge pages (JACK_SHM_HUGEPAGES, set to "1" if not already set). Between two clients, a private buffer is touched as
+    the process of the next client would do, so that the TLB does not keep the entries of the previous one.
+    The dTLB misses of the client parts are counted with perf events when the CPU provides them, their duration is
+    measured in any case. The results of both cycles are checked to be the same.
+    Huge pages have to be reserved, for instance with : echo 64 > /proc/sys/vm/nr_hugepages, and a hugetlbfs mounted.
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+
+#include <vector>
+#include <algorithm>
+
+#include "JackGraphManager.h"
+
+using namespace Jack;
+
+#define PORT_MAX 2048
+#define CLIENTS 32
+#define CHANNELS 4
+#define BUFFER_SIZE 256
+#define CYCLES 1000
+#define CLIENT_MEMORY (16 * 1024 * 1024)
+#define PAGE_STRIDE 4096
+
+struct CycleResult
+{
+    int fError;
+    int fPageSize;          // In KB, of the graph manager segment
+    int fCounters;          // 0 if not available, otherwise errno
+    double fTime;           // Median of the client parts of a cycle, in usecs
+    double fLoadMisses;     // Per cycle
+    double fStoreMisses;
+    double fChecksum;
+};
+
+static double GetTime()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return double(ts.tv_sec) * 1e6 + double(ts.tv_nsec) / 1e3;
+}
+
+static int OpenCounter(int op, int group)
+{
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HW_CACHE;
+    attr.config = PERF_COUNT_HW_CACHE_DTLB | (op << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    attr.disabled = (group < 0);
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return syscall(__NR_perf_event_open, &attr, 0, -1, group, 0);
+}
+
+static double ReadCounter(int fd)
+{
+    long long count = 0;
+    return (fd >= 0 && read(fd, &count, sizeof(count)) == sizeof(count)) ? double(count) : 0.;
+}
+
+// Page size of the mapping containing the address, from /proc/self/smaps
+static int GetPageSize(void* address)
+{
+    FILE* file = fopen("/proc/self/smaps", "r");
+    char line[512];
+    bool found = false;
+    int size = 0;
+
+    if (!file) {
+        return 0;
+    }
+    while (fgets(line, sizeof(line), file)) {
+        unsigned long start, end;
+        if (sscanf(line, "%lx-%lx ", &start, &end) == 2) {
+            found = ((unsigned long)address >= start && (unsigned long)address < end);
+        } else if (found && sscanf(line, "KernelPageSize: %d kB", &size) == 1) {
+            break;
+        }
+    }
+    fclose(file);
+    return size;
+}
+
+static jack_port_id_t Register(JackGraphManager* manager, int refnum, const char* name, JackPortFlags flags)
+{
+    char port_name[REAL_JACK_PORT_NAME_SIZE];
+    snprintf(port_name, sizeof(port_name), "client_%d:%s", refnum, name);
+    return manager->AllocatePort(refnum, port_name, JACK_DEFAULT_AUDIO_TYPE, flags, BUFFER_SIZE);
+}
+
+static void Connect(JackConnectionManager* manager, jack_port_id_t src, jack_port_id_t dst)
+{
+    manager->Connect(src, dst);
+    manager->Connect(dst, src);
+    manager->IncDirectConnection(src, dst);
+}
+
+static float RunClient(JackGraphManager* manager, jack_port_id_t* inputs, jack_port_id_t* outputs)
+{
+    float sum = 0.f;
+    for (int i = 0; i < CHANNELS; i++) {
+        float* in = (float*)manager->GetBuffer(inputs[i], BUFFER_SIZE);
+        float* out = (float*)manager->GetBuffer(outputs[i], BUFFER_SIZE);
+        for (int j = 0; j < BUFFER_SIZE; j++) {
+            out[j] = in[j] * 0.5f + 0.001f * float(j);
+            sum += out[j];
+        }
+    }
+    return sum;
+}
+
+static void RunCycles(CycleResult* result)
+{
+    jack_port_id_t inputs[CLIENTS + 1][CHANNELS];
+    jack_port_id_t outputs[CLIENTS + 1][CHANNELS];
+    char* memory = (char*)calloc(1, CLIENT_MEMORY);
+    int load_fd, store_fd;
+
+    JackGraphManager* manager = JackGraphManager::Allocate(PORT_MAX);
+    if (manager->SetBufferSize(BUFFER_SIZE) < 0) {
+        printf("Cannot allocate port buffers\n");
+        result->fError++;
+        return;
+    }
+
+    // Each input of a client is connected to an output of the two previous ones, so that it is mixed.
+    // Connections are done in the connection manager : JackGraphManager::Connect needs the engine control of a server.
+    JackConnectionManager* connections = manager->WriteNextStateStart();
+    for (int refnum = 1; refnum <= CLIENTS; refnum++) {
+        for (int i = 0; i < CHANNELS; i++) {
+            char name[32];
+            snprintf(name, sizeof(name), "in_%d", i);
+            inputs[refnum][i] = Register(manager, refnum, name, JackPortIsInput);
+            snprintf(name, sizeof(name), "out_%d", i);
+            outputs[refnum][i] = Register(manager, refnum, name, JackPortIsOutput);
+            if (inputs[refnum][i] == NO_PORT || outputs[refnum][i] == NO_PORT) {
+                printf("Cannot register ports of client %d\n", refnum);
+                result->fError++;
+                return;
+            }
+            if (refnum > 1) {
+                Connect(connections, outputs[refnum - 1][i], inputs[refnum][i]);
+            }
+            if (refnum > 2) {
+                Connect(connections, outputs[refnum - 2][(i + 1) % CHANNELS], inputs[refnum][i]);
+            }
+        }
+    }
+    manager->WriteNextStateStop();
+    manager->RunNextGraph();
+    result->fPageSize = GetPageSize(manager);
+
+    if ((load_fd = OpenCounter(PERF_COUNT_HW_CACHE_OP_READ, -1)) < 0) {
+        result->fCounters = errno;
+        store_fd = -1;
+    } else {
+        store_fd = OpenCounter(PERF_COUNT_HW_CACHE_OP_WRITE, load_fd);
+    }
+
+    std::vector<double> times(CYCLES, 0.);
+    for (int cycle = 0; cycle < CYCLES; cycle++) {
+        manager->RunCurrentGraph();
+        for (int refnum = 1; refnum <= CLIENTS; refnum++) {
+            for (int i = 0; i < CLIENT_MEMORY; i += PAGE_STRIDE) {
+                memory[i]++;
+            }
+            if (load_fd >= 0) {
+                ioctl(load_fd, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+            }
+            double start = GetTime();
+            float sum = RunClient(manager, inputs[refnum], outputs[refnum]);
+            times[cycle] += GetTime() - start;
+            if (load_fd >= 0) {
+                ioctl(load_fd, PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+            }
+            if (cycle == CYCLES - 1) {
+                result->fChecksum += sum;
+            }
+        }
+    }
+
+    std::sort(times.begin(), times.end());
+    result->fTime = times[CYCLES / 2];
+    result->fLoadMisses = ReadCounter(load_fd) / CYCLES;
+    result->fStoreMisses = ReadCounter(store_fd) / CYCLES;
+    if (load_fd >= 0) {
+        close(load_fd);
+    }
+    if (store_fd >= 0) {
+        close(store_fd);
+    }
+
+    JackGraphManager::Destroy(manager);
+    free(memory);
+}
+
+// Segments are placed according to the environment read on the first allocation, so each kind of pages is tested in a new process
+static bool RunProcess(bool hugepages, CycleResult* result)
+{
+    int fds[2];
+    memset(result, 0, sizeof(CycleResult));
+
+    if (pipe(fds) < 0) {
+        return false;
+    }
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        close(fds[0]);
+        if (!hugepages) {
+            unsetenv("JACK_SHM_HUGEPAGES");
+        } else if (!getenv("JACK_SHM_HUGEPAGES")) {
+            setenv("JACK_SHM_HUGEPAGES", "1", 1);
+        }
+        if (jack_register_server("test_shm_pages", 0) != 0) {
+            printf("Cannot register server\n");
+            result->fError++;
+        } else {
+            RunCycles(result);
+            jack_unregister_server("test_shm_pages");
+        }
+        fflush(stdout);
+        ssize_t res = write(fds[1], result, sizeof(CycleResult));
+        _exit(res == sizeof(CycleResult) ? 0 : 1);
+    }
+
+    close(fds[1]);
+    bool res = (pid > 0 && read(fds[0], result, sizeof(CycleResult)) == sizeof(CycleResult));
+    close(fds[0]);
+    if (pid > 0) {
+        waitpid(pid, NULL, 0);
+    }
+    return res;
+}
+
+static void PrintResult(const char* name, const CycleResult& result)
+{
+    printf("%s : %4d KB pages, %7.2f usecs", name, result.fPageSize, result.fTime);
+    if (result.fCounters == 0) {
+        printf(", %8.0f dTLB load misses, %8.0f dTLB store misses", result.fLoadMisses, result.fStoreMisses);
+    }
+    printf(" per cycle of %d clients\n", CLIENTS);
+}
+
+int main(int argc, char* argv[])
+{
+    CycleResult normal, huge;
+
+    if (!RunProcess(false, &normal) || !RunProcess(true, &huge) || normal.fError || huge.fError) {
+        printf("Shared memory pages test FAILED\n");
+        return 1;
+    }
+
+    PrintResult("Normal pages", normal);
+
+    // Without huge pages, both cycles use normal pages : there is nothing to compare
+    if (huge.fPageSize <= normal.fPageSize) {
+        printf("Huge pages   : not applicable, not available (see JACK_SHM_HUGEPAGES and /proc/sys/vm/nr_hugepages)\n");
+    } else {
+        PrintResult("Huge pages  ", huge);
+        if (normal.fCounters != 0) {
+            printf("dTLB miss counters not available (%s), only the times are compared\n", strerror(normal.fCounters));
+        } else if (normal.fLoadMisses + normal.fStoreMisses > 0) {
+            printf("dTLB misses reduced by %.1f%%\n",
+                   100. * (1. - (huge.fLoadMisses + huge.fStoreMisses) / (normal.fLoadMisses + normal.fStoreMisses)));
+        }
+        printf("Client parts of the cycle with huge pages : %.1f%% of the time with normal pages\n", 100. * huge.fTime / normal.fTime);
+    }
+
+    bool same = (normal.fChecksum == huge.fChecksum);
+    printf("%s\n", (same) ? "Shared memory pages test OK" : "Shared memory pages test FAILED : different cycle results");
+    return (same) ? 0 : 1;
+}
@@ -6,7 +6,7 @@
 	the Free Software Foundation; either version 2 of the License, or
 	(at your option) any later version.
 
-	This program is distributed in the hope that it will be useful, 
+	This program is distributed in the hope that it will be useful,
 	but WITHOUT ANY WARRANTY; without even the implied warranty of
 	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
 	GNU General Public License for more details.
@@ -17,6 +17,12 @@
 
 */
 
+/*
+    Latency of the inter thread swap with each synchronization primitive : a thread signals a synchro
+    and waits on a second one, signaled back by another thread. Each round trip gives two swaps,
+    the per swap latency of the ITER round trips is shown as a histogram.
+*/
+
 #ifdef WIN32
 
 #else
@@ -34,6 +40,9 @@
 
 #endif
 
+#include <algorithm>
+#include <vector>
+
 #ifdef __APPLE__
 	#include "JackMachSemaphore.h"
 #endif
@@ -45,11 +54,13 @@
 #ifdef linux
 	#include "JackPosixSemaphore.h"
 	#include "JackFifo.h"
+	#include "JackLinuxFutex.h"
 #endif
 
 #include "JackPlatformPlug.h"
 
 #define ITER 100000
+#define BUCKETS 12      // Powers of two usec : < 1, < 2, < 4... and the last one for higher values
 
 #define SERVER "serveur1"
 #define CLIENT "client1"
@@ -58,29 +69,21 @@ using namespace Jack;
 
 #ifdef WIN32
 LARGE_INTEGER gFreq;
-long gQueryOverhead;
 
-static long elapsed (LARGE_INTEGER * t1, LARGE_INTEGER *t2)
+static double GetTime()
 {
-    long high = t1->HighPart - t2->HighPart;
-    double low = t1->LowPart - t2->LowPart;
-    // ignore values when high part changes
-    return high ? 0 : (long)((low * 1000000) / gFreq.LowPart);
+    LARGE_INTEGER t;
+    QueryPerformanceCounter(&t);
+    return double(t.QuadPart) * 1e6 / double(gFreq.QuadPart);
 }
 
-static BOOL overhead (long * overhead)
+#else
+
+static double GetTime()
 {
-    LARGE_INTEGER t1, t2;
-    BOOL r1, r2;
-    int i = 50;
-    r1 = QueryPerformanceCounter (&t1);
-    while (i--)
-        QueryPerformanceCounter (&t2);
-    r2 = QueryPerformanceCounter (&t2);
-    if (!r1 || !r2)
-        return FALSE;
-    *overhead = elapsed(&t2, &t1) / 50;
-    return TRUE;
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return double(ts.tv_sec) * 1e6 + double(ts.tv_nsec) / 1e3;
 }
 
 #endif
@@ -93,45 +96,23 @@ class Test1 : public JackRunnableInterface
 
         sync_type* fSynchro1;
         sync_type* fSynchro2;
+        std::vector<double>& fLatency;
 
     public:
 
-        Test1(sync_type* synchro1, sync_type* synchro2)
-                : fSynchro1(synchro1), fSynchro2(synchro2)
+        Test1(sync_type* synchro1, sync_type* synchro2, std::vector<double>& latency)
+                : fSynchro1(synchro1), fSynchro2(synchro2), fLatency(latency)
         {}
 
         bool Execute()
         {
-
-		#ifdef WIN32
-            LARGE_INTEGER t1, t2;
-            BOOL r1, r2;
-            r1 = QueryPerformanceCounter (&t1);
-		#else
-			struct timeval T0, T1;
-            clock_t time1, time2;
-            // Get total time for 2 * ITER process swaps
-            time1 = clock();
-            gettimeofday(&T0, 0);
-		#endif
-
-            printf("Execute loop Test1\n");
             for (int i = 0; i < ITER; i++) {
+                double t1 = GetTime();
                 fSynchro2->Signal();
                 fSynchro1->Wait();
+                fLatency[i] = (GetTime() - t1) / 2.0;
             }
-
-		#ifdef WIN32
-            r2 = QueryPerformanceCounter (&t2);
-            elapsed(&t2, &t1);
-            printf ("%5.1lf usec for inter process swap\n", elapsed(&t2, &t1) / (2.0 * ITER));
-		#else
-			time2 = clock();
-            gettimeofday(&T1, 0);
-            printf ("%5.1lf usec for inter process swap\n", (1e6 * T1.tv_sec - 1e6 * T0.tv_sec + T1.tv_usec - T0.tv_usec) / (2.0 * ITER));
-            printf ("%f usec for inter process swap \n", (1e6 * ((time2 - time1) / (double(CLOCKS_PER_SEC)))) / (2.0 * ITER));
-		#endif
-            return true;
+            return false;
         }
 
 };
@@ -153,72 +134,90 @@ class Test2 : public JackRunnableInterface
 
         bool Execute()
         {
-            printf("Execute loop Test2\n");
             for (int i = 0; i < ITER; i++) {
                 fSynchro2->Wait();
                 fSynchro1->Signal();
             }
-            return true;
+            return false;
         }
 
 };
 
+static void print_histogram(const char* name, std::vector<double>& latency)
+{
+    int histogram[BUCKETS] = {};
+    double sum = 0;
+
+    for (int i = 0; i < ITER; i++) {
+        int bucket = 0;
+        while (bucket < BUCKETS - 1 && latency[i] >= double(1 << bucket)) {
+            bucket++;
+        }
+        histogram[bucket]++;
+        sum += latency[i];
+    }
+
+    std::sort(latency.begin(), latency.end());
+    printf("%s : min = %.2f avg = %.2f median = %.2f 99%% = %.2f max = %.2f usec per swap\n",
+           name, latency[0], sum / ITER, latency[ITER / 2], latency[(ITER * 99) / 100], latency[ITER - 1]);
+
+    for (int bucket = 0; bucket < BUCKETS; bucket++) {
+        if (bucket < BUCKETS - 1) {
+            printf("    < %5d usec : %7d (%5.1f %%)\n", 1 << bucket, histogram[bucket], (100.0 * histogram[bucket]) / ITER);
+        } else {
+            printf("   >= %5d usec : %7d (%5.1f %%)\n", 1 << (bucket - 1), histogram[bucket], (100.0 * histogram[bucket]) / ITER);
+        }
+    }
+}
+
 template <typename sync_type>
-void run_tests(void)
+void run_tests(const char* name)
 {
     sync_type sem1, sem2, sem3, sem4;
+    std::vector<double> latency(ITER);
 
     sem1.Allocate(SERVER, "default", 0);
     sem2.Allocate(CLIENT, "default", 0);
     sem3.ConnectOutput(SERVER, "default");
     sem4.ConnectInput(CLIENT, "default");
 
-    Test1<sync_type> obj1(&sem1, &sem2);
+    Test1<sync_type> obj1(&sem1, &sem2, latency);
     Test2<sync_type> obj2(&sem3, &sem4);
 
-    JackThread* thread1;
     JackThread* thread2;
 
 #ifdef __APPLE__
-    thread1 = new JackMachThread(&obj1, 10000 * 1000, 500 * 1000, 10000 * 1000);
     thread2 = new JackMachThread(&obj2, 10000 * 1000, 500 * 1000, 10000 * 1000);
 #endif
 
 #ifdef  WIN32
-    thread1 = new JackWinThread(&obj1);
     thread2 = new JackWinThread(&obj2);
 #endif
 
 #ifdef linux
-    thread1 = new JackPosixThread(&obj1, false, 50, PTHREAD_CANCEL_DEFERRED);
     thread2 = new JackPosixThread(&obj2, false, 50, PTHREAD_CANCEL_DEFERRED);
 #endif
-    thread1->Start();
     thread2->Start();
-    //thread1->AcquireRealTime();
     //thread2->AcquireRealTime();
-#ifdef  WIN32
-    Sleep(30 * 1000);
-#else
-    sleep (30);
-#endif
 
-    thread1->Stop();
+    // The measuring loop runs in the main thread, the other thread quits after ITER round trips
+    obj1.Execute();
+
     thread2->Stop();
     sem3.Disconnect();
     sem4.Disconnect();
     sem1.Destroy();
     sem2.Destroy();
 
-    delete thread1;
     delete thread2;
+
+    print_histogram(name, latency);
 }
 
 int main(int ac, char *av [])
 {
 #ifdef WIN32
-    if (!QueryPerformanceFrequency (&gFreq) ||
-            !overhead (&gQueryOverhead)) {
+    if (!QueryPerformanceFrequency (&gFreq)) {
         printf ("cannot query performance counter\n");
     }
 #endif
@@ -226,34 +225,41 @@ int main(int ac, char *av [])
     printf("Test of synchronization primitives : inside a process\n");
     printf("type -s to test Posix semaphore\n");
     printf("type -f to test Fifo\n");
+    printf("type -x to test futex\n");
+    printf("type -a to test all Linux primitives\n");
     printf("type -m to test Mach semaphore\n");
     printf("type -e to test Windows event\n");
 
+    if (ac < 2) {
+        return 1;
+    }
+
 #ifdef __APPLE__
     if (strcmp(av[1], "-m") == 0) {
-        printf("Mach semaphore\n");
-        run_tests<JackMachSemaphore>();
+        run_tests<JackMachSemaphore>("Mach semaphore");
     }
 #endif
 
 #ifdef WIN32
     if (strcmp(av[1], "-e") == 0) {
-        printf("Win event\n");
-        run_tests<JackWinEvent>();
+        run_tests<JackWinEvent>("Win event");
     }
 #endif
 
 #ifdef linux
-    if (strcmp(av[1], "-s") == 0) {
-        printf("Posix semaphore\n");
-        run_tests<JackPosixSemaphore>();
+    bool all = (strcmp(av[1], "-a") == 0);
+
+    if (all || strcmp(av[1], "-s") == 0) {
+        run_tests<JackPosixSemaphore>("Posix semaphore");
     }
 
-    if (strcmp(av[1], "-f") == 0) {
-        printf("Fifo\n");
-        run_tests<JackFifo>();
+    if (all || strcmp(av[1], "-f") == 0) {
+        run_tests<JackFifo>("Fifo");
     }
 
+    if (all || strcmp(av[1], "-x") == 0) {
+        run_tests<JackLinuxFutex>("Futex");
+    }
  #endif
     return 0;
 }
@@ -22,6 +22,7 @@
 #include "JackWinNamedPipeNotifyChannel.h"
 #include "JackError.h"
 #include "JackConstants.h"
+#include "JackTime.h"
 
 namespace Jack
 {
@@ -73,6 +74,36 @@ void JackWinNamedPipeNotifyChannel::ClientNotify(int refnum, const char* name, i
     }
 }
 
-} // end of namespace
+int JackWinNamedPipeNotifyChannel::ClientNotifyPost(int refnum, const char* name, int notify, const char* message, int value1, int value2)
+{
+    JackClientNotification event(name, refnum, notify, true, message, value1, value2);
+
+    // Send notification, the result is read later
+    if (event.Write(&fNotifyPipe) < 0) {
+        jack_error("Could not write notification");
+        return -1;
+    }
+    return 0;
+}
 
+int JackWinNamedPipeNotifyChannel::ClientNotifyResults(JackWinNamedPipeNotifyChannel** channels, int* results, jack_time_t* reply_times, int count, jack_time_t deadline)
+{
+    int res = 0;
 
+    // The results are read in order with the pipe time out
+    for (int i = 0; i < count; i++) {
+        JackResult result;
+        if (result.Read(&channels[i]->fNotifyPipe) < 0) {
+            jack_error("Could not read result");
+            results[i] = -1;
+            res = -1;
+        } else {
+            results[i] = result.fResult;
+        }
+        reply_times[i] = GetMicroSeconds();
+    }
+
+    return res;
+}
+
+} // end of namespace
@@ -277,8 +277,7 @@ int JackPortAudioDriver::Attach()
         if (fInputDevice != paNoDevice && fPaDevices->GetHostFromDevice(fInputDevice) == "ASIO") {
             for (int i = 0; i < fCaptureChannels; i++) {
                 if (PaAsio_GetInputChannelName(fInputDevice, i, &alias) == paNoError) {
-                    JackPort* port = fGraphManager->GetPort(fCapturePortList[i]);
-                    port->SetAlias(alias);
+                    fGraphManager->SetPortAlias(fCapturePortList[i], alias);
                 }
             }
         }
@@ -286,8 +285,7 @@ int JackPortAudioDriver::Attach()
         if (fOutputDevice != paNoDevice && fPaDevices->GetHostFromDevice(fOutputDevice) == "ASIO") {
             for (int i = 0; i < fPlaybackChannels; i++) {
                 if (PaAsio_GetOutputChannelName(fOutputDevice, i, &alias) == paNoError) {
-                    JackPort* port = fGraphManager->GetPort(fPlaybackPortList[i]);
-                    port->SetAlias(alias);
+                    fGraphManager->SetPortAlias(fPlaybackPortList[i], alias);
                 }
             }
         }
@@ -345,8 +343,8 @@ int JackPortAudioDriver::SetBufferSize(jack_nframes_t buffer_size)
         jack_error("Pa_OpenStream error = %s", Pa_GetErrorText(err));
         goto error;
     } else {
-        JackAudioDriver::SetBufferSize(buffer_size); // Generic change, never fails
-        return 0;
+        // Generic change, fails if port buffers cannot be allocated : the server then sets the previous buffer size again
+        return JackAudioDriver::SetBufferSize(buffer_size);
     }
 
 error: